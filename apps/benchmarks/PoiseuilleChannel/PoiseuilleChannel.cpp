@@ -20,6 +20,7 @@
 
 #include "blockforest/AABBRefinementSelection.h"
 #include "blockforest/communication/NonUniformBufferedScheme.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
 #include "blockforest/SetupBlockForest.h"
 #include "blockforest/StructuredBlockForest.h"
 #include "blockforest/loadbalancing/StaticCurve.h"
@@ -45,6 +46,8 @@
 #include "core/timing/RemainingTimeLogger.h"
 #include "core/timing/TimingPool.h"
 
+#include "domain_decomposition/SharedSweep.h"
+
 #include "field/AccuracyEvaluation.h"
 #include "field/AccuracyEvaluationLinePlot.h"
 #include "field/AddToStorage.h"
@@ -63,8 +66,10 @@
 #include "lbm/PerformanceEvaluation.h"
 #include "lbm/boundary/Curved.h"
 #include "lbm/boundary/NoSlip.h"
+#include "lbm/communication/PdfFieldPackInfo.h"
 #include "lbm/field/Adaptors.h"
 #include "lbm/field/AddToStorage.h"
+#include "lbm/field/MixedPrecisionPdfField.h"
 #include "lbm/field/PdfField.h"
 #include "lbm/lattice_model/CollisionModel.h"
 #include "lbm/lattice_model/D3Q19.h"
@@ -73,6 +78,7 @@
 #include "lbm/refinement/PdfFieldSyncPackInfo.h"
 #include "lbm/refinement/TimeStep.h"
 #include "lbm/sweeps/CellwiseSweep.h"
+#include "lbm/sweeps/MixedPrecisionSweep.h"
 #include "lbm/vtk/Density.h"
 #include "lbm/vtk/NonEquilibrium.h"
 #include "lbm/vtk/Velocity.h"
@@ -94,7 +100,10 @@
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -746,13 +755,214 @@ Vector3< real_t > exactPipeVelocity( const Vector3< real_t > & p, const shared_p
 
 
 
+/////////////////////////////////////////////////////
+// MIXED PRECISION STORAGE: ACCURACY AND THROUGHPUT //
+/////////////////////////////////////////////////////
+
+struct MixedPrecisionResult
+{
+   double mlups;
+   real_t errorL2;   // relative to the analytical solution
+   real_t errorLmax; // relative to the maximum velocity
+};
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+MixedPrecisionResult runMixedPrecision( const Config::BlockHandle & configBlock, const shared_ptr< StructuredBlockForest > & blocks,
+                                        const LatticeModel_T & latticeModel, const bool fzyx, const Setup & setup, const std::string & name )
+{
+   typedef lbm::MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight > PdfField_T;
+   typedef lbm::NoSlip< LatticeModel_T, flag_t, PdfField_T >                       NoSlip_T;
+   typedef BoundaryHandling< FlagField_T, typename LatticeModel_T::Stencil, boost::tuples::tuple< NoSlip_T > > BoundaryHandling_T;
+
+   const real_t initVelocity = ( configBlock.getParameter< bool >( "initWithMeanVelocity", false ) ) ? setup.meanVelocity_L : real_t(0);
+   const field::Layout layout = fzyx ? field::fzyx : field::zyxf;
+
+   // the mixed precision sweep is a pure sweep: one ghost layer is sufficient (and required by the pack info)
+
+   const BlockDataID pdfFieldId = blocks->addStructuredBlockData< PdfField_T >(
+            [&]( IBlock * const block, StructuredBlockStorage * const storage ) {
+               return new PdfField_T( storage->getNumberOfXCells( *block ), storage->getNumberOfYCells( *block ), storage->getNumberOfZCells( *block ),
+                                      latticeModel, true, Vector3< real_t >( initVelocity, real_t(0), real_t(0) ), real_t(1), uint_t(1), layout );
+            }, "pdf field (" + name + ")" );
+
+   const BlockDataID flagFieldId = field::addFlagFieldToStorage< FlagField_T >( blocks, "flag field (" + name + ")", uint_t(1) );
+
+   const BlockDataID boundaryHandlingId = blocks->addStructuredBlockData< BoundaryHandling_T >(
+            [&]( IBlock * const block, StructuredBlockStorage * const ) {
+               FlagField_T * flagField = block->getData< FlagField_T >( flagFieldId );
+               PdfField_T *   pdfField = block->getData< PdfField_T >( pdfFieldId );
+               const flag_t fluid = flagField->registerFlag( Fluid_Flag );
+               return new BoundaryHandling_T( "boundary handling (" + name + ")", flagField, fluid,
+                                              boost::tuples::make_tuple( NoSlip_T( "no slip", NoSlip_Flag, pdfField ) ) );
+            }, "boundary handling (" + name + ")" );
+
+   // staircase approximation of the channel walls
+
+   const Channel channel( setup, blocks->getDomain() );
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      FlagField_T        * flagField = block->getData< FlagField_T >( flagFieldId );
+      BoundaryHandling_T * handling  = block->getData< BoundaryHandling_T >( boundaryHandlingId );
+
+      for( auto cell = flagField->beginWithGhostLayerXYZ(); cell != flagField->end(); ++cell )
+      {
+         if( channel.wallContains( blocks->getBlockLocalCellCenter( *block, cell.cell() ) ) )
+            handling->forceBoundary( NoSlip_Flag, cell.x(), cell.y(), cell.z() );
+      }
+      handling->fillWithDomain( flagField->xyzSizeWithGhostLayer() );
+   }
+
+   // time loop: communication -> boundary handling -> stream & collide
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > communication( blocks );
+   communication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T, PdfField_T > >( pdfFieldId ) );
+
+   const uint_t timeSteps = configBlock.getParameter< uint_t >( "outerTimeSteps", uint_c(10) ) * configBlock.getParameter< uint_t >( "innerTimeSteps", uint_c(10) );
+
+   SweepTimeloop timeloop( blocks->getBlockStorage(), timeSteps );
+
+   timeloop.add() << BeforeFunction( communication, "communication" )
+                  << Sweep( BoundaryHandling_T::getBlockSweep( boundaryHandlingId ), "boundary handling" );
+   timeloop.add() << Sweep( makeSharedSweep( make_shared< lbm::MixedPrecisionSweep< LatticeModel_T, Storage_T, ShiftedByWeight > >( pdfFieldId ) ),
+                            "mixed precision sweep" );
+
+   WcTimingPool timeloopTiming;
+
+   WALBERLA_MPI_WORLD_BARRIER();
+   WcTimer timer;
+   timer.start();
+   timeloop.run( timeloopTiming );
+   timer.end();
+
+   double time = timer.max();
+   mpi::allReduceInplace( time, mpi::MAX );
+
+   const auto reducedTimeloopTiming = timeloopTiming.getReduced();
+   WALBERLA_LOG_RESULT_ON_ROOT( "Time loop timing (" << name << "):\n" << *reducedTimeloopTiming );
+
+   lbm::PerformanceEvaluation< FlagField_T > performance( blocks, flagFieldId, Fluid_Flag );
+
+   // accuracy
+
+   real_t errorSqr( real_t(0) );
+   real_t exactSqr( real_t(0) );
+   real_t errorMax( real_t(0) );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      const FlagField_T * flagField = block->getData< FlagField_T >( flagFieldId );
+      const PdfField_T  *  pdfField = block->getData< PdfField_T >( pdfFieldId );
+
+      const flag_t fluid = flagField->getFlag( Fluid_Flag );
+
+      for( auto cell = flagField->beginXYZ(); cell != flagField->end(); ++cell )
+      {
+         if( !isFlagSet( cell, fluid ) )
+            continue;
+
+         const auto p = blocks->getBlockLocalCellCenter( *block, cell.cell() );
+         const auto exact = setup.circularProfile ? exactPipeVelocity( p, blocks, setup ) : exactPlatesVelocity( p, blocks, setup );
+         const auto error = pdfField->getVelocity( cell.cell() ) - exact;
+
+         errorSqr += error.sqrLength();
+         exactSqr += exact.sqrLength();
+         errorMax = std::max( errorMax, error.length() );
+      }
+   }
+
+   mpi::allReduceInplace( errorSqr, mpi::SUM );
+   mpi::allReduceInplace( exactSqr, mpi::SUM );
+   mpi::allReduceInplace( errorMax, mpi::MAX );
+
+   MixedPrecisionResult result;
+   result.mlups     = performance.mlups( timeSteps, time );
+   result.errorL2   = std::sqrt( errorSqr / exactSqr );
+   result.errorLmax = errorMax / setup.maxVelocity_L;
+
+   if( configBlock.getParameter< bool >( "mixedPrecisionVTK", false ) )
+   {
+      auto vtkOutput = vtk::createVTKOutput_BlockData( blocks, "mixed_precision_" + name );
+      vtkOutput->addCellDataWriter( make_shared< lbm::VelocityVTKWriter< LatticeModel_T, float, PdfField_T > >( pdfFieldId, "Velocity" ) );
+      vtkOutput->addCellDataWriter( make_shared< lbm::DensityVTKWriter< LatticeModel_T, float, PdfField_T > >( pdfFieldId, "Density" ) );
+      vtkOutput->addCellDataWriter( make_shared< field::VTKWriter< FlagField_T > >( flagFieldId, "FlagField" ) );
+      vtkOutput->forceWrite( timeSteps );
+   }
+
+   blocks->clearBlockData( boundaryHandlingId );
+   blocks->clearBlockData( flagFieldId );
+   blocks->clearBlockData( pdfFieldId );
+
+   return result;
+}
+
+/// Runs the (uniform, non-refined) channel flow with PDFs stored as double, float, and float shifted by the lattice
+/// weights. All three runs use the same kernel (lbm::MixedPrecisionSweep, double arithmetic), which means that the
+/// difference in throughput is caused by the storage type only.
+template< typename LatticeModel_T >
+void mixedPrecisionComparison( const Config::BlockHandle & configBlock, const shared_ptr< StructuredBlockForest > & blocks,
+                               const LatticeModel_T & latticeModel, const bool fzyx, const Setup & setup )
+{
+   if( blocks->getNumberOfLevels() != uint_t(1) )
+      WALBERLA_ABORT( "The mixed precision comparison (\"--mixed-prec\") only supports uniform grids (no refinement)!" );
+
+   const auto doubleResult       = runMixedPrecision< LatticeModel_T, double, false >( configBlock, blocks, latticeModel, fzyx, setup, "double" );
+   const auto floatResult        = runMixedPrecision< LatticeModel_T, float,  false >( configBlock, blocks, latticeModel, fzyx, setup, "float" );
+   const auto shiftedFloatResult = runMixedPrecision< LatticeModel_T, float,  true  >( configBlock, blocks, latticeModel, fzyx, setup, "float_shifted" );
+
+   WALBERLA_LOG_RESULT_ON_ROOT( "Mixed precision comparison (" << CollisionModelString< LatticeModel_T >::str() << ", " <<
+                                StencilString< LatticeModel_T >::str() << ", " << ( LatticeModel_T::compressible ? "compressible" : "incompressible" ) << "):"
+                                "\n   storage          |  MLUPS      | L2 error     | Lmax error"
+                                "\n   double           |  " << std::setw(10) << doubleResult.mlups << " | " << std::setw(12) << doubleResult.errorL2 <<
+                                " | " << std::setw(12) << doubleResult.errorLmax <<
+                                "\n   float            |  " << std::setw(10) << floatResult.mlups << " | " << std::setw(12) << floatResult.errorL2 <<
+                                " | " << std::setw(12) << floatResult.errorLmax <<
+                                "\n   float (shifted)  |  " << std::setw(10) << shiftedFloatResult.mlups << " | " << std::setw(12) << shiftedFloatResult.errorL2 <<
+                                " | " << std::setw(12) << shiftedFloatResult.errorLmax <<
+                                "\n(errors relative to the analytical solution / the maximum velocity, " <<
+                                ( LatticeModel_T::compressible ? "shifting is effective for compressible models)" : "incompressible models are never shifted)" ) );
+
+   WALBERLA_ROOT_SECTION()
+   {
+      if( configBlock.getParameter< bool >( "logToSqlDB", true ) )
+      {
+         const std::string sqlFile = configBlock.getParameter< std::string >( "sqlFile", "performance.sqlite" );
+
+         const std::pair< std::string, MixedPrecisionResult > results[] = { std::make_pair( std::string( "double" ), doubleResult ),
+                                                                            std::make_pair( std::string( "float" ), floatResult ),
+                                                                            std::make_pair( std::string( "float_shifted" ), shiftedFloatResult ) };
+         for( uint_t i = 0; i != uint_t(3); ++i )
+         {
+            std::map< std::string, int >        integerProperties;
+            std::map< std::string, double >        realProperties;
+            std::map< std::string, std::string > stringProperties;
+
+            stringProperties[ "collisionModel" ] = CollisionModelString< LatticeModel_T >::str();
+            stringProperties[ "stencil" ]        = StencilString< LatticeModel_T >::str();
+            stringProperties[ "compressible" ]   = ( LatticeModel_T::compressible ? "yes" : "no" );
+            stringProperties[ "dataLayout" ]     = ( fzyx ? "fzyx" : "zyxf" );
+            stringProperties[ "pdfStorage" ]     = results[i].first;
+
+            realProperties[ "Re" ]        = double_c( setup.Re );
+            realProperties[ "MLUPS" ]     = results[i].second.mlups;
+            realProperties[ "errorL2" ]   = double_c( results[i].second.errorL2 );
+            realProperties[ "errorLmax" ] = double_c( results[i].second.errorLmax );
+
+            postprocessing::storeRunInSqliteDB( sqlFile, integerProperties, stringProperties, realProperties );
+         }
+      }
+   }
+}
+
+
+
+
 ////////////////////
 // THE SIMULATION //
 ////////////////////
 
 template< typename LatticeModel_T >
 void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeModel,
-          const bool fzyx, const bool syncComm, const bool fullComm, const bool linearExplosion,
+          const bool fzyx, const bool mixedPrecision, const bool syncComm, const bool fullComm, const bool linearExplosion,
           const blockforest::RefinementSelectionFunctions & refinementSelectionFunctions, Setup & setup,
           const memory_t memoryPerCell, const memory_t processMemoryLimit )
 {
@@ -775,6 +985,12 @@ void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeMod
 
    auto blocks = createStructuredBlockForest( configBlock, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
 
+   if( mixedPrecision )
+   {
+      mixedPrecisionComparison( configBlock, blocks, latticeModel, fzyx, setup );
+      return;
+   }
+
    // add pdf field to blocks
 
    const real_t initVelocity = ( configBlock.getParameter< bool >( "initWithMeanVelocity", false ) ) ? setup.meanVelocity_L : real_t(0);
@@ -1082,7 +1298,7 @@ int main( int argc, char **argv )
    {
       WALBERLA_ROOT_SECTION()
       {
-         std::cout << "Usage: " << argv[0] << " path-to-configuration-file [--trt] [--d3q27] [--comp] [--fzyx] [--sync-comm] [--full-comm] [--linear-exp]\n"
+         std::cout << "Usage: " << argv[0] << " path-to-configuration-file [--trt] [--d3q27] [--comp] [--fzyx] [--mixed-prec] [--sync-comm] [--full-comm] [--linear-exp]\n"
                       "\n"
                       "By default, SRT is selected as collision model, an asynchronous communication scheme with block neighborhood and\n"
                       "direction-aware optimizations is chosen, and an incompressible D3Q19 LB kernel is executed on a PDF field with\n"
@@ -1093,6 +1309,9 @@ int main( int argc, char **argv )
                       " --d3q27:      A D3Q27 model is used.\n"
                       " --comp:       LB kernel is switched from incompressible to compressible\n"
                       " --fzyx:       data layout switched to 'fzyx' (structure of arrays [SoA])\n"
+                      " --mixed-prec: Instead of the refinement benchmark, the (uniform) channel is simulated three times with\n"
+                      "               PDFs stored as double, float, and float shifted by the lattice weights (arithmetic is\n"
+                      "               always done in double precision). Throughput and accuracy are compared.\n"
                       " --sync-comm:  A synchronous communication scheme is used instead of an asynchronous scheme\n"
                       "               which is used by default.\n"
                       " --full-comm:  A full synchronization of neighboring blocks is performed instead of using a communication\n"
@@ -1218,6 +1437,7 @@ int main( int argc, char **argv )
    LM   lm              = LMD3Q19;
    bool compressible    = false;
    bool fzyx            = false;
+   bool mixedPrecision  = false;
    bool syncComm        = false;
    bool fullComm        = false;
    bool linearExplosion = false;
@@ -1228,6 +1448,7 @@ int main( int argc, char **argv )
       if( std::strcmp( argv[i], "--d3q27" )      == 0 ) lm              = LMD3Q27;
       if( std::strcmp( argv[i], "--comp" )       == 0 ) compressible    = true;
       if( std::strcmp( argv[i], "--fzyx" )       == 0 ) fzyx            = true;
+      if( std::strcmp( argv[i], "--mixed-prec" ) == 0 ) mixedPrecision  = true;
       if( std::strcmp( argv[i], "--sync-comm" )  == 0 ) syncComm        = true;
       if( std::strcmp( argv[i], "--full-comm" )  == 0 ) fullComm        = true;
       if( std::strcmp( argv[i], "--linear-exp" ) == 0 ) linearExplosion = true;
@@ -1266,12 +1487,12 @@ int main( int argc, char **argv )
          if( compressible )
          {
             D3Q19_SRT_COMP latticeModel = D3Q19_SRT_COMP( cm, lbm::force_model::SimpleConstant( setup.acceleration_L, real_t(0), real_t(0) ) );
-            run( config, latticeModel, fzyx, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
+            run( config, latticeModel, fzyx, mixedPrecision, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
          }
          else
          {
             D3Q19_SRT_INCOMP latticeModel = D3Q19_SRT_INCOMP( cm, lbm::force_model::SimpleConstant( setup.acceleration_L, real_t(0), real_t(0) ) );
-            run( config, latticeModel, fzyx, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
+            run( config, latticeModel, fzyx, mixedPrecision, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
          }
       }
       else
@@ -1279,12 +1500,12 @@ int main( int argc, char **argv )
          if( compressible )
          {
             D3Q27_SRT_COMP latticeModel = D3Q27_SRT_COMP( cm, lbm::force_model::SimpleConstant( setup.acceleration_L, real_t(0), real_t(0) ) );
-            run( config, latticeModel, fzyx, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
+            run( config, latticeModel, fzyx, mixedPrecision, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
          }
          else
          {
             D3Q27_SRT_INCOMP latticeModel = D3Q27_SRT_INCOMP( cm, lbm::force_model::SimpleConstant( setup.acceleration_L, real_t(0), real_t(0) ) );
-            run( config, latticeModel, fzyx, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
+            run( config, latticeModel, fzyx, mixedPrecision, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
          }
       }
    }
@@ -1308,19 +1529,19 @@ int main( int argc, char **argv )
          WALBERLA_CHECK( !compressible );
 
          D3Q19_TRT_INCOMP latticeModel = D3Q19_TRT_INCOMP( cm, lbm::force_model::SimpleConstant( setup.acceleration_L, real_t(0), real_t(0) ) );
-         run( config, latticeModel, fzyx, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
+         run( config, latticeModel, fzyx, mixedPrecision, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
       }
       else
       {
          if( compressible )
          {
             D3Q27_TRT_COMP latticeModel = D3Q27_TRT_COMP( cm, lbm::force_model::SimpleConstant( setup.acceleration_L, real_t(0), real_t(0) ) );
-            run( config, latticeModel, fzyx, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
+            run( config, latticeModel, fzyx, mixedPrecision, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
          }
          else
          {
             D3Q27_TRT_INCOMP latticeModel = D3Q27_TRT_INCOMP( cm, lbm::force_model::SimpleConstant( setup.acceleration_L, real_t(0), real_t(0) ) );
-            run( config, latticeModel, fzyx, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
+            run( config, latticeModel, fzyx, mixedPrecision, syncComm, fullComm, linearExplosion, refinementSelectionFunctions, setup, memoryPerCell, processMemoryLimit );
          }
       }
    }
@@ -55,8 +55,11 @@
 
 #include "lbm/BlockForestEvaluation.h"
 #include "lbm/PerformanceEvaluation.h"
+#include "lbm/boundary/InPlaceNoSlip.h"
+#include "lbm/boundary/InPlaceSimpleUBB.h"
 #include "lbm/boundary/NoSlip.h"
 #include "lbm/boundary/SimpleUBB.h"
+#include "lbm/communication/InPlacePdfFieldPackInfo.h"
 #include "lbm/communication/PdfFieldPackInfo.h"
 #include "lbm/communication/PdfFieldMPIDatatypeInfo.h"
 #include "lbm/field/AddToStorage.h"
@@ -64,6 +67,8 @@
 #include "lbm/lattice_model/CollisionModel.h"
 #include "lbm/lattice_model/D3Q19.h"
 #include "lbm/sweeps/CellwiseSweep.h"
+#include "lbm/sweeps/InPlaceSweep.h"
+#include "lbm/sweeps/InPlaceTimeStep.h"
 #include "lbm/sweeps/SplitPureSweep.h"
 #include "lbm/sweeps/SplitSweep.h"
 #include "lbm/sweeps/SweepWrappers.h"
@@ -335,6 +340,41 @@ shared_ptr< blockforest::StructuredBlockForest > createStructuredBlockForest( co
 // BOUNDARY HANDLING //
 ///////////////////////
 
+template< typename BoundaryHandling_T >
+void setupBoundaries( BoundaryHandling_T * handling, IBlock * const block, const StructuredBlockStorage * const storage )
+{
+   CellInterval domainBB = storage->getDomainCellBB();
+   storage->transformGlobalToBlockLocalCellInterval( domainBB, *block );
+
+   // no slip WEST
+   CellInterval west( domainBB.xMin(), domainBB.yMin(), domainBB.zMin(), domainBB.xMin(), domainBB.yMax(), domainBB.zMax() );
+   handling->forceBoundary( NoSlip_Flag, west );
+
+   // no slip EAST
+   CellInterval east( domainBB.xMax(), domainBB.yMin(), domainBB.zMin(), domainBB.xMax(), domainBB.yMax(), domainBB.zMax() );
+   handling->forceBoundary( NoSlip_Flag, east );
+
+   // no slip SOUTH
+   CellInterval south( domainBB.xMin(), domainBB.yMin(), domainBB.zMin(), domainBB.xMax(), domainBB.yMin(), domainBB.zMax() );
+   handling->forceBoundary( NoSlip_Flag, south );
+
+   // no slip NORTH
+   CellInterval north( domainBB.xMin(), domainBB.yMax(), domainBB.zMin(), domainBB.xMax(), domainBB.yMax(), domainBB.zMax() );
+   handling->forceBoundary( NoSlip_Flag, north );
+
+   // no slip BOTTOM
+   CellInterval bottom( domainBB.xMin(), domainBB.yMin(), domainBB.zMin(), domainBB.xMax(), domainBB.yMax(), domainBB.zMin() );
+   handling->forceBoundary( NoSlip_Flag, bottom );
+
+   // velocity bounce back TOP
+   CellInterval top( domainBB.xMin(), domainBB.yMin(), domainBB.zMax(), domainBB.xMax(), domainBB.yMax(), domainBB.zMax() );
+   handling->forceBoundary( UBB_Flag, top );
+
+   handling->fillWithDomain( domainBB );
+}
+
+
+
 template< typename LatticeModel_T >
 class MyBoundaryHandling
 {
@@ -381,34 +421,63 @@ MyBoundaryHandling<LatticeModel_T>::operator()( IBlock * const block, const Stru
          boost::tuples::make_tuple( NoSlip_T( "no slip", NoSlip_Flag, pdfField ),
                                        UBB_T( "velocity bounce back", UBB_Flag, pdfField, velocity_, real_c(0), real_c(0) ) ) );
 
-   CellInterval domainBB = storage->getDomainCellBB();
-   storage->transformGlobalToBlockLocalCellInterval( domainBB, *block );
+   setupBoundaries( handling, block, storage );
 
-   // no slip WEST
-   CellInterval west( domainBB.xMin(), domainBB.yMin(), domainBB.zMin(), domainBB.xMin(), domainBB.yMax(), domainBB.zMax() );
-   handling->forceBoundary( NoSlip_Flag, west );
+   return handling;
+}
 
-   // no slip EAST
-   CellInterval east( domainBB.xMax(), domainBB.yMin(), domainBB.zMin(), domainBB.xMax(), domainBB.yMax(), domainBB.zMax() );
-   handling->forceBoundary( NoSlip_Flag, east );
 
-   // no slip SOUTH
-   CellInterval south( domainBB.xMin(), domainBB.yMin(), domainBB.zMin(), domainBB.xMax(), domainBB.yMin(), domainBB.zMax() );
-   handling->forceBoundary( NoSlip_Flag, south );
 
-   // no slip NORTH
-   CellInterval north( domainBB.xMin(), domainBB.yMax(), domainBB.zMin(), domainBB.xMax(), domainBB.yMax(), domainBB.zMax() );
-   handling->forceBoundary( NoSlip_Flag, north );
+template< typename LatticeModel_T >
+class MyInPlaceBoundaryHandling
+{
+public:
 
-   // no slip BOTTOM
-   CellInterval bottom( domainBB.xMin(), domainBB.yMin(), domainBB.zMin(), domainBB.xMax(), domainBB.yMax(), domainBB.zMin() );
-   handling->forceBoundary( NoSlip_Flag, bottom );
+   typedef lbm::InPlaceNoSlip< LatticeModel_T, flag_t >    NoSlip_T;
+   typedef lbm::InPlaceSimpleUBB< LatticeModel_T, flag_t > UBB_T;
 
-   // velocity bounce back TOP
-   CellInterval top( domainBB.xMin(), domainBB.yMin(), domainBB.zMax(), domainBB.xMax(), domainBB.yMax(), domainBB.zMax() );
-   handling->forceBoundary( UBB_Flag, top );
+   typedef boost::tuples::tuple< NoSlip_T, UBB_T > BoundaryConditions_T;
 
-   handling->fillWithDomain( domainBB );
+   typedef BoundaryHandling< FlagField_T, typename Types<LatticeModel_T>::Stencil_T, BoundaryConditions_T > BoundaryHandling_T;
+
+
+
+   MyInPlaceBoundaryHandling( const BlockDataID & flagField, const BlockDataID & pdfField, const real_t velocity,
+                              const shared_ptr< lbm::InPlaceTimeStep > & timeStep ) :
+      flagField_( flagField ), pdfField_( pdfField ), velocity_( velocity ), timeStep_( timeStep ) {}
+
+   BoundaryHandling_T * operator()( IBlock* const block, const StructuredBlockStorage* const storage ) const;
+
+private:
+
+   const BlockDataID flagField_;
+   const BlockDataID  pdfField_;
+
+   const real_t velocity_;
+
+   shared_ptr< lbm::InPlaceTimeStep > timeStep_;
+
+}; // class MyInPlaceBoundaryHandling
+
+template< typename LatticeModel_T >
+typename MyInPlaceBoundaryHandling<LatticeModel_T>::BoundaryHandling_T *
+MyInPlaceBoundaryHandling<LatticeModel_T>::operator()( IBlock * const block, const StructuredBlockStorage * const storage ) const
+{
+   typedef typename Types<LatticeModel_T>::PdfField_T PdfField_T;
+
+   WALBERLA_ASSERT_NOT_NULLPTR( block );
+   WALBERLA_ASSERT_NOT_NULLPTR( storage );
+
+   FlagField_T * flagField = block->getData< FlagField_T >( flagField_ );
+   PdfField_T *   pdfField = block->getData< PdfField_T > (  pdfField_ );
+
+   const auto fluid = flagField->flagExists( Fluid_Flag ) ? flagField->getFlag( Fluid_Flag ) : flagField->registerFlag( Fluid_Flag );
+
+   BoundaryHandling_T * handling = new BoundaryHandling_T( "in-place boundary handling", flagField, fluid,
+         boost::tuples::make_tuple( NoSlip_T( "no slip", NoSlip_Flag, pdfField, timeStep_ ),
+                                       UBB_T( "velocity bounce back", UBB_Flag, pdfField, timeStep_, velocity_, real_c(0), real_c(0) ) ) );
+
+   setupBoundaries( handling, block, storage );
 
    return handling;
 }
@@ -491,7 +560,7 @@ struct AddLB
 
    static void add( shared_ptr< blockforest::StructuredBlockForest > & blocks, SweepTimeloop & timeloop,
                     const BlockDataID & pdfFieldId, const BlockDataID & flagFieldId, const BlockDataID & boundaryHandlingId,
-                    const bool split, const bool pure, const bool fullComm, const bool fused, const bool directComm )
+                    const bool split, const bool pure, const bool fullComm, const bool fused, const bool directComm, const bool neighborComm )
    {
       // setup of the LB communication for synchronizing the pdf field between neighboring blocks
 
@@ -503,6 +572,7 @@ struct AddLB
             blockforest::communication::UniformDirectScheme< stencil::D3Q27 > comm( blocks );
             auto mpiDatatypeInfo = make_shared<field::communication::UniformMPIDatatypeInfo< PdfField > >( pdfFieldId );
             comm.addDataToCommunicate( mpiDatatypeInfo );
+            comm.useNeighborCollectives( neighborComm );
             commFunction = comm;
          }
          else
@@ -510,6 +580,7 @@ struct AddLB
             blockforest::communication::UniformDirectScheme< CommunicationStencil > comm( blocks );
             auto mpiDatatypeInfo = make_shared<lbm::communication::PdfFieldMPIDatatypeInfo< PdfField > >( pdfFieldId );
             comm.addDataToCommunicate( mpiDatatypeInfo );
+            comm.useNeighborCollectives( neighborComm );
             commFunction = comm;
          }
       }
@@ -595,7 +666,7 @@ struct AddLB< LatticeModel_T, typename boost::enable_if_c< boost::mpl::or_<
 
    static void add( shared_ptr< blockforest::StructuredBlockForest > & blocks, SweepTimeloop & timeloop,
                     const BlockDataID & pdfFieldId, const BlockDataID & flagFieldId, const BlockDataID & boundaryHandlingId,
-                    const bool /*split*/, const bool /*pure*/, const bool fullComm, const bool fused, const bool directComm )
+                    const bool /*split*/, const bool /*pure*/, const bool fullComm, const bool fused, const bool directComm, const bool neighborComm )
    {
       // setup of the LB communication for synchronizing the pdf field between neighboring blocks
 
@@ -608,6 +679,7 @@ struct AddLB< LatticeModel_T, typename boost::enable_if_c< boost::mpl::or_<
             blockforest::communication::UniformDirectScheme< stencil::D3Q27 > comm( blocks );
             auto mpiDatatypeInfo = make_shared<field::communication::UniformMPIDatatypeInfo< PdfField > >( pdfFieldId );
             comm.addDataToCommunicate( mpiDatatypeInfo );
+            comm.useNeighborCollectives( neighborComm );
             commFunction = comm;
          }
          else
@@ -615,6 +687,7 @@ struct AddLB< LatticeModel_T, typename boost::enable_if_c< boost::mpl::or_<
             blockforest::communication::UniformDirectScheme< CommunicationStencil > comm( blocks );
             auto mpiDatatypeInfo = make_shared<lbm::communication::PdfFieldMPIDatatypeInfo< PdfField > >( pdfFieldId );
             comm.addDataToCommunicate( mpiDatatypeInfo );
+            comm.useNeighborCollectives( neighborComm );
             commFunction = comm;
          }
       }
@@ -654,9 +727,53 @@ struct AddLB< LatticeModel_T, typename boost::enable_if_c< boost::mpl::or_<
 
 
 
+// In-place streaming (AA pattern): only one PDF field is required, even and odd time steps alternate.
+// Communication and boundary handling depend on the kind of the last time step, which is why the time step
+// counter is advanced right after the LB sweep (but before the communication).
+
+template< typename LatticeModel_T, class Enable = void >
+struct AddInPlaceLB
+{
+   typedef typename Types<LatticeModel_T>::CommunicationStencil_T  CommunicationStencil;
+
+   static void add( shared_ptr< blockforest::StructuredBlockForest > & blocks, SweepTimeloop & timeloop,
+                    const BlockDataID & pdfFieldId, const BlockDataID & flagFieldId, const real_t velocity )
+   {
+      auto timeStep = make_shared< lbm::InPlaceTimeStep >();
+
+      BlockDataID boundaryHandlingId = blocks->template addStructuredBlockData< typename MyInPlaceBoundaryHandling< LatticeModel_T >::BoundaryHandling_T >(
+               MyInPlaceBoundaryHandling< LatticeModel_T >( flagFieldId, pdfFieldId, velocity, timeStep ), "in-place boundary handling" );
+
+      blockforest::communication::UniformBufferedScheme< CommunicationStencil > scheme( blocks );
+      scheme.addPackInfo( make_shared< lbm::InPlacePdfFieldPackInfo< LatticeModel_T > >( pdfFieldId, timeStep ) );
+
+      timeloop.add() << Sweep( lbm::InPlaceSweep< LatticeModel_T >( pdfFieldId, timeStep ), "in-place LB sweep (AA pattern)" )
+                     << AfterFunction( [timeStep]() { timeStep->advance(); }, "in-place time step" )
+                     << AfterFunction( scheme, "LB communication" );
+      timeloop.add() << Sweep( MyInPlaceBoundaryHandling<LatticeModel_T>::BoundaryHandling_T::getBlockSweep( boundaryHandlingId ), "LB boundary sweep" );
+   }
+};
+
+template< typename LatticeModel_T  >
+struct AddInPlaceLB< LatticeModel_T, typename boost::enable_if_c< boost::mpl::or_<
+                                                                                  boost::is_same< typename LatticeModel_T::CollisionModel::tag,
+                                                                                                  lbm::collision_model::MRT_tag >,
+                                                                                  boost::is_same< typename LatticeModel_T::CollisionModel::tag,
+                                                                                                  lbm::collision_model::Cumulant_tag >
+                                                                                 >::value >::type >
+{
+   static void add( shared_ptr< blockforest::StructuredBlockForest > &, SweepTimeloop &,
+                    const BlockDataID &, const BlockDataID &, const real_t )
+   {
+      WALBERLA_ABORT( "In-place streaming (AA pattern) is only available for SRT and TRT!" );
+   }
+};
+
+
+
 template< typename LatticeModel_T >
 void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeModel,
-          const bool split, const bool pure, const bool fzyx, const bool fullComm, const bool fused, const bool directComm )
+          const bool split, const bool pure, const bool fzyx, const bool fullComm, const bool fused, const bool directComm, const bool neighborComm, const bool inPlace )
 {
    typedef typename Types<LatticeModel_T>::PdfField_T  PdfField;
 
@@ -683,8 +800,10 @@ void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeMod
 
    const real_t velocity = configBlock.getParameter< real_t >( "velocity", real_t(0.05) );
 
-   BlockDataID boundaryHandlingId = blocks->template addStructuredBlockData< typename MyBoundaryHandling< LatticeModel_T >::BoundaryHandling_T >(
-            MyBoundaryHandling< LatticeModel_T >( flagFieldId, pdfFieldId, velocity ), "boundary handling" );
+   BlockDataID boundaryHandlingId;
+   if( !inPlace )
+      boundaryHandlingId = blocks->template addStructuredBlockData< typename MyBoundaryHandling< LatticeModel_T >::BoundaryHandling_T >(
+               MyBoundaryHandling< LatticeModel_T >( flagFieldId, pdfFieldId, velocity ), "boundary handling" );
 
    // creating the time loop
 
@@ -709,7 +828,10 @@ void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeMod
 
    // add LB kernel, boundary handling, and communication to time loop
 
-   AddLB< LatticeModel_T >::add( blocks, timeloop, pdfFieldId, flagFieldId, boundaryHandlingId, split, pure, fullComm, fused, directComm );
+   if( inPlace )
+      AddInPlaceLB< LatticeModel_T >::add( blocks, timeloop, pdfFieldId, flagFieldId, velocity );
+   else
+      AddLB< LatticeModel_T >::add( blocks, timeloop, pdfFieldId, flagFieldId, boundaryHandlingId, split, pure, fullComm, fused, directComm, neighborComm );
 
    // logging right before the benchmark starts
 
@@ -725,7 +847,8 @@ void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeMod
                               "\n- pure kernel:                     " << ( pure ? "yes (collision is also performed within obstacle cells)" : "no" ) <<
                               "\n- data layout:                     " << ( fzyx ? "fzyx (structure of arrays [SoA])" : "zyxf (array of structures [AoS])" ) <<
                               "\n- communication:                   " << ( fullComm ? "full synchronization" : "direction-aware optimizations" ) <<
-                              "\n- direct communication:            " << ( directComm ? "enabled" : "disabled" ) );
+                              "\n- direct communication:            " << ( directComm ? ( neighborComm ? "enabled (MPI-3 neighborhood collectives)" : "enabled" ) : "disabled" ) <<
+                              "\n- in-place streaming:              " << ( inPlace ? "yes (AA pattern, no temporary PDF field)" : "no" ) );
 
    // run the benchmark
 
@@ -777,6 +900,8 @@ void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeMod
             stringProperties[ "dataLayout" ]        = ( fzyx ? "fzyx" : "zyxf" );
             stringProperties[ "fullCommunication" ] = ( fullComm ? "yes" : "no" );
             stringProperties[ "directComm"]         = ( directComm ? "yes" : "no" );
+            stringProperties[ "neighborComm"]       = ( neighborComm ? "yes" : "no" );
+            stringProperties[ "inPlace" ]           = ( inPlace ? "yes" : "no" );
 
             auto runId = postprocessing::storeRunInSqliteDB( sqlFile, integerProperties, stringProperties, realProperties );
             postprocessing::storeTimingPoolInSqliteDB( sqlFile, runId, *reducedTimeloopTiming, "Timeloop" );
@@ -797,7 +922,8 @@ void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeMod
                               "\n- pure kernel:                     " << ( pure ? "yes (collision is also performed within obstacle cells)" : "no" ) <<
                               "\n- data layout:                     " << ( fzyx ? "fzyx (structure of arrays [SoA])" : "zyxf (array of structures [AoS])" ) <<
                               "\n- communication:                   " << ( fullComm ? "full synchronization" : "direction-aware optimizations" ) <<
-                              "\n- direct communication:            " << ( directComm ? "enabled" : "disabled" ) );
+                              "\n- direct communication:            " << ( directComm ? ( neighborComm ? "enabled (MPI-3 neighborhood collectives)" : "enabled" ) : "disabled" ) <<
+                              "\n- in-place streaming:              " << ( inPlace ? "yes (AA pattern, no temporary PDF field)" : "no" ) );
 
 }
 
@@ -816,7 +942,7 @@ int main( int argc, char **argv )
    {
       WALBERLA_ROOT_SECTION()
       {
-         std::cout << "Usage: " << argv[0] << " path-to-configuration-file [--trt | --mrt] [--comp] [--not-split] [--not-pure] [--zyxf] [--full-comm] [--not-fused] [--direct-comm]\n"
+         std::cout << "Usage: " << argv[0] << " path-to-configuration-file [--trt | --mrt] [--comp] [--not-split] [--not-pure] [--zyxf] [--full-comm] [--not-fused] [--direct-comm | --neighbor-comm] [--in-place]\n"
                       "\n"
                       "By default, SRT is selected as collision model, a communication with direction-aware optimizations is chosen, and an\n"
                       "incompressible, split, pure LB kernel is executed on a PDF field with layout 'fzyx' (= structure of arrays [SoA]).\n"
@@ -836,6 +962,12 @@ int main( int argc, char **argv )
                       " --not-fused:   Selects separate LB kernels for collision and streaming.\n"
                       "                By default, a 'fused' stream & collide kernel is used.\n"
                       " --direct-comm: Enables bufferless direct communication\n"
+                      " --neighbor-comm: Enables bufferless direct communication that uses one MPI-3 neighborhood collective\n"
+                      "                (MPI_Ineighbor_alltoallw) per time step instead of one message per block and direction\n"
+                      " --in-place:    Selects the in-place streaming LB kernel (AA pattern) for SRT and TRT. Only one PDF field\n"
+                      "                is allocated (no temporary field), which halves the memory footprint of the PDF data.\n"
+                      "                The kernel is always fused and pure, communication is always buffered and direction-aware.\n"
+                      "                VTK output is only meaningful after an even number of time steps.\n"
                       "\n"
                       "Please note: For small/very small blocks (i.e., blocks with only few cells), the best performance may be achieved with\n"
                       "             basic (non-split), incompressible LB kernels combined with an array of structures ('zyxf') data layout!" << std::endl;
@@ -900,6 +1032,8 @@ int main( int argc, char **argv )
    bool fullComm     = false;
    bool fused        = true;
    bool directComm   = false;
+   bool neighborComm = false;
+   bool inPlace      = false;
 
    for( int i = 2; i < argc; ++i )
    {
@@ -913,6 +1047,8 @@ int main( int argc, char **argv )
       if( std::strcmp( argv[i], "--full-comm" )   == 0 ) fullComm       = true;
       if( std::strcmp( argv[i], "--not-fused" )   == 0 ) fused          = false;
       if( std::strcmp( argv[i], "--direct-comm" ) == 0 ) directComm     = true;
+      if( std::strcmp( argv[i], "--neighbor-comm" ) == 0 ) { directComm = true; neighborComm = true; }
+      if( std::strcmp( argv[i], "--in-place" )    == 0 ) inPlace        = true;
    }
 
    if( pure && !split )
@@ -939,6 +1075,21 @@ int main( int argc, char **argv )
       pure         = false;
    }
 
+   if( inPlace && ( collisionModel == CMMRT || collisionModel == CMCUM ) )
+   {
+      WALBERLA_LOG_WARNING_ON_ROOT( "Option \"--in-place\" is only available for SRT and TRT! Setting \"in-place\" to false ..." );
+      inPlace = false;
+   }
+   if( inPlace && ( !fused || fullComm || directComm ) )
+   {
+      WALBERLA_LOG_WARNING_ON_ROOT( "Option \"--in-place\" cannot be combined with \"--not-fused\", \"--full-comm\", \"--direct-comm\", or \"--neighbor-comm\"!\n"
+                                    "Setting \"fused\" to true and \"full-comm\", \"direct-comm\", and \"neighbor-comm\" to false ..." );
+      fused        = true;
+      fullComm     = false;
+      directComm   = false;
+      neighborComm = false;
+   }
+
    WALBERLA_NON_MPI_SECTION()
    {
       if( directComm )
@@ -946,9 +1097,18 @@ int main( int argc, char **argv )
          WALBERLA_LOG_WARNING_ON_ROOT( "Direct (bufferless) communication is not available when building with MPI disabled.\n"
                                        "Switching to buffered comm..." );
       }
-      directComm = false;
+      directComm   = false;
+      neighborComm = false;
    }
 
+#ifndef WALBERLA_MPI_NEIGHBOR_COLLECTIVES
+   if( neighborComm )
+   {
+      WALBERLA_LOG_WARNING_ON_ROOT( "MPI-3 neighborhood collectives are not available. Switching to direct comm..." );
+      neighborComm = false;
+   }
+#endif
+
    const real_t omega = configBlock.getParameter< real_t >( "omega", real_t(1.4) ); // on the coarsest grid!
 
    // executing benchmark
@@ -958,12 +1118,12 @@ int main( int argc, char **argv )
       if( compressible )
       {
          D3Q19_SRT_COMP latticeModel = D3Q19_SRT_COMP( lbm::collision_model::SRT( omega ) );
-         run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm );
+         run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm, neighborComm, inPlace );
       }
       else
       {
          D3Q19_SRT_INCOMP latticeModel = D3Q19_SRT_INCOMP( lbm::collision_model::SRT( omega ) );
-         run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm );
+         run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm, neighborComm, inPlace );
       }
    }
    else if( collisionModel == CMTRT ) // TRT
@@ -971,23 +1131,23 @@ int main( int argc, char **argv )
       if( compressible )
       {
          D3Q19_TRT_COMP latticeModel = D3Q19_TRT_COMP( lbm::collision_model::TRT::constructWithMagicNumber( omega ) );
-         run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm );
+         run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm, neighborComm, inPlace );
       }
       else
       {
          D3Q19_TRT_INCOMP latticeModel = D3Q19_TRT_INCOMP( lbm::collision_model::TRT::constructWithMagicNumber( omega ) );
-         run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm );
+         run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm, neighborComm, inPlace );
       }
    }
    else if( collisionModel == CMMRT ) // MRT
    {
       D3Q19_MRT_INCOMP latticeModel = D3Q19_MRT_INCOMP( lbm::collision_model::D3Q19MRT::constructTRTWithMagicNumber( omega ) );
-      run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm );
+      run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm, neighborComm, inPlace );
    }
    else  // Cumulant
    {
       D3Q27_CUMULANT_COMP latticeModel = D3Q27_CUMULANT_COMP( lbm::collision_model::D3Q27Cumulant(omega) );
-      run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm );
+      run( config, latticeModel, split, pure, fzyx, fullComm, fused, directComm, neighborComm, inPlace );
    }
 
    logging::Logging::printFooterOnStream();
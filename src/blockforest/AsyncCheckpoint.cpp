@@ -0,0 +1,271 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file AsyncCheckpoint.cpp
+//! \ingroup blockforest
+//
+//======================================================================================================================
+
+#include "AsyncCheckpoint.h"
+
+#include "core/Abort.h"
+#include "core/logging/Logging.h"
+#include "core/mpi/MPIManager.h"
+#include "core/mpi/Reduce.h"
+#include "core/timing/WcPolicy.h"
+
+#include <fstream>
+
+
+namespace walberla {
+namespace blockforest {
+
+
+
+static inline int iwriteAt( MPI_File file, MPI_Offset offset, void * buffer, int count, MPI_Datatype datatype, MPI_Request * request )
+{
+#ifdef WALBERLA_MPI_NONBLOCKING_COLLECTIVE_IO
+   return MPI_File_iwrite_at_all( file, offset, buffer, count, datatype, request );
+#else
+   return MPI_File_iwrite_at( file, offset, buffer, count, datatype, request );
+#endif
+}
+
+
+
+void AsyncCheckpoint::saveToFile( const std::string & file )
+{
+   auto forest = forest_.lock();
+   WALBERLA_CHECK_NOT_NULLPTR( forest, "Trying to access 'AsyncCheckpoint' for a block storage object that doesn't exist anymore" );
+
+   const double begin = timing::WcPolicy::getTimestamp();
+
+   auto stagedFile = make_shared< File >( file, false );
+   forest->saveToBuffer( stagedFile->structure );
+   staged_.push_back( stagedFile );
+
+   stagedSnapshotTime_ += timing::WcPolicy::getTimestamp() - begin;
+}
+
+
+
+/// ATTENTION: 'blockStates' must be identical for every process!
+void AsyncCheckpoint::saveToFile( const std::string & file, const Set<SUID> & blockStates )
+{
+   auto forest = forest_.lock();
+   WALBERLA_CHECK_NOT_NULLPTR( forest, "Trying to access 'AsyncCheckpoint' for a block storage object that doesn't exist anymore" );
+
+   const double begin = timing::WcPolicy::getTimestamp();
+
+   auto stagedFile = make_shared< File >( file, false );
+   forest->saveToBuffer( stagedFile->structure, blockStates );
+   staged_.push_back( stagedFile );
+
+   stagedSnapshotTime_ += timing::WcPolicy::getTimestamp() - begin;
+}
+
+
+
+void AsyncCheckpoint::saveBlockData( const std::string & file, const BlockDataID & id )
+{
+   auto forest = forest_.lock();
+   WALBERLA_CHECK_NOT_NULLPTR( forest, "Trying to access 'AsyncCheckpoint' for a block storage object that doesn't exist anymore" );
+
+   const double begin = timing::WcPolicy::getTimestamp();
+
+   auto stagedFile = make_shared< File >( file, true );
+   forest->serializeBlockData( id, stagedFile->data );
+   staged_.push_back( stagedFile );
+
+   stagedSnapshotTime_ += timing::WcPolicy::getTimestamp() - begin;
+}
+
+
+
+/// Begins writing all staged files. A previous checkpoint that is still written is completed first.
+void AsyncCheckpoint::start()
+{
+   wait();
+
+   std::swap( staged_, written_ );
+   staged_.clear();
+
+   writtenSnapshotTime_ = stagedSnapshotTime_;
+   stagedSnapshotTime_ = 0.0;
+
+   writing_ = true;
+   completed_ = false;
+   startTime_ = timing::WcPolicy::getTimestamp();
+
+   for( auto file = written_.begin(); file != written_.end(); ++file )
+      startWriting( **file );
+
+   WALBERLA_NON_MPI_SECTION()
+   {
+      completed_ = true;
+      completionTime_ = timing::WcPolicy::getTimestamp();
+   }
+}
+
+
+
+/// Lets the MPI library progress the writes and returns true if all writes are completed (does not close the files)
+bool AsyncCheckpoint::test()
+{
+   if( !writing_ || completed_ )
+      return true;
+
+   int flag( 1 );
+   if( !requests_.empty() )
+   {
+      int result = MPI_Testall( int_c( requests_.size() ), &(requests_[0]), &flag, MPI_STATUSES_IGNORE );
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while writing checkpoint. MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+   }
+
+   if( flag )
+   {
+      completed_ = true;
+      completionTime_ = timing::WcPolicy::getTimestamp();
+   }
+
+   return completed_;
+}
+
+
+
+/// Completes all writes, closes the files and reports the statistics of the checkpoint
+void AsyncCheckpoint::wait()
+{
+   if( !writing_ )
+      return;
+
+   const double waitStart = timing::WcPolicy::getTimestamp();
+
+   if( !completed_ )
+   {
+      if( !requests_.empty() )
+      {
+         int result = MPI_Waitall( int_c( requests_.size() ), &(requests_[0]), MPI_STATUSES_IGNORE );
+         if( result != MPI_SUCCESS )
+            WALBERLA_ABORT( "Error while writing checkpoint. MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+      }
+      completed_ = true;
+      completionTime_ = timing::WcPolicy::getTimestamp();
+   }
+   requests_.clear();
+
+   uint_t bytes( uint_t(0) );
+   for( auto file = written_.begin(); file != written_.end(); ++file )
+   {
+      WALBERLA_MPI_SECTION()
+      {
+         int result = MPI_File_close( &((*file)->handle) );
+         if( result != MPI_SUCCESS )
+            WALBERLA_ABORT( "Error while closing file \"" << (*file)->name << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+      }
+
+      if( (*file)->blockData )
+      {
+         bytes += uint_c( (*file)->data.size() );
+         WALBERLA_MPI_SECTION() { bytes += uint_t(2) * uint_c( sizeof( uint_t ) ); }
+      }
+      else
+         bytes += uint_c( (*file)->structure.size() );
+   }
+
+   const double waitEnd = timing::WcPolicy::getTimestamp();
+
+   MPI_Comm comm = MPIManager::instance()->comm();
+
+   bytes_       = mpi::allReduce( bytes, mpi::SUM, comm );
+   stagingTime_ = mpi::allReduce( writtenSnapshotTime_, mpi::MAX, comm );
+   writeTime_   = mpi::allReduce( completionTime_ - startTime_, mpi::MAX, comm );
+   overlapTime_ = mpi::allReduce( waitStart - startTime_, mpi::MIN, comm );
+   waitTime_    = mpi::allReduce( waitEnd - waitStart, mpi::MAX, comm );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "Checkpoint with " << written_.size() << " file(s) written: " << bytes_ << " bytes, bandwidth: " <<
+                              ( getBandwidth() / 1e6 ) << " MB/s\n" <<
+                              "   - snapshot:   " << stagingTime_ << " s\n" <<
+                              "   - write:      " << writeTime_ << " s\n" <<
+                              "   - overlapped: " << overlapTime_ << " s\n" <<
+                              "   - waiting:    " << waitTime_ << " s" );
+
+   written_.clear();
+   writing_ = false;
+}
+
+
+
+void AsyncCheckpoint::startWriting( File & file )
+{
+   const uint8_t * buffer = file.blockData ? file.data.ptr() : ( file.structure.empty() ? NULL : &(file.structure[0]) );
+   const uint_t size = file.blockData ? uint_c( file.data.size() ) : uint_c( file.structure.size() );
+
+   WALBERLA_NON_MPI_SECTION()
+   {
+      std::ofstream ofile( file.name.c_str(), std::ofstream::binary );
+      ofile.write( reinterpret_cast< const char* >( buffer ), numeric_cast< std::streamsize >( size ) );
+      ofile.close();
+   }
+
+   WALBERLA_MPI_SECTION()
+   {
+      MPI_Comm comm = MPIManager::instance()->comm();
+      const int rank = MPIManager::instance()->rank();
+
+      int result = MPI_File_open( comm, const_cast<char*>( file.name.c_str() ), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &(file.handle) );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while opening file \"" << file.name << "\" for writing. MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+      int uintSize;
+      MPI_Type_size( MPITrait< uint_t >::type(), &uintSize );
+
+      // block data files start with the offset and the size of the data of every process (see BlockStorage::saveBlockData)
+      const uint_t headerSize = file.blockData ? uint_c( MPIManager::instance()->numProcesses() * 2 * uintSize ) : uint_t(0);
+
+      MPI_File_set_size( file.handle, numeric_cast<MPI_Offset>( headerSize + mpi::allReduce( size, mpi::SUM, comm ) ) );
+
+      uint_t exscanResult;
+      MPI_Exscan( const_cast<uint_t*>( &size ), &exscanResult, 1, MPITrait<uint_t>::type(), MPI_SUM, comm );
+      if( rank == 0 )
+         exscanResult = uint_t( 0 );
+      const uint_t offset = headerSize + exscanResult;
+
+      if( file.blockData )
+      {
+         file.header[0] = offset;
+         file.header[1] = size;
+
+         requests_.push_back( MPI_REQUEST_NULL );
+         result = iwriteAt( file.handle, numeric_cast<MPI_Offset>( rank * 2 * uintSize ), file.header, 2, MPITrait< uint_t >::type(), &(requests_.back()) );
+
+         if( result != MPI_SUCCESS )
+            WALBERLA_ABORT( "Error while writing to file \"" << file.name << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+      }
+
+      requests_.push_back( MPI_REQUEST_NULL );
+      result = iwriteAt( file.handle, numeric_cast<MPI_Offset>( offset ), const_cast<uint8_t*>( buffer ), int_c( size ), MPITrait< uint8_t >::type(), &(requests_.back()) );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while writing to file \"" << file.name << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+   }
+}
+
+
+
+} // namespace blockforest
+} // namespace walberla
@@ -0,0 +1,138 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file AsyncCheckpoint.h
+//! \ingroup blockforest
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "BlockForest.h"
+
+#include "core/DataTypes.h"
+#include "core/NonCopyable.h"
+#include "core/mpi/MPIWrapper.h"
+#include "core/mpi/SendBuffer.h"
+
+#include <string>
+#include <vector>
+
+
+namespace walberla {
+namespace blockforest {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Asynchronous, double buffered checkpointing of the block structure and of block data
+*
+*   The files are identical to the files written by BlockForest::saveToFile (in MPI_PARALLEL mode) and
+*   BlockStorage::saveBlockData and can be loaded with the usual functions. Writing a checkpoint consists of three
+*   steps:
+*   - 'saveToFile' and 'saveBlockData' take a snapshot of the block structure / block data into a staging buffer. They
+*     only serialize the data and do not access the file system.
+*   - 'start' begins writing all staged files with nonblocking MPI-IO (MPI_File_iwrite_at_all for MPI 3.1,
+*     MPI_File_iwrite_at otherwise) and returns immediately, so that the time stepping can continue while the data is
+*     written. 'test' can be called between time steps in order to let the MPI library progress the writes.
+*   - 'wait' completes the writes, closes the files and reports the checkpoint bandwidth and the time the write
+*     overlapped with the computation.
+*
+*   The next checkpoint can be staged while the previous one is still written. 'start' completes a previous checkpoint
+*   before it begins writing the new one.
+*
+*   'start' and 'wait' are collective operations, and all processes must stage the same files in the same order.
+*   Without MPI, 'start' writes the files synchronously.
+*/
+//**********************************************************************************************************************
+class AsyncCheckpoint : public NonCopyable
+{
+public:
+
+   AsyncCheckpoint( const shared_ptr< BlockForest > & forest ) :
+      forest_( forest ), writing_( false ), completed_( false ), stagedSnapshotTime_( 0.0 ), writtenSnapshotTime_( 0.0 ),
+      startTime_( 0.0 ), completionTime_( 0.0 ),
+      bytes_( uint_t(0) ), stagingTime_( 0.0 ), writeTime_( 0.0 ), overlapTime_( 0.0 ), waitTime_( 0.0 ) {}
+
+   /// completes a checkpoint that is still written (collective!)
+   ~AsyncCheckpoint() { wait(); }
+
+   /// stages the block structure (block states are reduced using MPI)
+   void saveToFile( const std::string & file );
+   /// stages the block structure (ATTENTION: 'blockStates' must be identical for every process!)
+   void saveToFile( const std::string & file, const Set<SUID> & blockStates );
+   /// stages the block data that corresponds to 'id'
+   void saveBlockData( const std::string & file, const BlockDataID & id );
+
+   void start();
+   bool test();
+   void wait();
+
+   bool isWriting() const { return writing_; }
+
+   /// \name Statistics of the last completed checkpoint (identical on all processes)
+   //@{
+   uint_t getBytes()       const { return bytes_; }       ///< size of all files
+   double getStagingTime() const { return stagingTime_; } ///< time spent for taking the snapshots (max over all processes)
+   double getWriteTime()   const { return writeTime_; }   ///< time from 'start' until the writes were found to be completed (max)
+   double getOverlapTime() const { return overlapTime_; } ///< time from 'start' until 'wait' was called (min)
+   double getWaitTime()    const { return waitTime_; }    ///< time spent in 'wait' (max)
+   double getBandwidth()   const { return writeTime_ > 0.0 ? static_cast< double >( bytes_ ) / writeTime_ : 0.0; } ///< in bytes per second
+   //@}
+
+private:
+
+   struct File
+   {
+      File( const std::string & _name, const bool _blockData ) : name( _name ), blockData( _blockData ), handle( MPI_FILE_NULL ) {}
+
+      std::string name;
+      bool blockData; ///< block data files start with the offsets and sizes of the data of all processes
+
+      std::vector< uint8_t > structure; ///< process local part of the block structure file
+      mpi::SendBuffer data;             ///< process local block data
+      uint_t header[2];
+
+      MPI_File handle;
+   };
+
+   void startWriting( File & file );
+
+   weak_ptr< BlockForest > forest_;
+
+   std::vector< shared_ptr< File > > staged_;
+   std::vector< shared_ptr< File > > written_;
+   std::vector< MPI_Request > requests_;
+
+   bool writing_;
+   bool completed_;
+
+   double stagedSnapshotTime_;  ///< time spent for taking the snapshots of 'staged_'
+   double writtenSnapshotTime_; ///< time spent for taking the snapshots of 'written_'
+   double startTime_;
+   double completionTime_;
+
+   uint_t bytes_;
+   double stagingTime_;
+   double writeTime_;
+   double overlapTime_;
+   double waitTime_;
+};
+
+
+
+} // namespace blockforest
+} // namespace walberla
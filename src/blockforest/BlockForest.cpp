@@ -353,7 +353,6 @@ BlockForest::BlockForest( const uint_t process, const char* const filename, cons
 {
    blockInformation_ = make_shared< BlockInformation >( *this );
 
-   uint_t offset = 0;
    std::vector< uint8_t > buffer;
 
    if( broadcastFile && (mpi::MPIManager::instance()->numProcesses() > 1) )
@@ -398,57 +397,27 @@ BlockForest::BlockForest( const uint_t process, const char* const filename, cons
       file.close();
    }
 
-   // HEADER
-
-   // domain AABB
-
-   real_t domain[6];
-
-   for( uint_t i = 0; i != 6; ++i ) {
-      domain[i] = byteArrayToReal< real_t >( buffer, offset );
-      offset += sizeof( real_t ) + 1 + 2;
-   }
-
-   domain_.initMinMaxCorner( domain[0], domain[1], domain[2], domain[3], domain[4], domain[5] );
-
-   // number of coarse/root blocks in each direction
-
-   for( uint_t i = 0; i != 3; ++i ) {
-      size_[i] = byteArrayToUint( buffer, offset, 4 );
-      offset += 4;
-   }
-
-   // domain periodicity
-
-   for( uint_t i = 0; i != 3; ++i ) {
-      periodic_[i] = ( byteArrayToUint( buffer, offset, 1 ) == uint_c(1) );
-      ++offset;
-   }
-
-   // block forest depth (= number of levels - 1)
-
-   depth_ = byteArrayToUint( buffer, offset, 1 );
-   ++offset;
-
-   // treeIdDigits (= number of bits used for storing the tree ID [tree ID marker + tree index])
+   const internal::BlockForestFileParser file( buffer, filename );
 
-   treeIdDigits_ = byteArrayToUint( buffer, offset, 1 );
-   ++offset;
+   // HEADER
 
-   // processIdBytes (= number of bytes required for storing process IDs)
+   domain_ = file.getDomain();
 
-   processIdBytes_ = byteArrayToUint( buffer, offset, 1 );
-   ++offset;
+   size_[0] = file.getXSize();
+   size_[1] = file.getYSize();
+   size_[2] = file.getZSize();
 
-   // insertBuffersIntoProcessNetwork?
+   periodic_[0] = file.isXPeriodic();
+   periodic_[1] = file.isYPeriodic();
+   periodic_[2] = file.isZPeriodic();
 
-   insertBuffersIntoProcessNetwork_ = ( byteArrayToUint( buffer, offset, 1 ) == uint_c(1) );
-   ++offset;
+   depth_          = file.getDepth();
+   treeIdDigits_   = file.getTreeIdDigits();
+   processIdBytes_ = file.getProcessIdBytes();
 
-   // number of processes
+   insertBuffersIntoProcessNetwork_ = file.insertBuffersIntoProcessNetwork();
 
-   const uint_t numberOfProcesses = byteArrayToUint( buffer, offset, 4 );
-   offset += 4;
+   const uint_t numberOfProcesses = file.getNumberOfProcesses();
 
    if( numberOfProcesses != uint_c( MPIManager::instance()->numProcesses() ) )
       WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
@@ -459,67 +428,16 @@ BlockForest::BlockForest( const uint_t process, const char* const filename, cons
       WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
                       "The process index \'" << process << "\' exceeds the number of available processes (" << numberOfProcesses << ")!" );
 
-   // SUID MAPPING
-
-   // number of SUIDs
-
-   const uint_t numberOfSUIDs = byteArrayToUint( buffer, offset, 1 );
-   ++offset;
-
-   const uint_t suidBytes = ( ( numberOfSUIDs % 8 == 0 ) ? ( numberOfSUIDs / 8 ) : ( numberOfSUIDs / 8 + 1 ) );
-
-   std::vector< SUID > suidMap;
-
-   // for every SUID ...
-
-   for( uint_t i = 0; i != numberOfSUIDs; ++i ) {
-
-      // length of its identifier string
-
-      const uint_t identifierLength = byteArrayToUint( buffer, offset, 1 );
-      ++offset;
-
-      // the identifier string
-
-      const std::string identifier( reinterpret_cast< const char* >( &(buffer[offset]) ), identifierLength );
-      offset += identifierLength;
-
-      SUID suid( identifier, false );
-
-      suidMap.push_back( suid );
-   }
-
-   // BLOCK DATA
-
-   const uint_t blockIdBytes = getBlockIdBytes();
-
-   // calculate offsets to block and neighborhood data of each process
-
-   std::vector< uint_t > offsetBlocks( numberOfProcesses );
-   std::vector< uint_t > offsetNeighbors( numberOfProcesses );
-
-   for( uint_t i = 0; i != numberOfProcesses; ++i )
-   {
-      offsetBlocks[i] = offset;
-
-      const uint_t numberOfBlocks = byteArrayToUint( buffer, offset, 2 );
-      offset += 2 + numberOfBlocks * ( blockIdBytes + suidBytes );
-
-      offsetNeighbors[i] = offset;
-
-      offset += 2 + byteArrayToUint( buffer, offset, 2 ) * processIdBytes_;
-   }
-
    // process neighborhood (= all neighboring processes)
 
-   const uint_t numberOfNeighbors = byteArrayToUint( buffer, offsetNeighbors[ process_ ], 2 );
+   const uint_t numberOfNeighbors = file.getNumberOfNeighbors( process_ );
 
    for( uint_t i = 0; i != numberOfNeighbors; ++i )
-      neighborhood_.push_back( byteArrayToUint( buffer, offsetNeighbors[ process_ ] + 2 + i * processIdBytes_, processIdBytes_ ) );
+      neighborhood_.push_back( file.getNeighbor( process_, i ) );
 
    // number of blocks associated with this process
 
-   const uint_t numberOfBlocks = byteArrayToUint( buffer, offsetBlocks[ process_ ], 2 );
+   const uint_t numberOfBlocks = file.getNumberOfBlocks( process_ );
 
    if( numberOfBlocks > 0 )
    {
@@ -530,65 +448,28 @@ BlockForest::BlockForest( const uint_t process, const char* const filename, cons
 
       std::vector< BlockReconstruction::NeighborhoodReconstructionBlock > neighbors;
 
-      for( uint_t i = 0; i != numberOfBlocks; ++i ) {
-
-         offset = offsetBlocks[ process_ ] + 2 + i * ( blockIdBytes + suidBytes );
-
-         const BlockID id( buffer, offset, blockIdBytes );
-
-         Set<SUID> state;
-         boost::dynamic_bitset< uint8_t > suidBitset = byteArrayToBitset( buffer, offset + blockIdBytes, suidBytes );
-         for( uint_t j = 0; j != suidBitset.size(); ++j ) {
-            WALBERLA_ASSERT( !suidBitset.test( j ) || j < suidMap.size() );
-            if( suidBitset.test( j ) )
-               state += suidMap[j];
-         }
-
-         neighbors.push_back( BlockReconstruction::NeighborhoodReconstructionBlock( id, process_, state, aabbReconstruction ) );
-      }
+      for( uint_t i = 0; i != numberOfBlocks; ++i )
+         neighbors.push_back( BlockReconstruction::NeighborhoodReconstructionBlock( file.getBlockId( process_, i ), process_,
+                                                                                    file.getBlockState( process_, i ), aabbReconstruction ) );
 
       for( uint_t i = 0; i != numberOfNeighbors; ++i ) {
 
          const uint_t neighborProcess = neighborhood_[i];
-         const uint_t numberOfNeighborBlocks = byteArrayToUint( buffer, offsetBlocks[ neighborProcess ], 2 );
-
-         for( uint_t j = 0; j != numberOfNeighborBlocks; ++j ) {
-
-            offset = offsetBlocks[ neighborProcess ] + 2 + j * ( blockIdBytes + suidBytes );
-
-            const BlockID id( buffer, offset, blockIdBytes );
+         const uint_t numberOfNeighborBlocks = file.getNumberOfBlocks( neighborProcess );
 
-            Set<SUID> state;
-            boost::dynamic_bitset< uint8_t > suidBitset = byteArrayToBitset( buffer, offset + blockIdBytes, suidBytes );
-            for( uint_t k = 0; k != suidBitset.size(); ++k ) {
-               WALBERLA_ASSERT( !suidBitset.test( k ) || k < suidMap.size() );
-               if( suidBitset.test( k ) )
-                  state += suidMap[k];
-            }
-
-            neighbors.push_back( BlockReconstruction::NeighborhoodReconstructionBlock( id, neighborProcess, state, aabbReconstruction ) );
-         }
+         for( uint_t j = 0; j != numberOfNeighborBlocks; ++j )
+            neighbors.push_back( BlockReconstruction::NeighborhoodReconstructionBlock( file.getBlockId( neighborProcess, j ), neighborProcess,
+                                                                                       file.getBlockState( neighborProcess, j ), aabbReconstruction ) );
       }
 
       // for each block ...
 
       for( uint_t i = 0; i != numberOfBlocks; ++i ) {
 
-         offset = offsetBlocks[ process_ ] + 2 + i * ( blockIdBytes + suidBytes );
-
-         // block ID
+         // block ID and block state (SUID set)
 
-         const BlockID id( buffer, offset, blockIdBytes );
-
-         // block state (SUID set)
-
-         Set<SUID> state;
-         boost::dynamic_bitset< uint8_t > suidBitset = byteArrayToBitset( buffer, offset + blockIdBytes, suidBytes );
-         for( uint_t j = 0; j != suidBitset.size(); ++j ) {
-            WALBERLA_ASSERT( !suidBitset.test( j ) || j < suidMap.size() );
-            if( suidBitset.test( j ) )
-               state += suidMap[j];
-         }
+         const BlockID id = file.getBlockId( process_, i );
+         const Set<SUID> state = file.getBlockState( process_, i );
 
          // create block using the just constructed reconstruction information
 
@@ -608,23 +489,12 @@ BlockForest::BlockForest( const uint_t process, const char* const filename, cons
 
       for( uint_t i = 0; i != numberOfProcesses; ++i ) {
 
-         const uint_t numBlocks = byteArrayToUint( buffer, offsetBlocks[ i ], 2 );
+         const uint_t numBlocks = file.getNumberOfBlocks( i );
 
          for( uint_t j = 0; j != numBlocks; ++j ) {
 
-            offset = offsetBlocks[ i ] + 2 + j * ( blockIdBytes + suidBytes );
-
-            ids.push_back( BlockID( buffer, offset, blockIdBytes ) );
-
-            Set<SUID> state;
-            boost::dynamic_bitset< uint8_t > suidBitset = byteArrayToBitset( buffer, offset + blockIdBytes, suidBytes );
-            for( uint_t k = 0; k != suidBitset.size(); ++k ) {
-               WALBERLA_ASSERT( !(suidBitset.test( k ) ) || k < suidMap.size() );
-               if( suidBitset.test( k ) )
-                  state += suidMap[k];
-            }
-
-            nodes.push_back( make_shared< BlockInformation::Node >( i, state ) );
+            ids.push_back( file.getBlockId( i, j ) );
+            nodes.push_back( make_shared< BlockInformation::Node >( i, file.getBlockState( i, j ) ) );
          }
       }
 
@@ -1305,6 +1175,44 @@ void BlockForest::restoreSnapshot( const SnapshotRestorenFunction & processMappi
 
 
 void BlockForest::saveToFile( const std::string & filename, FileIOMode fileIOMode ) const
+{
+   saveToFile( filename, reduceBlockStates(), fileIOMode );
+}
+
+
+
+/// ATTENTION: 'blockStates' must be identical for every process!
+void BlockForest::saveToFile( const std::string & filename, const Set<SUID> & blockStates, FileIOMode fileIOMode ) const
+{
+   std::map< SUID, boost::dynamic_bitset< uint8_t > > suidMap;
+   uint_t suidBytes( uint_t(0) );
+   createSuidMap( blockStates, suidMap, suidBytes );
+
+   saveToFile( filename, fileIOMode, suidMap, suidBytes );
+}
+
+
+
+void BlockForest::saveToBuffer( std::vector< uint8_t > & buffer ) const
+{
+   saveToBuffer( buffer, reduceBlockStates() );
+}
+
+
+
+/// ATTENTION: 'blockStates' must be identical for every process!
+void BlockForest::saveToBuffer( std::vector< uint8_t > & buffer, const Set<SUID> & blockStates ) const
+{
+   std::map< SUID, boost::dynamic_bitset< uint8_t > > suidMap;
+   uint_t suidBytes( uint_t(0) );
+   createSuidMap( blockStates, suidMap, suidBytes );
+
+   saveToBuffer( buffer, suidMap, suidBytes );
+}
+
+
+
+Set<SUID> BlockForest::reduceBlockStates() const
 {
    Set<SUID> suids;
    for( auto block = blocks_.begin(); block != blocks_.end(); ++block )
@@ -1316,19 +1224,16 @@ void BlockForest::saveToFile( const std::string & filename, FileIOMode fileIOMod
    suids.clear();
    suids.insert( allSuids.begin(), allSuids.end() );
 
-   saveToFile( filename, suids, fileIOMode );
+   return suids;
 }
 
 
 
-/// ATTENTION: 'blockStates' must be identical for every process!
-void BlockForest::saveToFile( const std::string & filename, const Set<SUID> & blockStates, FileIOMode fileIOMode ) const
+void BlockForest::createSuidMap( const Set<SUID> & blockStates, std::map< SUID, boost::dynamic_bitset<uint8_t> > & suidMap, uint_t & suidBytes )
 {
    WALBERLA_CHECK_LESS( blockStates.size(), uint_c(256), "When saving the block structure to file, only 255 different SUIDs are allowed!" );
 
-   const uint_t suidBytes = ( ( blockStates.size() % 8 == 0 ) ? ( blockStates.size() / 8 ) : ( blockStates.size() / 8 + 1 ) );
-
-   std::map< SUID, boost::dynamic_bitset< uint8_t > > suidMap;
+   suidBytes = ( ( blockStates.size() % 8 == 0 ) ? ( blockStates.size() / 8 ) : ( blockStates.size() / 8 + 1 ) );
 
    uint_t i = 0;
    for( Set<SUID>::const_iterator it = blockStates.begin(); it != blockStates.end(); ++it ) {
@@ -1338,8 +1243,6 @@ void BlockForest::saveToFile( const std::string & filename, const Set<SUID> & bl
       suidMap[ *it ] = suidBitset;
       ++i;
    }
-
-   saveToFile( filename, fileIOMode, suidMap, suidBytes );
 }
 
 
@@ -2753,11 +2656,10 @@ void BlockForest::update( PhantomBlockForest & phantomForest )
 }
 
 
-/// For a description of the file format see BlockForestFile.h
+/// Stores the process local part of the file written by saveToFile (see BlockForestFile.h)
 /// \attention 'suidMap' and 'suidBytes' must be identical for every process!
-/// \see BlockForestFile.h
-void BlockForest::saveToFile( const std::string & filename, FileIOMode fileIOMode,
-                              const std::map< SUID, boost::dynamic_bitset<uint8_t> > & suidMap, const uint_t suidBytes ) const
+void BlockForest::saveToBuffer( std::vector< uint8_t > & processDataBuffer,
+                                const std::map< SUID, boost::dynamic_bitset<uint8_t> > & suidMap, const uint_t suidBytes ) const
 {
    // process data
 
@@ -2772,7 +2674,7 @@ void BlockForest::saveToFile( const std::string & filename, FileIOMode fileIOMod
          dataSize += uint_t(1) + uint_c( suid->first.getIdentifier().length() );
    }
 
-   std::vector< uint8_t > processDataBuffer( dataSize );
+   processDataBuffer.assign( dataSize, uint8_t(0) );
    uint_t offset = 0;
 
    if( MPIManager::instance()->rank() == 0 )
@@ -2858,6 +2760,20 @@ void BlockForest::saveToFile( const std::string & filename, FileIOMode fileIOMod
       uintToByteArray( *neighbor, processDataBuffer, offset, processIdBytes_ );
       offset += processIdBytes_;
    }
+}
+
+
+
+/// For a description of the file format see BlockForestFile.h
+/// \attention 'suidMap' and 'suidBytes' must be identical for every process!
+/// \see BlockForestFile.h
+void BlockForest::saveToFile( const std::string & filename, FileIOMode fileIOMode,
+                              const std::map< SUID, boost::dynamic_bitset<uint8_t> > & suidMap, const uint_t suidBytes ) const
+{
+   std::vector< uint8_t > processDataBuffer;
+   saveToBuffer( processDataBuffer, suidMap, suidBytes );
+
+   const uint_t dataSize = uint_c( processDataBuffer.size() );
 
    // store data to file
 
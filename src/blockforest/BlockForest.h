@@ -483,6 +483,11 @@ public:
    /// Block states are passed by argument (ATTENTION: 'blockStates' must be identical for every process!)
    void saveToFile( const std::string & filename, const Set<SUID> & blockStates, FileIOMode fileIOMode = MPI_PARALLEL ) const;
 
+   /// Stores the process local part of the file written by saveToFile into 'buffer' (block states are reduced using MPI)
+   void saveToBuffer( std::vector< uint8_t > & buffer ) const;
+   /// Block states are passed by argument (ATTENTION: 'blockStates' must be identical for every process!)
+   void saveToBuffer( std::vector< uint8_t > & buffer, const Set<SUID> & blockStates ) const;
+
 protected:
 
    bool equal( const BlockStorage* rhs ) const;
@@ -500,8 +505,13 @@ private:
    bool determineBlockTargetLevels( bool & additionalRefreshCycleRequired, bool & rerun );
    void update( PhantomBlockForest & phantomForest );
 
+   Set<SUID> reduceBlockStates() const;
+   static void createSuidMap( const Set<SUID> & blockStates, std::map< SUID, boost::dynamic_bitset<uint8_t> > & suidMap, uint_t & suidBytes );
+
    void saveToFile( const std::string & filename, FileIOMode fileIOMode,
                     const std::map< SUID, boost::dynamic_bitset<uint8_t> > & suidMap, const uint_t suidBytes ) const;
+   void saveToBuffer( std::vector< uint8_t > & buffer,
+                      const std::map< SUID, boost::dynamic_bitset<uint8_t> > & suidMap, const uint_t suidBytes ) const;
    void storeFileHeader( std::vector< uint8_t > & data, uint_t & offset ) const;
 
 
@@ -0,0 +1,220 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BlockForestFile.cpp
+//! \ingroup blockforest
+//
+//======================================================================================================================
+
+#include "BlockForestFile.h"
+
+#include "core/Abort.h"
+#include "core/EndianIndependentSerialization.h"
+
+
+namespace walberla {
+namespace blockforest {
+namespace internal {
+
+
+
+BlockForestFileParser::BlockForestFileParser( const std::vector< uint8_t > & buffer, const std::string & filename ) :
+   buffer_( buffer )
+{
+   if( buffer.size() < FILE_HEADER_SIZE )
+      WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
+                      "The file is too small to contain a block structure." );
+
+   uint_t offset = 0;
+
+   // HEADER
+
+   // domain AABB
+
+   real_t domain[6];
+
+   for( uint_t i = 0; i != 6; ++i ) {
+      domain[i] = byteArrayToReal< real_t >( buffer, offset );
+      offset += sizeof( real_t ) + 1 + 2;
+   }
+
+   domain_.initMinMaxCorner( domain[0], domain[1], domain[2], domain[3], domain[4], domain[5] );
+
+   // number of coarse/root blocks in each direction
+
+   for( uint_t i = 0; i != 3; ++i ) {
+      size_[i] = byteArrayToUint( buffer, offset, 4 );
+      offset += 4;
+   }
+
+   // domain periodicity
+
+   for( uint_t i = 0; i != 3; ++i ) {
+      periodic_[i] = ( byteArrayToUint( buffer, offset, 1 ) == uint_c(1) );
+      ++offset;
+   }
+
+   // block forest depth (= number of levels - 1)
+
+   depth_ = byteArrayToUint( buffer, offset, 1 );
+   ++offset;
+
+   // treeIdDigits (= number of bits used for storing the tree ID [tree ID marker + tree index])
+
+   treeIdDigits_ = byteArrayToUint( buffer, offset, 1 );
+   ++offset;
+
+   const uint_t blockIdBits = treeIdDigits_ + 3 * depth_;
+   blockIdBytes_ = ( blockIdBits >> 3 ) + ( ( blockIdBits & 7 ) ? uint_c(1) : uint_c(0) );
+
+   // processIdBytes (= number of bytes required for storing process IDs)
+
+   processIdBytes_ = byteArrayToUint( buffer, offset, 1 );
+   ++offset;
+
+   // insertBuffersIntoProcessNetwork?
+
+   insertBuffersIntoProcessNetwork_ = ( byteArrayToUint( buffer, offset, 1 ) == uint_c(1) );
+   ++offset;
+
+   // number of processes
+
+   const uint_t numberOfProcesses = byteArrayToUint( buffer, offset, 4 );
+   offset += 4;
+
+   // SUID MAPPING
+
+   // number of SUIDs
+
+   const uint_t numberOfSUIDs = byteArrayToUint( buffer, offset, 1 );
+   ++offset;
+
+   suidBytes_ = ( ( numberOfSUIDs % 8 == 0 ) ? ( numberOfSUIDs / 8 ) : ( numberOfSUIDs / 8 + 1 ) );
+
+   // for every SUID ...
+
+   for( uint_t i = 0; i != numberOfSUIDs; ++i ) {
+
+      // length of its identifier string
+
+      if( offset + 1 > buffer.size() )
+         WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
+                         "The file ends within the SUID mapping." );
+
+      const uint_t identifierLength = byteArrayToUint( buffer, offset, 1 );
+      ++offset;
+
+      if( offset + identifierLength > buffer.size() )
+         WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
+                         "The file ends within the SUID mapping." );
+
+      // the identifier string
+
+      const std::string identifier( reinterpret_cast< const char* >( &(buffer[offset]) ), identifierLength );
+      offset += identifierLength;
+
+      suidMap_.push_back( SUID( identifier, false ) );
+   }
+
+   // BLOCK DATA
+
+   // calculate offsets to block and neighborhood data of each process
+
+   offsetBlocks_.resize( numberOfProcesses );
+   offsetNeighbors_.resize( numberOfProcesses );
+
+   for( uint_t i = 0; i != numberOfProcesses; ++i )
+   {
+      if( offset + 2 > buffer.size() )
+         WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
+                         "The file ends within the block data of process " << i << "." );
+
+      offsetBlocks_[i] = offset;
+
+      const uint_t numberOfBlocks = byteArrayToUint( buffer, offset, 2 );
+      offset += 2 + numberOfBlocks * ( blockIdBytes_ + suidBytes_ );
+
+      if( offset + 2 > buffer.size() )
+         WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
+                         "The file ends within the block data of process " << i << "." );
+
+      offsetNeighbors_[i] = offset;
+
+      offset += 2 + byteArrayToUint( buffer, offset, 2 ) * processIdBytes_;
+
+      if( offset > buffer.size() )
+         WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
+                         "The file ends within the process neighborhood of process " << i << "." );
+   }
+}
+
+
+
+uint_t BlockForestFileParser::getNumberOfBlocks( const uint_t process ) const
+{
+   WALBERLA_ASSERT_LESS( process, offsetBlocks_.size() );
+   return byteArrayToUint( buffer_, offsetBlocks_[ process ], 2 );
+}
+
+
+
+/// Returns the ID of the 'index'-th block that is stored for process 'process'
+BlockID BlockForestFileParser::getBlockId( const uint_t process, const uint_t index ) const
+{
+   WALBERLA_ASSERT_LESS( index, getNumberOfBlocks( process ) );
+
+   return BlockID( buffer_, offsetBlocks_[ process ] + 2 + index * ( blockIdBytes_ + suidBytes_ ), blockIdBytes_ );
+}
+
+
+
+/// Returns the state (SUID set) of the 'index'-th block that is stored for process 'process'
+Set<SUID> BlockForestFileParser::getBlockState( const uint_t process, const uint_t index ) const
+{
+   WALBERLA_ASSERT_LESS( index, getNumberOfBlocks( process ) );
+
+   const uint_t offset = offsetBlocks_[ process ] + 2 + index * ( blockIdBytes_ + suidBytes_ ) + blockIdBytes_;
+
+   Set<SUID> state;
+   boost::dynamic_bitset< uint8_t > suidBitset = byteArrayToBitset( buffer_, offset, suidBytes_ );
+   for( uint_t i = 0; i != suidBitset.size(); ++i ) {
+      WALBERLA_ASSERT( !suidBitset.test( i ) || i < suidMap_.size() );
+      if( suidBitset.test( i ) )
+         state += suidMap_[i];
+   }
+   return state;
+}
+
+
+
+uint_t BlockForestFileParser::getNumberOfNeighbors( const uint_t process ) const
+{
+   WALBERLA_ASSERT_LESS( process, offsetNeighbors_.size() );
+   return byteArrayToUint( buffer_, offsetNeighbors_[ process ], 2 );
+}
+
+
+
+uint_t BlockForestFileParser::getNeighbor( const uint_t process, const uint_t index ) const
+{
+   WALBERLA_ASSERT_LESS( index, getNumberOfNeighbors( process ) );
+   return byteArrayToUint( buffer_, offsetNeighbors_[ process ] + 2 + index * processIdBytes_, processIdBytes_ );
+}
+
+
+
+} // namespace internal
+} // namespace blockforest
+} // namespace walberla
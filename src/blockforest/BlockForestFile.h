@@ -20,7 +20,15 @@
 
 #pragma once
 
+#include "BlockID.h"
+
 #include "core/DataTypes.h"
+#include "core/Set.h"
+#include "core/math/AABB.h"
+#include "core/uid/SUID.h"
+
+#include <string>
+#include <vector>
 
 namespace walberla {
 namespace blockforest {
@@ -90,6 +98,73 @@ namespace internal {
 
 static const uint_t FILE_HEADER_SIZE = 6 * sizeof( real_t ) + 6 + 12 + 3 * 4 + 3 + 1 + 1 + 1 + 1 + 4;
 
-}
-}
-}
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Reads the block structure stored in a buffer that contains an entire file written by BlockForest::saveToFile
+*          or SetupBlockForest::saveToFile (for the file format see above)
+*
+*   The header and the SUID mapping are decoded on construction. Blocks and process neighborhoods are only decoded on
+*   request, so that every process can restrict itself to the processes it is interested in. The buffer must outlive
+*   the parser.
+*/
+//**********************************************************************************************************************
+
+class BlockForestFileParser
+{
+public:
+
+   BlockForestFileParser( const std::vector< uint8_t > & buffer, const std::string & filename );
+
+   const AABB & getDomain() const { return domain_; }
+
+   uint_t getXSize() const { return size_[0]; }
+   uint_t getYSize() const { return size_[1]; }
+   uint_t getZSize() const { return size_[2]; }
+
+   bool isXPeriodic() const { return periodic_[0]; }
+   bool isYPeriodic() const { return periodic_[1]; }
+   bool isZPeriodic() const { return periodic_[2]; }
+
+   uint_t getDepth()          const { return depth_; }
+   uint_t getTreeIdDigits()   const { return treeIdDigits_; }
+   uint_t getProcessIdBytes() const { return processIdBytes_; }
+   uint_t getBlockIdBytes()   const { return blockIdBytes_; }
+
+   bool insertBuffersIntoProcessNetwork() const { return insertBuffersIntoProcessNetwork_; }
+
+   uint_t getNumberOfProcesses() const { return uint_c( offsetBlocks_.size() ); }
+
+   uint_t    getNumberOfBlocks( const uint_t process ) const;
+   BlockID   getBlockId   ( const uint_t process, const uint_t index ) const;
+   Set<SUID> getBlockState( const uint_t process, const uint_t index ) const;
+
+   uint_t getNumberOfNeighbors( const uint_t process ) const;
+   uint_t getNeighbor( const uint_t process, const uint_t index ) const;
+
+private:
+
+   const std::vector< uint8_t > & buffer_;
+
+   AABB   domain_;
+   uint_t size_[3];
+   bool   periodic_[3];
+
+   uint_t depth_;
+   uint_t treeIdDigits_;
+   uint_t processIdBytes_;
+   uint_t blockIdBytes_;
+
+   bool insertBuffersIntoProcessNetwork_;
+
+   std::vector< SUID > suidMap_;
+   uint_t suidBytes_;
+
+   std::vector< uint_t > offsetBlocks_;    ///< offset to the block data of each process
+   std::vector< uint_t > offsetNeighbors_; ///< offset to the process neighborhood of each process
+};
+
+} // namespace internal
+} // namespace blockforest
+} // namespace walberla
@@ -19,6 +19,7 @@
 //
 //======================================================================================================================
 
+#include "BlockForestFile.h"
 #include "BlockNeighborhoodSection.h"
 #include "Initialization.h"
 #include "SetupBlockForest.h"
@@ -31,6 +32,10 @@
 
 #include "stencil/D3Q19.h"
 
+#include <fstream>
+#include <map>
+#include <set>
+
 namespace walberla {
 namespace blockforest {
 
@@ -611,6 +616,171 @@ createUniformBlockGrid( const std::string& filename,
 
 
 
+/// Every process reads the entire block structure file with one collective read (no broadcast from the root process)
+static void readBlockStructureFile( const std::string& filename, std::vector< uint8_t >& buffer )
+{
+   WALBERLA_NON_MPI_SECTION()
+   {
+      std::ifstream file( filename.c_str(), std::ifstream::binary );
+      if( file.fail() )
+         WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
+                         "Opening the file failed. Does the file even exist?" );
+
+      file.seekg( 0, std::ios::end );
+      buffer.resize( uint_c( static_cast< std::streamoff >( file.tellg() ) ) );
+      file.seekg( 0, std::ios::beg );
+
+      if( !buffer.empty() )
+         file.read( reinterpret_cast< char* >( &(buffer[0]) ), numeric_cast< std::streamsize >( buffer.size() ) );
+      file.close();
+      return;
+   }
+
+   MPI_File mpiFile = MPI_FILE_NULL;
+   int result = MPI_File_open( MPIManager::instance()->comm(), const_cast<char*>( filename.c_str() ), MPI_MODE_RDONLY, MPI_INFO_NULL, &mpiFile );
+
+   if( result != MPI_SUCCESS )
+      WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
+                      "Opening the file failed. MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+   MPI_Offset size( 0 );
+   MPI_File_get_size( mpiFile, &size );
+   buffer.resize( numeric_cast< uint_t >( size ) );
+
+   result = MPI_File_read_at_all( mpiFile, 0, buffer.empty() ? NULL : &(buffer[0]), int_c( buffer.size() ), MPITrait< uint8_t >::type(), MPI_STATUS_IGNORE );
+
+   if( result != MPI_SUCCESS )
+      WALBERLA_ABORT( "Error while reading from file \"" << filename << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+   result = MPI_File_close( &mpiFile );
+
+   if( result != MPI_SUCCESS )
+      WALBERLA_ABORT( "Error while closing file \"" << filename << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+}
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Function for restoring a block forest that was saved with BlockForest::saveToFile (or SetupBlockForest::saveToFile)
+*          on an arbitrary number of processes.
+*
+*   The saved block structure (blocks, their states, and their process assignment) is used to reconstruct a
+*   SetupBlockForest on every process. If the number of processes did not change, the blocks are assigned to the same
+*   processes as before. Otherwise, the blocks are distributed to the currently available processes by 'balancer'
+*   (a space filling curve by default, which keeps blocks that were neighbors on the curve - and therefore stored next
+*   to each other in block data files - on the same process). Every block is assigned a workload and a memory of 1.
+*
+*   Block data should be saved with BlockStorage::saveChunkedBlockData and loaded with
+*   BlockStorage::loadChunkedBlockData, which allows every process to read only the byte ranges of its own blocks.
+*
+*   \param filename                   A file that stores a block structure and its corresponding process distribution
+*   \param keepGlobalBlockInformation If true, each process keeps information about remote blocks (blocks that reside
+*                                     on other processes). This information includes the process rank, the state, and
+*                                     the axis-aligned bounding box of any block (local or remote). [false by default]
+*   \param balancer                   Target process assignment function used if the number of processes changed
+*                                     [StaticLevelwiseCurveBalance (Hilbert curve) by default]
+*/
+//**********************************************************************************************************************
+
+shared_ptr< BlockForest >
+createBlockForestFromFile( const std::string& filename, const bool keepGlobalBlockInformation /*= false*/,
+                           const SetupBlockForest::TargetProcessAssignmentFunction & balancer /*= StaticLevelwiseCurveBalance( true )*/ )
+{
+   if( !MPIManager::instance()->rankValid() )
+      MPIManager::instance()->useWorldComm();
+
+   std::vector< uint8_t > buffer;
+   readBlockStructureFile( filename, buffer );
+
+   const internal::BlockForestFileParser file( buffer, filename );
+
+   // saved process and state of every block (the process neighborhood is recomputed)
+
+   std::map< BlockID, std::pair< uint_t, Set<SUID> > > blocks;
+   std::set< uint_t > trees;
+
+   const uint_t numberOfProcesses = file.getNumberOfProcesses();
+
+   for( uint_t process = 0; process != numberOfProcesses; ++process )
+   {
+      const uint_t numberOfBlocks = file.getNumberOfBlocks( process );
+
+      for( uint_t i = 0; i != numberOfBlocks; ++i )
+      {
+         const BlockID id = file.getBlockId( process, i );
+
+         blocks[ id ] = std::make_pair( process, file.getBlockState( process, i ) );
+
+         BlockID root( id );
+         while( root.getUsedBits() > file.getTreeIdDigits() )
+            root.removeBranchId();
+         trees.insert( root.getTreeIndex() );
+      }
+   }
+
+   // reconstruct the block structure: root blocks without saved blocks are excluded, all other blocks are refined
+   // until the saved blocks are reached
+
+   SetupBlockForest sforest;
+
+   sforest.addRootBlockExclusionFunction( [&trees]( std::vector< uint8_t > & excludeBlock, const SetupBlockForest::RootBlockAABB & ) {
+      for( uint_t i = 0; i != excludeBlock.size(); ++i )
+         if( trees.find( i ) == trees.end() )
+            excludeBlock[i] = uint8_t(1);
+   } );
+
+   sforest.addRefinementSelectionFunction( [&blocks]( SetupBlockForest & forest ) {
+      for( auto block = forest.begin(); block != forest.end(); ++block )
+         if( blocks.find( block->getId() ) == blocks.end() )
+            block->setMarker( true );
+   } );
+
+   sforest.addWorkloadMemorySUIDAssignmentFunction( [&blocks,&filename]( SetupBlockForest & forest ) {
+      for( auto block = forest.begin(); block != forest.end(); ++block )
+      {
+         auto savedBlock = blocks.find( block->getId() );
+         if( savedBlock == blocks.end() )
+            WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
+                            "The reconstructed block structure contains block " << block->getId() << " (" << block->getAABB() << "), "
+                            "which is not stored in the file." );
+         block->setWorkload( workload_t(1) );
+         block->setMemory( memory_t(1) );
+         block->addState( savedBlock->second.second );
+      }
+   } );
+
+   sforest.init( file.getDomain(), file.getXSize(), file.getYSize(), file.getZSize(),
+                 file.isXPeriodic(), file.isYPeriodic(), file.isZPeriodic() );
+
+   if( sforest.getNumberOfBlocks() != blocks.size() )
+      WALBERLA_ABORT( "Loading BlockForest from file \'" << filename << "\' failed:\n"
+                      "The reconstructed block structure contains " << sforest.getNumberOfBlocks() << " blocks, "
+                      "the file contains " << blocks.size() << " blocks." );
+
+   const uint_t processes = uint_c( MPIManager::instance()->numProcesses() );
+
+   if( processes == numberOfProcesses )
+   {
+      sforest.balanceLoad( [&blocks]( SetupBlockForest & forest, const uint_t targetProcesses, const memory_t ) {
+         for( auto block = forest.begin(); block != forest.end(); ++block )
+            block->assignTargetProcess( blocks.at( block->getId() ).first );
+         return targetProcesses;
+      }, processes );
+   }
+   else
+   {
+      sforest.balanceLoad( balancer, processes );
+   }
+
+   WALBERLA_LOG_PROGRESS_ON_ROOT( "BlockForest with " << blocks.size() << " blocks saved on " << numberOfProcesses << " process(es) "
+                              "restored on " << processes << " process(es)" );
+
+   return shared_ptr< BlockForest >( new BlockForest( uint_c( MPIManager::instance()->rank() ), sforest, keepGlobalBlockInformation ) );
+}
+
+
+
 ///////////////////////////////////////////
 // HELPER FUNCTIONS                      //
 ///////////////////////////////////////////
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "StructuredBlockForest.h"
+#include "loadbalancing/StaticCurve.h"
 
 #include "core/config/Config.h"
 
@@ -109,6 +110,12 @@ createUniformBlockGrid( const std::string& filename,
 
 
 
+shared_ptr< BlockForest >
+createBlockForestFromFile( const std::string& filename, const bool keepGlobalBlockInformation = false,
+                           const SetupBlockForest::TargetProcessAssignmentFunction & balancer = StaticLevelwiseCurveBalance( true ) );
+
+
+
 
 
 void calculateCellDistribution( const Vector3<uint_t> & cells, uint_t nrOfBlocks,
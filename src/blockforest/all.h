@@ -23,6 +23,7 @@
 #pragma once
 
 #include "AABBRefinementSelection.h"
+#include "AsyncCheckpoint.h"
 #include "Block.h"
 #include "BlockDataHandling.h"
 #include "BlockForest.h"
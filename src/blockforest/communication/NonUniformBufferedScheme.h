@@ -133,6 +133,24 @@ public:
    //@}
    //*******************************************************************************************************************
 
+   //** Aggregated Communication ***************************************************************************************
+   /*! \name Aggregated Communication
+   *
+   *  Equal level communication on level 'fineLevel' and coarse to fine communication from 'fineLevel-1' to 'fineLevel'
+   *  can be executed in one combined step: All data that is sent to the same process during both communication phases
+   *  is packed into one buffer and exchanged with one MPI message (instead of one message per communication phase).
+   *  'savedMessages()' returns the total number of MPI messages (sent by this process) that have been saved so far.
+   *  Aggregated communication must not be mixed with the corresponding non-aggregated calls while communication is
+   *  in progress.
+   */
+   //@{
+   inline void startCommunicateEqualLevelAndCoarseToFine( const uint_t fineLevel );
+   inline void  waitCommunicateEqualLevelAndCoarseToFine( const uint_t fineLevel );
+
+   uint_t savedMessages() const { return savedMessages_; }
+   //@}
+   //*******************************************************************************************************************
+
 protected:
 
    void init();
@@ -142,11 +160,22 @@ protected:
    void startCommunicationCoarseToFine( const uint_t index, const uint_t coarsestLevel, const uint_t finestLevel );
    void startCommunicationFineToCoarse( const uint_t index, const uint_t coarsestLevel, const uint_t finestLevel );
 
+   void setupCommunicationEqualLevel  ( const uint_t index, std::set< uint_t > & participatingLevels );
+   void setupCommunicationCoarseToFine( const uint_t index, const uint_t coarsestLevel, const uint_t finestLevel );
+   void setupCommunicationFineToCoarse( const uint_t index, const uint_t coarsestLevel, const uint_t finestLevel );
+
+   void setupAggregatedCommunication( const uint_t fineLevel );
+
    void resetBufferSystem( shared_ptr< mpi::OpenMPBufferSystem > & bufferSystem );
 
    void start( const INDEX i, const uint_t j );
    void  wait( const INDEX i, const uint_t j );
 
+   void startLocalCommunication( const INDEX i, const uint_t j );
+   void  waitLocalCommunication( const INDEX i, const uint_t j );
+
+   void  waitAggregated( const uint_t fineLevel );
+
    static void writeHeader( SendBuffer & buffer, const BlockID & sender, const BlockID & receiver, const stencil::Direction & dir );
    static void  readHeader( RecvBuffer & buffer,       BlockID & sender,       BlockID & receiver,       stencil::Direction & dir );
 
@@ -183,6 +212,16 @@ protected:
    std::vector< std::vector< char > > setupBeforeNextCommunication_; // cannot be a vector of 'bool' since access by non-const reference is required
    std::vector< std::vector< bool > > communicationInProgress_;
 
+   // remote communication partners of each communication phase (required for aggregated communication)
+   std::vector< std::vector< std::map< uint_t, std::vector< SendBufferFunction > > > > sendFunctions_;
+   std::vector< std::vector< std::set< uint_t > > > ranksToReceiveFrom_;
+
+   std::vector< shared_ptr< mpi::OpenMPBufferSystem > > aggregatedBufferSystem_; // one per fine level
+   std::vector< char > setupAggregatedBeforeNextCommunication_;
+   std::vector< bool > aggregatedCommunicationInProgress_;
+   std::vector< uint_t > aggregatedSavedMessages_; // messages saved per aggregated communication step (per fine level)
+   uint_t savedMessages_;
+
    Set<SUID> requiredBlockSelectors_;
    Set<SUID> incompatibleBlockSelectors_;
 
@@ -192,7 +231,7 @@ protected:
 
 template< typename Stencil >
 NonUniformBufferedScheme<Stencil>::NonUniformBufferedScheme( weak_ptr<StructuredBlockForest> bf, const int baseTag )
-   : blockForest_( bf ), localMode_( START ), baseTag_( baseTag ),
+   : blockForest_( bf ), localMode_( START ), baseTag_( baseTag ), savedMessages_( uint_t(0) ),
      requiredBlockSelectors_( Set<SUID>::emptySet() ), incompatibleBlockSelectors_( Set<SUID>::emptySet() )
 {
    init();
@@ -205,7 +244,7 @@ NonUniformBufferedScheme<Stencil>::NonUniformBufferedScheme( weak_ptr<Structured
                                                              const Set<SUID> & requiredBlockSelectors, 
                                                              const Set<SUID> & incompatibleBlockSelectors,
                                                              const int baseTag /*= 778*/ ) // waLBerla = 119+97+76+66+101+114+108+97
-   : blockForest_( bf ), localMode_( START ), baseTag_( baseTag ),
+   : blockForest_( bf ), localMode_( START ), baseTag_( baseTag ), savedMessages_( uint_t(0) ),
      requiredBlockSelectors_( requiredBlockSelectors ), incompatibleBlockSelectors_( incompatibleBlockSelectors )
 {
    init();
@@ -229,6 +268,9 @@ void NonUniformBufferedScheme<Stencil>::init()
    setupBeforeNextCommunication_.resize( 3 );
    communicationInProgress_.resize( 3 );
 
+   sendFunctions_.resize( 3 );
+   ranksToReceiveFrom_.resize( 3 );
+
    refresh();
 }
 
@@ -253,6 +295,8 @@ void NonUniformBufferedScheme<Stencil>::refresh()
       localBuffers_[i].clear();
       setupBeforeNextCommunication_[i].clear();
       communicationInProgress_[i].clear();
+      sendFunctions_[i].clear();
+      ranksToReceiveFrom_[i].clear();
 
       for( uint_t j = 0; j <= levels; ++j )
          bufferSystem_[i].push_back( make_shared< mpi::OpenMPBufferSystem >( mpi::MPIManager::instance()->comm(), baseTag_ + int_c( i * levels + j ) ) );
@@ -267,7 +311,19 @@ void NonUniformBufferedScheme<Stencil>::refresh()
 
       setupBeforeNextCommunication_[i].resize( levels + uint_t(1), char(1) );
       communicationInProgress_[i].resize( levels + uint_t(1), false );
+
+      sendFunctions_[i].resize( levels + uint_t(1) );
+      ranksToReceiveFrom_[i].resize( levels + uint_t(1) );
    }
+
+   // tags of the aggregated buffer systems follow the tags of all buffer systems of the separate communication phases
+   aggregatedBufferSystem_.clear();
+   for( uint_t j = 0; j != levels; ++j )
+      aggregatedBufferSystem_.push_back( make_shared< mpi::OpenMPBufferSystem >( mpi::MPIManager::instance()->comm(), baseTag_ + int_c( uint_t(3) * levels + uint_t(1) + j ) ) );
+
+   setupAggregatedBeforeNextCommunication_.assign( levels, char(1) );
+   aggregatedCommunicationInProgress_.assign( levels, false );
+   aggregatedSavedMessages_.assign( levels, uint_t(0) );
    
 #ifndef NDEBUG
    for( auto p = packInfos_.begin(); p != packInfos_.end(); ++p )
@@ -288,6 +344,8 @@ NonUniformBufferedScheme<Stencil>::~NonUniformBufferedScheme()
       wait( FINE_TO_COARSE, i );
       wait( COARSE_TO_FINE, i );
    }
+   for( uint_t i = 0; i != aggregatedBufferSystem_.size(); ++i )
+      waitAggregated( i );
 }
 
 
@@ -587,6 +645,68 @@ inline void NonUniformBufferedScheme<Stencil>::waitCommunicateFineToCoarse( cons
 
 
 
+template< typename Stencil >
+inline void NonUniformBufferedScheme<Stencil>::startCommunicateEqualLevelAndCoarseToFine( const uint_t fineLevel )
+{
+   auto forest = blockForest_.lock();
+   WALBERLA_CHECK_NOT_NULLPTR( forest, "Trying to access communication for a block storage object that doesn't exist anymore" );
+   WALBERLA_ASSERT_GREATER( fineLevel, uint_t(0) );
+   WALBERLA_ASSERT_LESS( fineLevel, forest->getNumberOfLevels() );
+
+   if( forestModificationStamp_ != forest->getBlockForest().getModificationStamp() )
+      refresh();
+
+   if( packInfos_.empty() )
+      return;
+
+   WALBERLA_ASSERT( !communicationInProgress_[ EQUAL_LEVEL ][ fineLevel ] );
+   WALBERLA_ASSERT( !communicationInProgress_[ COARSE_TO_FINE ][ fineLevel ] );
+
+   communicationInProgress_[ EQUAL_LEVEL ][ fineLevel ] = true;
+   communicationInProgress_[ COARSE_TO_FINE ][ fineLevel ] = true;
+   aggregatedCommunicationInProgress_[ fineLevel ] = true;
+
+   if( setupBeforeNextCommunication_[ EQUAL_LEVEL ][ fineLevel ] == char(1) ||
+       setupBeforeNextCommunication_[ COARSE_TO_FINE ][ fineLevel ] == char(1) )
+      setupAggregatedBeforeNextCommunication_[ fineLevel ] = char(1);
+
+   std::set< uint_t > participatingLevels;
+   participatingLevels.insert( fineLevel );
+
+   setupCommunicationEqualLevel( fineLevel, participatingLevels );
+   setupCommunicationCoarseToFine( fineLevel, fineLevel - uint_t(1), fineLevel );
+
+   if( setupAggregatedBeforeNextCommunication_[ fineLevel ] == char(1) )
+      setupAggregatedCommunication( fineLevel );
+
+   // MPI
+
+   aggregatedBufferSystem_[ fineLevel ]->startCommunication();
+   savedMessages_ += aggregatedSavedMessages_[ fineLevel ];
+
+   // LOCAL
+
+   startLocalCommunication( COARSE_TO_FINE, fineLevel );
+   startLocalCommunication( EQUAL_LEVEL, fineLevel );
+}
+
+
+
+template< typename Stencil >
+inline void NonUniformBufferedScheme<Stencil>::waitCommunicateEqualLevelAndCoarseToFine( const uint_t fineLevel )
+{
+   auto forest = blockForest_.lock();
+   WALBERLA_CHECK_NOT_NULLPTR( forest, "Trying to access communication for a block storage object that doesn't exist anymore" );
+   WALBERLA_ASSERT_GREATER( fineLevel, uint_t(0) );
+   WALBERLA_ASSERT_LESS( fineLevel, forest->getNumberOfLevels() );
+   WALBERLA_ASSERT_EQUAL( forest->getNumberOfLevels(), aggregatedBufferSystem_.size() );
+   WALBERLA_ASSERT_EQUAL( forestModificationStamp_, forest->getBlockForest().getModificationStamp() );
+
+   waitAggregated( fineLevel );
+}
+
+
+
 template< typename Stencil >
 void NonUniformBufferedScheme<Stencil>::startCommunicationEqualLevel( const uint_t index, std::set< uint_t > & participatingLevels )
 {
@@ -595,6 +715,16 @@ void NonUniformBufferedScheme<Stencil>::startCommunicationEqualLevel( const uint
 
    communicationInProgress_[ EQUAL_LEVEL ][ index ] = true;
 
+   setupCommunicationEqualLevel( index, participatingLevels );
+
+   start( EQUAL_LEVEL, index );
+}
+
+
+
+template< typename Stencil >
+void NonUniformBufferedScheme<Stencil>::setupCommunicationEqualLevel( const uint_t index, std::set< uint_t > & participatingLevels )
+{
    shared_ptr< mpi::OpenMPBufferSystem > & bufferSystem = bufferSystem_[ EQUAL_LEVEL ][ index ];
 
    std::vector< VoidFunction > &           localCommunication =           localCommunication_[ EQUAL_LEVEL ][ index ];
@@ -704,10 +834,15 @@ void NonUniformBufferedScheme<Stencil>::startCommunicationEqualLevel( const uint
          bufferSystem->addReceivingFunction( int_c(sender->first), boost::bind( &NonUniformBufferedScheme<Stencil>::receive, this, _1 ) );
       }
 
+      std::set< uint_t > & ranksToReceiveFrom = ranksToReceiveFrom_[ EQUAL_LEVEL ][ index ];
+      ranksToReceiveFrom.clear();
+      for( auto sender = sendFunctions.begin(); sender != sendFunctions.end(); ++sender )
+         ranksToReceiveFrom.insert( sender->first );
+
+      sendFunctions_[ EQUAL_LEVEL ][ index ].swap( sendFunctions );
+
       setupBeforeNextCommunication = char(0);
    }
-
-   start( EQUAL_LEVEL, index );
 }
 
 
@@ -720,6 +855,16 @@ void NonUniformBufferedScheme<Stencil>::startCommunicationCoarseToFine( const ui
 
    communicationInProgress_[ COARSE_TO_FINE ][ index ] = true;
 
+   setupCommunicationCoarseToFine( index, coarsestLevel, finestLevel );
+
+   start( COARSE_TO_FINE, index );
+}
+
+
+
+template< typename Stencil >
+void NonUniformBufferedScheme<Stencil>::setupCommunicationCoarseToFine( const uint_t index, const uint_t coarsestLevel, const uint_t finestLevel )
+{
    shared_ptr< mpi::OpenMPBufferSystem > & bufferSystem = bufferSystem_[ COARSE_TO_FINE ][ index ];
 
    std::vector< VoidFunction > &           localCommunication =           localCommunication_[ COARSE_TO_FINE ][ index ];
@@ -849,10 +994,11 @@ void NonUniformBufferedScheme<Stencil>::startCommunicationCoarseToFine( const ui
       for( auto receiver = ranksToReceiveFrom.begin(); receiver != ranksToReceiveFrom.end(); ++receiver )
          bufferSystem->addReceivingFunction( int_c(*receiver), boost::bind( &NonUniformBufferedScheme<Stencil>::receive, this, _1 ) );
 
+      sendFunctions_[ COARSE_TO_FINE ][ index ].swap( sendFunctions );
+      ranksToReceiveFrom_[ COARSE_TO_FINE ][ index ].swap( ranksToReceiveFrom );
+
       setupBeforeNextCommunication = char(0);
    }
-
-   start( COARSE_TO_FINE, index );
 }
 
 
@@ -865,6 +1011,16 @@ void NonUniformBufferedScheme<Stencil>::startCommunicationFineToCoarse( const ui
 
    communicationInProgress_[ FINE_TO_COARSE ][ index ] = true;
 
+   setupCommunicationFineToCoarse( index, coarsestLevel, finestLevel );
+
+   start( FINE_TO_COARSE, index );
+}
+
+
+
+template< typename Stencil >
+void NonUniformBufferedScheme<Stencil>::setupCommunicationFineToCoarse( const uint_t index, const uint_t coarsestLevel, const uint_t finestLevel )
+{
    shared_ptr< mpi::OpenMPBufferSystem > & bufferSystem = bufferSystem_[ FINE_TO_COARSE ][ index ];
 
    std::vector< VoidFunction > &           localCommunication =           localCommunication_[ FINE_TO_COARSE ][ index ];
@@ -994,10 +1150,46 @@ void NonUniformBufferedScheme<Stencil>::startCommunicationFineToCoarse( const ui
       for( auto receiver = ranksToReceiveFrom.begin(); receiver != ranksToReceiveFrom.end(); ++receiver )
          bufferSystem->addReceivingFunction( int_c(*receiver), boost::bind( &NonUniformBufferedScheme<Stencil>::receive, this, _1 ) );
 
+      sendFunctions_[ FINE_TO_COARSE ][ index ].swap( sendFunctions );
+      ranksToReceiveFrom_[ FINE_TO_COARSE ][ index ].swap( ranksToReceiveFrom );
+
       setupBeforeNextCommunication = char(0);
    }
+}
 
-   start( FINE_TO_COARSE, index );
+
+
+template< typename Stencil >
+void NonUniformBufferedScheme<Stencil>::setupAggregatedCommunication( const uint_t fineLevel )
+{
+   shared_ptr< mpi::OpenMPBufferSystem > & bufferSystem = aggregatedBufferSystem_[ fineLevel ];
+
+   const std::map< uint_t, std::vector< SendBufferFunction > > & equalLevelSendFunctions  = sendFunctions_[ EQUAL_LEVEL    ][ fineLevel ];
+   const std::map< uint_t, std::vector< SendBufferFunction > > & coarseToFineSendFunctions = sendFunctions_[ COARSE_TO_FINE ][ fineLevel ];
+
+   // coarse to fine data is packed first, the headers of all messages allow for unpacking in any order
+
+   std::map< uint_t, std::vector< SendBufferFunction > > sendFunctions( coarseToFineSendFunctions );
+   for( auto sender = equalLevelSendFunctions.begin(); sender != equalLevelSendFunctions.end(); ++sender )
+   {
+      std::vector< SendBufferFunction > & functions = sendFunctions[ sender->first ];
+      functions.insert( functions.end(), sender->second.begin(), sender->second.end() );
+   }
+
+   std::set< uint_t > ranksToReceiveFrom( ranksToReceiveFrom_[ COARSE_TO_FINE ][ fineLevel ] );
+   ranksToReceiveFrom.insert( ranksToReceiveFrom_[ EQUAL_LEVEL ][ fineLevel ].begin(), ranksToReceiveFrom_[ EQUAL_LEVEL ][ fineLevel ].end() );
+
+   resetBufferSystem( bufferSystem );
+
+   for( auto sender = sendFunctions.begin(); sender != sendFunctions.end(); ++sender )
+      bufferSystem->addSendingFunction( int_c(sender->first), boost::bind(  NonUniformBufferedScheme<Stencil>::send, _1, sender->second ) );
+
+   for( auto receiver = ranksToReceiveFrom.begin(); receiver != ranksToReceiveFrom.end(); ++receiver )
+      bufferSystem->addReceivingFunction( int_c(*receiver), boost::bind( &NonUniformBufferedScheme<Stencil>::receive, this, _1 ) );
+
+   aggregatedSavedMessages_[ fineLevel ] = equalLevelSendFunctions.size() + coarseToFineSendFunctions.size() - sendFunctions.size();
+
+   setupAggregatedBeforeNextCommunication_[ fineLevel ] = char(0);
 }
 
 
@@ -1026,17 +1218,23 @@ void NonUniformBufferedScheme<Stencil>::resetBufferSystem( shared_ptr< mpi::Open
 template< typename Stencil >
 void NonUniformBufferedScheme<Stencil>::start( const INDEX i, const uint_t j )
 {
-   shared_ptr< mpi::OpenMPBufferSystem > & bufferSystem = bufferSystem_[i][j];
-
-   std::vector< VoidFunction > &           localCommunication =           localCommunication_[i][j];
-   std::vector< VoidFunction > & threadsafeLocalCommunication = threadsafeLocalCommunication_[i][j];
-
    // MPI
 
-   bufferSystem->startCommunication();
+   bufferSystem_[i][j]->startCommunication();
 
    // LOCAL
 
+   startLocalCommunication( i, j );
+}
+
+
+
+template< typename Stencil >
+void NonUniformBufferedScheme<Stencil>::startLocalCommunication( const INDEX i, const uint_t j )
+{
+   std::vector< VoidFunction > &           localCommunication =           localCommunication_[i][j];
+   std::vector< VoidFunction > & threadsafeLocalCommunication = threadsafeLocalCommunication_[i][j];
+
    if( localMode_ == START )
    {
       for( auto function = localCommunication.begin(); function != localCommunication.end(); ++function )
@@ -1068,16 +1266,34 @@ void NonUniformBufferedScheme<Stencil>::wait( const INDEX i, const uint_t j )
    if( !communicationInProgress_[i][j] || packInfos_.empty() )
       return;
 
-   shared_ptr< mpi::OpenMPBufferSystem > & bufferSystem = bufferSystem_[i][j];
+   if( i != FINE_TO_COARSE && aggregatedCommunicationInProgress_[j] )
+   {
+      waitAggregated( j );
+      return;
+   }
+
+   // LOCAL
+
+   waitLocalCommunication( i, j );
+
+   // MPI
+
+   bufferSystem_[i][j]->wait();
+
+   communicationInProgress_[i][j] = false;
+}
 
+
+
+template< typename Stencil >
+void NonUniformBufferedScheme<Stencil>::waitLocalCommunication( const INDEX i, const uint_t j )
+{
    std::vector< VoidFunction > &           localCommunication =           localCommunication_[i][j];
    std::vector< VoidFunction > & threadsafeLocalCommunication = threadsafeLocalCommunication_[i][j];
 
    std::vector< VoidFunction > &           localCommunicationUnpack =           localCommunicationUnpack_[i][j];
    std::vector< VoidFunction > & threadsafeLocalCommunicationUnpack = threadsafeLocalCommunicationUnpack_[i][j];
 
-   // LOCAL
-
    if( localMode_ == WAIT )
    {
       for( auto function = localCommunication.begin(); function != localCommunication.end(); ++function )
@@ -1102,12 +1318,28 @@ void NonUniformBufferedScheme<Stencil>::wait( const INDEX i, const uint_t j )
       for( int c = 0; c < threadsafeLocalCommunicationUnpackSize; ++c )
          threadsafeLocalCommunicationUnpack[uint_c(c)]();
    }
+}
+
+
+
+template< typename Stencil >
+void NonUniformBufferedScheme<Stencil>::waitAggregated( const uint_t fineLevel )
+{
+   if( !aggregatedCommunicationInProgress_[ fineLevel ] || packInfos_.empty() )
+      return;
+
+   // LOCAL
+
+   waitLocalCommunication( COARSE_TO_FINE, fineLevel );
+   waitLocalCommunication( EQUAL_LEVEL, fineLevel );
 
    // MPI
 
-   bufferSystem->wait();
+   aggregatedBufferSystem_[ fineLevel ]->wait();
 
-   communicationInProgress_[i][j] = false;
+   communicationInProgress_[ EQUAL_LEVEL ][ fineLevel ] = false;
+   communicationInProgress_[ COARSE_TO_FINE ][ fineLevel ] = false;
+   aggregatedCommunicationInProgress_[ fineLevel ] = false;
 }
 
 
@@ -1240,6 +1472,10 @@ bool NonUniformBufferedScheme<Stencil>::isAnyCommunicationInProgress() const
          if( *levelIt )
             return true;
 
+   for( auto levelIt = aggregatedCommunicationInProgress_.begin(); levelIt != aggregatedCommunicationInProgress_.end(); ++levelIt )
+      if( *levelIt )
+         return true;
+
    return false;
 }
 
@@ -154,6 +154,10 @@ public:
    LocalCommunicationMode localMode() const { return localMode_; }
    inline void setLocalMode( const LocalCommunicationMode & mode );
 
+   /// see mpi::BufferSystem::usePersistentRequests(), only has an effect if buffer sizes are constant
+   bool persistentRequests() const { return bufferSystem_.usesPersistentRequests(); }
+   void usePersistentRequests( const bool persistent ) { WALBERLA_ASSERT( !communicationInProgress_ ); bufferSystem_.usePersistentRequests( persistent ); }
+
 
    //** Asynchronous Communication *************************************************************************************
    /*! \name Asynchronous Communication */
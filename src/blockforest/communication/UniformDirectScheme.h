@@ -41,6 +41,12 @@ namespace communication {
 //*******************************************************************************************************************
 /*! Communication for a single field using MPI datatypes ( no intermediate buffers )
 *
+* By default, one MPI_Isend / MPI_Irecv pair is issued for every block, direction, and registered data.
+* Alternatively, with useNeighborCollectives( true ), a distributed graph communicator is created from the process
+* neighborhood and all data that is exchanged with a neighbor process is combined into one MPI struct datatype.
+* One communication step then consists of a single MPI_Ineighbor_alltoallw call (requires MPI-3). In this mode,
+* setup and communication are collective operations: all processes of the communicator have to take part, even
+* processes without any blocks.
 */
 //*******************************************************************************************************************
 template< typename Stencil >
@@ -62,7 +68,8 @@ public:
         communicationRunning_( false ),
         requiredBlockSelectors_( Set<SUID>::emptySet() ),
         incompatibleBlockSelectors_( Set<SUID>::emptySet() ),
-        tag_( tag )
+        tag_( tag ),
+        neighborCollectives_( false )
    {
       if ( dataInfo )
          dataInfos_.push_back( dataInfo );
@@ -78,7 +85,8 @@ public:
         communicationRunning_( false ),
         requiredBlockSelectors_( requiredBlockSelectors ),
         incompatibleBlockSelectors_( incompatibleBlockSelectors ),
-        tag_( tag )
+        tag_( tag ),
+        neighborCollectives_( false )
    {
       if ( dataInfo )
          dataInfos_.push_back( dataInfo );
@@ -117,8 +125,19 @@ public:
    //@}
    //*******************************************************************************************************************
 
+
+   //** Neighborhood Collectives ***************************************************************************************
+   /*! \name Neighborhood Collectives */
+   //@{
+   inline void useNeighborCollectives( const bool value );
+   bool neighborCollectives() const { return neighborCollectives_; }
+   //@}
+   //*******************************************************************************************************************
+
 protected:
    void setup();
+   void setupNeighborCollectives();
+   void startNeighborCollectives();
 
    struct CommInfo
    {
@@ -156,6 +175,47 @@ protected:
 
    int tag_;
 
+
+   /// MPI resources of the neighborhood collective mode
+   /// (not shared between copies of the scheme, a copy creates its own resources during its first communication)
+   struct NeighborCollectives
+   {
+      /// combined send/receive datatypes (one per neighbor process) for a certain set of buffer addresses
+      struct Datatypes
+      {
+         std::vector< void * >       pointers;
+         std::vector< MPI_Datatype > sendTypes;
+         std::vector< MPI_Datatype > recvTypes;
+      };
+
+      NeighborCollectives() : comm( MPI_COMM_NULL ), request( MPI_REQUEST_NULL ) {}
+      NeighborCollectives( const NeighborCollectives & ) : comm( MPI_COMM_NULL ), request( MPI_REQUEST_NULL ) {}
+      NeighborCollectives & operator=( const NeighborCollectives & ) { clear(); return *this; }
+      ~NeighborCollectives() { clear(); }
+
+      void clear();
+      static void freeDatatypes( Datatypes & datatypes );
+
+      MPI_Comm    comm;    ///< distributed graph communicator, sources and destinations are the ranks in 'neighbors'
+      MPI_Request request;
+
+      std::vector< int >                    neighbors;
+      std::vector< std::vector< uint_t > >  sendItems; ///< per neighbor: indices into sendInfos_
+      std::vector< std::vector< uint_t > >  recvItems; ///< per neighbor: indices into recvInfos_
+      std::vector< int >                    itemCounts; ///< per send/recv info: number of items of its datatype
+      std::vector< int >                    sendCounts;
+      std::vector< int >                    recvCounts;
+      std::vector< MPI_Aint >               displacements;
+
+      /// the addresses of the communicated data change if fields swap their data pointers -> the datatypes for the
+      /// two most recently used sets of addresses are kept (this covers fields with src/dst swapping)
+      std::vector< Datatypes > cache;
+      std::vector< void * >    pointers;
+   };
+
+   bool                neighborCollectives_;
+   NeighborCollectives neighborData_;
+
 }; // class UniformDirectScheme
 
 
@@ -24,6 +24,8 @@
 #include "UniformDirectScheme.h"
 #include "blockforest/BlockNeighborhoodSection.h"
 
+#include <algorithm>
+
 namespace walberla {
 namespace blockforest {
 namespace communication {
@@ -170,17 +172,159 @@ void UniformDirectScheme<Stencil>::setup()
 
    mpiRequests_.resize( sendInfos_.size() + recvInfos_.size(), MPI_REQUEST_NULL );
 
+   neighborData_.clear();
+   if( neighborCollectives_ )
+      setupNeighborCollectives();
+
    setupRequired_ = false;
 }
 
 
+template< typename Stencil >
+void UniformDirectScheme<Stencil>::setupNeighborCollectives()
+{
+#ifdef WALBERLA_MPI_NEIGHBOR_COLLECTIVES
+   NeighborCollectives & nc = neighborData_;
+
+   for( auto it = sendInfos_.begin(); it != sendInfos_.end(); ++it )
+      nc.neighbors.push_back( int_c( it->remoteProcess ) );
+   for( auto it = recvInfos_.begin(); it != recvInfos_.end(); ++it )
+      nc.neighbors.push_back( int_c( it->remoteProcess ) );
+
+   std::sort( nc.neighbors.begin(), nc.neighbors.end() );
+   nc.neighbors.erase( std::unique( nc.neighbors.begin(), nc.neighbors.end() ), nc.neighbors.end() );
+
+   const uint_t numberOfNeighbors = nc.neighbors.size();
+
+   // The items that are exchanged with a neighbor keep the order of sendInfos_ / recvInfos_, which is sorted such that
+   // it matches on both sides (see setup()) -> the combined datatypes of sender and receiver match as well.
+   nc.sendItems.resize( numberOfNeighbors );
+   nc.recvItems.resize( numberOfNeighbors );
+
+   auto forest = blockForest_.lock();
+
+   for( uint_t i = 0; i < sendInfos_.size(); ++i )
+   {
+      const auto neighbor = std::lower_bound( nc.neighbors.begin(), nc.neighbors.end(), int_c( sendInfos_[i].remoteProcess ) );
+      nc.sendItems[ uint_c( neighbor - nc.neighbors.begin() ) ].push_back( i );
+      nc.itemCounts.push_back( dataInfos_[ sendInfos_[i].dataIdx ]->getNumberOfItemsToCommunicate( forest->getBlock( sendInfos_[i].localBlockId ),
+                                                                                                    sendInfos_[i].dir ) );
+   }
+   for( uint_t i = 0; i < recvInfos_.size(); ++i )
+   {
+      const auto neighbor = std::lower_bound( nc.neighbors.begin(), nc.neighbors.end(), int_c( recvInfos_[i].remoteProcess ) );
+      nc.recvItems[ uint_c( neighbor - nc.neighbors.begin() ) ].push_back( i );
+      nc.itemCounts.push_back( dataInfos_[ recvInfos_[i].dataIdx ]->getNumberOfItemsToCommunicate( forest->getBlock( recvInfos_[i].localBlockId ),
+                                                                                                    recvInfos_[i].dir ) );
+   }
+
+   for( uint_t n = 0; n < numberOfNeighbors; ++n )
+   {
+      nc.sendCounts.push_back( nc.sendItems[n].empty() ? 0 : 1 );
+      nc.recvCounts.push_back( nc.recvItems[n].empty() ? 0 : 1 );
+   }
+   nc.displacements.assign( numberOfNeighbors, MPI_Aint(0) ); // datatypes contain absolute addresses (-> MPI_BOTTOM)
+
+   MPI_Dist_graph_create_adjacent( MPIManager::instance()->comm(),
+                                   int_c( numberOfNeighbors ), nc.neighbors.data(), MPI_UNWEIGHTED,
+                                   int_c( numberOfNeighbors ), nc.neighbors.data(), MPI_UNWEIGHTED,
+                                   MPI_INFO_NULL, 0, &nc.comm );
+#else
+   WALBERLA_ABORT( "Neighborhood collectives are only available if waLBerla is built with an MPI-3 implementation!" );
+#endif
+}
+
+
+template< typename Stencil >
+void UniformDirectScheme<Stencil>::startNeighborCollectives()
+{
+#ifdef WALBERLA_MPI_NEIGHBOR_COLLECTIVES
+   NeighborCollectives & nc = neighborData_;
+
+   auto forest = blockForest_.lock();
+
+   nc.pointers.clear();
+   for( auto it = sendInfos_.begin(); it != sendInfos_.end(); ++it )
+      nc.pointers.push_back( dataInfos_[ it->dataIdx ]->getSendPointer( forest->getBlock( it->localBlockId ), it->dir ) );
+   for( auto it = recvInfos_.begin(); it != recvInfos_.end(); ++it )
+      nc.pointers.push_back( dataInfos_[ it->dataIdx ]->getRecvPointer( forest->getBlock( it->localBlockId ), it->dir ) );
+
+   auto datatypes = nc.cache.begin();
+   while( datatypes != nc.cache.end() && datatypes->pointers != nc.pointers )
+      ++datatypes;
+
+   if( datatypes == nc.cache.end() )
+   {
+      if( nc.cache.size() == uint_t(2) )
+      {
+         NeighborCollectives::freeDatatypes( nc.cache.front() );
+         nc.cache.erase( nc.cache.begin() );
+      }
+
+      typename NeighborCollectives::Datatypes newDatatypes;
+      newDatatypes.pointers = nc.pointers;
+
+      std::vector< int >          blockLengths;
+      std::vector< MPI_Aint >     addresses;
+      std::vector< MPI_Datatype > types;
+
+      for( int sending = 1; sending >= 0; --sending )
+      {
+         const auto & items = ( sending == 1 ) ? nc.sendItems : nc.recvItems;
+         const uint_t offset = ( sending == 1 ) ? uint_t(0) : sendInfos_.size();
+
+         for( auto neighbor = items.begin(); neighbor != items.end(); ++neighbor )
+         {
+            MPI_Datatype combined = MPI_BYTE;
+            if( !neighbor->empty() )
+            {
+               blockLengths.clear();
+               addresses.clear();
+               types.clear();
+               for( auto item = neighbor->begin(); item != neighbor->end(); ++item )
+               {
+                  MPI_Aint address;
+                  MPI_Get_address( nc.pointers[ offset + *item ], &address );
+                  blockLengths.push_back( nc.itemCounts[ offset + *item ] );
+                  addresses.push_back( address );
+                  types.push_back( *mpiDatatypes_[ offset + *item ] );
+               }
+               MPI_Type_create_struct( int_c( types.size() ), blockLengths.data(), addresses.data(), types.data(), &combined );
+               MPI_Type_commit( &combined );
+            }
+            ( sending == 1 ? newDatatypes.sendTypes : newDatatypes.recvTypes ).push_back( combined );
+         }
+      }
+
+      nc.cache.push_back( newDatatypes );
+      datatypes = nc.cache.end() - 1;
+   }
+
+   communicationRunning_ = true;
+
+   MPI_Ineighbor_alltoallw( MPI_BOTTOM, nc.sendCounts.data(), nc.displacements.data(), datatypes->sendTypes.data(),
+                            MPI_BOTTOM, nc.recvCounts.data(), nc.displacements.data(), datatypes->recvTypes.data(),
+                            nc.comm, &nc.request );
+#endif
+}
+
+
 template< typename Stencil >
 void UniformDirectScheme<Stencil>::startCommunication()
 {
    WALBERLA_ASSERT( !communicationRunning_ );
 
+   if( neighborCollectives_ && neighborData_.comm == MPI_COMM_NULL )
+      setupRequired_ = true; // copy of a scheme that was already set up
+
    setup();
 
+   if( neighborCollectives_ )
+   {
+      startNeighborCollectives();
+      return;
+   }
+
    if( mpiRequests_.empty() )
       return;
 
@@ -248,6 +392,14 @@ void UniformDirectScheme<Stencil>::startCommunication()
 template< typename Stencil >
 void UniformDirectScheme<Stencil>::wait()
 {
+   if( neighborCollectives_ )
+   {
+      WALBERLA_ASSERT( communicationRunning_ );
+      MPI_Wait( &neighborData_.request, MPI_STATUS_IGNORE );
+      communicationRunning_ = false;
+      return;
+   }
+
    if( mpiRequests_.empty() )
       return;
 
@@ -269,6 +421,75 @@ void UniformDirectScheme<Stencil>::addDataToCommunicate(  const shared_ptr<Unifo
 }
 
 
+template< typename Stencil >
+inline void UniformDirectScheme<Stencil>::useNeighborCollectives( const bool value )
+{
+   WALBERLA_ASSERT( !communicationRunning_ );
+
+#ifndef WALBERLA_MPI_NEIGHBOR_COLLECTIVES
+   if( value )
+      WALBERLA_ABORT( "Neighborhood collectives are only available if waLBerla is built with an MPI-3 implementation!" );
+#endif
+
+   if( value != neighborCollectives_ )
+      setupRequired_ = true;
+   neighborCollectives_ = value;
+}
+
+
+
+//===================================================================================================================
+//
+//  UniformDirectScheme::NeighborCollectives
+//
+//===================================================================================================================
+
+template< typename Stencil >
+void UniformDirectScheme<Stencil>::NeighborCollectives::clear()
+{
+#ifdef WALBERLA_MPI_NEIGHBOR_COLLECTIVES
+   int finalized = 0;
+   MPI_Finalized( &finalized );
+   if( !finalized )
+   {
+      for( auto datatypes = cache.begin(); datatypes != cache.end(); ++datatypes )
+         freeDatatypes( *datatypes );
+      if( comm != MPI_COMM_NULL )
+         MPI_Comm_free( &comm );
+   }
+#endif
+   comm    = MPI_COMM_NULL;
+   request = MPI_REQUEST_NULL;
+
+   neighbors.clear();
+   sendItems.clear();
+   recvItems.clear();
+   itemCounts.clear();
+   sendCounts.clear();
+   recvCounts.clear();
+   displacements.clear();
+   cache.clear();
+}
+
+
+template< typename Stencil >
+void UniformDirectScheme<Stencil>::NeighborCollectives::freeDatatypes( Datatypes & datatypes )
+{
+#ifdef WALBERLA_MPI_NEIGHBOR_COLLECTIVES
+   for( int sending = 1; sending >= 0; --sending )
+   {
+      auto & types = ( sending == 1 ) ? datatypes.sendTypes : datatypes.recvTypes;
+      for( auto type = types.begin(); type != types.end(); ++type )
+         if( *type != MPI_BYTE )
+            MPI_Type_free( &( *type ) );
+      types.clear();
+   }
+#else
+   WALBERLA_UNUSED( datatypes );
+#endif
+}
+
+
 
 } // namespace communication
 } // namespace blockforest
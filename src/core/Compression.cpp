@@ -0,0 +1,170 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file Compression.cpp
+//! \ingroup core
+//
+//======================================================================================================================
+
+#include "Compression.h"
+#include "core/debug/CheckFunctions.h"
+
+#include <cstring>
+
+
+namespace walberla {
+
+
+
+namespace compression {
+
+static const uint_t MIN_MATCH  = uint_t(4);
+static const uint_t HASH_BITS  = uint_t(14);
+static const uint_t NO_ENTRY   = ~uint_t(0);
+
+inline uint32_t read32( const uint8_t * p )
+{
+   uint32_t value;
+   std::memcpy( &value, p, sizeof( uint32_t ) );
+   return value;
+}
+
+inline uint_t hash( const uint32_t sequence )
+{
+   return uint_c( ( sequence * uint32_t(2654435761u) ) >> ( 32 - HASH_BITS ) );
+}
+
+inline void writeVarUInt( uint_t value, std::vector< uint8_t > & out )
+{
+   while( value >= uint_t(128) )
+   {
+      out.push_back( uint8_c( ( value & uint_t(127) ) | uint_t(128) ) );
+      value >>= 7;
+   }
+   out.push_back( uint8_c( value ) );
+}
+
+inline uint_t readVarUInt( const uint8_t * & in, const uint8_t * const end )
+{
+   uint_t value( 0 );
+   uint_t shift( 0 );
+   for(;;)
+   {
+      WALBERLA_CHECK( in != end && shift < uint_t(64), "Corrupt compressed data!" );
+      const uint8_t byte = *in++;
+      value |= uint_c( byte & uint8_t(127) ) << shift;
+      if( ( byte & uint8_t(128) ) == 0 )
+         return value;
+      shift += uint_t(7);
+   }
+}
+
+inline void writeLiterals( const uint8_t * begin, const uint8_t * end, std::vector< uint8_t > & out )
+{
+   writeVarUInt( uint_c( end - begin ), out );
+   out.insert( out.end(), begin, end );
+}
+
+} // namespace compression
+
+
+
+uint_t compress( const uint8_t * data, const uint_t size, std::vector< uint8_t > & compressed )
+{
+   using namespace compression;
+
+   const uint_t initialSize = uint_c( compressed.size() );
+
+   std::vector< uint_t > table( uint_t(1) << HASH_BITS, NO_ENTRY );
+
+   uint_t anchor( 0 ); // first byte that is not yet encoded
+   uint_t pos( 0 );
+   uint_t misses( 0 );
+
+   while( size >= MIN_MATCH && pos <= size - MIN_MATCH )
+   {
+      const uint32_t sequence = read32( data + pos );
+      const uint_t h = hash( sequence );
+      const uint_t candidate = table[h];
+      table[h] = pos;
+
+      if( candidate != NO_ENTRY && read32( data + candidate ) == sequence )
+      {
+         uint_t length = MIN_MATCH;
+         while( pos + length < size && data[ candidate + length ] == data[ pos + length ] )
+            ++length;
+
+         // sequence: literals since the last match, length and offset of the match
+         writeLiterals( data + anchor, data + pos, compressed );
+         writeVarUInt( length - MIN_MATCH, compressed );
+         writeVarUInt( pos - candidate, compressed );
+
+         pos += length;
+         anchor = pos;
+         misses = uint_t(0);
+      }
+      else
+      {
+         // incompressible data is skipped with increasing steps
+         pos += uint_t(1) + ( misses >> 6 );
+         ++misses;
+      }
+   }
+
+   // the last sequence only consists of literals
+   writeLiterals( data + anchor, data + size, compressed );
+
+   return uint_c( compressed.size() ) - initialSize;
+}
+
+
+
+void decompress( const uint8_t * compressed, const uint_t compressedSize, uint8_t * data, const uint_t size )
+{
+   using namespace compression;
+
+   const uint8_t * in = compressed;
+   const uint8_t * const end = compressed + compressedSize;
+
+   uint_t pos( 0 );
+   for(;;)
+   {
+      const uint_t literals = readVarUInt( in, end );
+      WALBERLA_CHECK( literals <= size - pos && literals <= uint_c( end - in ), "Corrupt compressed data!" );
+      if( literals > uint_t(0) )
+         std::memcpy( data + pos, in, literals );
+      in  += literals;
+      pos += literals;
+
+      if( pos == size )
+         break;
+
+      const uint_t length = readVarUInt( in, end ) + MIN_MATCH;
+      const uint_t offset = readVarUInt( in, end );
+      WALBERLA_CHECK( offset > uint_t(0) && offset <= pos && length <= size - pos, "Corrupt compressed data!" );
+
+      // byte by byte since source and destination may overlap (runs of identical values)
+      const uint8_t * source = data + pos - offset;
+      for( uint_t i = 0; i != length; ++i )
+         data[ pos + i ] = source[i];
+      pos += length;
+   }
+
+   WALBERLA_CHECK( in == end, "Corrupt compressed data!" );
+}
+
+
+
+} // namespace walberla
@@ -0,0 +1,50 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file Compression.h
+//! \ingroup core
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "DataTypes.h"
+
+#include <vector>
+
+
+namespace walberla {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Fast lossless compression of byte streams (LZ77 with a single hash table, similar to LZ4)
+*
+*   The compressed stream is a sequence of literal runs and back references (length + offset). Runs of identical
+*   bytes or of repeated multi-byte values (flag fields, boundary handling data, ...) are reduced to a few bytes,
+*   incompressible data (random floating point values) grows by less than 1%.
+*
+*   The compressed data is appended to 'compressed', the number of appended bytes is returned.
+*/
+//**********************************************************************************************************************
+uint_t compress( const uint8_t * data, const uint_t size, std::vector< uint8_t > & compressed );
+
+/// Decompresses the 'compressedSize' bytes at 'compressed' into 'data', which must hold exactly 'size' bytes
+void decompress( const uint8_t * compressed, const uint_t compressedSize, uint8_t * data, const uint_t size );
+
+
+
+} // namespace walberla
@@ -24,6 +24,7 @@
 
 #include "Abort.h"
 #include "AllSet.h"
+#include "Compression.h"
 #include "Array.h"
 #include "DataTypes.h"
 #include "Deprecated.h"
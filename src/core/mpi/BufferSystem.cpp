@@ -104,6 +104,7 @@ BufferSystem::BufferSystem( const BufferSystem &other )
      sendInfos_( other.sendInfos_ )
 {
    WALBERLA_ASSERT( !communicationRunning_, "Can't copy BufferSystem while communication is running" );
+   knownSizeComm_.usePersistentRequests( other.usesPersistentRequests() );
    if( other.currentComm_ == &other.knownSizeComm_ )
       currentComm_ = &knownSizeComm_;
    else if ( other.currentComm_ == &other.unknownSizeComm_ )
@@ -124,6 +125,8 @@ BufferSystem & BufferSystem::operator=( const BufferSystem & other )
    recvInfos_ = other.recvInfos_;
    sendInfos_ = other.sendInfos_;
 
+   knownSizeComm_.usePersistentRequests( other.usesPersistentRequests() );
+
    if( other.currentComm_ == &other.knownSizeComm_ )
       currentComm_ = &knownSizeComm_;
    else if ( other.currentComm_ == &other.unknownSizeComm_ )
@@ -259,6 +262,38 @@ void BufferSystem::sizeHasChanged( bool alwaysChangingSize )
 
 
 
+//======================================================================================================================
+//
+//  Persistent Requests
+//
+//======================================================================================================================
+
+
+//**********************************************************************************************************************
+/*! Enables/disables persistent MPI requests for all communication steps where the message sizes are known
+*
+* In the persistent mode, MPI_Send_init / MPI_Recv_init requests are created in the first step with known message
+* sizes and are only restarted (MPI_Start / MPI_Startall) in all following steps. This reduces the per-step overhead
+* for communication patterns that do not change, e.g. ghost layer exchange with constant sizes
+* ( setReceiverInfo(...) with changingSize == false ).
+*
+* The SendBuffers and RecvBuffers of the BufferSystem keep their memory when they are cleared after a communication
+* step, so the requests remain valid as long as the communication partners and the message sizes stay the same.
+* If a buffer has to grow, or the receiver information or message sizes change, the affected requests are created
+* again automatically. Steps where sizes are communicated are not affected by this setting.
+*
+* Can only be called if no communication is currently running.
+*/
+//**********************************************************************************************************************
+void BufferSystem::usePersistentRequests( bool persistent )
+{
+   WALBERLA_ASSERT( ! communicationRunning_ );
+
+   knownSizeComm_.usePersistentRequests( persistent );
+}
+
+
+
 //======================================================================================================================
 //
 //  Step 1: Schedule Receives and ISends
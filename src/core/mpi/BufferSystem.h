@@ -46,6 +46,7 @@ class OpenMPBufferSystem;
 *    - unknown message sizes possible ( -> automatic extra message to exchange sizes )
 *    - Implemented with non-blocking MPI calls, and MPI_Waitany to process a message as soon
 *      as it was received while still waiting for other messages
+*    - optionally, persistent MPI requests are used for messages of known size ( see usePersistentRequests() )
 *
 *
 * \ingroup mpi
@@ -156,6 +157,17 @@ public:
    //*******************************************************************************************************************
 
 
+   //** Persistent Requests  *******************************************************************************************
+   /*! \name Persistent Requests */
+   //@{
+   void usePersistentRequests( bool persistent );
+   bool usesPersistentRequests() const       { return knownSizeComm_.usesPersistentRequests();   }
+   uint_t persistentRequestSetups() const    { return knownSizeComm_.persistentRequestSetups();  }
+   uint_t persistentSendRequests() const     { return knownSizeComm_.persistentSendRequests();   }
+   //@}
+   //*******************************************************************************************************************
+
+
    //** Iterator        ************************************************************************************************
    /*! \name Iterator  */
    //@{
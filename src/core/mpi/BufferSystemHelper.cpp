@@ -45,6 +45,31 @@ void KnownSizeCommunication::send( MPIRank receiver, const SendBuffer & sendBuff
    if ( ! sending_ )
       sending_ = true;
 
+   if ( persistent_ )
+   {
+      PersistentRequest & persistentRequest = persistentSends_[ receiver ];
+
+      if ( persistentRequest.request == MPI_REQUEST_NULL || persistentRequest.ptr  != sendBuffer.ptr() ||
+                                                            persistentRequest.size != int_c( sendBuffer.size() ) )
+      {
+         if ( persistentRequest.request != MPI_REQUEST_NULL )
+            MPI_Request_free( &persistentRequest.request );
+
+         persistentRequest.ptr  = sendBuffer.ptr();
+         persistentRequest.size = int_c( sendBuffer.size() );
+         MPI_Send_init( sendBuffer.ptr(), persistentRequest.size, MPI_BYTE, receiver, tag_, communicator_,
+                        &persistentRequest.request );
+         ++persistentRequestSetups_;
+      }
+
+      MPI_Start( &persistentRequest.request );
+      persistentRequest.used = true;
+
+      // persistent request handles are not modified by MPI_Waitall -> a copy can be used for waiting
+      sendRequests_.push_back( persistentRequest.request );
+      return;
+   }
+
    sendRequests_.push_back( MPI_REQUEST_NULL );
    MPI_Request & request = sendRequests_.back();
    MPI_Isend( sendBuffer.ptr(),          // pointer to size buffer
@@ -65,14 +90,30 @@ void KnownSizeCommunication::waitForSends( )
 
    sending_ = false;
 
-   if ( sendRequests_.empty() )
-      return;
+   if ( ! sendRequests_.empty() )
+   {
+      MPI_Waitall( int_c( sendRequests_.size() ),
+                   &sendRequests_[0],
+                   MPI_STATUSES_IGNORE );
 
-   MPI_Waitall( int_c( sendRequests_.size() ),
-                &sendRequests_[0],
-                MPI_STATUSES_IGNORE );
+      sendRequests_.clear();
+   }
 
-   sendRequests_.clear();
+   // free the persistent requests of receivers that were not sent to in this step (communication partners changed)
+   for( auto it = persistentSends_.begin(); it != persistentSends_.end(); )
+   {
+      if ( it->second.used )
+      {
+         it->second.used = false;
+         ++it;
+      }
+      else
+      {
+         if ( it->second.request != MPI_REQUEST_NULL )
+            MPI_Request_free( &( it->second.request ) );
+         it = persistentSends_.erase( it );
+      }
+   }
 }
 
 
@@ -83,6 +124,52 @@ void KnownSizeCommunication::scheduleReceives( std::map<MPIRank, ReceiveInfo> &
 
    WALBERLA_ASSERT( ! receiving_ );
 
+   if ( persistent_ )
+   {
+      // requests can be restarted if they were created for the same ranks, sizes, and receive buffers
+      bool upToDate = ( persistentRecvs_.size() == recvInfos.size() );
+
+      size_t recvCount = 0;
+      for( auto it = recvInfos.begin(); it != recvInfos.end(); ++it, ++recvCount )
+      {
+         WALBERLA_ASSERT_GREATER( it->second.size, 0 );
+         it->second.buffer.resize( uint_c( it->second.size ) );
+
+         upToDate = upToDate && persistentRecvs_[recvCount].first      == it->first &&
+                                persistentRecvs_[recvCount].second.ptr  == it->second.buffer.ptr() &&
+                                persistentRecvs_[recvCount].second.size == it->second.size;
+      }
+
+      if ( ! upToDate )
+      {
+         for( auto it = persistentRecvs_.begin(); it != persistentRecvs_.end(); ++it )
+            if ( it->second.request != MPI_REQUEST_NULL )
+               MPI_Request_free( &( it->second.request ) );
+
+         persistentRecvs_.assign( recvInfos.size(), std::make_pair( INVALID_RANK, PersistentRequest() ) );
+         recvRequests_.assign( recvInfos.size(), MPI_REQUEST_NULL );
+
+         recvCount = 0;
+         for( auto it = recvInfos.begin(); it != recvInfos.end(); ++it, ++recvCount )
+         {
+            PersistentRequest & persistentRequest = persistentRecvs_[recvCount].second;
+            persistentRecvs_[recvCount].first = it->first;
+            persistentRequest.ptr  = it->second.buffer.ptr();
+            persistentRequest.size = it->second.size;
+            MPI_Recv_init( it->second.buffer.ptr(), it->second.size, MPI_BYTE, it->first, tag_, communicator_,
+                           &persistentRequest.request );
+            recvRequests_[recvCount] = persistentRequest.request;
+            ++persistentRequestSetups_;
+         }
+      }
+
+      if ( ! recvRequests_.empty() )
+         MPI_Startall( int_c( recvRequests_.size() ), &recvRequests_[0] );
+
+      receiving_ = true;
+      return;
+   }
+
    recvRequests_.assign( recvInfos.size(), MPI_REQUEST_NULL );
    size_t recvCount = 0;
 
@@ -135,7 +222,9 @@ MPIRank KnownSizeCommunication::waitForNextReceive( std::map<MPIRank, ReceiveInf
 
    if ( requestIndex == MPI_UNDEFINED )
    {
-      recvRequests_.clear();
+      // completed persistent requests are inactive (not null) and are kept for the next step
+      if ( ! persistent_ )
+         recvRequests_.clear();
       receiving_ = false;
       return INVALID_RANK;
    }
@@ -144,7 +233,8 @@ MPIRank KnownSizeCommunication::waitForNextReceive( std::map<MPIRank, ReceiveInf
    WALBERLA_ASSERT_GREATER_EQUAL( requestIndex, 0 );
    WALBERLA_ASSERT_LESS( requestIndex, int_c( recvRequests_.size() ) );
 
-   recvRequests_[ uint_c( requestIndex ) ] = MPI_REQUEST_NULL;
+   if ( ! persistent_ )
+      recvRequests_[ uint_c( requestIndex ) ] = MPI_REQUEST_NULL;
 
    MPIRank senderRank = status.MPI_SOURCE;
    WALBERLA_ASSERT_GREATER_EQUAL( senderRank, 0 );
@@ -163,6 +253,47 @@ MPIRank KnownSizeCommunication::waitForNextReceive( std::map<MPIRank, ReceiveInf
 
 
 
+void KnownSizeCommunication::usePersistentRequests( bool persistent )
+{
+   WALBERLA_ASSERT( ! sending_ && ! receiving_ );
+
+   if ( persistent == persistent_ )
+      return;
+
+   freePersistentRequests();
+   persistent_ = persistent;
+}
+
+
+
+void KnownSizeCommunication::freePersistentRequests()
+{
+   WALBERLA_ASSERT( ! sending_ && ! receiving_ );
+
+   if ( persistentSends_.empty() && persistentRecvs_.empty() )
+      return;
+
+   // requests that still exist after MPI_Finalize cannot be freed anymore
+   int finalized = 0;
+   MPI_Finalized( &finalized );
+
+   if ( ! finalized )
+   {
+      for( auto it = persistentSends_.begin(); it != persistentSends_.end(); ++it )
+         if ( it->second.request != MPI_REQUEST_NULL )
+            MPI_Request_free( &( it->second.request ) );
+      for( auto it = persistentRecvs_.begin(); it != persistentRecvs_.end(); ++it )
+         if ( it->second.request != MPI_REQUEST_NULL )
+            MPI_Request_free( &( it->second.request ) );
+   }
+
+   persistentSends_.clear();
+   persistentRecvs_.clear();
+   recvRequests_.clear();
+}
+
+
+
 
 //======================================================================================================================
 //
@@ -105,9 +105,13 @@ namespace internal {
    {
    public:
       KnownSizeCommunication( const MPI_Comm & communicator, int tag = 0 )
-           : AbstractCommunication( communicator, tag ), sending_(false), receiving_(false) {}
+           : AbstractCommunication( communicator, tag ), sending_(false), receiving_(false),
+             persistent_(false), persistentRequestSetups_(0) {}
 
-      virtual ~KnownSizeCommunication() {}
+      KnownSizeCommunication( const KnownSizeCommunication & ) = delete;
+      KnownSizeCommunication & operator=( const KnownSizeCommunication & ) = delete;
+
+      virtual ~KnownSizeCommunication() { freePersistentRequests(); }
 
       virtual void send( MPIRank receiver, const SendBuffer & sendBuffer );
       virtual void waitForSends();
@@ -117,12 +121,46 @@ namespace internal {
       /// size field of recvInfos is expected to be valid
       virtual MPIRank waitForNextReceive( std::map<MPIRank, ReceiveInfo> & recvInfos );
 
+
+      /*************************************************************************************************************//**
+      * Enables/disables persistent requests
+      *
+      * If enabled, the requests are created with MPI_Send_init/MPI_Recv_init and restarted (MPI_Start/MPI_Startall)
+      * in every following step. A request is only created again if the communication partners, the message size,
+      * or the memory location of the corresponding buffer have changed since the last step.
+      *****************************************************************************************************************/
+      void usePersistentRequests( bool persistent );
+      bool usesPersistentRequests() const { return persistent_; }
+
+      /// total number of persistent requests that had to be created (for statistics and testing)
+      uint_t persistentRequestSetups() const { return persistentRequestSetups_; }
+
+      /// number of persistent send requests that currently exist (one per receiver of the last step)
+      uint_t persistentSendRequests() const { return uint_c( persistentSends_.size() ); }
+
    private:
+      void freePersistentRequests();
+
       bool sending_;
       bool receiving_;
 
       std::vector<MPI_Request> sendRequests_;
       std::vector<MPI_Request> recvRequests_;
+
+      /// persistent request together with the buffer location and message size it was created for
+      struct PersistentRequest {
+         PersistentRequest() : request( MPI_REQUEST_NULL ), ptr( NULL ), size( 0 ), used( false ) {}
+         MPI_Request request;
+         const void * ptr;
+         MPISize      size;
+         bool         used; //< send requests that were not used in the last step are freed in waitForSends()
+      };
+
+      bool persistent_;
+      uint_t persistentRequestSetups_;
+
+      std::map<MPIRank, PersistentRequest> persistentSends_;
+      std::vector< std::pair<MPIRank, PersistentRequest> > persistentRecvs_; //< same order as recvRequests_
    };
 
 
@@ -67,6 +67,16 @@ namespace mpistubs {
 #pragma warning ( pop )
 #endif
 
+// MPI-3 neighborhood collectives on distributed graph communicators
+#if MPI_VERSION >= 3
+#define WALBERLA_MPI_NEIGHBOR_COLLECTIVES
+#endif
+
+// MPI-3.1 nonblocking collective file I/O
+#if MPI_VERSION > 3 || ( MPI_VERSION == 3 && MPI_SUBVERSION >= 1 )
+#define WALBERLA_MPI_NONBLOCKING_COLLECTIVE_IO
+#endif
+
 
 
 #else // WALBERLA_BUILD_WITH_MPI
@@ -181,6 +191,7 @@ const int MPI_MAX_ERROR_STRING = 255;
 
 inline int MPI_Init( int*, char*** )  { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Initialized( int *)    { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_Finalized( int *)      { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Finalize()             { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Abort( MPI_Comm, int ) { WALBERLA_MPI_FUNCTION_ERROR }
 
@@ -218,13 +229,20 @@ inline int MPI_Probe    ( int, int, MPI_Comm, MPI_Status* )       { WALBERLA_MPI
 inline int MPI_Iprobe   ( int, int, MPI_Comm, int*, MPI_Status* ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Get_count( MPI_Status*, MPI_Datatype, int* )       { WALBERLA_MPI_FUNCTION_ERROR }
 
-inline int MPI_Start   ( MPI_Request* )      { WALBERLA_MPI_FUNCTION_ERROR }
-inline int MPI_Startall( int, MPI_Request* ) { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_Recv_init( void*, int, MPI_Datatype, int, int, MPI_Comm, MPI_Request* ) { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_Send_init( void*, int, MPI_Datatype, int, int, MPI_Comm, MPI_Request* ) { WALBERLA_MPI_FUNCTION_ERROR }
+
+inline int MPI_Start       ( MPI_Request* )      { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_Startall    ( int, MPI_Request* ) { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_Request_free( MPI_Request* )      { WALBERLA_MPI_FUNCTION_ERROR }
 
 inline int MPI_Wait   ( MPI_Request*, MPI_Status* )            { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Waitall( int, MPI_Request*, MPI_Status* )       { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Waitany( int, MPI_Request*, int*, MPI_Status* ) { WALBERLA_MPI_FUNCTION_ERROR }
 
+inline int MPI_Test   ( MPI_Request*, int*, MPI_Status* )      { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_Testall( int, MPI_Request*, int*, MPI_Status* ) { WALBERLA_MPI_FUNCTION_ERROR }
+
 inline int MPI_Reduce   ( void*, void*, int, MPI_Datatype, MPI_Op, int, MPI_Comm ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Allreduce( void*, void*, int, MPI_Datatype, MPI_Op, MPI_Comm )      { WALBERLA_MPI_FUNCTION_ERROR }
 
@@ -241,6 +259,7 @@ inline int MPI_Alltoall  ( void*, int, MPI_Datatype, void*, int, MPI_Datatype, M
 inline int MPI_Type_contiguous( int, MPI_Datatype, MPI_Datatype* ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Type_create_subarray( int, const int*, const int*, const int*, int, MPI_Datatype, MPI_Datatype* ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Type_create_indexed_block( int, int, const int*, MPI_Datatype, MPI_Datatype* ) { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_Type_create_hindexed( int, const int*, const MPI_Aint*, MPI_Datatype, MPI_Datatype* ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Type_commit( MPI_Datatype* ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Type_free( MPI_Datatype* ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_Type_create_resized( MPI_Datatype, MPI_Aint, MPI_Aint, MPI_Datatype* ) { WALBERLA_MPI_FUNCTION_ERROR }
@@ -255,12 +274,20 @@ inline int MPI_File_write_shared( MPI_File, void*, int, MPI_Datatype, MPI_Status
 inline int MPI_File_write       ( MPI_File, void*, int, MPI_Datatype, MPI_Status* ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_File_write_all   ( MPI_File, void*, int, MPI_Datatype, MPI_Status* ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_File_write_at    ( MPI_File, MPI_Offset, void*, int, MPI_Datatype, MPI_Status* ) { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_File_iwrite_at   ( MPI_File, MPI_Offset, void*, int, MPI_Datatype, MPI_Request* ) { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_File_write_at_all( MPI_File, MPI_Offset, void*, int, MPI_Datatype, MPI_Status* ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_File_read_all    ( MPI_File, void *, int, MPI_Datatype, MPI_Status * ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_File_read_at     ( MPI_File, MPI_Offset, void*, int, MPI_Datatype, MPI_Status* ) { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_File_read_at_all ( MPI_File, MPI_Offset, void*, int, MPI_Datatype, MPI_Status* ) { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_File_close       ( MPI_File* )                                       { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_File_set_size    ( MPI_File, MPI_Offset )                            { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_File_get_size    ( MPI_File, MPI_Offset* )                           { WALBERLA_MPI_FUNCTION_ERROR }
 inline int MPI_File_set_view    ( MPI_File, MPI_Offset, MPI_Datatype , MPI_Datatype, char*, MPI_Info ) { WALBERLA_MPI_FUNCTION_ERROR }
 
+inline int MPI_Info_create( MPI_Info* )                    { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_Info_set   ( MPI_Info, char*, char* )       { WALBERLA_MPI_FUNCTION_ERROR }
+inline int MPI_Info_free  ( MPI_Info* )                    { WALBERLA_MPI_FUNCTION_ERROR }
+
 inline int MPI_Error_string ( int, char*, int* ) { WALBERLA_MPI_FUNCTION_ERROR }
 
 inline double MPI_Wtime() { WALBERLA_MPI_FUNCTION_ERROR }
@@ -60,6 +60,9 @@ public:
 
    bool isSizeCommunicatedInNextStep() const          { return bs_.isSizeCommunicatedInNextStep(); }
 
+   void usePersistentRequests( bool val )             { bs_.usePersistentRequests( val ); }
+   bool usesPersistentRequests() const                { return bs_.usesPersistentRequests(); }
+
    void addReceivingFunction( MPIRank rank, std::function<void ( RecvBuffer & buf ) > recvFunction );
    void addSendingFunction  ( MPIRank rank, std::function<void ( SendBuffer & buf ) > sendFunction );
 
@@ -55,20 +55,19 @@ namespace cuda {
          allocSize1=size1;
          allocSize2=size2;
          allocSize3=size3;
-         void * result;
-         WALBERLA_CUDA_CHECK( cudaHostAlloc( &result, size0*size1*size2*size3*sizeof(T), cudaHostAllocFlags ) );
-         return (T*)(result);
+         return allocateMemory( size0*size1*size2*size3 );
       }
 
+      // the first 'headerSize()' bytes of the allocation are reserved for the reference counter of the base class
       virtual T * allocateMemory ( uint_t size )
       {
-         T* result;
-         cudaHostAlloc( &result, size*sizeof(T), cudaHostAllocFlags );
-         return result;
+         void * result;
+         WALBERLA_CUDA_CHECK( cudaHostAlloc( &result, field::FieldAllocator<T>::headerSize() + size*sizeof(T), cudaHostAllocFlags ) );
+         return reinterpret_cast<T*>( static_cast<char*>( result ) + field::FieldAllocator<T>::headerSize() );
       }
 
       virtual void deallocate(T *& values) {
-         WALBERLA_CUDA_CHECK( cudaFreeHost( values ) );
+         WALBERLA_CUDA_CHECK( cudaFreeHost( reinterpret_cast<char*>( values ) - field::FieldAllocator<T>::headerSize() ) );
       }
    };
 
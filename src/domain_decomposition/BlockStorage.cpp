@@ -24,6 +24,7 @@
 #include "PeriodicIntersect.h"
 
 #include "core/Abort.h"
+#include "core/Compression.h"
 #include "core/debug/CheckFunctions.h"
 #include "core/debug/Debug.h"
 #include "core/logging/Logging.h"
@@ -31,6 +32,10 @@
 #include "core/mpi/Reduce.h"
 #include "core/uid/GlobalState.h"
 
+#include <algorithm>
+#include <fstream>
+#include <map>
+
 
 namespace walberla {
 namespace domain_decomposition {
@@ -245,23 +250,8 @@ BlockDataID BlockStorage::loadBlockData( const std::string & file, const interna
 //**********************************************************************************************************************
 void BlockStorage::saveBlockData( const std::string & file, const BlockDataID & id )
 {
-   WALBERLA_CHECK_LESS( uint_t(id), blockDataItem_.size() );
-   
-   std::vector< IBlock * > blocks;
-   for( auto block = begin(); block != end(); ++block )
-      blocks.push_back( block.get() );
-   std::sort( blocks.begin(), blocks.end(), internal::sortBlocksByID );
-   
-   auto & item = blockDataItem_[ uint_t(id) ];
    mpi::SendBuffer buffer;
-   
-   for( auto it = blocks.begin(); it != blocks.end(); ++it )
-   {
-      IBlock * block = *it;
-      auto dh = item.getDataHandling( block );
-      if( dh )
-         dh->serialize( block, id, buffer );
-   }
+   serializeBlockData( id, buffer );
    
    uint_t dataSize = sizeof( mpi::SendBuffer::ElementType ) * buffer.size();
    
@@ -344,6 +334,394 @@ void BlockStorage::saveBlockData( const std::string & file, const BlockDataID &
 
 
 
+//**********************************************************************************************************************
+/*!
+*   Serializes the data that corresponds to 'id' of all process local blocks (sorted by block ID) into 'buffer'. This
+*   is the process local part of the file written by 'saveBlockData'.
+*/
+//**********************************************************************************************************************
+void BlockStorage::serializeBlockData( const BlockDataID & id, mpi::SendBuffer & buffer )
+{
+   WALBERLA_CHECK_LESS( uint_t(id), blockDataItem_.size() );
+   
+   std::vector< IBlock * > blocks;
+   for( auto block = begin(); block != end(); ++block )
+      blocks.push_back( block.get() );
+   std::sort( blocks.begin(), blocks.end(), internal::sortBlocksByID );
+   
+   auto & item = blockDataItem_[ uint_t(id) ];
+   for( auto it = blocks.begin(); it != blocks.end(); ++it )
+   {
+      IBlock * block = *it;
+      auto dh = item.getDataHandling( block );
+      if( dh )
+         dh->serialize( block, id, buffer );
+   }
+}
+
+
+
+//**********************************************************************************************************************
+/*!
+*   Chunked block data files (see 'saveChunkedBlockData' and 'loadChunkedBlockData')
+*
+*   header: file ID, number of blocks
+*   index:  for every block: block ID, offset of the chunk (in bytes from the beginning of the file), size of the chunk,
+*           size of the serialized block data (the chunk is compressed if its size is smaller than the size of the data)
+*   chunks: the serialized (and possibly compressed) data of every block
+*
+*   All entries of the header and of the index are of type uint_t. The processes store their blocks sorted by block ID
+*   one after another, i.e., the chunks of the blocks of one process form one contiguous byte range.
+*/
+//**********************************************************************************************************************
+namespace internal {
+   static const uint_t CHUNKED_BLOCK_DATA_FILE_ID = uint_c( 0x31484B4E48434257ull ); // "WBCHNKH1"
+   static const uint_t CHUNKED_BLOCK_DATA_HEADER_ENTRIES = uint_t(2);
+   static const uint_t CHUNKED_BLOCK_DATA_INDEX_ENTRIES = uint_t(4);
+}
+
+
+
+//**********************************************************************************************************************
+/*!
+*   This function stores the data that corresponds to 'id' to file in a chunked format: the data of every block is
+*   stored separately (compressed with the fast lossless compression of 'core/Compression.h' if 'compress' is true and
+*   if the compression reduces the size) and the file starts with an index of the offsets of all blocks. The data can
+*   be loaded with 'loadChunkedBlockData' - in contrast to 'saveBlockData'/'loadBlockData', the number of processes and
+*   the distribution of the blocks to the processes may differ when the data is loaded.
+*/
+//**********************************************************************************************************************
+void BlockStorage::saveChunkedBlockData( const std::string & file, const BlockDataID & id, const bool compress )
+{
+   WALBERLA_CHECK_LESS( uint_t(id), blockDataItem_.size() );
+
+   std::vector< IBlock * > blocks;
+   for( auto block = begin(); block != end(); ++block )
+      blocks.push_back( block.get() );
+   std::sort( blocks.begin(), blocks.end(), internal::sortBlocksByID );
+
+   // serialize and compress the data of every block
+
+   auto & item = blockDataItem_[ uint_t(id) ];
+
+   std::vector< uint_t > index;
+   std::vector< uint8_t > chunks;
+   mpi::SendBuffer buffer;
+
+   for( auto it = blocks.begin(); it != blocks.end(); ++it )
+   {
+      IBlock * block = *it;
+      auto dh = item.getDataHandling( block );
+      if( !dh )
+         continue;
+
+      buffer.clear();
+      dh->serialize( block, id, buffer );
+
+      const uint8_t * data = reinterpret_cast< const uint8_t * >( buffer.ptr() );
+      const uint_t size = sizeof( mpi::SendBuffer::ElementType ) * buffer.size();
+      const uint_t offset = uint_c( chunks.size() );
+
+      uint_t chunkSize = size;
+      if( compress && size > uint_t(0) )
+      {
+         chunkSize = walberla::compress( data, size, chunks );
+         if( chunkSize >= size )
+         {
+            chunks.resize( offset );
+            chunkSize = size;
+         }
+      }
+      if( chunkSize == size )
+         chunks.insert( chunks.end(), data, data + size );
+
+      index.push_back( block->getId().getID() );
+      index.push_back( offset );
+      index.push_back( chunkSize );
+      index.push_back( size );
+   }
+
+   // position of the index entries and of the chunks of this process within the file
+
+   const uint_t numberOfBlocks = index.size() / internal::CHUNKED_BLOCK_DATA_INDEX_ENTRIES;
+   const uint_t chunksSize = uint_c( chunks.size() );
+
+   uint_t totalNumberOfBlocks = numberOfBlocks;
+   uint_t previousBlocks( uint_t(0) );
+   uint_t previousBytes( uint_t(0) );
+
+   WALBERLA_MPI_SECTION()
+   {
+      totalNumberOfBlocks = mpi::allReduce( numberOfBlocks, mpi::SUM, MPIManager::instance()->comm() );
+
+      uint_t local[2] = { numberOfBlocks, chunksSize };
+      uint_t exscanResult[2];
+      MPI_Exscan( local, exscanResult, 2, MPITrait<uint_t>::type(), MPI_SUM, MPIManager::instance()->comm() );
+      if( MPIManager::instance()->rank() != 0 )
+      {
+         previousBlocks = exscanResult[0];
+         previousBytes  = exscanResult[1];
+      }
+   }
+
+   const uint_t headerSize = ( internal::CHUNKED_BLOCK_DATA_HEADER_ENTRIES + internal::CHUNKED_BLOCK_DATA_INDEX_ENTRIES * totalNumberOfBlocks ) *
+                             uint_c( sizeof( uint_t ) );
+   const uint_t chunksOffset = headerSize + previousBytes;
+
+   for( uint_t i = 0; i != numberOfBlocks; ++i )
+      index[ i * internal::CHUNKED_BLOCK_DATA_INDEX_ENTRIES + 1 ] += chunksOffset;
+
+   uint_t indexOffset = ( internal::CHUNKED_BLOCK_DATA_HEADER_ENTRIES + internal::CHUNKED_BLOCK_DATA_INDEX_ENTRIES * previousBlocks ) *
+                        uint_c( sizeof( uint_t ) );
+
+   if( MPIManager::instance()->rank() == 0 )
+   {
+      index.insert( index.begin(), totalNumberOfBlocks );
+      index.insert( index.begin(), internal::CHUNKED_BLOCK_DATA_FILE_ID );
+      indexOffset = uint_t(0);
+   }
+
+   // store data to file
+
+   WALBERLA_NON_MPI_SECTION()
+   {
+      std::ofstream ofile( file.c_str(), std::ofstream::binary );
+      ofile.write( reinterpret_cast< const char* >( &(index[0]) ), numeric_cast< std::streamsize >( index.size() * sizeof( uint_t ) ) );
+      if( !chunks.empty() )
+         ofile.write( reinterpret_cast< const char* >( &(chunks[0]) ), numeric_cast< std::streamsize >( chunks.size() ) );
+      ofile.close();
+   }
+
+   WALBERLA_MPI_SECTION()
+   {
+      MPI_File mpiFile = MPI_FILE_NULL;
+      int result = MPI_SUCCESS;
+      result = MPI_File_open( MPIManager::instance()->comm(), const_cast<char*>( file.c_str() ), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &mpiFile );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while opening file \"" << file << "\" for writing. MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+      MPI_File_set_size( mpiFile, numeric_cast<MPI_Offset>( headerSize + mpi::allReduce( chunksSize, mpi::SUM, MPIManager::instance()->comm() ) ) );
+
+      result = MPI_File_write_at_all( mpiFile, numeric_cast<MPI_Offset>( indexOffset ), index.empty() ? NULL : reinterpret_cast<char*>( &(index[0]) ),
+                                      int_c( index.size() ), MPITrait< uint_t >::type(), MPI_STATUS_IGNORE );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while writing to file \"" << file << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+      result = MPI_File_write_at_all( mpiFile, numeric_cast<MPI_Offset>( chunksOffset ), chunks.empty() ? NULL : reinterpret_cast<char*>( &(chunks[0]) ),
+                                      int_c( chunks.size() ), MPITrait< uint8_t >::type(), MPI_STATUS_IGNORE );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while writing to file \"" << file << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+      result = MPI_File_close( &mpiFile );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while closing file \"" << file << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+   }
+}
+
+
+
+//**********************************************************************************************************************
+/*!
+*   After registering one/multiple block data handling objects, this function is called for actually adding data to
+*   the blocks by loading the data from a file written by 'saveChunkedBlockData'.
+*   Every process reads the index of the file and then only the chunks of its own blocks (with one collective read
+*   of all byte ranges). The number of processes and the distribution of the blocks may differ from the run that
+*   saved the data, but the file must contain all blocks (with the same block IDs) that require the data.
+*/
+//**********************************************************************************************************************
+BlockDataID BlockStorage::loadChunkedBlockData( const std::string & file, const internal::SelectableBlockDataHandlingWrapper & dataHandling,
+                                                const std::string & identifier )
+{
+   WALBERLA_LOG_PROGRESS( "Adding block data (\"" << identifier << "\"), loading data from chunked file \"" << file << "\" ..." );
+
+   BlockDataID id( blockDataItem_.size() );
+   internal::BlockDataItem item( id, identifier, dataHandling );
+   blockDataItem_.push_back( item );
+
+   // blocks that require the data
+
+   std::vector< IBlock * > blocks;
+   for( auto block = begin(); block != end(); ++block )
+      if( item.getDataHandling( block.get() ) )
+         blocks.push_back( block.get() );
+   std::sort( blocks.begin(), blocks.end(), internal::sortBlocksByID );
+
+   std::map< IBlockID::IDType, uint_t > blockIndex;
+   for( uint_t i = 0; i != blocks.size(); ++i )
+      blockIndex[ blocks[i]->getId().getID() ] = i;
+
+   std::ifstream ifile;
+   MPI_File mpiFile = MPI_FILE_NULL;
+
+   WALBERLA_NON_MPI_SECTION()
+   {
+      ifile.open( file.c_str(), std::ifstream::binary );
+      if( !ifile )
+         WALBERLA_ABORT( "Error while opening file \"" << file << "\" for reading." );
+   }
+
+   WALBERLA_MPI_SECTION()
+   {
+      int result = MPI_File_open( MPIManager::instance()->comm(), const_cast<char*>( file.c_str() ), MPI_MODE_RDONLY, MPI_INFO_NULL, &mpiFile );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while opening file \"" << file << "\" for reading. MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+   }
+
+   // header and index (read by every process)
+
+   std::vector< uint_t > header( internal::CHUNKED_BLOCK_DATA_HEADER_ENTRIES );
+   std::vector< uint_t > index;
+
+   for( uint_t part = 0; part != 2; ++part )
+   {
+      if( part == 1 )
+         index.resize( internal::CHUNKED_BLOCK_DATA_INDEX_ENTRIES * header[1] );
+
+      std::vector< uint_t > & data = ( part == 0 ) ? header : index;
+      const uint_t offset = ( part == 0 ) ? uint_t(0) : internal::CHUNKED_BLOCK_DATA_HEADER_ENTRIES * uint_c( sizeof( uint_t ) );
+
+      WALBERLA_NON_MPI_SECTION()
+      {
+         ifile.seekg( numeric_cast< std::streamoff >( offset ) );
+         if( !data.empty() )
+            ifile.read( reinterpret_cast< char* >( &(data[0]) ), numeric_cast< std::streamsize >( data.size() * sizeof( uint_t ) ) );
+         if( !ifile )
+            WALBERLA_ABORT( "Error while reading from file \"" << file << "\"." );
+      }
+
+      WALBERLA_MPI_SECTION()
+      {
+         int result = MPI_File_read_at_all( mpiFile, numeric_cast<MPI_Offset>( offset ), data.empty() ? NULL : reinterpret_cast<char*>( &(data[0]) ),
+                                            int_c( data.size() ), MPITrait< uint_t >::type(), MPI_STATUS_IGNORE );
+
+         if( result != MPI_SUCCESS )
+            WALBERLA_ABORT( "Error while reading from file \"" << file << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+      }
+
+      if( part == 0 )
+         WALBERLA_CHECK_EQUAL( header[0], internal::CHUNKED_BLOCK_DATA_FILE_ID, "File \"" << file << "\" is not a chunked block data file!" );
+   }
+
+   // chunks of the blocks of this process
+
+   std::vector< uint_t > blockChunk( blocks.size(), header[1] );
+   for( uint_t i = 0; i != header[1]; ++i )
+   {
+      auto block = blockIndex.find( index[ i * internal::CHUNKED_BLOCK_DATA_INDEX_ENTRIES ] );
+      if( block != blockIndex.end() )
+         blockChunk[ block->second ] = i;
+   }
+
+   std::vector< std::pair< uint_t, uint_t > > ranges; // offset and size of all chunks
+   for( uint_t i = 0; i != blocks.size(); ++i )
+   {
+      WALBERLA_CHECK_LESS( blockChunk[i], header[1], "The data of block " << blocks[i]->getId() << " is missing in file \"" << file << "\"!" );
+      const uint_t * entry = &(index[ blockChunk[i] * internal::CHUNKED_BLOCK_DATA_INDEX_ENTRIES ]);
+      ranges.push_back( std::make_pair( entry[1], entry[2] ) );
+   }
+   std::sort( ranges.begin(), ranges.end() );
+
+   // adjacent chunks are merged into one contiguous byte range
+
+   std::vector< std::pair< uint_t, uint_t > > mergedRanges;
+   std::map< uint_t, uint_t > chunkPosition; // position of a chunk (identified by its offset in the file) in 'chunks'
+   uint_t chunksSize( uint_t(0) );
+   for( auto range = ranges.begin(); range != ranges.end(); ++range )
+   {
+      if( !mergedRanges.empty() && mergedRanges.back().first + mergedRanges.back().second == range->first )
+         mergedRanges.back().second += range->second;
+      else
+         mergedRanges.push_back( *range );
+      chunkPosition[ range->first ] = chunksSize;
+      chunksSize += range->second;
+   }
+
+   std::vector< uint8_t > chunks( chunksSize );
+
+   WALBERLA_NON_MPI_SECTION()
+   {
+      uint_t position( uint_t(0) );
+      for( auto range = mergedRanges.begin(); range != mergedRanges.end(); ++range )
+      {
+         ifile.seekg( numeric_cast< std::streamoff >( range->first ) );
+         ifile.read( reinterpret_cast< char* >( &(chunks[position]) ), numeric_cast< std::streamsize >( range->second ) );
+         if( !ifile )
+            WALBERLA_ABORT( "Error while reading from file \"" << file << "\"." );
+         position += range->second;
+      }
+      ifile.close();
+   }
+
+   WALBERLA_MPI_SECTION()
+   {
+      std::vector< int > blocklengths;
+      std::vector< MPI_Aint > displacements;
+      for( auto range = mergedRanges.begin(); range != mergedRanges.end(); ++range )
+      {
+         blocklengths.push_back( int_c( range->second ) );
+         displacements.push_back( numeric_cast< MPI_Aint >( range->first ) );
+      }
+
+      MPI_Datatype filetype;
+      MPI_Type_create_hindexed( int_c( mergedRanges.size() ), blocklengths.empty() ? NULL : &(blocklengths[0]),
+                                displacements.empty() ? NULL : &(displacements[0]), MPITrait< uint8_t >::type(), &filetype );
+      MPI_Type_commit( &filetype );
+
+      int result = MPI_File_set_view( mpiFile, 0, MPITrait< uint8_t >::type(), filetype, const_cast<char*>( "native" ), MPI_INFO_NULL );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Internal MPI-IO error! MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+      result = MPI_File_read_all( mpiFile, chunks.empty() ? NULL : reinterpret_cast<char*>( &(chunks[0]) ), int_c( chunks.size() ),
+                                  MPITrait< uint8_t >::type(), MPI_STATUS_IGNORE );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while reading from file \"" << file << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+      result = MPI_File_close( &mpiFile );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while closing file \"" << file << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+      MPI_Type_free( &filetype );
+   }
+
+   // decompress and deserialize the data of every block
+
+   mpi::RecvBuffer buffer;
+
+   for( uint_t i = 0; i != blocks.size(); ++i )
+   {
+      IBlock * block = blocks[i];
+      const uint_t * entry = &(index[ blockChunk[i] * internal::CHUNKED_BLOCK_DATA_INDEX_ENTRIES ]);
+      const uint8_t * chunk = chunks.empty() ? NULL : &(chunks[ chunkPosition[ entry[1] ] ]);
+
+      buffer.resize( entry[3] / sizeof( mpi::RecvBuffer::ElementType ) );
+      uint8_t * data = reinterpret_cast< uint8_t * >( buffer.ptr() );
+      if( entry[2] < entry[3] )
+         decompress( chunk, entry[2], data, entry[3] );
+      else if( entry[3] > uint_t(0) )
+         std::copy( chunk, chunk + entry[3], data );
+
+      auto dh = item.getDataHandling( block );
+      block->addData( id, dh->deserialize( block ) );
+      dh->deserialize( block, id, buffer );
+   }
+
+   for( auto block = begin(); block != end(); ++block )
+      if( !item.getDataHandling( block.get() ) )
+         block->addData( id, NULL );
+
+   return id;
+}
+
+
+
 //**********************************************************************************************************************
 /*!
 *   Returns a MPI communicator that only contains processes that possess blocks
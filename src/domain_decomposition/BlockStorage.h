@@ -489,6 +489,18 @@ public:
                               const internal::SelectableBlockDataHandlingWrapper & dataHandling, const std::string & identifier = std::string() );
                               
    void saveBlockData( const std::string & file, const BlockDataID & id );
+   void serializeBlockData( const BlockDataID & id, mpi::SendBuffer & buffer );
+
+   template< typename T >
+   inline BlockDataID loadChunkedBlockData( const std::string & file, const shared_ptr< T > & dataHandling,
+                                            const std::string & identifier          = std::string(),
+                                            const Set<SUID> & requiredSelectors     = Set<SUID>::emptySet(),
+                                            const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() );
+
+   BlockDataID loadChunkedBlockData( const std::string & file,
+                                     const internal::SelectableBlockDataHandlingWrapper & dataHandling, const std::string & identifier = std::string() );
+
+   void saveChunkedBlockData( const std::string & file, const BlockDataID & id, const bool compress = true );
    
    inline void clearBlockData( const BlockDataID & id );
 
@@ -707,6 +719,18 @@ inline BlockDataID BlockStorage::loadBlockData( const std::string & file, const
 
 
 
+template< typename T >
+inline BlockDataID BlockStorage::loadChunkedBlockData( const std::string & file, const shared_ptr< T > & dataHandling, const std::string & identifier,
+                                                       const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors )
+{
+   internal::SelectableBlockDataHandlingWrapper sbdhw( walberla::make_shared< internal::BlockDataHandlingHelper<typename T::value_type> >( dataHandling ),
+                                                       requiredSelectors, incompatibleSelectors, identifier );
+
+   return loadChunkedBlockData( file, sbdhw, identifier );
+}
+
+
+
 //**********************************************************************************************************************
 /*!
 *   This function can be used for removing all data that corresponds to block data ID 'id'.
@@ -257,6 +257,16 @@ public:
    { return blockStorage_->loadBlockData( file, dataHandling, identifier, requiredSelectors, incompatibleSelectors ); }
    
    void saveBlockData( const std::string & file, const BlockDataID & id ) { blockStorage_->saveBlockData( file, id ); }
+   void serializeBlockData( const BlockDataID & id, mpi::SendBuffer & buffer ) { blockStorage_->serializeBlockData( id, buffer ); }
+
+   template< typename T >
+   inline BlockDataID loadChunkedBlockData( const std::string & file, const shared_ptr< T > & dataHandling,
+                                            const std::string & identifier          = std::string(),
+                                            const Set<SUID> & requiredSelectors     = Set<SUID>::emptySet(),
+                                            const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() )
+   { return blockStorage_->loadChunkedBlockData( file, dataHandling, identifier, requiredSelectors, incompatibleSelectors ); }
+
+   void saveChunkedBlockData( const std::string & file, const BlockDataID & id, const bool compress = true ) { blockStorage_->saveChunkedBlockData( file, id, compress ); }
    
    void clearBlockData( const BlockDataID & id ) { blockStorage_->clearBlockData(id); }
 
@@ -110,9 +110,10 @@ struct AddToStorage
                            const typename GhostLayerField_T::value_type & initValue, const Layout layout, const uint_t nrOfGhostLayers,
                            const bool /*alwaysInitialize*/, const std::function< void ( GhostLayerField_T * field, IBlock * const block ) > & initFunction,
                            const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors,
-                           const std::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = defaultSize )
+                           const std::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = defaultSize,
+                           const shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > > & alloc = nullptr )
    {
-      auto dataHandling = walberla::make_shared< field::AlwaysInitializeBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize );
+      auto dataHandling = walberla::make_shared< field::AlwaysInitializeBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize, alloc );
       dataHandling->addInitializationFunction( initFunction );
       return blocks->addBlockData( dataHandling, identifier, requiredSelectors, incompatibleSelectors );
    }
@@ -127,16 +128,17 @@ struct AddToStorage< GhostLayerField_T, BlockStorage_T,
                            const typename GhostLayerField_T::value_type & initValue, const Layout layout, const uint_t nrOfGhostLayers,
                            const bool alwaysInitialize, const std::function< void ( GhostLayerField_T * field, IBlock * const block ) > & initFunction,
                            const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors,
-                           const std::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = defaultSize )
+                           const std::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = defaultSize,
+                           const shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > > & alloc = nullptr )
    {
       if( alwaysInitialize )
       {
-         auto dataHandling = walberla::make_shared< field::AlwaysInitializeBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize );
+         auto dataHandling = walberla::make_shared< field::AlwaysInitializeBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize, alloc );
          dataHandling->addInitializationFunction( initFunction );
          return blocks->addBlockData( dataHandling, identifier, requiredSelectors, incompatibleSelectors );
       }
 
-      auto dataHandling = walberla::make_shared< field::DefaultBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize );
+      auto dataHandling = walberla::make_shared< field::DefaultBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize, alloc );
       dataHandling->addInitializationFunction( initFunction );
       return blocks->addBlockData( dataHandling, identifier, requiredSelectors, incompatibleSelectors );
    }
@@ -156,10 +158,12 @@ BlockDataID addToStorage( const shared_ptr< BlockStorage_T > & blocks,
                           const std::function< void ( GhostLayerField_T * field, IBlock * const block ) > & initFunction =
                              std::function< void ( GhostLayerField_T * field, IBlock * const block ) >(),
                           const Set<SUID> & requiredSelectors = Set<SUID>::emptySet(),
-                          const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() )
+                          const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet(),
+                          const shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > > & alloc = nullptr )
 {
    return internal::AddToStorage< GhostLayerField_T, BlockStorage_T >::add( blocks, identifier, initValue, layout, nrOfGhostLayers,
-                                                                            alwaysInitialize, initFunction, requiredSelectors, incompatibleSelectors );
+                                                                            alwaysInitialize, initFunction, requiredSelectors, incompatibleSelectors,
+                                                                            internal::defaultSize, alloc );
 }
 
 
@@ -171,11 +175,12 @@ BlockDataID addToStorage( const shared_ptr< BlockStorage_T > & blocks,
                           const Layout layout,
                           const uint_t nrOfGhostLayers,
                           const bool alwaysInitialize,
-                          const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() )
+                          const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet(),
+                          const shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > > & alloc = nullptr )
 {
    return addToStorage< GhostLayerField_T >( blocks, identifier, initValue, layout, nrOfGhostLayers, alwaysInitialize,
                                              std::function< void ( GhostLayerField_T * field, IBlock * const block ) >(),
-                                             requiredSelectors, incompatibleSelectors );
+                                             requiredSelectors, incompatibleSelectors, alloc );
 }
 
 
@@ -191,11 +196,12 @@ BlockDataID addToStorage( const shared_ptr< BlockStorage_T > & blocks,
                           const std::function< void ( GhostLayerField_T * field, IBlock * const block ) > & initFunction =
                           std::function< void ( GhostLayerField_T * field, IBlock * const block ) >(),
                           const Set<SUID> & requiredSelectors = Set<SUID>::emptySet(),
-                          const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() )
+                          const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet(),
+                          const shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > > & alloc = nullptr )
 {
    return internal::AddToStorage< GhostLayerField_T, BlockStorage_T >::add( blocks, identifier, initValue, layout, nrOfGhostLayers,
                                                                             alwaysInitialize, initFunction, requiredSelectors,
-                                                                            incompatibleSelectors, calculateSize );
+                                                                            incompatibleSelectors, calculateSize, alloc );
 }
 
 
@@ -208,11 +214,12 @@ BlockDataID addToStorage( const shared_ptr< BlockStorage_T > & blocks,
                           const Layout layout,
                           const uint_t nrOfGhostLayers,
                           const bool alwaysInitialize,
-                          const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() )
+                          const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet(),
+                          const shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > > & alloc = nullptr )
 {
-   return addToStorage< GhostLayerField_T >( blocks, identifier, initValue, layout, nrOfGhostLayers, alwaysInitialize,
+   return addToStorage< GhostLayerField_T >( blocks, identifier, calculateSize, initValue, layout, nrOfGhostLayers, alwaysInitialize,
                                              std::function< void ( GhostLayerField_T * field, IBlock * const block ) >(),
-                                             requiredSelectors, incompatibleSelectors, calculateSize );
+                                             requiredSelectors, incompatibleSelectors, alloc );
 }
 
 
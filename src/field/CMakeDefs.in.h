@@ -8,4 +8,3 @@
 #pragma once
 
 #cmakedefine WALBERLA_FIELD_MONITORED_ACCESS
-#cmakedefine WALBERLA_THREAD_SAFE_FIELD_ALLOCATION
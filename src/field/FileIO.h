@@ -26,7 +26,9 @@
 
 #include <domain_decomposition/BlockStorage.h>
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -35,6 +37,36 @@ namespace field {
 
 
 
+//======================================================================================================================
+/*!
+ *  \brief Settings for the collective mode of writeToFile / readFromFile
+ *
+ *  In the collective mode, every process gathers the data of consecutive blocks in one contiguous staging buffer,
+ *  which is then written / read with a single collective MPI-IO call. This allows the MPI library to apply two-phase
+ *  I/O: a few aggregator processes combine the data of all processes into large, aligned file system requests.
+ *  If the data of a process does not fit into the staging buffer, the blocks are processed in several collective
+ *  rounds (a staging buffer size of zero gathers all blocks of a process in one buffer). Every round contains at least
+ *  one block.
+ *
+ *  The number of aggregators and the size of their buffers are passed to the MPI library as MPI_Info hints
+ *  ("cb_nodes" and "cb_buffer_size"). A value of zero leaves the choice to the MPI library.
+ *
+ *  The files are identical to the files written in the default (independent) mode.
+ */
+//======================================================================================================================
+struct CollectiveIO
+{
+   explicit CollectiveIO( const uint_t _aggregators = uint_t(0), const uint_t _bufferSize = uint_t(0),
+                          const uint_t _stagingBufferSize = uint_t(16) * uint_t(1024) * uint_t(1024) ) :
+      aggregators( _aggregators ), bufferSize( _bufferSize ), stagingBufferSize( _stagingBufferSize ) {}
+
+   uint_t aggregators;       ///< number of processes that access the file system
+   uint_t bufferSize;        ///< size of the collective buffer of every aggregator in bytes
+   uint_t stagingBufferSize; ///< maximum size of the staging buffer of every process in bytes
+};
+
+
+
 //======================================================================================================================
 /*!
  *  \brief Writes a field from a BlockStorage to file
@@ -62,6 +94,11 @@ template< typename FieldT >
 void writeToFile( const std::string & filename, const BlockStorage & blockStorage, const BlockDataID & fieldID,
                   const Set<SUID> & requiredSelectors = Set<SUID>::emptySet(), const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() );
 
+/// Writes a field from a BlockStorage to file using a single collective write per process (see CollectiveIO)
+template< typename FieldT >
+void writeToFile( const std::string & filename, const BlockStorage & blockStorage, const BlockDataID & fieldID, const CollectiveIO & collectiveIO,
+                  const Set<SUID> & requiredSelectors = Set<SUID>::emptySet(), const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() );
+
 
 
 //======================================================================================================================
@@ -89,6 +126,11 @@ template< typename FieldT >
 void readFromFile( const std::string & filename, BlockStorage & blockStorage, const BlockDataID & fieldID,
                    const Set<SUID> & requiredSelectors = Set<SUID>::emptySet(), const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() );
 
+/// Reads a field from a file using a single collective read per process (see CollectiveIO)
+template< typename FieldT >
+void readFromFile( const std::string & filename, BlockStorage & blockStorage, const BlockDataID & fieldID, const CollectiveIO & collectiveIO,
+                   const Set<SUID> & requiredSelectors = Set<SUID>::emptySet(), const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() );
+
 
 
 } // namespace walberla
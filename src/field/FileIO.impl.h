@@ -33,7 +33,15 @@ class FieldWriter
 public:
    FieldWriter( const std::string & filename, const BlockDataID & fieldID,
                 const Set<SUID> & requiredSelectors = Set<SUID>::emptySet(), const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() )
-      : filename_( filename ), fieldID_( fieldID ), requiredSelectors_( requiredSelectors ), incompatibleSelectors_( incompatibleSelectors )
+      : filename_( filename ), fieldID_( fieldID ), requiredSelectors_( requiredSelectors ), incompatibleSelectors_( incompatibleSelectors ),
+        collective_( false )
+   {
+   }
+
+   FieldWriter( const std::string & filename, const BlockDataID & fieldID, const CollectiveIO & collectiveIO,
+                const Set<SUID> & requiredSelectors = Set<SUID>::emptySet(), const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() )
+      : filename_( filename ), fieldID_( fieldID ), requiredSelectors_( requiredSelectors ), incompatibleSelectors_( incompatibleSelectors ),
+        collective_( true ), collectiveIO_( collectiveIO )
    {
    }
 
@@ -47,6 +55,12 @@ private:
    void writeToFileNonMPI( const std::vector< const IBlock * > & blocks ) const;
    void readFromFileNonMPI( const std::vector< IBlock * > & blocks ) const;
 
+   void writeToFileCollective( const std::vector< const IBlock * > & blocks, const std::vector< uint_t > & blockOffsets ) const;
+   void readFromFileCollective( const std::vector< IBlock * > & blocks, const std::vector< uint_t > & blockOffsets ) const;
+
+   std::vector< size_t > computeRounds( const std::vector< uint_t > & blockOffsets ) const;
+   MPI_Info createCollectiveInfo( const bool write ) const;
+
    std::vector< uint_t > computeBlockOffsets( const std::vector< const IBlock * > & blocks ) const;
    std::vector< uint_t > computeBlockOffsets( const std::vector< IBlock * > & blocks ) const;
 
@@ -58,6 +72,9 @@ private:
    
    Set<SUID> requiredSelectors_;
    Set<SUID> incompatibleSelectors_;
+
+   bool collective_;
+   CollectiveIO collectiveIO_;
 };
 
 
@@ -78,6 +95,12 @@ void FieldWriter<FieldT>::writeToFile( const BlockStorage & blockStorage ) const
    if( blockOffsets.back() > uint_c( std::numeric_limits<int>::max() ) )
       WALBERLA_ABORT( "writeToFile does not support writing more than " << std::numeric_limits<int>::max() << " field elements per process!" );
 
+   if( collective_ )
+   {
+      writeToFileCollective( blocks, blockOffsets );
+      return;
+   }
+
    const MPI_Offset filesize = numeric_cast<MPI_Offset>( mpi::allReduce( blockOffsets.back(), mpi::SUM, MPIManager::instance()->comm() ) * sizeof( typename FieldT::value_type ) );
 
    MPI_Datatype arraytype;
@@ -148,6 +171,12 @@ void FieldWriter<FieldT>::readFromFile( BlockStorage & blockStorage ) const
    if( blockOffsets.back() > uint_c( std::numeric_limits<int>::max() ) )
       WALBERLA_ABORT( "readFromFile does not support reading more than " << std::numeric_limits<int>::max() << " field elements per process!" );
 
+   if( collective_ )
+   {
+      readFromFileCollective( blocks, blockOffsets );
+      return;
+   }
+
    MPI_Datatype arraytype;
    MPI_Type_contiguous( int_c( blockOffsets.back() ), MPITrait< typename FieldT::value_type >::type(), &arraytype );
    MPI_Type_commit( &arraytype );
@@ -266,6 +295,182 @@ void FieldWriter<FieldT>::readFromFileNonMPI( const std::vector< IBlock * > & bl
 
 
 
+/// Splits the blocks of this process into rounds of consecutive blocks whose data fits into the staging buffer
+/// (every round contains at least one block). The returned vector contains the index of the first block of every
+/// round followed by the number of blocks.
+template< typename FieldT >
+std::vector< size_t > FieldWriter<FieldT>::computeRounds( const std::vector< uint_t > & blockOffsets ) const
+{
+   const uint_t stagingElements = ( collectiveIO_.stagingBufferSize == uint_t(0) ) ? std::numeric_limits< uint_t >::max() :
+                                  std::max( collectiveIO_.stagingBufferSize / uint_c( sizeof( typename FieldT::value_type ) ), uint_t(1) );
+
+   const size_t numBlocks = blockOffsets.size() - size_t(1);
+
+   std::vector< size_t > rounds( 1, size_t(0) );
+   for( size_t blockIdx = 0; blockIdx != numBlocks; ++blockIdx )
+   {
+      if( blockIdx > rounds.back() && blockOffsets[blockIdx + 1] - blockOffsets[ rounds.back() ] > stagingElements )
+         rounds.push_back( blockIdx );
+   }
+   rounds.push_back( numBlocks );
+
+   return rounds;
+}
+
+
+
+template< typename FieldT >
+void FieldWriter<FieldT>::writeToFileCollective( const std::vector< const IBlock * > & blocks, const std::vector< uint_t > & blockOffsets ) const
+{
+   // the data of consecutive blocks is gathered in a staging buffer that is written with a single collective call,
+   // processes with fewer rounds than others participate with empty writes
+
+   const std::vector< size_t > rounds = computeRounds( blockOffsets );
+   const uint_t numRounds = mpi::allReduce( uint_c( rounds.size() - size_t(1) ), mpi::MAX, MPIManager::instance()->comm() );
+
+   uint_t stagingElements( 0 );
+   for( size_t round = 0; round + 1 < rounds.size(); ++round )
+      stagingElements = std::max( stagingElements, blockOffsets[ rounds[round + 1] ] - blockOffsets[ rounds[round] ] );
+
+   std::vector< typename FieldT::value_type > data( stagingElements );
+
+   const MPI_Offset filesize = numeric_cast<MPI_Offset>( mpi::allReduce( blockOffsets.back(), mpi::SUM, MPIManager::instance()->comm() ) * sizeof( typename FieldT::value_type ) );
+   const MPI_Offset offset = computeProcessByteOffset( blockOffsets.back() );
+
+   MPI_Info info = createCollectiveInfo( true );
+
+   MPI_File mpiFile = MPI_FILE_NULL;
+   int result = MPI_SUCCESS;
+   result = MPI_File_open( MPIManager::instance()->comm(), const_cast<char*>( filename_.c_str() ), MPI_MODE_WRONLY | MPI_MODE_CREATE, info, &mpiFile );
+
+   if( result != MPI_SUCCESS )
+      WALBERLA_ABORT( "Error while opening file \"" << filename_ << "\" for writing. MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+   MPI_File_set_size( mpiFile, filesize );
+
+   for( uint_t round = 0; round != numRounds; ++round )
+   {
+      const size_t first = ( round + 1 < rounds.size() ) ? rounds[round] : rounds.back();
+      const size_t last  = ( round + 1 < rounds.size() ) ? rounds[round + 1] : rounds.back();
+
+      auto dataIt = data.begin();
+      for( size_t blockIdx = first; blockIdx != last; ++blockIdx )
+      {
+         const FieldT * field = blocks[blockIdx]->template getData<FieldT>( fieldID_ );
+
+         for( auto fieldIt = field->begin(); fieldIt != field->end(); ++fieldIt, ++dataIt )
+         {
+            WALBERLA_ASSERT( dataIt != data.end() );
+            *dataIt = *fieldIt;
+         }
+      }
+
+      const uint_t count = blockOffsets[last] - blockOffsets[first];
+      WALBERLA_ASSERT( dataIt == data.begin() + numeric_cast< std::ptrdiff_t >( count ) );
+
+      result = MPI_File_write_at_all( mpiFile, offset + numeric_cast<MPI_Offset>( blockOffsets[first] * sizeof( typename FieldT::value_type ) ),
+                                      data.empty() ? NULL : &data[0], int_c( count ), MPITrait<typename FieldT::value_type>::type(), MPI_STATUS_IGNORE );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while writing to file \"" << filename_ << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+   }
+
+   result = MPI_File_close( &mpiFile );
+
+   if( result != MPI_SUCCESS )
+      WALBERLA_ABORT( "Error while closing file \"" << filename_ << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+   MPI_Info_free( &info );
+}
+
+
+
+template< typename FieldT >
+void FieldWriter<FieldT>::readFromFileCollective( const std::vector< IBlock * > & blocks, const std::vector< uint_t > & blockOffsets ) const
+{
+   const std::vector< size_t > rounds = computeRounds( blockOffsets );
+   const uint_t numRounds = mpi::allReduce( uint_c( rounds.size() - size_t(1) ), mpi::MAX, MPIManager::instance()->comm() );
+
+   uint_t stagingElements( 0 );
+   for( size_t round = 0; round + 1 < rounds.size(); ++round )
+      stagingElements = std::max( stagingElements, blockOffsets[ rounds[round + 1] ] - blockOffsets[ rounds[round] ] );
+
+   std::vector< typename FieldT::value_type > data( stagingElements );
+
+   const MPI_Offset offset = computeProcessByteOffset( blockOffsets.back() );
+
+   MPI_Info info = createCollectiveInfo( false );
+
+   MPI_File mpiFile = MPI_FILE_NULL;
+   int result = MPI_SUCCESS;
+   result = MPI_File_open( MPIManager::instance()->comm(), const_cast<char*>( filename_.c_str() ), MPI_MODE_RDONLY, info, &mpiFile );
+
+   if( result != MPI_SUCCESS )
+      WALBERLA_ABORT( "Error while opening file \"" << filename_ << "\" for reading. MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+   for( uint_t round = 0; round != numRounds; ++round )
+   {
+      const size_t first = ( round + 1 < rounds.size() ) ? rounds[round] : rounds.back();
+      const size_t last  = ( round + 1 < rounds.size() ) ? rounds[round + 1] : rounds.back();
+
+      const uint_t count = blockOffsets[last] - blockOffsets[first];
+
+      result = MPI_File_read_at_all( mpiFile, offset + numeric_cast<MPI_Offset>( blockOffsets[first] * sizeof( typename FieldT::value_type ) ),
+                                     data.empty() ? NULL : &data[0], int_c( count ), MPITrait<typename FieldT::value_type>::type(), MPI_STATUS_IGNORE );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while reading from file \"" << filename_ << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+      auto dataIt = data.begin();
+      for( size_t blockIdx = first; blockIdx != last; ++blockIdx )
+      {
+         FieldT * field = blocks[blockIdx]->template getData<FieldT>( fieldID_ );
+
+         for( auto fieldIt = field->begin(); fieldIt != field->end(); ++fieldIt, ++dataIt )
+         {
+            WALBERLA_ASSERT( dataIt != data.end() );
+            *fieldIt = *dataIt;
+         }
+      }
+      WALBERLA_ASSERT( dataIt == data.begin() + numeric_cast< std::ptrdiff_t >( count ) );
+   }
+
+   result = MPI_File_close( &mpiFile );
+
+   if( result != MPI_SUCCESS )
+      WALBERLA_ABORT( "Error while closing file \"" << filename_ << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+   MPI_Info_free( &info );
+}
+
+
+
+/// Hints for two-phase I/O: collective buffering is enabled, aggregator count and buffer size are set if specified
+template< typename FieldT >
+MPI_Info FieldWriter<FieldT>::createCollectiveInfo( const bool write ) const
+{
+   MPI_Info info;
+   MPI_Info_create( &info );
+
+   MPI_Info_set( info, const_cast<char*>( "collective_buffering" ), const_cast<char*>( "true" ) );
+   MPI_Info_set( info, const_cast<char*>( write ? "romio_cb_write" : "romio_cb_read" ), const_cast<char*>( "enable" ) );
+
+   if( collectiveIO_.aggregators > uint_t(0) )
+   {
+      const std::string aggregators = std::to_string( collectiveIO_.aggregators );
+      MPI_Info_set( info, const_cast<char*>( "cb_nodes" ), const_cast<char*>( aggregators.c_str() ) );
+   }
+   if( collectiveIO_.bufferSize > uint_t(0) )
+   {
+      const std::string bufferSize = std::to_string( collectiveIO_.bufferSize );
+      MPI_Info_set( info, const_cast<char*>( "cb_buffer_size" ), const_cast<char*>( bufferSize.c_str() ) );
+   }
+
+   return info;
+}
+
+
+
 template< typename FieldT >
 std::vector< uint_t > FieldWriter<FieldT>::computeBlockOffsets( const std::vector< const IBlock * > & blocks ) const
 {
@@ -336,5 +541,25 @@ void readFromFile( const std::string & filename, BlockStorage & blockStorage, co
    writer.readFromFile( blockStorage );
 }
 
+
+
+template< typename FieldT >
+void writeToFile( const std::string & filename, const BlockStorage & blockStorage, const BlockDataID & fieldID, const CollectiveIO & collectiveIO,
+                  const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors )
+{
+   internal::FieldWriter<FieldT> writer( filename, fieldID, collectiveIO, requiredSelectors, incompatibleSelectors );
+   writer.writeToFile( blockStorage );
+}
+
+
+
+template< typename FieldT >
+void readFromFile( const std::string & filename, BlockStorage & blockStorage, const BlockDataID & fieldID, const CollectiveIO & collectiveIO,
+                   const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors )
+{
+   internal::FieldWriter<FieldT> writer( filename, fieldID, collectiveIO, requiredSelectors, incompatibleSelectors );
+   writer.readFromFile( blockStorage );
+}
+
 } // namespace walberla
 } // namespace field
@@ -23,10 +23,12 @@
 #pragma once
 
 #include "AlignedMalloc.h"
+#include "core/DataTypes.h"
 #include "core/debug/Debug.h"
 #include "field/CMakeDefs.h"
 
-#include <map>
+#include <atomic>
+#include <cstdint>
 #include <new>
 
 
@@ -34,6 +36,21 @@ namespace walberla {
 namespace field {
 
 
+   namespace internal {
+
+      /// Bookkeeping data that is stored directly in front of every memory region that is handed out by a FieldAllocator
+      struct FieldAllocationHeader
+      {
+         FieldAllocationHeader( const uint_t elements ) : referenceCount( uint_t(1) ), nrOfElements( elements ) {}
+
+         std::atomic< uint_t > referenceCount;
+         uint_t                nrOfElements;
+      };
+
+   } // namespace internal
+
+
+
    //*******************************************************************************************************************
    /*! Allocation Strategy base class for fields
    *
@@ -41,6 +58,12 @@ namespace field {
    *
    * The base class handles reference counting, and has purely virtual member functions
    * that have to be implemented by concrete strategy.
+   *
+   * The reference counter (and the number of allocated elements) of every memory region is stored in a small header
+   * directly in front of the memory region. Hence, all operations on the reference counter are lock-free (atomic) and
+   * do not involve any global data structure, i.e., fields can be allocated, cloned, and destroyed concurrently from
+   * different threads. Every implementation of 'allocateMemory' must therefore reserve (at least) headerSize() bytes
+   * directly in front of the memory it returns - these bytes are initialized and used by the base class.
    */
    //*******************************************************************************************************************
    template<typename T>
@@ -48,6 +71,8 @@ namespace field {
    {
       public:
 
+         virtual ~FieldAllocator() {}
+
          /**
           * \brief Allocate memory for a field of given sizes and initializes reference counter with one
           *
@@ -63,15 +88,7 @@ namespace field {
                          uint_t & allocSize1, uint_t & allocSize2, uint_t & allocSize3)
          {
             T * mem = allocateMemory(size0,size1,size2,size3,allocSize1,allocSize2,allocSize3);
-            #ifdef WALBERLA_THREAD_SAFE_FIELD_ALLOCATION
-            #ifdef _OPENMP
-            #pragma omp critical( walberla_field_allocator_refcount )
-            #endif
-            #endif
-            {
-               WALBERLA_ASSERT( referenceCounts_.find(mem) == referenceCounts_.end() || referenceCounts_[mem] == 0 );
-               referenceCounts_[mem] = 1;
-            }
+            new ( header( mem ) ) internal::FieldAllocationHeader( size0 * allocSize1 * allocSize2 * allocSize3 );
             return mem;
          }
 
@@ -87,16 +104,7 @@ namespace field {
          T * allocate ( uint_t allocSize )
          {
             T * mem = allocateMemory( allocSize );
-            
-            #ifdef WALBERLA_THREAD_SAFE_FIELD_ALLOCATION
-            #ifdef _OPENMP
-            #pragma omp critical( walberla_field_allocator_refcount )
-            #endif
-            #endif
-            {
-               WALBERLA_ASSERT( referenceCounts_.find(mem) == referenceCounts_.end() || referenceCounts_[mem] == 0 );
-               referenceCounts_[mem] = 1;
-            }
+            new ( header( mem ) ) internal::FieldAllocationHeader( allocSize );
             return mem;
          }
 
@@ -110,16 +118,11 @@ namespace field {
           */
          void incrementReferenceCount( T * mem )
          {
-            #ifdef WALBERLA_THREAD_SAFE_FIELD_ALLOCATION
-            #ifdef _OPENMP
-            #pragma omp critical( walberla_field_allocator_refcount )
-            #endif
-            #endif
-            {
-               WALBERLA_ASSERT( referenceCounts_.find(mem) != referenceCounts_.end() );
-               WALBERLA_ASSERT_GREATER( referenceCounts_[mem], 0 );
-               referenceCounts_[mem]++;
-            }
+            WALBERLA_ASSERT_NOT_NULLPTR( mem );
+            WALBERLA_ASSERT_GREATER( header( mem )->referenceCount.load( std::memory_order_relaxed ), 0 );
+
+            // a new reference can only be created from an existing one -> no ordering constraints
+            header( mem )->referenceCount.fetch_add( uint_t(1), std::memory_order_relaxed );
          }
 
 
@@ -134,50 +137,34 @@ namespace field {
           */
          bool decrementReferenceCount( T * mem )
          {
-            bool memoryFreed = false;
-            
-            uint_t refCount = 0;
-
-            #ifdef WALBERLA_THREAD_SAFE_FIELD_ALLOCATION
-            #ifdef _OPENMP
-            #pragma omp critical( walberla_field_allocator_refcount )
-            #endif
-            #endif
-            {
-               WALBERLA_ASSERT( referenceCounts_.find(mem) != referenceCounts_.end() );
-               WALBERLA_ASSERT_GREATER( referenceCounts_[mem], 0 );
-
-               refCount = --referenceCounts_[mem];
-            }
+            WALBERLA_ASSERT_NOT_NULLPTR( mem );
+            WALBERLA_ASSERT_GREATER( header( mem )->referenceCount.load( std::memory_order_relaxed ), 0 );
 
-            if( refCount == 0 ) {
+            // acquire/release: all accesses of other owners happen before the memory is freed by the last owner
+            if( header( mem )->referenceCount.fetch_sub( uint_t(1), std::memory_order_acq_rel ) == uint_t(1) )
+            {
                deallocate( mem );
-               memoryFreed = true;
+               return true;
             }
-            
-            return memoryFreed;
+
+            return false;
          }
 
 
          uint_t referenceCount ( T * mem ) const
          {
-            uint_t refCount = 0;
-            #ifdef WALBERLA_THREAD_SAFE_FIELD_ALLOCATION
-            #ifdef _OPENMP
-            #pragma omp critical( walberla_field_allocator_refcount )
-            #endif
-            #endif
-            {
-               WALBERLA_ASSERT( referenceCounts_.find(mem) != referenceCounts_.end()  );
-               refCount = referenceCounts_[mem];
-            }
-            
-            return refCount;
+            WALBERLA_ASSERT_NOT_NULLPTR( mem );
+            return header( mem )->referenceCount.load( std::memory_order_acquire );
          }
 
+         /// Number of bytes that every implementation of 'allocateMemory' has to reserve in front of the returned memory
+         static uint_t headerSize() { return uint_t(64); }
+
       protected:
          /**
           * \brief Same as allocated, without handling of reference counter
+          *
+          * The returned pointer must be preceded by (at least) headerSize() bytes of unused memory.
           */
          virtual T * allocateMemory (  uint_t size0, uint_t size1, uint_t size2, uint_t size3,
                                        uint_t & allocSize1, uint_t & allocSize2, uint_t & allocSize3 ) = 0;
@@ -185,6 +172,8 @@ namespace field {
 
          /**
           * \brief Same as allocated, without handling of reference counter
+          *
+          * The returned pointer must be preceded by (at least) headerSize() bytes of unused memory.
           */
          virtual T * allocateMemory ( uint_t size ) = 0;
 
@@ -195,13 +184,22 @@ namespace field {
           */
          virtual void deallocate( T *& values ) = 0;
 
+         /// Number of elements of type T of a memory region that has been allocated using allocate() (can be used in 'deallocate')
+         static uint_t nrOfElements( T * mem ) { return header( mem )->nrOfElements; }
+
       private:
-         static std::map<T*, uint_t> referenceCounts_;
 
-   };
+         /// The header is placed at the last suitably aligned address in front of 'mem' that provides enough space.
+         static internal::FieldAllocationHeader * header( T * mem )
+         {
+            const std::uintptr_t address = ( reinterpret_cast< std::uintptr_t >( mem ) - sizeof( internal::FieldAllocationHeader ) ) &
+                                           ~( std::uintptr_t( alignof( internal::FieldAllocationHeader ) ) - std::uintptr_t(1) );
+            return reinterpret_cast< internal::FieldAllocationHeader * >( address );
+         }
 
-   template<typename T>
-   std::map<T*, uint_t> FieldAllocator<T>::referenceCounts_ = std::map<T*,uint_t>();
+         static_assert( sizeof( internal::FieldAllocationHeader ) + alignof( internal::FieldAllocationHeader ) <= 64,
+                        "The header does not fit into the memory that is reserved in front of each allocation!" );
+   };
 
 
 
@@ -240,21 +238,18 @@ namespace field {
 
          virtual T * allocateMemory (  uint_t size )
          {
-            void * ptr = aligned_malloc_with_offset(size * sizeof(T), alignment, offset_ % alignment );
+            const uint_t headerSize = FieldAllocator<T>::headerSize();
+
+            void * ptr = aligned_malloc_with_offset( headerSize + size * sizeof(T), alignment, ( headerSize + offset_ ) % alignment );
             if(!ptr)
                throw std::bad_alloc();
 
-            // placement new
-            new (ptr) T[ size ];
+            T * ret = reinterpret_cast<T*>( static_cast<char*>( ptr ) + headerSize );
 
-            T * ret = reinterpret_cast<T*>( ptr );
+            // placement new
+            for( uint_t i = 0; i < size; ++i )
+               new (ret + i) T;
 
-            #ifdef _OPENMP
-            #pragma omp critical( walberla_field_aligned_allocator_nrOfElements )
-            #endif
-            {
-               nrOfElements_[ret] = size;
-            }
             return ret;
          }
 
@@ -264,46 +259,26 @@ namespace field {
 
          virtual void deallocate(T *& values )
          {
-            WALBERLA_ASSERT ( nrOfElements_.find(values) != nrOfElements_.end() );
-
-            size_t nrOfValues = 0;
-
-            #ifdef _OPENMP
-            #pragma omp critical( walberla_field_aligned_allocator_nrOfElements )
-            #endif
-            {
-               nrOfValues = nrOfElements_[values];
-            }
+            const uint_t nrOfValues = FieldAllocator<T>::nrOfElements( values );
 
             for( uint_t i = 0; i < nrOfValues; ++i )
                values[i].~T();
 
-            #ifdef _OPENMP
-            #pragma omp critical( walberla_field_aligned_allocator_nrOfElements )
-            #endif
-            {
-               nrOfElements_.erase( values );
-            }
-
-            aligned_free(values);
+            aligned_free( reinterpret_cast<char*>( values ) - FieldAllocator<T>::headerSize() );
+            values = 0;
          }
 
          static_assert(alignment > 0, "Use StdFieldAlloc");
          static_assert(!(alignment & (alignment - 1)) , "Alignment has to be power of 2");
 
-      private:
-         /// Nr of elements per allocated pointer has to be stored to call the destructor on each element
-         static std::map<T*, uint_t> nrOfElements_;
-
-         uint_t offset_;
+         /// the element at position 'offset_' (in bytes) of each allocation is aligned (= first inner cell)
+         uint_t offset_ = uint_t(0);
    };
-   template <typename T, uint_t alignment>
-   std::map<T*,uint_t> AllocateAligned<T,alignment>::nrOfElements_ = std::map<T*,uint_t>();
 
 
 
    /****************************************************************************************************************//**
-   *  Allocator without alignment using new and delete[]
+   *  Allocator without additional alignment (only the alignment of T is respected)
    *
    * \ingroup field
    *
@@ -318,18 +293,34 @@ namespace field {
             allocSize1=size1;
             allocSize2=size2;
             allocSize3=size3;
-            return new T[size0*size1*size2*size3];
+            return allocateMemory( size0*size1*size2*size3 );
          }
 
          virtual T * allocateMemory ( uint_t size )
          {
-            return new T[size];
+            const uint_t headerSize = FieldAllocator<T>::headerSize();
+
+            // the header must not break the alignment of T (which may exceed the alignment of 'new')
+            void * ptr = aligned_malloc_with_offset( headerSize + size * sizeof(T), alignment, headerSize % alignment );
+            if(!ptr)
+               throw std::bad_alloc();
+
+            T * ret = reinterpret_cast<T*>( static_cast<char*>( ptr ) + headerSize );
+            for( uint_t i = 0; i < size; ++i )
+               new (ret + i) T;
+            return ret;
          }
 
          virtual void deallocate(T *& values) {
-            delete[] values;
+            const uint_t nrOfValues = FieldAllocator<T>::nrOfElements( values );
+            for( uint_t i = 0; i < nrOfValues; ++i )
+               values[i].~T();
+            aligned_free( reinterpret_cast<char*>( values ) - FieldAllocator<T>::headerSize() );
             values = 0;
          }
+
+      private:
+         static const uint_t alignment = alignof(T) > uint_t(64) ? uint_t( alignof(T) ) : uint_t(64);
    };
 
 
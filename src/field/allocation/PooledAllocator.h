@@ -0,0 +1,263 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file PooledAllocator.h
+//! \ingroup field
+//! \brief Aligned field allocator that recycles freed memory (e.g. across BlockForest::refresh() cycles)
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "FieldAllocator.h"
+
+#include "core/DataTypes.h"
+#include "core/OpenMP.h"
+#include "core/debug/Debug.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <new>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+
+namespace walberla {
+namespace field {
+
+
+   /****************************************************************************************************************//**
+   * Aligned allocation strategy for fields that keeps freed memory in a pool and reuses it for later allocations
+   *
+   * \ingroup field
+   *
+   * During dynamic refinement / load balancing (BlockForest::refresh()), all fields of migrated, split, or merged blocks
+   * are destroyed and allocated again. With this allocator, the memory of destroyed fields is not returned to the
+   * operating system, but kept in a pool and handed out again for the next allocation of the same size class. This
+   * avoids the cost of malloc/free and - more importantly - of the page faults of freshly allocated memory.
+   *
+   * The pool is organized in size classes: every request is rounded up to the next size class (the waste is at most
+   * 1/8 of the requested size) and all buffers of a size class (and alignment offset) are interchangeable. The data
+   * layout is identical to AllocateAligned< T, alignment >.
+   *
+   * If 'firstTouch' is enabled, memory that is freshly allocated from the operating system is touched page by page
+   * before it is handed out - in parallel with a static OpenMP schedule if the allocation happens outside of a parallel
+   * region, otherwise by the allocating thread. Recycled memory keeps its (already established) page placement.
+   *
+   * One allocator object can (and should) be shared by all fields of the same type, e.g. by passing it to
+   * field::addToStorage. Fields keep their allocator alive, so the pool is freed once all fields that use it are
+   * destroyed (or explicitly with 'release()'). Hit rate and pool size can be queried at any time (see operator<<).
+   *
+   * Fields may be allocated and destroyed concurrently from different threads, with one restriction inherited from
+   * AllocateAligned: the alignment offset is allocator state that each field sets (setInnerGhostLayerSize) right before
+   * its allocation, so fields that are allocated concurrently must have the same number of inner ghost layers (as all
+   * fields of one type usually do). The statistics are individual atomic counters - values read while other threads
+   * allocate are not a consistent snapshot.
+   *
+   * Template parameters:
+   *  - T          type that is stored in field
+   *  - alignment  see AllocateAligned
+   ********************************************************************************************************************/
+   template <typename T, uint_t alignment = uint_t(64)>
+   class PooledAllocator : public AllocateAligned<T,alignment>
+   {
+      public:
+
+         /**
+          * \param maxPoolSize  upper limit (in bytes) for the memory that is kept in the pool, memory that is freed
+          *                     while the pool is full is returned to the operating system
+          * \param firstTouch   touch freshly allocated memory (see class documentation)
+          */
+         PooledAllocator( const uint_t maxPoolSize = std::numeric_limits< uint_t >::max(), const bool firstTouch = true ) :
+            maxPoolSize_( maxPoolSize ), firstTouch_( firstTouch ),
+            hits_( uint_t(0) ), misses_( uint_t(0) ), pooledBytes_( uint_t(0) ), pooledBuffers_( uint_t(0) ) {}
+
+         virtual ~PooledAllocator() { release(); }
+
+         /// frees all memory that is currently kept in the pool (memory that is still in use by fields is not affected)
+         void release()
+         {
+            #ifdef _OPENMP
+            #pragma omp critical (walberla_field_pooled_allocator)
+            #endif
+            {
+               for( auto sizeClass = pool_.begin(); sizeClass != pool_.end(); ++sizeClass )
+                  for( auto buffer = sizeClass->second.begin(); buffer != sizeClass->second.end(); ++buffer )
+                     aligned_free( *buffer );
+               pool_.clear();
+               pooledBytes_   = uint_t(0);
+               pooledBuffers_ = uint_t(0);
+            }
+         }
+
+         /// number of allocations that were served from the pool
+         uint_t hits() const { return hits_; }
+         /// number of allocations that required new memory from the operating system
+         uint_t misses() const { return misses_; }
+         /// fraction of all allocations that were served from the pool (0 if nothing has been allocated yet)
+         double hitRate() const
+         {
+            const uint_t hits = hits_;
+            const uint_t allocations = hits + misses_;
+            return ( allocations == uint_t(0) ) ? 0.0 : double( hits ) / double( allocations );
+         }
+
+         /// memory (in bytes) that is currently kept in the pool
+         uint_t pooledBytes() const { return pooledBytes_; }
+         /// number of buffers that are currently kept in the pool
+         uint_t pooledBuffers() const { return pooledBuffers_; }
+
+         /// size class (in bytes) that a request for 'bytes' bytes is rounded up to
+         static uint_t sizeClass( const uint_t bytes )
+         {
+            if( bytes <= uint_t(64) )
+               return uint_t(64);
+
+            uint_t step( 1 ); // 2^( floor( log2( bytes ) ) - 3 )
+            while( ( step << 4 ) <= bytes )
+               step <<= 1;
+
+            return ( ( bytes + step - uint_t(1) ) / step ) * step;
+         }
+
+      protected:
+
+         using AllocateAligned<T,alignment>::allocateMemory;
+
+         virtual T * allocateMemory (  uint_t size )
+         {
+            const uint_t headerSize = FieldAllocator<T>::headerSize();
+            const Key key( sizeClass( size * sizeof(T) ), ( headerSize + this->offset_ ) % alignment );
+
+            void * ptr = NULL;
+
+            #ifdef _OPENMP
+            #pragma omp critical (walberla_field_pooled_allocator)
+            #endif
+            {
+               auto sizeClass = pool_.find( key );
+               if( sizeClass != pool_.end() && !sizeClass->second.empty() )
+               {
+                  ptr = sizeClass->second.back();
+                  sizeClass->second.pop_back();
+                  pooledBytes_ -= key.first;
+                  --pooledBuffers_;
+                  ++hits_;
+               }
+               else
+               {
+                  ++misses_;
+               }
+            }
+
+            if( ptr == NULL )
+            {
+               ptr = aligned_malloc_with_offset( headerSize + key.first, alignment, key.second );
+               if(!ptr)
+                  throw std::bad_alloc();
+               if( firstTouch_ )
+                  touch( static_cast<char*>( ptr ) + headerSize, key.first );
+            }
+
+            T * ret = reinterpret_cast<T*>( static_cast<char*>( ptr ) + headerSize );
+
+            // placement new
+            for( uint_t i = 0; i < size; ++i )
+               new (ret + i) T;
+
+            return ret;
+         }
+
+         virtual void deallocate( T *& values )
+         {
+            const uint_t headerSize = FieldAllocator<T>::headerSize();
+            const uint_t nrOfValues = FieldAllocator<T>::nrOfElements( values );
+
+            for( uint_t i = 0; i < nrOfValues; ++i )
+               values[i].~T();
+
+            void * ptr = reinterpret_cast<char*>( values ) - headerSize;
+
+            // the alignment offset is a property of the address, it does not depend on the current inner ghost layer size
+            const uint_t offset = ( alignment - uint_c( reinterpret_cast< std::uintptr_t >( ptr ) % alignment ) ) % alignment;
+            const Key key( sizeClass( nrOfValues * sizeof(T) ), offset );
+
+            bool pooled = false;
+
+            #ifdef _OPENMP
+            #pragma omp critical (walberla_field_pooled_allocator)
+            #endif
+            {
+               if( key.first <= maxPoolSize_ - pooledBytes_ )
+               {
+                  pool_[ key ].push_back( ptr );
+                  pooledBytes_ += key.first;
+                  ++pooledBuffers_;
+                  pooled = true;
+               }
+            }
+
+            if( !pooled )
+               aligned_free( ptr );
+            values = 0;
+         }
+
+      private:
+
+         /// size class (in bytes) + alignment offset of the pointer returned by aligned_malloc_with_offset
+         typedef std::pair< uint_t, uint_t > Key;
+
+         /// page size that is assumed for first-touch
+         static uint_t pageSize() { return uint_t(4096); }
+
+         static void touch( char * const memory, const uint_t bytes )
+         {
+            const int64_t pages = int64_c( ( bytes + pageSize() - uint_t(1) ) / pageSize() );
+
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(static) if( !omp_in_parallel() )
+            #endif
+            for( int64_t page = 0; page < pages; ++page )
+               memory[ uint_c( page ) * pageSize() ] = char(0);
+         }
+
+         const uint_t maxPoolSize_;
+         const bool   firstTouch_;
+
+         std::map< Key, std::vector< void * > > pool_;
+
+         std::atomic< uint_t > hits_;
+         std::atomic< uint_t > misses_;
+         std::atomic< uint_t > pooledBytes_;
+         std::atomic< uint_t > pooledBuffers_;
+   };
+
+
+
+   template <typename T, uint_t alignment>
+   inline std::ostream & operator<<( std::ostream & os, const PooledAllocator<T,alignment> & allocator )
+   {
+      os << "pooled field allocator: " << allocator.hits() << " hits, " << allocator.misses() << " misses (hit rate: "
+         << ( 100.0 * allocator.hitRate() ) << " %), " << allocator.pooledBuffers() << " buffers / "
+         << allocator.pooledBytes() << " bytes in pool";
+      return os;
+   }
+
+
+} // namespace field
+} // namespace walberla
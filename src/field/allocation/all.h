@@ -24,3 +24,4 @@
 
 #include "AlignedMalloc.h"
 #include "FieldAllocator.h"
+#include "PooledAllocator.h"
@@ -0,0 +1,133 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InPlaceNoSlip.h
+//! \ingroup lbm
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "lbm/field/PdfField.h"
+#include "lbm/sweeps/InPlaceTimeStep.h"
+
+#include "boundary/Boundary.h"
+
+#include "core/DataTypes.h"
+#include "core/cell/CellInterval.h"
+#include "core/config/Config.h"
+#include "core/debug/Debug.h"
+
+#include "field/FlagField.h"
+
+#include "stencil/Directions.h"
+
+#include <vector>
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief No slip boundary condition for PDF fields that are updated in-place with the AA pattern (see lbm::InPlaceSweep)
+*
+*   After an even time step, the post-collision value of direction 'dir' of the fluid cell is stored in the slot of
+*   the inverse direction of the same cell and is copied to slot 'dir' of the boundary cell (this is where the odd
+*   kernel of the fluid cell gathers its PDF from).
+*   After an odd time step, the post-collision value has been pushed to slot 'dir' of the boundary cell and is copied
+*   back to the slot of the inverse direction of the fluid cell (this is where the even kernel reads its PDF from).
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T, typename flag_t >
+class InPlaceNoSlip : public Boundary<flag_t>
+{
+protected:
+
+   typedef PdfField< LatticeModel_T >        PDFField;
+   typedef typename LatticeModel_T::Stencil  Stencil;
+
+public:
+
+   static const bool threadsafe = true;
+
+   static shared_ptr<BoundaryConfiguration> createConfiguration( const Config::BlockHandle& /*config*/ )
+      { return make_shared<BoundaryConfiguration>(); }
+
+
+
+   InPlaceNoSlip( const BoundaryUID& boundaryUID, const FlagUID& uid, PDFField* const pdfField, const shared_ptr< InPlaceTimeStep > & timeStep ) :
+      Boundary<flag_t>( boundaryUID ), uid_( uid ), pdfField_( pdfField ), timeStep_( timeStep )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( pdfField_ );
+      WALBERLA_ASSERT_NOT_NULLPTR( timeStep_ );
+   }
+
+   void pushFlags( std::vector< FlagUID >& uids ) const { uids.push_back( uid_ ); }
+
+   void beforeBoundaryTreatment() const {}
+   void  afterBoundaryTreatment() const {}
+
+   template< typename Buffer_T >
+   void packCell( Buffer_T &, const cell_idx_t, const cell_idx_t, const cell_idx_t ) const {}
+
+   template< typename Buffer_T >
+   void registerCell( Buffer_T &, const flag_t, const cell_idx_t, const cell_idx_t, const cell_idx_t ) {}
+
+   void registerCell( const flag_t, const cell_idx_t, const cell_idx_t, const cell_idx_t, const BoundaryConfiguration& ) {}
+   void registerCells( const flag_t, const CellInterval&, const BoundaryConfiguration& ) {}
+   template< typename CellIterator >
+   void registerCells( const flag_t, const CellIterator&, const CellIterator&, const BoundaryConfiguration& ) {}
+
+   void unregisterCell( const flag_t, const cell_idx_t, const cell_idx_t, const cell_idx_t ) const {}
+
+#ifndef NDEBUG
+   inline void treatDirection( const cell_idx_t  x, const cell_idx_t  y, const cell_idx_t  z, const stencil::Direction dir,
+                               const cell_idx_t nx, const cell_idx_t ny, const cell_idx_t nz, const flag_t mask )
+#else
+   inline void treatDirection( const cell_idx_t  x, const cell_idx_t  y, const cell_idx_t  z, const stencil::Direction dir,
+                               const cell_idx_t nx, const cell_idx_t ny, const cell_idx_t nz, const flag_t /*mask*/ )
+#endif
+   {
+      WALBERLA_ASSERT_EQUAL( nx, x + cell_idx_c( stencil::cx[ dir ] ) );
+      WALBERLA_ASSERT_EQUAL( ny, y + cell_idx_c( stencil::cy[ dir ] ) );
+      WALBERLA_ASSERT_EQUAL( nz, z + cell_idx_c( stencil::cz[ dir ] ) );
+      WALBERLA_ASSERT_UNEQUAL( mask & this->mask_, numeric_cast<flag_t>(0) );
+      WALBERLA_ASSERT_EQUAL( mask & this->mask_, this->mask_ ); // only true if "this->mask_" only contains one single flag, which is the case for the
+                                                                // current implementation of this boundary condition (InPlaceNoSlip)
+
+      if( timeStep_->isOdd() ) // last time step was even
+         pdfField_->get( nx, ny, nz, Stencil::idx[dir] ) = pdfField_->get( x, y, z, Stencil::invDirIdx(dir) );
+      else
+         pdfField_->get( x, y, z, Stencil::invDirIdx(dir) ) = pdfField_->get( nx, ny, nz, Stencil::idx[dir] );
+   }
+
+private:
+
+   const FlagUID uid_;
+
+   PDFField* const pdfField_;
+
+   shared_ptr< InPlaceTimeStep > timeStep_;
+
+}; // class InPlaceNoSlip
+
+
+
+} // namespace lbm
+} // namespace walberla
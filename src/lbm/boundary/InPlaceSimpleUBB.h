@@ -0,0 +1,162 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InPlaceSimpleUBB.h
+//! \ingroup lbm
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "lbm/field/PdfField.h"
+#include "lbm/sweeps/InPlaceTimeStep.h"
+
+#include "boundary/Boundary.h"
+
+#include "core/DataTypes.h"
+#include "core/cell/CellInterval.h"
+#include "core/config/Config.h"
+#include "core/debug/Debug.h"
+#include "core/math/Vector3.h"
+
+#include "field/FlagUID.h"
+
+#include "stencil/Directions.h"
+
+#include <vector>
+
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Velocity bounce back boundary condition (constant velocity) for PDF fields that are updated in-place with
+*          the AA pattern (see lbm::InPlaceSweep and lbm::InPlaceNoSlip)
+*
+*   For compressible lattice models, the density of the fluid cell is required. After an even time step, it is the sum
+*   of all PDFs of the cell. After an odd time step, the post-collision values of the fluid cell have been pushed to
+*   its neighbors, so the density is gathered from slot 'f' of the neighbor at x + c_f.
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T, typename flag_t >
+class InPlaceSimpleUBB : public Boundary<flag_t>
+{
+   typedef PdfField< LatticeModel_T >        PDFField;
+   typedef typename LatticeModel_T::Stencil  Stencil;
+
+public:
+
+   static const bool threadsafe = true;
+
+   static shared_ptr<BoundaryConfiguration> createConfiguration( const Config::BlockHandle& /*config*/ )
+      { return make_shared<BoundaryConfiguration>(); }
+
+
+
+   InPlaceSimpleUBB( const BoundaryUID& boundaryUID, const FlagUID& uid, PDFField* const pdfField, const shared_ptr< InPlaceTimeStep > & timeStep,
+                     const Vector3< real_t > & velocity ) :
+      Boundary<flag_t>( boundaryUID ), uid_( uid ), pdfField_( pdfField ), timeStep_( timeStep ), velocity_( velocity )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( pdfField_ );
+      WALBERLA_ASSERT_NOT_NULLPTR( timeStep_ );
+   }
+
+   InPlaceSimpleUBB( const BoundaryUID& boundaryUID, const FlagUID& uid, PDFField* const pdfField, const shared_ptr< InPlaceTimeStep > & timeStep,
+                     const real_t x, const real_t y, const real_t z ) :
+      Boundary<flag_t>( boundaryUID ), uid_( uid ), pdfField_( pdfField ), timeStep_( timeStep ), velocity_( x, y, z )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( pdfField_ );
+      WALBERLA_ASSERT_NOT_NULLPTR( timeStep_ );
+   }
+
+   void pushFlags( std::vector< FlagUID >& uids ) const { uids.push_back( uid_ ); }
+
+   void beforeBoundaryTreatment() const {}
+   void  afterBoundaryTreatment() const {}
+
+   template< typename Buffer_T >
+   void packCell( Buffer_T &, const cell_idx_t, const cell_idx_t, const cell_idx_t ) const {}
+
+   template< typename Buffer_T >
+   void registerCell( Buffer_T &, const flag_t, const cell_idx_t, const cell_idx_t, const cell_idx_t ) {}
+
+   void registerCell( const flag_t, const cell_idx_t, const cell_idx_t, const cell_idx_t, const BoundaryConfiguration& ) {}
+   void registerCells( const flag_t, const CellInterval&, const BoundaryConfiguration& ) const {}
+   template< typename CellIterator >
+   void registerCells( const flag_t, const CellIterator&, const CellIterator&, const BoundaryConfiguration& ) const {}
+
+   void unregisterCell( const flag_t, const cell_idx_t, const cell_idx_t, const cell_idx_t ) const {}
+
+#ifndef NDEBUG
+   inline void treatDirection( const cell_idx_t  x, const cell_idx_t  y, const cell_idx_t  z, const stencil::Direction dir,
+                               const cell_idx_t nx, const cell_idx_t ny, const cell_idx_t nz, const flag_t mask )
+#else
+   inline void treatDirection( const cell_idx_t  x, const cell_idx_t  y, const cell_idx_t  z, const stencil::Direction dir,
+                               const cell_idx_t nx, const cell_idx_t ny, const cell_idx_t nz, const flag_t /*mask*/ )
+#endif
+   {
+      WALBERLA_ASSERT_EQUAL( nx, x + cell_idx_c( stencil::cx[ dir ] ) );
+      WALBERLA_ASSERT_EQUAL( ny, y + cell_idx_c( stencil::cy[ dir ] ) );
+      WALBERLA_ASSERT_EQUAL( nz, z + cell_idx_c( stencil::cz[ dir ] ) );
+      WALBERLA_ASSERT_UNEQUAL( mask & this->mask_, numeric_cast<flag_t>(0) );
+      WALBERLA_ASSERT_EQUAL( mask & this->mask_, this->mask_ ); // only true if "this->mask_" only contains one single flag, which is the case for the
+                                                                // current implementation of this boundary condition (InPlaceSimpleUBB)
+
+      const bool lastStepWasEven = timeStep_->isOdd();
+
+      const real_t density = LatticeModel_T::compressible ? ( lastStepWasEven ? pdfField_->getDensity(x,y,z) : pushedDensity(x,y,z) ) : real_t(1);
+
+      const real_t delta = real_c(6) * density * real_c(LatticeModel_T::w[ Stencil::idx[dir] ]) *
+                           ( real_c(stencil::cx[ dir ]) * velocity_[0] +
+                             real_c(stencil::cy[ dir ]) * velocity_[1] +
+                             real_c(stencil::cz[ dir ]) * velocity_[2] );
+
+      if( lastStepWasEven )
+         pdfField_->get( nx, ny, nz, Stencil::idx[dir] ) = pdfField_->get( x, y, z, Stencil::invDirIdx(dir) ) - delta;
+      else
+         pdfField_->get( x, y, z, Stencil::invDirIdx(dir) ) = pdfField_->get( nx, ny, nz, Stencil::idx[dir] ) - delta;
+   }
+
+private:
+
+   real_t pushedDensity( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const
+   {
+      real_t rho = real_t(0);
+      for( auto d = Stencil::begin(); d != Stencil::end(); ++d )
+         rho += pdfField_->get( x + d.cx(), y + d.cy(), z + d.cz(), d.toIdx() );
+      return rho;
+   }
+
+
+
+   const FlagUID uid_;
+
+   PDFField* const pdfField_;
+
+   shared_ptr< InPlaceTimeStep > timeStep_;
+
+   const Vector3< real_t > velocity_;
+
+}; // class InPlaceSimpleUBB
+
+
+
+} // namespace lbm
+} // namespace walberla
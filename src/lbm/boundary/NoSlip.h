@@ -42,12 +42,14 @@ namespace lbm {
 
 
 
-template< typename LatticeModel_T, typename flag_t >
+// 'Field_T' may be any PDF field type (e.g. MixedPrecisionPdfField): PDFs are only copied, and since w_i == w_inv(i), this is
+// also correct for fields that store their PDFs shifted by the lattice weights.
+template< typename LatticeModel_T, typename flag_t, typename Field_T = PdfField< LatticeModel_T > >
 class NoSlip : public Boundary<flag_t>
 {
 protected:
 
-   typedef PdfField< LatticeModel_T >        PDFField;
+   typedef Field_T                           PDFField;
    typedef typename LatticeModel_T::Stencil  Stencil;
 
 public:
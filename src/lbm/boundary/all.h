@@ -28,6 +28,8 @@
 #include "DynamicUBB.h"
 #include "FreeDiffusion.h"
 #include "FreeSlip.h"
+#include "InPlaceNoSlip.h"
+#include "InPlaceSimpleUBB.h"
 #include "NoDiffusion.h"
 #include "NoSlip.h"
 #include "Outlet.h"
@@ -0,0 +1,236 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InPlacePdfFieldPackInfo.h
+//! \ingroup lbm
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "lbm/field/PdfField.h"
+#include "lbm/sweeps/InPlaceTimeStep.h"
+#include "communication/UniformPackInfo.h"
+#include "core/cell/CellInterval.h"
+#include "core/debug/Debug.h"
+#include "stencil/Directions.h"
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+/**
+ * \brief PackInfo for PDF fields that are updated in-place with the AA pattern (see lbm::InPlaceSweep)
+ *
+ * The communication depends on the kind of the last executed time step:
+ *
+ * - after an even time step (next time step is odd): The post-collision values of all cells are stored in the slots
+ *   of the inverse directions. The odd kernel gathers PDFs from the ghost layer, so the sender packs the last slice
+ *   before the ghost layer and the receiver unpacks into its ghost layer. Only the (inverse) components that point
+ *   away from the receiver are communicated.
+ *
+ * - after an odd time step (next time step is even): The odd kernel has pushed post-collision values into the ghost
+ *   layer. These values belong to the neighboring block, so the sender packs its ghost layer and the receiver unpacks
+ *   into the last slice before its ghost layer ("reverse" communication). For every component, only those ghost
+ *   cells are communicated that were actually written by an inner cell of the sender.
+ *
+ * The lbm::InPlaceTimeStep object must be the one that is also used by the in-place sweep, and it must already be
+ * advanced when the communication is triggered. Since the amount of data differs between the two kinds of time steps,
+ * the message sizes are not constant.
+ *
+ * \ingroup lbm
+ */
+template< typename LatticeModel_T >
+class InPlacePdfFieldPackInfo : public walberla::communication::UniformPackInfo
+{
+public:
+
+   typedef PdfField<LatticeModel_T>          PdfField_T;
+   typedef typename LatticeModel_T::Stencil  Stencil;
+
+   InPlacePdfFieldPackInfo( const BlockDataID & pdfFieldId, const shared_ptr< InPlaceTimeStep > & timeStep ) :
+      pdfFieldId_( pdfFieldId ), timeStep_( timeStep ) {}
+   virtual ~InPlacePdfFieldPackInfo() {}
+
+   bool constantDataExchange() const { return false; } // message sizes differ between even and odd time steps
+   bool threadsafeReceiving()  const { return true; }
+
+   void unpackData( IBlock * receiver, stencil::Direction dir, mpi::RecvBuffer & buffer );
+
+   void communicateLocal( const IBlock * sender, IBlock * receiver, stencil::Direction dir );
+
+protected:
+
+   void packDataImpl( const IBlock * sender, stencil::Direction dir, mpi::SendBuffer & outBuffer ) const;
+
+   /// ghost cells of the sender (in direction 'dir') that were written by inner cells during the odd time step
+   static CellInterval reverseSenderInterval( const PdfField_T * field, const stencil::Direction dir, const stencil::Direction f );
+   /// inner cells of the receiver that obtain component 'f' from the neighbor in direction 'dir'
+   static CellInterval reverseReceiverInterval( const PdfField_T * field, const stencil::Direction dir, const stencil::Direction f );
+
+
+
+   const BlockDataID pdfFieldId_;
+
+   shared_ptr< InPlaceTimeStep > timeStep_;
+};
+
+
+
+template< typename LatticeModel_T >
+CellInterval InPlacePdfFieldPackInfo< LatticeModel_T >::reverseSenderInterval( const PdfField_T * field, const stencil::Direction dir,
+                                                                               const stencil::Direction f )
+{
+   CellInterval ghostRegion;
+   field->getGhostRegion( dir, ghostRegion, cell_idx_t(1), false );
+
+   CellInterval writtenByInnerCells = field->xyzSize();
+   writtenByInnerCells.shift( stencil::cx[f], stencil::cy[f], stencil::cz[f] );
+
+   ghostRegion.intersect( writtenByInnerCells );
+   return ghostRegion;
+}
+
+
+
+template< typename LatticeModel_T >
+CellInterval InPlacePdfFieldPackInfo< LatticeModel_T >::reverseReceiverInterval( const PdfField_T * field, const stencil::Direction dir,
+                                                                                 const stencil::Direction f )
+{
+   CellInterval ghostRegion;
+   field->getGhostRegion( dir, ghostRegion, cell_idx_t(1), false );
+   ghostRegion.shift( stencil::cx[f], stencil::cy[f], stencil::cz[f] );
+
+   CellInterval innerCells = field->xyzSize();
+   innerCells.intersect( ghostRegion );
+   return innerCells;
+}
+
+
+
+template< typename LatticeModel_T >
+void InPlacePdfFieldPackInfo< LatticeModel_T >::unpackData( IBlock * receiver, stencil::Direction dir, mpi::RecvBuffer & buffer )
+{
+   if( Stencil::idx[ stencil::inverseDir[dir] ] >= Stencil::Size )
+      return;
+
+   PdfField_T * pdfField = receiver->getData< PdfField_T >( pdfFieldId_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( pdfField );
+
+   stencil::Direction packerDirection = stencil::inverseDir[dir];
+
+   if( timeStep_->isOdd() )
+   {
+      for( auto i = pdfField->beginGhostLayerOnlyXYZ( uint_t(1), dir ); i != pdfField->end(); ++i )
+         for( uint_t f = 0; f < Stencil::d_per_d_length[dir]; ++f )
+            buffer >> i.getF( Stencil::idx[ Stencil::d_per_d[dir][f] ] );
+   }
+   else
+   {
+      for( uint_t f = 0; f < Stencil::d_per_d_length[packerDirection]; ++f )
+      {
+         const stencil::Direction d = Stencil::d_per_d[packerDirection][f];
+         const CellInterval ci = reverseReceiverInterval( pdfField, dir, d );
+         for( auto cell = ci.begin(); cell != ci.end(); ++cell )
+            buffer >> pdfField->get( *cell, Stencil::idx[d] );
+      }
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+void InPlacePdfFieldPackInfo< LatticeModel_T >::communicateLocal( const IBlock * sender, IBlock * receiver, stencil::Direction dir )
+{
+   if( Stencil::idx[dir] >= Stencil::Size )
+      return;
+
+   const PdfField_T * sf = sender  ->getData< PdfField_T >( pdfFieldId_ );
+         PdfField_T * rf = receiver->getData< PdfField_T >( pdfFieldId_ );
+
+   WALBERLA_ASSERT_EQUAL( sf->xyzSize(), rf->xyzSize() );
+
+   const stencil::Direction invDir = stencil::inverseDir[dir];
+
+   if( timeStep_->isOdd() )
+   {
+      typename PdfField_T::const_iterator srcIter = sf->beginSliceBeforeGhostLayerXYZ(dir);
+      typename PdfField_T::iterator       dstIter = rf->beginGhostLayerOnlyXYZ( uint_t(1), invDir );
+
+      while( srcIter != sf->end() )
+      {
+         for( uint_t f = 0; f < Stencil::d_per_d_length[invDir]; ++f )
+            dstIter.getF( Stencil::idx[ Stencil::d_per_d[invDir][f] ] ) = srcIter.getF( Stencil::idx[ Stencil::d_per_d[invDir][f] ] );
+
+         ++srcIter;
+         ++dstIter;
+      }
+      WALBERLA_ASSERT( srcIter == sf->end() );
+      WALBERLA_ASSERT( dstIter == rf->end() );
+   }
+   else
+   {
+      for( uint_t f = 0; f < Stencil::d_per_d_length[dir]; ++f )
+      {
+         const stencil::Direction d = Stencil::d_per_d[dir][f];
+
+         const CellInterval srcInterval = reverseSenderInterval  ( sf, dir,    d );
+         const CellInterval dstInterval = reverseReceiverInterval( rf, invDir, d );
+         WALBERLA_ASSERT_EQUAL( srcInterval.numCells(), dstInterval.numCells() );
+
+         auto dstCell = dstInterval.begin();
+         for( auto srcCell = srcInterval.begin(); srcCell != srcInterval.end(); ++srcCell, ++dstCell )
+            rf->get( *dstCell, Stencil::idx[d] ) = sf->get( *srcCell, Stencil::idx[d] );
+      }
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+void InPlacePdfFieldPackInfo< LatticeModel_T >::packDataImpl( const IBlock * sender, stencil::Direction dir, mpi::SendBuffer & outBuffer ) const
+{
+   if( Stencil::idx[dir] >= Stencil::Size )
+      return;
+
+   const PdfField_T * pdfField = sender->getData< PdfField_T >( pdfFieldId_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( pdfField );
+
+   const stencil::Direction invDir = stencil::inverseDir[dir];
+
+   if( timeStep_->isOdd() )
+   {
+      for( auto i = pdfField->beginSliceBeforeGhostLayerXYZ(dir); i != pdfField->end(); ++i )
+         for( uint_t f = 0; f < Stencil::d_per_d_length[invDir]; ++f )
+            outBuffer << i.getF( Stencil::idx[ Stencil::d_per_d[invDir][f] ] );
+   }
+   else
+   {
+      for( uint_t f = 0; f < Stencil::d_per_d_length[dir]; ++f )
+      {
+         const stencil::Direction d = Stencil::d_per_d[dir][f];
+         const CellInterval ci = reverseSenderInterval( pdfField, dir, d );
+         for( auto cell = ci.begin(); cell != ci.end(); ++cell )
+            outBuffer << pdfField->get( *cell, Stencil::idx[d] );
+      }
+   }
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
@@ -52,14 +52,17 @@ namespace lbm {
  *          the boundary are communicated, which may not be the desired behavior
  *          for the 'inner' ghost layers
  *
+ * The PDFs are sent with the value type of the field. For fields that store their PDFs with reduced precision
+ * (see MixedPrecisionPdfField), the messages shrink accordingly.
+ *
  * \ingroup lbm
  */
-template< typename LatticeModel_T >
+template< typename LatticeModel_T, typename Field_T = PdfField< LatticeModel_T > >
 class PdfFieldPackInfo : public walberla::communication::UniformPackInfo
 {
 public:
 
-   typedef PdfField<LatticeModel_T>          PdfField_T;
+   typedef Field_T                           PdfField_T;
    typedef typename LatticeModel_T::Stencil  Stencil;
 
    PdfFieldPackInfo( const BlockDataID & pdfFieldId ) : pdfFieldId_( pdfFieldId ) {}
@@ -83,8 +86,8 @@ protected:
 
 
 
-template< typename LatticeModel_T >
-void PdfFieldPackInfo< LatticeModel_T >::unpackData( IBlock * receiver, stencil::Direction dir, mpi::RecvBuffer & buffer )
+template< typename LatticeModel_T, typename Field_T >
+void PdfFieldPackInfo< LatticeModel_T, Field_T >::unpackData( IBlock * receiver, stencil::Direction dir, mpi::RecvBuffer & buffer )
 {
    if( Stencil::idx[ stencil::inverseDir[dir] ] >= Stencil::Size )
       return;
@@ -102,8 +105,8 @@ void PdfFieldPackInfo< LatticeModel_T >::unpackData( IBlock * receiver, stencil:
 
 
 
-template< typename LatticeModel_T >
-void PdfFieldPackInfo< LatticeModel_T >::communicateLocal( const IBlock * sender, IBlock * receiver, stencil::Direction dir )
+template< typename LatticeModel_T, typename Field_T >
+void PdfFieldPackInfo< LatticeModel_T, Field_T >::communicateLocal( const IBlock * sender, IBlock * receiver, stencil::Direction dir )
 {
    if( Stencil::idx[dir] >= Stencil::Size )
       return;
@@ -130,8 +133,8 @@ void PdfFieldPackInfo< LatticeModel_T >::communicateLocal( const IBlock * sender
 
 
 
-template< typename LatticeModel_T >
-void PdfFieldPackInfo< LatticeModel_T >::packDataImpl( const IBlock * sender, stencil::Direction dir, mpi::SendBuffer & outBuffer ) const
+template< typename LatticeModel_T, typename Field_T >
+void PdfFieldPackInfo< LatticeModel_T, Field_T >::packDataImpl( const IBlock * sender, stencil::Direction dir, mpi::SendBuffer & outBuffer ) const
 {
    if( Stencil::idx[dir] >= Stencil::Size )
       return;
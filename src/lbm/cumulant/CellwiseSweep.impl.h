@@ -29,6 +29,7 @@
 #include "lbm/lattice_model/D3Q27.h"
 #include "lbm/lattice_model/EquilibriumDistribution.h"
 #include "lbm/lattice_model/LatticeModelBase.h"
+#include "lbm/sweeps/InnerFrameSplit.h"
 #include "lbm/sweeps/StreamPull.h"
 #include "lbm/sweeps/SweepBase.h"
 
@@ -90,7 +91,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t omega_trm10( real_t(1.0) - omega10 );
   
    
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       using namespace stencil;
 
@@ -471,7 +472,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
 	 
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
    
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
@@ -0,0 +1,432 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file MixedPrecisionPdfField.h
+//! \ingroup lbm
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "Density.h"
+#include "DensityAndMomentumDensity.h"
+#include "DensityAndVelocity.h"
+#include "Equilibrium.h"
+
+#include "core/DataTypes.h"
+#include "core/cell/Cell.h"
+#include "core/math/Vector3.h"
+
+#include "field/GhostLayerField.h"
+#include "field/SwapableCompare.h"
+
+#include "stencil/Directions.h"
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Conversion between the stored value of a PDF and its value in 'real_t' arithmetic
+*
+*   If 'ShiftedByWeight' is true, the deviation f_i - w_i is stored instead of f_i. For compressible lattice models, the
+*   PDFs fluctuate around w_i (the equilibrium at rest for rho = 1), which means that storing the deviation keeps all
+*   significant digits of a reduced precision storage type for the part of the value that actually changes.
+*   Incompressible lattice models already store the deviation from w_i (rho = 1 + sum f_i), therefore no additional
+*   shift is applied for them.
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+struct PdfStorage
+{
+   typedef Storage_T value_type;
+
+   static const bool shifted = ShiftedByWeight && LatticeModel_T::compressible;
+
+   static inline real_t decode( const Storage_T value, const uint_t f )
+   {
+      return shifted ? ( static_cast< real_t >( value ) + LatticeModel_T::w[f] ) : static_cast< real_t >( value );
+   }
+
+   static inline Storage_T encode( const real_t value, const uint_t f )
+   {
+      return shifted ? static_cast< Storage_T >( value - LatticeModel_T::w[f] ) : static_cast< Storage_T >( value );
+   }
+};
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief PDF field that stores its PDFs with a different (usually lower) precision than 'real_t'
+*
+*   The global 'real_t' determines the precision of all arithmetic: PDFs are converted to 'real_t' when they are read
+*   (see getPdf) and converted back to 'Storage_T' when they are written (see setPdf). Storing the PDFs as float while
+*   'real_t' is double halves the memory traffic of all stream/collide sweeps and the size of all PDF messages, while
+*   the collision itself is still evaluated in double precision. Optionally, the PDFs are stored shifted by their lattice
+*   weight (see PdfStorage), which considerably improves the accuracy of float storage for compressible lattice models.
+*
+*   Note that the raw values returned by 'get' (and by all iterators) are the stored (and possibly shifted) values! All
+*   member functions for setting or evaluating macroscopic values follow the interface of lbm::PdfField, which means
+*   that this field can be used with all VTK writers in "lbm/vtk", the NoSlip boundary condition, and the
+*   PdfFieldPackInfo (by providing the field type as additional template argument). For stream/collide, see
+*   lbm::MixedPrecisionSweep.
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T, typename Storage_T = float, bool ShiftedByWeight = true >
+class MixedPrecisionPdfField : public GhostLayerField< Storage_T, LatticeModel_T::Stencil::Size >
+{
+public:
+
+   //** Type Definitions  **********************************************************************************************
+   /*! \name Type Definitions */
+   //@{
+   typedef LatticeModel_T                                       LatticeModel;
+   typedef typename LatticeModel_T::Stencil                     Stencil;
+   typedef PdfStorage< LatticeModel_T, Storage_T, ShiftedByWeight > Storage;
+
+   typedef typename GhostLayerField< Storage_T, Stencil::Size >::value_type             value_type;
+
+   typedef typename GhostLayerField< Storage_T, Stencil::Size >::iterator               iterator;
+   typedef typename GhostLayerField< Storage_T, Stencil::Size >::const_iterator         const_iterator;
+
+   typedef typename GhostLayerField< Storage_T, Stencil::Size >::Ptr                    Ptr;
+   typedef typename GhostLayerField< Storage_T, Stencil::Size >::ConstPtr               ConstPtr;
+   //@}
+   //*******************************************************************************************************************
+
+   //*******************************************************************************************************************
+   /*!
+   *   All PDFs of one cell converted to 'real_t'. Behaves like a field iterator (operator[], x(), y(), z()), which means
+   *   it can be passed to all the back-end functions for calculating macroscopic values (Density.h, Equilibrium.h, ...).
+   */
+   //*******************************************************************************************************************
+   class DecodedCell
+   {
+   public:
+      DecodedCell( const cell_idx_t _x, const cell_idx_t _y, const cell_idx_t _z ) : x_( _x ), y_( _y ), z_( _z ) {}
+
+            real_t & operator[]( const uint_t f )       { return pdfs_[f]; }
+      const real_t & operator[]( const uint_t f ) const { return pdfs_[f]; }
+
+      cell_idx_t x() const { return x_; }
+      cell_idx_t y() const { return y_; }
+      cell_idx_t z() const { return z_; }
+
+   private:
+      cell_idx_t x_, y_, z_;
+      real_t pdfs_[ Stencil::Size ];
+   };
+
+
+
+   MixedPrecisionPdfField( const uint_t _xSize, const uint_t _ySize, const uint_t _zSize,
+                           const LatticeModel_T & _latticeModel,
+                           const bool initialize = true, const Vector3< real_t > & initialVelocity = Vector3< real_t >( real_t(0.0) ),
+                           const real_t initialDensity = real_t(1.0),
+                           const uint_t ghostLayers = uint_t(1), const field::Layout & _layout = field::zyxf,
+                           const shared_ptr< field::FieldAllocator<Storage_T> > & alloc = shared_ptr< field::FieldAllocator<Storage_T> >() );
+
+   virtual ~MixedPrecisionPdfField() {}
+
+
+
+   inline MixedPrecisionPdfField * clone()              const;
+   inline MixedPrecisionPdfField * cloneUninitialized() const;
+   inline MixedPrecisionPdfField * cloneShallowCopy()   const;
+
+   const LatticeModel_T & latticeModel() const { return latticeModel_; }
+         LatticeModel_T & latticeModel()       { return latticeModel_; }
+
+   void resetLatticeModel( const LatticeModel_T & lm ) { latticeModel_ = lm; }
+
+   /////////////////////////////////////////////
+   // Access functions (converted PDF values) //
+   /////////////////////////////////////////////
+
+   real_t getPdf( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z, const uint_t f ) const
+   {
+      return Storage::decode( this->get( x, y, z, f ), f );
+   }
+   real_t getPdf( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z, const stencil::Direction d ) const
+   {
+      return getPdf( x, y, z, Stencil::idx[d] );
+   }
+
+   void setPdf( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z, const uint_t f, const real_t value )
+   {
+      this->get( x, y, z, f ) = Storage::encode( value, f );
+   }
+   void setPdf( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z, const stencil::Direction d, const real_t value )
+   {
+      setPdf( x, y, z, Stencil::idx[d], value );
+   }
+
+   inline DecodedCell decode( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const;
+   inline void        encode( const DecodedCell & cell );
+
+   //////////////////////////////
+   // set density and velocity //
+   //////////////////////////////
+
+   inline void setDensityAndVelocity( const Vector3< real_t > & velocity = Vector3< real_t >( real_t(0.0) ), const real_t rho = real_t(1.0) );
+   inline void setDensityAndVelocity( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z,
+                                      const Vector3< real_t > & velocity = Vector3< real_t >( real_t(0.0) ), const real_t rho = real_t(1.0) );
+   inline void setDensityAndVelocity( const Cell & cell,
+                                      const Vector3< real_t > & velocity = Vector3< real_t >( real_t(0.0) ), const real_t rho = real_t(1.0) )
+      { setDensityAndVelocity( cell.x(), cell.y(), cell.z(), velocity, rho ); }
+
+   /////////////////////
+   // set equilibrium //
+   /////////////////////
+
+   inline void setToEquilibrium( const Vector3< real_t > & velocity = Vector3< real_t >( real_t(0.0) ), const real_t rho = real_t(1.0) );
+   inline void setToEquilibrium( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z,
+                                 const Vector3< real_t > & velocity = Vector3< real_t >( real_t(0.0) ), const real_t rho = real_t(1.0) );
+   inline void setToEquilibrium( const Cell & cell,
+                                 const Vector3< real_t > & velocity = Vector3< real_t >( real_t(0.0) ), const real_t rho = real_t(1.0) )
+      { setToEquilibrium( cell.x(), cell.y(), cell.z(), velocity, rho ); }
+
+   /////////////////
+   // get density //
+   /////////////////
+
+   inline real_t getDensity( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const;
+   inline real_t getDensity( const Cell & cell ) const { return getDensity( cell.x(), cell.y(), cell.z() ); }
+
+   inline real_t getDensitySI( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z, const real_t rho_SI ) const { return getDensity(x,y,z) * rho_SI; }
+   inline real_t getDensitySI( const Cell & cell,                                          const real_t rho_SI ) const { return getDensity( cell ) * rho_SI; }
+
+   //////////////////
+   // get velocity //
+   //////////////////
+
+   inline Vector3< real_t > getVelocity( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const;
+   inline Vector3< real_t > getVelocity( const Cell & cell ) const { return getVelocity( cell.x(), cell.y(), cell.z() ); }
+
+   inline Vector3< real_t > getVelocitySI( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z, const real_t dxDividedByDt_SI ) const
+      { return getVelocity(x,y,z) * dxDividedByDt_SI; }
+   inline Vector3< real_t > getVelocitySI( const Cell & cell, const real_t dxDividedByDt_SI ) const
+      { return getVelocity( cell ) * dxDividedByDt_SI; }
+
+   //////////////////////////////
+   // get density and velocity //
+   //////////////////////////////
+
+   inline real_t getDensityAndVelocity( Vector3< real_t > & velocity, const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const;
+   inline real_t getDensityAndVelocity( Vector3< real_t > & velocity, const Cell & cell ) const
+      { return getDensityAndVelocity( velocity, cell.x(), cell.y(), cell.z() ); }
+
+   inline real_t getDensityAndEquilibriumVelocity( Vector3< real_t > & velocity, const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const;
+   inline real_t getDensityAndEquilibriumVelocity( Vector3< real_t > & velocity, const Cell & cell ) const
+      { return getDensityAndEquilibriumVelocity( velocity, cell.x(), cell.y(), cell.z() ); }
+
+   // evaluation for cells that are already converted to 'real_t' (see decode)
+   inline real_t getDensityAndVelocity( Vector3< real_t > & velocity, const DecodedCell & cell ) const;
+   inline real_t getDensityAndEquilibriumVelocity( Vector3< real_t > & velocity, const DecodedCell & cell ) const;
+
+protected:
+
+   //** Shallow Copy ***************************************************************************************************
+   /*! \name Shallow Copy */
+   //@{
+   inline MixedPrecisionPdfField( const MixedPrecisionPdfField & other );
+   Field< Storage_T, Stencil::Size > * cloneShallowCopyInternal() const { return new MixedPrecisionPdfField( *this ); }
+   //@}
+   //*******************************************************************************************************************
+
+   LatticeModel_T latticeModel_;
+};
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::MixedPrecisionPdfField( const uint_t _xSize, const uint_t _ySize, const uint_t _zSize,
+                                                                                             const LatticeModel_T & _latticeModel, const bool initialize,
+                                                                                             const Vector3< real_t > & initialVelocity, const real_t initialDensity,
+                                                                                             const uint_t ghostLayers, const field::Layout & _layout,
+                                                                                             const shared_ptr< field::FieldAllocator<Storage_T> > & alloc ) :
+
+   GhostLayerField< Storage_T, Stencil::Size >( _xSize, _ySize, _zSize, ghostLayers, _layout, alloc ),
+   latticeModel_( _latticeModel )
+{
+#ifdef _OPENMP
+   // take care of proper thread<->memory assignment (first-touch allocation policy !)
+   this->setWithGhostLayer( Storage_T(0) );
+#endif
+
+   if( initialize )
+      setDensityAndVelocity( initialVelocity, initialDensity );
+}
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight > *
+MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::clone() const
+{
+   return dynamic_cast< MixedPrecisionPdfField * >( GhostLayerField< Storage_T, Stencil::Size >::clone() );
+}
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight > *
+MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::cloneUninitialized() const
+{
+   return dynamic_cast< MixedPrecisionPdfField * >( GhostLayerField< Storage_T, Stencil::Size >::cloneUninitialized() );
+}
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight > *
+MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::cloneShallowCopy() const
+{
+   return dynamic_cast< MixedPrecisionPdfField * >( GhostLayerField< Storage_T, Stencil::Size >::cloneShallowCopy() );
+}
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline typename MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::DecodedCell
+MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::decode( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const
+{
+   DecodedCell cell( x, y, z );
+   for( uint_t f = 0; f != Stencil::Size; ++f )
+      cell[f] = getPdf( x, y, z, f );
+   return cell;
+}
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline void MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::encode( const DecodedCell & cell )
+{
+   for( uint_t f = 0; f != Stencil::Size; ++f )
+      setPdf( cell.x(), cell.y(), cell.z(), f, cell[f] );
+}
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline void MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::setDensityAndVelocity( const Vector3< real_t > & velocity,
+                                                                                                        const real_t rho )
+{
+   for( auto cell = this->beginWithGhostLayerXYZ(); cell != this->end(); ++cell )
+      setDensityAndVelocity( cell.x(), cell.y(), cell.z(), velocity, rho );
+}
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline void MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::setDensityAndVelocity( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z,
+                                                                                                        const Vector3< real_t > & velocity, const real_t rho )
+{
+   DecodedCell cell( x, y, z );
+   DensityAndVelocity< LatticeModel_T >::set( cell, latticeModel_, velocity, rho );
+   encode( cell );
+}
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline void MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::setToEquilibrium( const Vector3< real_t > & velocity, const real_t rho )
+{
+   for( auto cell = this->beginWithGhostLayerXYZ(); cell != this->end(); ++cell )
+      setToEquilibrium( cell.x(), cell.y(), cell.z(), velocity, rho );
+}
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline void MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::setToEquilibrium( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z,
+                                                                                                   const Vector3< real_t > & velocity, const real_t rho )
+{
+   DecodedCell cell( x, y, z );
+   Equilibrium< LatticeModel_T >::set( cell, velocity, rho );
+   encode( cell );
+}
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline real_t MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::getDensity( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const
+{
+   return Density< LatticeModel_T >::get( latticeModel_, decode( x, y, z ) );
+}
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline Vector3< real_t > MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::getVelocity( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const
+{
+   Vector3< real_t > velocity;
+   getDensityAndVelocity( velocity, x, y, z );
+   return velocity;
+}
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline real_t MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::getDensityAndVelocity( Vector3< real_t > & velocity,
+                                                                                                          const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const
+{
+   return getDensityAndVelocity( velocity, decode( x, y, z ) );
+}
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline real_t MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::getDensityAndEquilibriumVelocity( Vector3< real_t > & velocity,
+                                                                                                                     const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const
+{
+   return getDensityAndEquilibriumVelocity( velocity, decode( x, y, z ) );
+}
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline real_t MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::getDensityAndVelocity( Vector3< real_t > & velocity,
+                                                                                                          const DecodedCell & cell ) const
+{
+   const real_t rho = DensityAndMomentumDensity< LatticeModel_T >::get( velocity, latticeModel_, cell );
+   if( LatticeModel_T::compressible )
+   {
+      const real_t invRho = real_t(1.0) / rho;
+      velocity *= invRho;
+   }
+   return rho;
+}
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline real_t MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::getDensityAndEquilibriumVelocity( Vector3< real_t > & velocity,
+                                                                                                                     const DecodedCell & cell ) const
+{
+   const real_t rho = DensityAndMomentumDensity< LatticeModel_T >::getEquilibrium( velocity, latticeModel_, cell );
+   if( LatticeModel_T::compressible )
+   {
+      const real_t invRho = real_t(1.0) / rho;
+      velocity *= invRho;
+   }
+   return rho;
+}
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+inline MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight >::MixedPrecisionPdfField( const MixedPrecisionPdfField & other )
+   : GhostLayerField< Storage_T, Stencil::Size >::GhostLayerField( other ),
+     latticeModel_( other.latticeModel_ )
+{
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
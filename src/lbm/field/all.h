@@ -26,6 +26,7 @@
 #include "AddToStorage.h"
 #include "DensityVelocityCallback.h"
 #include "MacroscopicValueCalculation.h"
+#include "MixedPrecisionPdfField.h"
 #include "PdfField.h"
 #include "VelocityFieldWriter.h"
 
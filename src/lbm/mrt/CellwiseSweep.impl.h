@@ -25,6 +25,7 @@
 #include "lbm/lattice_model/D3Q19.h"
 #include "lbm/lattice_model/EquilibriumDistribution.h"
 #include "lbm/lattice_model/LatticeModelBase.h"
+#include "lbm/sweeps/InnerFrameSplit.h"
 #include "lbm/sweeps/StreamPull.h"
 #include "lbm/sweeps/SweepBase.h"
 
@@ -89,7 +90,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t _1_48 = real_t(1) / real_t(48);
    const real_t _1_72 = real_t(1) / real_t(72);
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       if( this->filter(x,y,z) )
       {
@@ -191,7 +192,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          }
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -140,6 +140,19 @@ public:
       pdfPackInfo_->optimizeForLinearExplosion( optimizedCommunication_ && performLinearExplosion_ );
    }
 
+   /// If communication is aggregated, equal level communication on level L and coarse to fine communication from level
+   /// L-1 to level L (which both happen in the first half of each sub-cycle on level L) are combined into one step,
+   /// i.e., only one MPI message is sent to each neighbor process instead of one message per communication phase
+   /// (see NonUniformBufferedScheme::startCommunicateEqualLevelAndCoarseToFine). The number of messages saved this way
+   /// is returned by savedMessages().
+   bool communicationIsAggregated() const { return aggregatedCommunication_; }
+   void aggregateCommunication( const bool value = true )
+   {
+      aggregatedCommunication_ = value;
+      refresh( postCollideVoidFunctions_.size() );
+   }
+   uint_t savedMessages() const { return communication_.savedMessages(); }
+
    bool equalLevelBorderStreamCorrectionIsPerformed() const { return performEqualLevelBorderStreamCorrection_; }
    void performEqualLevelBorderStreamCorrection( const bool value = true )
    {
@@ -266,6 +279,8 @@ private:
    void   endCommunicationCoarseToFine( const uint_t level );
    void startCommunicationFineToCoarse( const uint_t level );
    void   endCommunicationFineToCoarse( const uint_t level );
+   void startCommunicationAggregated( const uint_t level );
+   void   endCommunicationAggregated( const uint_t level );
 
    void performLinearExplosion( std::vector< Block * > & blocks, const uint_t level );
 
@@ -281,6 +296,7 @@ private:
 
    bool asynchronousCommunication_;
    bool optimizedCommunication_;
+   bool aggregatedCommunication_;
 
    shared_ptr< TimeStepPdfPackInfo > pdfPackInfo_;
 
@@ -332,7 +348,7 @@ TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::TimeStep( weak_ptr< Str
    blocks_( blocks ), sweep_( sweep ),
    boundarySweep_( BoundaryHandling_T::getBlockSweep( boundaryHandlingId, uint_t(0) ) ),
    boundarySweepWithLayers_( BoundaryHandling_T::getBlockSweep( boundaryHandlingId, StreamIncludedGhostLayers ) ),
-   asynchronousCommunication_( true ), optimizedCommunication_( true ),
+   asynchronousCommunication_( true ), optimizedCommunication_( true ), aggregatedCommunication_( false ),
 #ifdef NDEBUG   
    pdfPackInfo_( make_shared< lbm::refinement::PdfFieldPackInfo< LatticeModel_T > >( pdfFieldId, true, true ) ),
 #else
@@ -358,7 +374,7 @@ TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::TimeStep( weak_ptr< Str
    blocks_( blocks ), sweep_( sweep ),
    boundarySweep_( BoundaryHandling_T::getBlockSweep( boundaryHandlingId, uint_t(0) ) ),
    boundarySweepWithLayers_( BoundaryHandling_T::getBlockSweep( boundaryHandlingId, StreamIncludedGhostLayers ) ),
-   asynchronousCommunication_( true ), optimizedCommunication_( true ),
+   asynchronousCommunication_( true ), optimizedCommunication_( true ), aggregatedCommunication_( false ),
    pdfPackInfo_( pdfPackInfo ),
    communication_( blocks, requiredBlockSelectors, incompatibleBlockSelectors ),
    performEqualLevelBorderStreamCorrection_( true ), equalLevelBorderStreamCorrection_( pdfFieldId ),
@@ -799,6 +815,11 @@ void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::createTimers( cons
       std::vector< std::string > timers;
       timers.push_back( getTimingPoolString( "boundary handling" ) );
       timers.push_back( getTimingPoolString( "collide" ) );
+      if( aggregatedCommunication_ )
+      {
+         timers.push_back( getTimingPoolString( "communication aggregated", "[pack & send]" ) );
+         timers.push_back( getTimingPoolString( "communication aggregated", "[wait & unpack]" ) );
+      }
       timers.push_back( getTimingPoolString( "communication coarse to fine", "[pack & send]" ) );
       timers.push_back( getTimingPoolString( "communication coarse to fine", "[wait & unpack]" ) );
       timers.push_back( getTimingPoolString( "communication equal level", "[pack & send]" ) );
@@ -827,6 +848,11 @@ void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::createTimers( cons
          timers.push_back( getLevelwiseTimingPoolString( "stream", i ) );
          if( i != uint_t(0) )
          {
+            if( aggregatedCommunication_ )
+            {
+               timers.push_back( getLevelwiseTimingPoolString( "communication aggregated", i, "[pack & send]" ) );
+               timers.push_back( getLevelwiseTimingPoolString( "communication aggregated", i, "[wait & unpack]" ) );
+            }
             timers.push_back( getLevelwiseTimingPoolString( "communication coarse to fine", i, "[pack & send]" ) );
             timers.push_back( getLevelwiseTimingPoolString( "communication coarse to fine", i, "[wait & unpack]" ) );
             timers.push_back( getLevelwiseTimingPoolString( "communication fine to coarse", i, "[pack & send]" ) );
@@ -1551,6 +1577,40 @@ void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::endCommunicationFi
 
 
 
+template< typename LatticeModel_T, typename Sweep_T, typename BoundaryHandling_T >
+void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::startCommunicationAggregated( const uint_t level )
+{
+   if( timing_ )
+   {
+      startTiming( "communication aggregated", level, "[pack & send]" );
+      communication_.startCommunicateEqualLevelAndCoarseToFine( level );
+      stopTiming( "communication aggregated", level, "[pack & send]" );
+   }
+   else
+   {
+      communication_.startCommunicateEqualLevelAndCoarseToFine( level );
+   }
+}
+
+
+
+template< typename LatticeModel_T, typename Sweep_T, typename BoundaryHandling_T >
+void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::endCommunicationAggregated( const uint_t level )
+{
+   if( timing_ )
+   {
+      startTiming( "communication aggregated", level, "[wait & unpack]" );
+      communication_.waitCommunicateEqualLevelAndCoarseToFine( level );
+      stopTiming( "communication aggregated", level, "[wait & unpack]" );
+   }
+   else
+   {
+      communication_.waitCommunicateEqualLevelAndCoarseToFine( level );
+   }
+}
+
+
+
 template< typename LatticeModel_T, typename Sweep_T, typename BoundaryHandling_T >
 void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::performLinearExplosion( std::vector< Block * > & blocks, const uint_t level )
 {
@@ -1593,7 +1653,10 @@ void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::recursiveStep( con
 
    WALBERLA_LOG_DETAIL("Starting recursive step with level " << level << " and execution count " << executionCount);
 
-   if( asynchronousCommunication_ && level != coarsestLevel )
+   // equal level and coarse to fine communication of the first half of the sub-cycle are combined
+   const bool aggregate = aggregatedCommunication_ && level != coarsestLevel;
+
+   if( asynchronousCommunication_ && level != coarsestLevel && !aggregate )
    {
       WALBERLA_LOG_DETAIL("Start communication coarse to fine, initiated by fine level " << level );
       startCommunicationCoarseToFine( level ); // [start] explosion (initiated by fine level, involves "level" and "level-1")
@@ -1604,8 +1667,16 @@ void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::recursiveStep( con
 
    if( asynchronousCommunication_ )
    {
-      WALBERLA_LOG_DETAIL("Start communication equal level, initiated by level " << level );
-      startCommunicationEqualLevel( level ); // [start] equal level communication
+      if( aggregate )
+      {
+         WALBERLA_LOG_DETAIL("Start aggregated communication equal level & coarse to fine, initiated by level " << level );
+         startCommunicationAggregated( level ); // [start] equal level communication + explosion
+      }
+      else
+      {
+         WALBERLA_LOG_DETAIL("Start communication equal level, initiated by level " << level );
+         startCommunicationEqualLevel( level ); // [start] equal level communication
+      }
    }
 
    if( level != finestLevel )
@@ -1621,22 +1692,37 @@ void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::recursiveStep( con
 
    if( level != coarsestLevel )
    {
-      if( !asynchronousCommunication_ ) {
-         WALBERLA_LOG_DETAIL("Start communication coarse to fine, initiated by fine level " << level );
-         startCommunicationCoarseToFine(level); // [start] explosion (initiated by fine level, involves "level" and "level-1")
+      if( aggregate )
+      {
+         if( !asynchronousCommunication_ ) {
+            WALBERLA_LOG_DETAIL("Start aggregated communication equal level & coarse to fine, initiated by level " << level );
+            startCommunicationAggregated( level ); // [start] equal level communication + explosion
+         }
+         WALBERLA_LOG_DETAIL("End aggregated communication equal level & coarse to fine, initiated by level " << level );
+         endCommunicationAggregated( level ); // [end] equal level communication + explosion
+      }
+      else
+      {
+         if( !asynchronousCommunication_ ) {
+            WALBERLA_LOG_DETAIL("Start communication coarse to fine, initiated by fine level " << level );
+            startCommunicationCoarseToFine(level); // [start] explosion (initiated by fine level, involves "level" and "level-1")
+         }
+         WALBERLA_LOG_DETAIL("End communication coarse to fine, initiated by fine level " << level );
+         endCommunicationCoarseToFine( level ); // [end] explosion (initiated by fine level, involves "level" and "level-1")
       }
-      WALBERLA_LOG_DETAIL("End communication coarse to fine, initiated by fine level " << level );
-      endCommunicationCoarseToFine( level ); // [end] explosion (initiated by fine level, involves "level" and "level-1")
       WALBERLA_LOG_DETAIL("Perform linear explosion on level " << level );
       performLinearExplosion( blocks, level );
    }
 
-   if( !asynchronousCommunication_ ) {
-      WALBERLA_LOG_DETAIL("Start communication equal level, initiated by level " << level );
-      startCommunicationEqualLevel(level); // [start] equal level communication
+   if( !aggregate )
+   {
+      if( !asynchronousCommunication_ ) {
+         WALBERLA_LOG_DETAIL("Start communication equal level, initiated by level " << level );
+         startCommunicationEqualLevel(level); // [start] equal level communication
+      }
+      WALBERLA_LOG_DETAIL("End communication equal level, initiated by level " << level );
+      endCommunicationEqualLevel( level ); // [end] equal level communication
    }
-   WALBERLA_LOG_DETAIL("End communication equal level, initiated by level " << level );
-   endCommunicationEqualLevel( level ); // [end] equal level communication
 
    // performLinearExplosion( blocks, level ); // if equal level neighbor values are needed, linear explosion should be performed here
 
@@ -25,6 +25,7 @@
 #include "lbm/lattice_model/D3Q27.h"
 #include "lbm/lattice_model/EquilibriumDistribution.h"
 #include "lbm/lattice_model/LatticeModelBase.h"
+#include "lbm/sweeps/InnerFrameSplit.h"
 #include "lbm/sweeps/StreamPull.h"
 #include "lbm/sweeps/SweepBase.h"
 
@@ -72,7 +73,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t  omega_w2( real_t(3) * ( real_t(1) / real_t(36) ) * omega );
    const real_t one_third( real_t(1) / real_t(3) );
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       using namespace stencil;
 
@@ -112,7 +113,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get(x,y,z,Stencil_T::idx[SW]) = omega_trm * vSW + omega_w2 * ( vel_trm_NE_SW - velXpY );
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -204,7 +205,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t  omega_w2( real_t(3) * ( real_t(1) / real_t(36) ) * omega );
    const real_t one_third( real_t(1) / real_t(3) );
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       using namespace stencil;
 
@@ -272,7 +273,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get(x,y,z,Stencil_T::idx[BS]) = omega_trm * vBS + omega_w2 * ( vel_trm_TN_BS - velYpZ );
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -388,7 +389,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t  omega_w2( real_t(3) * ( real_t(1) / real_t(36) ) * omega );
    const real_t one_third( real_t(1) / real_t(3) );
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       using namespace stencil;
 
@@ -460,7 +461,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get(x,y,z,Stencil_T::idx[BS]) = omega_trm * vBS + omega_w2_rho * ( vel_trm_TN_BS - velYpZ );
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -583,7 +584,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t three_w1( real_t(1) / real_t(6) );
    const real_t three_w2( real_t(1) / real_t(12) );
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       using namespace stencil;
 
@@ -653,7 +654,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get(x,y,z,Stencil_T::idx[BS]) = omega_trm * vBS + omega_w2 * ( vel_trm_TN_BS - velYpZ ) + three_w2 * ( -force[1] - force[2] );
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -777,7 +778,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t three_w1( real_t(1) / real_t(6) );
    const real_t three_w2( real_t(1) / real_t(12) );
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       using namespace stencil;
 
@@ -851,7 +852,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get(x,y,z,Stencil_T::idx[BS]) = omega_trm * vBS + omega_w2_rho * ( vel_trm_TN_BS - velYpZ ) + three_w2 * ( -force[1] - force[2] );
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -981,7 +982,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t  omega_w3( real_t(3) * ( real_t(1.0) / real_t(216.0) ) * omega );
    const real_t one_third( real_t(1) / real_t(3) );
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       using namespace stencil;
 
@@ -1074,7 +1075,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
 
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -1216,7 +1217,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t  omega_w3( real_t(3) * ( real_t(1.0) / real_t(216.0) ) * omega );
    const real_t one_third( real_t(1) / real_t(3) );
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       using namespace stencil;
 
@@ -1314,7 +1315,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get( x, y, z, Stencil_T::idx[BNE] ) = omega_trm * vBNE + omega_w3_rho * ( vel_trm_TSW_BNE - vel_TSW_BNE );
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -1466,7 +1467,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t three_w2( real_t(1) / real_t(18) );
    const real_t three_w3( real_t(1) / real_t(72) );
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       using namespace stencil;
 
@@ -1560,7 +1561,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get( x, y, z, Stencil_T::idx[BNE] ) = omega_trm * vBNE + omega_w3 * ( vel_trm_TSW_BNE - vel_TSW_BNE ) - three_w3 * (  -force[0] - force[1] + force[2] );
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -1712,7 +1713,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t three_w2( real_t(1) / real_t(18) );
    const real_t three_w3( real_t(1) / real_t(72) );
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       using namespace stencil;
 
@@ -1812,7 +1813,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get( x, y, z, Stencil_T::idx[BNE] ) = omega_trm * vBNE + omega_w3_rho * ( vel_trm_TSW_BNE - vel_TSW_BNE ) - three_w3 * (  -force[0] - force[1] + force[2] );
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -1968,7 +1969,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_CLASS_HEAD_AND_STREAM( WALBERLA_LBM_CELLWISE_SWEEP_S
 
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPECIALIZATION_SRT )
 {
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       if( this->filter(x,y,z) )
       {
@@ -1997,7 +1998,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          }
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
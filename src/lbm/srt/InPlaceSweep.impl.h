@@ -0,0 +1,166 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InPlaceSweep.impl.h
+//! \ingroup lbm
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "lbm/lattice_model/EquilibriumDistribution.h"
+#include "lbm/lattice_model/LatticeModelBase.h"
+#include "lbm/sweeps/InPlaceTimeStep.h"
+#include "lbm/sweeps/SweepBase.h"
+
+#include "field/iterators/IteratorMacros.h"
+
+#include <boost/mpl/logical.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+
+
+namespace walberla {
+namespace lbm {
+
+///////////////////////////////////////////////////////
+// Available SRT implementations:                    //
+//                                                   //
+// Generic (D*Q*) version:                           //
+//                     incompressible | compressible //
+//          no forces:       x               x       //
+///////////////////////////////////////////////////////
+
+#define WALBERLA_LBM_INPLACE_SWEEP_SPECIALIZATION_SRT \
+   boost::mpl::and_< boost::is_same< typename LatticeModel_T::CollisionModel::tag, collision_model::SRT_tag >, \
+                     boost::mpl::bool_< LatticeModel_T::CollisionModel::constant >, \
+                     boost::is_same< typename LatticeModel_T::ForceModel::tag, force_model::None_tag > \
+   >
+
+template< typename LatticeModel_T >
+class InPlaceSweep< LatticeModel_T, typename boost::enable_if< WALBERLA_LBM_INPLACE_SWEEP_SPECIALIZATION_SRT >::type > :
+   public SweepBase< LatticeModel_T >
+{
+public:
+
+   static_assert( (boost::is_same< typename LatticeModel_T::CollisionModel::tag, collision_model::SRT_tag >::value), "Only works with SRT!" );
+   static_assert( LatticeModel_T::CollisionModel::constant,                                                          "Only works with constant relaxation!" );
+   static_assert( (boost::is_same< typename LatticeModel_T::ForceModel::tag, force_model::None_tag >::value),        "Only works without additional forces!" );
+
+   typedef typename SweepBase<LatticeModel_T>::PdfField_T  PdfField_T;
+   typedef typename LatticeModel_T::Stencil                Stencil;
+
+   InPlaceSweep( const BlockDataID & pdfField, const shared_ptr< InPlaceTimeStep > & timeStep ) :
+      SweepBase<LatticeModel_T>( pdfField ), timeStep_( timeStep ) {}
+
+   void operator()( IBlock * const block )
+   {
+      if( timeStep_->isEven() )
+         even( block );
+      else
+         odd( block );
+   }
+
+   void even( IBlock * const block );
+   void odd ( IBlock * const block );
+
+private:
+
+   shared_ptr< InPlaceTimeStep > timeStep_;
+};
+
+template< typename LatticeModel_T >
+void InPlaceSweep< LatticeModel_T, typename boost::enable_if< WALBERLA_LBM_INPLACE_SWEEP_SPECIALIZATION_SRT >::type
+   >::even( IBlock * const block )
+{
+   PdfField_T * src = this->getSrcField( block );
+
+   const real_t omega = src->latticeModel().collisionModel().omega();
+   const real_t omega_trm( real_t(1) - omega );
+
+#ifdef _OPENMP
+   #pragma omp parallel
+   {
+#endif
+
+   real_t pdfs[ Stencil::Size ];
+
+   WALBERLA_FOR_ALL_CELLS_XYZ_OMP( src, omp for schedule(static),
+
+      real_t * const xyz0 = &src->get(x,y,z,0);
+
+      for( auto d = Stencil::begin(); d != Stencil::end(); ++d )
+         pdfs[ d.toIdx() ] = src->getF( xyz0, d.toIdx() );
+
+      Vector3< real_t > velocity;
+      const real_t rho = internal::getInPlaceDensityAndVelocity< LatticeModel_T >( velocity, pdfs );
+
+      // post-collision values are stored in the slots of the inverse directions
+      for( auto d = Stencil::begin(); d != Stencil::end(); ++d )
+         src->getF( xyz0, d.toInvIdx() ) = omega_trm * pdfs[ d.toIdx() ] + omega * EquilibriumDistribution< LatticeModel_T >::get( *d, velocity, rho );
+
+   ) // WALBERLA_FOR_ALL_CELLS_XYZ_OMP
+
+#ifdef _OPENMP
+   }
+#endif
+}
+
+template< typename LatticeModel_T >
+void InPlaceSweep< LatticeModel_T, typename boost::enable_if< WALBERLA_LBM_INPLACE_SWEEP_SPECIALIZATION_SRT >::type
+   >::odd( IBlock * const block )
+{
+   PdfField_T * src = this->getSrcField( block );
+
+   WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+
+   const real_t omega = src->latticeModel().collisionModel().omega();
+   const real_t omega_trm( real_t(1) - omega );
+
+#ifdef _OPENMP
+   #pragma omp parallel
+   {
+#endif
+
+   real_t pdfs[ Stencil::Size ];
+
+   WALBERLA_FOR_ALL_CELLS_XYZ_OMP( src, omp for schedule(static),
+
+      // gather: PDF 'f' of this cell is stored in the inverse slot of the neighbor at x - c_f
+      for( auto d = Stencil::begin(); d != Stencil::end(); ++d )
+         pdfs[ d.toIdx() ] = src->get( x - d.cx(), y - d.cy(), z - d.cz(), d.toInvIdx() );
+
+      Vector3< real_t > velocity;
+      const real_t rho = internal::getInPlaceDensityAndVelocity< LatticeModel_T >( velocity, pdfs );
+
+      // scatter: post-collision value 'f' is pushed to slot 'f' of the neighbor at x + c_f
+      for( auto d = Stencil::begin(); d != Stencil::end(); ++d )
+         src->get( x + d.cx(), y + d.cy(), z + d.cz(), d.toIdx() ) = omega_trm * pdfs[ d.toIdx() ] +
+                                                                     omega * EquilibriumDistribution< LatticeModel_T >::get( *d, velocity, rho );
+
+   ) // WALBERLA_FOR_ALL_CELLS_XYZ_OMP
+
+#ifdef _OPENMP
+   }
+#endif
+}
+
+#undef WALBERLA_LBM_INPLACE_SWEEP_SPECIALIZATION_SRT
+
+
+
+} // namespace lbm
+} // namespace walberla
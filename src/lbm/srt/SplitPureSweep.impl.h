@@ -27,6 +27,7 @@
 
 #include "lbm/lattice_model/LatticeModelBase.h"
 #include "lbm/lattice_model/D3Q19.h"
+#include "lbm/sweeps/SplitPureSIMD.h"
 #include "lbm/sweeps/Streaming.h"
 #include "lbm/sweeps/SweepBase.h"
 #include "lbm/IntelCompilerOptimization.h"
@@ -54,6 +55,113 @@ namespace lbm {
 ///////////////////////////////////////////////////////
 
 
+#ifdef WALBERLA_LBM_SPLIT_PURE_SIMD
+
+namespace internal {
+
+/// Fused stream & collide kernel of the incompressible D3Q19 SRT sweep for one vector/scalar of cells.
+/// The order of all floating point operations is identical to the X_LOOP implementation below, so both produce
+/// bit-identical results.
+class SRTSplitPureIncompressibleKernel
+{
+public:
+
+   SRTSplitPureIncompressibleKernel( const real_t omega_trm, const real_t omega_w0, const real_t omega_w1, const real_t omega_w2,
+                                     const real_t one_third ) :
+      omega_trm_( omega_trm ), omega_w0_( omega_w0 ), omega_w1_( omega_w1 ), omega_w2_( omega_w2 ), one_third_( one_third ) {}
+
+   template< typename Ops >
+   inline void cell( const split_pure_simd::D3Q19Line & l, const cell_idx_t x ) const
+   {
+      typedef typename Ops::value_type V;
+
+      const V omega_trm = Ops::broadcast( omega_trm_ );
+      const V omega_w0  = Ops::broadcast( omega_w0_ );
+      const V omega_w1  = Ops::broadcast( omega_w1_ );
+      const V omega_w2  = Ops::broadcast( omega_w2_ );
+      const V one_third = Ops::broadcast( one_third_ );
+      const V half      = Ops::broadcast( real_c(0.5) );
+      const V three_halves = Ops::broadcast( real_c(1.5) );
+
+      const V pNE = Ops::load( l.pNE + x ); const V pN  = Ops::load( l.pN  + x ); const V pNW = Ops::load( l.pNW + x );
+      const V pW  = Ops::load( l.pW  + x ); const V pSW = Ops::load( l.pSW + x ); const V pS  = Ops::load( l.pS  + x );
+      const V pSE = Ops::load( l.pSE + x ); const V pE  = Ops::load( l.pE  + x ); const V pT  = Ops::load( l.pT  + x );
+      const V pTE = Ops::load( l.pTE + x ); const V pTN = Ops::load( l.pTN + x ); const V pTW = Ops::load( l.pTW + x );
+      const V pTS = Ops::load( l.pTS + x ); const V pB  = Ops::load( l.pB  + x ); const V pBE = Ops::load( l.pBE + x );
+      const V pBN = Ops::load( l.pBN + x ); const V pBW = Ops::load( l.pBW + x ); const V pBS = Ops::load( l.pBS + x );
+      const V pC  = Ops::load( l.pC  + x );
+
+      const V velX_trm = pE + pNE + pSE + pTE + pBE;
+      const V velY_trm = pN + pNW + pTN + pBN;
+      const V velZ_trm = pT + pTS + pTW;
+
+      const V rho = pC + pS + pW + pB + pSW + pBS + pBW + velX_trm + velY_trm + velZ_trm;
+
+      const V velX = velX_trm - pW  - pNW - pSW - pTW - pBW;
+      const V velY = velY_trm + pNE - pS  - pSW - pSE - pTS - pBS;
+      const V velZ = velZ_trm + pTN + pTE - pB  - pBN - pBS - pBW - pBE;
+
+      const V dir_indep_trm = one_third * rho - half * ( velX * velX + velY * velY + velZ * velZ );
+
+      Ops::store( l.dC + x, omega_trm * pC + omega_w0 * dir_indep_trm );
+
+      const V velXMY = velX - velY;
+      const V vel_trm_NW_SE = dir_indep_trm + three_halves * velXMY * velXMY;
+      Ops::store( l.dNW + x, omega_trm * pNW + omega_w2 * ( vel_trm_NW_SE - velXMY ) );
+      Ops::store( l.dSE + x, omega_trm * pSE + omega_w2 * ( vel_trm_NW_SE + velXMY ) );
+
+      const V velXPY = velX + velY;
+      const V vel_trm_NE_SW = dir_indep_trm + three_halves * velXPY * velXPY;
+      Ops::store( l.dNE + x, omega_trm * pNE + omega_w2 * ( vel_trm_NE_SW + velXPY ) );
+      Ops::store( l.dSW + x, omega_trm * pSW + omega_w2 * ( vel_trm_NE_SW - velXPY ) );
+
+      const V velXMZ = velX - velZ;
+      const V vel_trm_TW_BE = dir_indep_trm + three_halves * velXMZ * velXMZ;
+      Ops::store( l.dTW + x, omega_trm * pTW + omega_w2 * ( vel_trm_TW_BE - velXMZ ) );
+      Ops::store( l.dBE + x, omega_trm * pBE + omega_w2 * ( vel_trm_TW_BE + velXMZ ) );
+
+      const V velXPZ = velX + velZ;
+      const V vel_trm_TE_BW = dir_indep_trm + three_halves * velXPZ * velXPZ;
+      Ops::store( l.dTE + x, omega_trm * pTE + omega_w2 * ( vel_trm_TE_BW + velXPZ ) );
+      Ops::store( l.dBW + x, omega_trm * pBW + omega_w2 * ( vel_trm_TE_BW - velXPZ ) );
+
+      const V velYMZ = velY - velZ;
+      const V vel_trm_TS_BN = dir_indep_trm + three_halves * velYMZ * velYMZ;
+      Ops::store( l.dTS + x, omega_trm * pTS + omega_w2 * ( vel_trm_TS_BN - velYMZ ) );
+      Ops::store( l.dBN + x, omega_trm * pBN + omega_w2 * ( vel_trm_TS_BN + velYMZ ) );
+
+      const V velYPZ = velY + velZ;
+      const V vel_trm_TN_BS = dir_indep_trm + three_halves * velYPZ * velYPZ;
+      Ops::store( l.dTN + x, omega_trm * pTN + omega_w2 * ( vel_trm_TN_BS + velYPZ ) );
+      Ops::store( l.dBS + x, omega_trm * pBS + omega_w2 * ( vel_trm_TN_BS - velYPZ ) );
+
+      const V vel_trm_N_S = dir_indep_trm + three_halves * velY * velY;
+      Ops::store( l.dN + x, omega_trm * pN + omega_w1 * ( vel_trm_N_S + velY ) );
+      Ops::store( l.dS + x, omega_trm * pS + omega_w1 * ( vel_trm_N_S - velY ) );
+
+      const V vel_trm_E_W = dir_indep_trm + three_halves * velX * velX;
+      Ops::store( l.dE + x, omega_trm * pE + omega_w1 * ( vel_trm_E_W + velX ) );
+      Ops::store( l.dW + x, omega_trm * pW + omega_w1 * ( vel_trm_E_W - velX ) );
+
+      const V vel_trm_T_B = dir_indep_trm + three_halves * velZ * velZ;
+      Ops::store( l.dT + x, omega_trm * pT + omega_w1 * ( vel_trm_T_B + velZ ) );
+      Ops::store( l.dB + x, omega_trm * pB + omega_w1 * ( vel_trm_T_B - velZ ) );
+   }
+
+private:
+
+   const real_t omega_trm_;
+   const real_t omega_w0_;
+   const real_t omega_w1_;
+   const real_t omega_w2_;
+   const real_t one_third_;
+};
+
+} // namespace internal
+
+#endif // WALBERLA_LBM_SPLIT_PURE_SIMD
+
+
 ///////////////////////////////
 // Specialization for D3Q19: //
 // - incompressible          //
@@ -90,7 +198,43 @@ public:
    SplitPureSweep( const BlockDataID & src, const BlockDataID & dst ) :
       SweepBase<LatticeModel_T>( src, dst ) {}
 
-   void operator()( IBlock * const block );
+   void operator()( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getFields( block, src, dst );
+
+      streamCollide( src, dst, src->xyzSize() );
+      src->swapDataPointers( dst );
+   }
+
+   // 'inner' + 'frame' == 'operator()', see lbm::CellwiseSweep
+   void inner( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getBlockLocalFields( block, src, dst );
+
+      const CellInterval cells = innerCells< Stencil >( src->xyzSize() );
+      if( !cells.empty() )
+         streamCollide( src, dst, cells );
+   }
+
+   void frame( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getBlockLocalFields( block, src, dst );
+
+      const std::vector< CellInterval > cells = frameCells< Stencil >( src->xyzSize() );
+      for( auto interval = cells.begin(); interval != cells.end(); ++interval )
+         streamCollide( src, dst, *interval );
+      src->swapDataPointers( dst );
+      this->releaseBlockLocalDstField( block );
+   }
+
+   /// stream & collide for all cells in 'cells' (src and dst are NOT swapped)
+   void streamCollide( PdfField_T * const src, PdfField_T * const dst, const CellInterval & cells );
 
    void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
    void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
@@ -104,14 +248,13 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
                                                                                   boost::mpl::not_< boost::mpl::bool_< LatticeModel_T::compressible > >,
                                                                                   boost::is_same< typename LatticeModel_T::ForceModel::tag,
                                                                                                   force_model::None_tag > > >::type
-   >::operator()( IBlock * const block )
+   >::streamCollide( PdfField_T * const src, PdfField_T * const dst, const CellInterval & cells )
 {
-   PdfField_T * src( NULL );
-   PdfField_T * dst( NULL );
-
-   this->getFields( block, src, dst );
-
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
+   WALBERLA_ASSERT_EQUAL( src->xyzSize(), dst->xyzSize() );
    WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT( src->xyzSize().contains( cells ) );
 
    // constants used during stream/collide
 
@@ -125,7 +268,21 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    // loop constants
 
-   const cell_idx_t xSize = cell_idx_c( src->xSize() );
+   const cell_idx_t xOff  = cells.xMin(); // x-lines start at x = xOff, x below is relative to xOff
+   const cell_idx_t xSize = cell_idx_c( cells.xSize() );
+
+#ifdef WALBERLA_LBM_SPLIT_PURE_SIMD
+   if( internal::split_pure_simd::isApplicable( src, dst ) )
+   {
+      const internal::SRTSplitPureIncompressibleKernel kernel( omega_trm, omega_w0, omega_w1, omega_w2, one_third );
+
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp parallel for schedule(static),
+         internal::split_pure_simd::processLine( kernel, internal::split_pure_simd::D3Q19Line( src, dst, xOff, y, z ), xSize );
+      )
+
+      return;
+   }
+#endif
 
 #ifdef _OPENMP
    #pragma omp parallel
@@ -141,31 +298,31 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    if( src->layout() == field::fzyx && dst->layout() == field::fzyx )
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp for schedule(static),
 
          using namespace stencil;
 
-         real_t * WALBERLA_RESTRICT pNE = &src->get(-1, y-1, z  , Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT pN  = &src->get(0 , y-1, z  , Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT pNW = &src->get(+1, y-1, z  , Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT pW  = &src->get(+1, y  , z  , Stencil::idx[W]);
-         real_t * WALBERLA_RESTRICT pSW = &src->get(+1, y+1, z  , Stencil::idx[SW]);
-         real_t * WALBERLA_RESTRICT pS  = &src->get(0 , y+1, z  , Stencil::idx[S]);
-         real_t * WALBERLA_RESTRICT pSE = &src->get(-1, y+1, z  , Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT pE  = &src->get(-1, y  , z  , Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT pT  = &src->get(0 , y  , z-1, Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT pTE = &src->get(-1, y  , z-1, Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT pTN = &src->get(0 , y-1, z-1, Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT pTW = &src->get(+1, y  , z-1, Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT pTS = &src->get(0 , y+1, z-1, Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT pB  = &src->get(0 , y  , z+1, Stencil::idx[B]);
-         real_t * WALBERLA_RESTRICT pBE = &src->get(-1, y  , z+1, Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT pBN = &src->get(0 , y-1, z+1, Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT pBW = &src->get(+1, y  , z+1, Stencil::idx[BW]);
-         real_t * WALBERLA_RESTRICT pBS = &src->get(0 , y+1, z+1, Stencil::idx[BS]);
-         real_t * WALBERLA_RESTRICT pC  = &src->get(0 , y  , z  , Stencil::idx[C]);
-
-         real_t * WALBERLA_RESTRICT dC = &dst->get(0,y,z,Stencil::idx[C]);
+         real_t * WALBERLA_RESTRICT pNE = &src->get(xOff-1, y-1, z  , Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT pN  = &src->get(xOff  , y-1, z  , Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT pNW = &src->get(xOff+1, y-1, z  , Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT pW  = &src->get(xOff+1, y  , z  , Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT pSW = &src->get(xOff+1, y+1, z  , Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT pS  = &src->get(xOff  , y+1, z  , Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT pSE = &src->get(xOff-1, y+1, z  , Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT pE  = &src->get(xOff-1, y  , z  , Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT pT  = &src->get(xOff  , y  , z-1, Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT pTE = &src->get(xOff-1, y  , z-1, Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT pTN = &src->get(xOff  , y-1, z-1, Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT pTW = &src->get(xOff+1, y  , z-1, Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT pTS = &src->get(xOff  , y+1, z-1, Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT pB  = &src->get(xOff  , y  , z+1, Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT pBE = &src->get(xOff-1, y  , z+1, Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT pBN = &src->get(xOff  , y-1, z+1, Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT pBW = &src->get(xOff+1, y  , z+1, Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT pBS = &src->get(xOff  , y+1, z+1, Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT pC  = &src->get(xOff  , y  , z  , Stencil::idx[C]);
+
+         real_t * WALBERLA_RESTRICT dC = &dst->get(xOff,y,z,Stencil::idx[C]);
 
          X_LOOP
          (
@@ -184,8 +341,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dC[x] = omega_trm * pC[x] + omega_w0 * dir_indep_trm[x];
          )
 
-         real_t * WALBERLA_RESTRICT dNW = &dst->get(0,y,z,Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT dSE = &dst->get(0,y,z,Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT dNW = &dst->get(xOff,y,z,Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT dSE = &dst->get(xOff,y,z,Stencil::idx[SE]);
 
          X_LOOP
          (
@@ -196,8 +353,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSE[x] = omega_trm * pSE[x] + omega_w2 * ( vel_trm_NW_SE + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dNE = &dst->get(0,y,z,Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT dSW = &dst->get(0,y,z,Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT dNE = &dst->get(xOff,y,z,Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT dSW = &dst->get(xOff,y,z,Stencil::idx[SW]);
 
          X_LOOP
          (
@@ -208,8 +365,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSW[x] = omega_trm * pSW[x] + omega_w2 * ( vel_trm_NE_SW - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTW = &dst->get(0,y,z,Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT dBE = &dst->get(0,y,z,Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT dTW = &dst->get(xOff,y,z,Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT dBE = &dst->get(xOff,y,z,Stencil::idx[BE]);
 
          X_LOOP
          (
@@ -220,8 +377,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBE[x] = omega_trm * pBE[x] + omega_w2 * ( vel_trm_TW_BE + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTE = &dst->get(0,y,z,Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT dBW = &dst->get(0,y,z,Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT dTE = &dst->get(xOff,y,z,Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT dBW = &dst->get(xOff,y,z,Stencil::idx[BW]);
 
          X_LOOP
          (
@@ -232,8 +389,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBW[x] = omega_trm * pBW[x] + omega_w2 * ( vel_trm_TE_BW - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTS = &dst->get(0,y,z,Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT dBN = &dst->get(0,y,z,Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT dTS = &dst->get(xOff,y,z,Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT dBN = &dst->get(xOff,y,z,Stencil::idx[BN]);
 
          X_LOOP
          (
@@ -244,8 +401,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBN[x] = omega_trm * pBN[x] + omega_w2 * ( vel_trm_TS_BN + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTN = &dst->get(0,y,z,Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT dBS = &dst->get(0,y,z,Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT dTN = &dst->get(xOff,y,z,Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT dBS = &dst->get(xOff,y,z,Stencil::idx[BS]);
 
          X_LOOP
          (
@@ -256,8 +413,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBS[x] = omega_trm * pBS[x] + omega_w2 * ( vel_trm_TN_BS - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dN = &dst->get(0,y,z,Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT dS = &dst->get(0,y,z,Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT dN = &dst->get(xOff,y,z,Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT dS = &dst->get(xOff,y,z,Stencil::idx[S]);
 
          X_LOOP
          (
@@ -267,8 +424,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dS[x] = omega_trm * pS[x] + omega_w1 * ( vel_trm_N_S - velY[x] );
          )
 
-         real_t * WALBERLA_RESTRICT dE = &dst->get(0,y,z,Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT dW = &dst->get(0,y,z,Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT dE = &dst->get(xOff,y,z,Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT dW = &dst->get(xOff,y,z,Stencil::idx[W]);
 
          X_LOOP
          (
@@ -278,8 +435,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dW[x] = omega_trm * pW[x] + omega_w1 * ( vel_trm_E_W - velX[x] );
          )
 
-         real_t * WALBERLA_RESTRICT dT = &dst->get(0,y,z,Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT dB = &dst->get(0,y,z,Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT dT = &dst->get(xOff,y,z,Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT dB = &dst->get(xOff,y,z,Stencil::idx[B]);
 
          X_LOOP
          (
@@ -289,35 +446,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dB[x] = omega_trm * pB[x] + omega_w1 * ( vel_trm_T_B - velZ[x] );
          )
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
    else // ==> src->layout() == field::zyxf || dst->layout() == field::zyxf
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp for schedule(static),
 
          using namespace stencil;
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z  , Stencil::idx[NE]);
-            const real_t dd_tmp_N  = src->get(x  , y-1, z  , Stencil::idx[N]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z  , Stencil::idx[NW]);
-            const real_t dd_tmp_W  = src->get(x+1, y  , z  , Stencil::idx[W]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z  , Stencil::idx[SW]);
-            const real_t dd_tmp_S  = src->get(x  , y+1, z  , Stencil::idx[S]);
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z  , Stencil::idx[SE]);
-            const real_t dd_tmp_E  = src->get(x-1, y  , z  , Stencil::idx[E]);
-            const real_t dd_tmp_T  = src->get(x  , y  , z-1, Stencil::idx[T]);
-            const real_t dd_tmp_TE = src->get(x-1, y  , z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_TN = src->get(x  , y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_TW = src->get(x+1, y  , z-1, Stencil::idx[TW]);
-            const real_t dd_tmp_TS = src->get(x  , y+1, z-1, Stencil::idx[TS]);
-            const real_t dd_tmp_B  = src->get(x  , y  , z+1, Stencil::idx[B]);
-            const real_t dd_tmp_BE = src->get(x-1, y  , z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_BN = src->get(x  , y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_BW = src->get(x+1, y  , z+1, Stencil::idx[BW]);
-            const real_t dd_tmp_BS = src->get(x  , y+1, z+1, Stencil::idx[BS]);
-            const real_t dd_tmp_C  = src->get(x  , y  , z  , Stencil::idx[C]);
+            const real_t dd_tmp_NE = src->get(xOff+x-1, y-1, z  , Stencil::idx[NE]);
+            const real_t dd_tmp_N  = src->get(xOff+x  , y-1, z  , Stencil::idx[N]);
+            const real_t dd_tmp_NW = src->get(xOff+x+1, y-1, z  , Stencil::idx[NW]);
+            const real_t dd_tmp_W  = src->get(xOff+x+1, y  , z  , Stencil::idx[W]);
+            const real_t dd_tmp_SW = src->get(xOff+x+1, y+1, z  , Stencil::idx[SW]);
+            const real_t dd_tmp_S  = src->get(xOff+x  , y+1, z  , Stencil::idx[S]);
+            const real_t dd_tmp_SE = src->get(xOff+x-1, y+1, z  , Stencil::idx[SE]);
+            const real_t dd_tmp_E  = src->get(xOff+x-1, y  , z  , Stencil::idx[E]);
+            const real_t dd_tmp_T  = src->get(xOff+x  , y  , z-1, Stencil::idx[T]);
+            const real_t dd_tmp_TE = src->get(xOff+x-1, y  , z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_TN = src->get(xOff+x  , y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_TW = src->get(xOff+x+1, y  , z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_TS = src->get(xOff+x  , y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_B  = src->get(xOff+x  , y  , z+1, Stencil::idx[B]);
+            const real_t dd_tmp_BE = src->get(xOff+x-1, y  , z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_BN = src->get(xOff+x  , y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_BW = src->get(xOff+x+1, y  , z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_BS = src->get(xOff+x  , y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_C  = src->get(xOff+x  , y  , z  , Stencil::idx[C]);
 
             const real_t velX_trm = dd_tmp_E + dd_tmp_NE + dd_tmp_SE + dd_tmp_TE + dd_tmp_BE;
             const real_t velY_trm = dd_tmp_N + dd_tmp_NW + dd_tmp_TN + dd_tmp_BN;
@@ -331,7 +488,7 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
             dir_indep_trm[x] = one_third * rho - real_c(0.5) * ( velX[x] * velX[x] + velY[x] * velY[x] + velZ[x] * velZ[x] );
 
-            dst->get(x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * dir_indep_trm[x];
+            dst->get(xOff+x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * dir_indep_trm[x];
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -339,8 +496,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] - velY[x];
             const real_t vel_trm_NW_SE = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[NW]) = omega_trm * src->get(x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * ( vel_trm_NW_SE - vel );
-            dst->get(x,y,z,Stencil::idx[SE]) = omega_trm * src->get(x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * ( vel_trm_NW_SE + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[NW]) = omega_trm * src->get(xOff+x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * ( vel_trm_NW_SE - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[SE]) = omega_trm * src->get(xOff+x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * ( vel_trm_NW_SE + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -348,8 +505,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] + velY[x];
             const real_t vel_trm_NE_SW = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[NE]) = omega_trm * src->get(x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * ( vel_trm_NE_SW + vel );
-            dst->get(x,y,z,Stencil::idx[SW]) = omega_trm * src->get(x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * ( vel_trm_NE_SW - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[NE]) = omega_trm * src->get(xOff+x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * ( vel_trm_NE_SW + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[SW]) = omega_trm * src->get(xOff+x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * ( vel_trm_NE_SW - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -357,8 +514,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] - velZ[x];
             const real_t vel_trm_TW_BE = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TW]) = omega_trm * src->get(x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * ( vel_trm_TW_BE - vel );
-            dst->get(x,y,z,Stencil::idx[BE]) = omega_trm * src->get(x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * ( vel_trm_TW_BE + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[TW]) = omega_trm * src->get(xOff+x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * ( vel_trm_TW_BE - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[BE]) = omega_trm * src->get(xOff+x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * ( vel_trm_TW_BE + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -366,8 +523,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] + velZ[x];
             const real_t vel_trm_TE_BW = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TE]) = omega_trm * src->get(x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * ( vel_trm_TE_BW + vel );
-            dst->get(x,y,z,Stencil::idx[BW]) = omega_trm * src->get(x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * ( vel_trm_TE_BW - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[TE]) = omega_trm * src->get(xOff+x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * ( vel_trm_TE_BW + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[BW]) = omega_trm * src->get(xOff+x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * ( vel_trm_TE_BW - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -375,8 +532,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velY[x] - velZ[x];
             const real_t vel_trm_TS_BN = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TS]) = omega_trm * src->get(x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * ( vel_trm_TS_BN - vel );
-            dst->get(x,y,z,Stencil::idx[BN]) = omega_trm * src->get(x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * ( vel_trm_TS_BN + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[TS]) = omega_trm * src->get(xOff+x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * ( vel_trm_TS_BN - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[BN]) = omega_trm * src->get(xOff+x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * ( vel_trm_TS_BN + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -384,35 +541,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velY[x] + velZ[x];
             const real_t vel_trm_TN_BS = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TN]) = omega_trm * src->get(x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * ( vel_trm_TN_BS + vel );
-            dst->get(x,y,z,Stencil::idx[BS]) = omega_trm * src->get(x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * ( vel_trm_TN_BS - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[TN]) = omega_trm * src->get(xOff+x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * ( vel_trm_TN_BS + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[BS]) = omega_trm * src->get(xOff+x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * ( vel_trm_TN_BS - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_N_S = dir_indep_trm[x] + real_c(1.5) * velY[x] * velY[x];
 
-            dst->get(x,y,z,Stencil::idx[N]) = omega_trm * src->get(x, y-1, z, Stencil::idx[N]) + omega_w1 * ( vel_trm_N_S + velY[x] );
-            dst->get(x,y,z,Stencil::idx[S]) = omega_trm * src->get(x, y+1, z, Stencil::idx[S]) + omega_w1 * ( vel_trm_N_S - velY[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[N]) = omega_trm * src->get(xOff+x, y-1, z, Stencil::idx[N]) + omega_w1 * ( vel_trm_N_S + velY[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[S]) = omega_trm * src->get(xOff+x, y+1, z, Stencil::idx[S]) + omega_w1 * ( vel_trm_N_S - velY[x] );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_E_W = dir_indep_trm[x] + real_c(1.5) * velX[x] * velX[x];
 
-            dst->get(x,y,z,Stencil::idx[E]) = omega_trm * src->get(x-1, y, z, Stencil::idx[E]) + omega_w1 * ( vel_trm_E_W + velX[x] );
-            dst->get(x,y,z,Stencil::idx[W]) = omega_trm * src->get(x+1, y, z, Stencil::idx[W]) + omega_w1 * ( vel_trm_E_W - velX[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[E]) = omega_trm * src->get(xOff+x-1, y, z, Stencil::idx[E]) + omega_w1 * ( vel_trm_E_W + velX[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[W]) = omega_trm * src->get(xOff+x+1, y, z, Stencil::idx[W]) + omega_w1 * ( vel_trm_E_W - velX[x] );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_T_B = dir_indep_trm[x] + real_c(1.5) * velZ[x] * velZ[x];
 
-            dst->get(x,y,z,Stencil::idx[T]) = omega_trm * src->get(x, y, z-1, Stencil::idx[T]) + omega_w1 * ( vel_trm_T_B + velZ[x] );
-            dst->get(x,y,z,Stencil::idx[B]) = omega_trm * src->get(x, y, z+1, Stencil::idx[B]) + omega_w1 * ( vel_trm_T_B - velZ[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[T]) = omega_trm * src->get(xOff+x, y, z-1, Stencil::idx[T]) + omega_w1 * ( vel_trm_T_B + velZ[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[B]) = omega_trm * src->get(xOff+x, y, z+1, Stencil::idx[B]) + omega_w1 * ( vel_trm_T_B - velZ[x] );
          }
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
 
    delete[] velX;
@@ -423,8 +580,6 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 #ifdef _OPENMP
    }
 #endif
-
-   src->swapDataPointers( dst );
 }
 
 
@@ -754,6 +909,116 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
 
 
+#ifdef WALBERLA_LBM_SPLIT_PURE_SIMD
+
+namespace internal {
+
+/// Fused stream & collide kernel of the compressible D3Q19 SRT sweep for one vector/scalar of cells.
+/// The order of all floating point operations is identical to the X_LOOP implementation below, so both produce
+/// bit-identical results.
+class SRTSplitPureCompressibleKernel
+{
+public:
+
+   SRTSplitPureCompressibleKernel( const real_t omega_trm, const real_t omega_w0, const real_t omega_w1, const real_t omega_w2,
+                                   const real_t one_third ) :
+      omega_trm_( omega_trm ), omega_w0_( omega_w0 ), omega_w1_( omega_w1 ), omega_w2_( omega_w2 ), one_third_( one_third ) {}
+
+   template< typename Ops >
+   inline void cell( const split_pure_simd::D3Q19Line & l, const cell_idx_t x ) const
+   {
+      typedef typename Ops::value_type V;
+
+      const V omega_trm = Ops::broadcast( omega_trm_ );
+      const V omega_w0  = Ops::broadcast( omega_w0_ );
+      const V omega_w1  = Ops::broadcast( omega_w1_ );
+      const V omega_w2  = Ops::broadcast( omega_w2_ );
+      const V one_third = Ops::broadcast( one_third_ );
+      const V one       = Ops::broadcast( real_t(1) );
+      const V half      = Ops::broadcast( real_c(0.5) );
+      const V three_halves = Ops::broadcast( real_c(1.5) );
+
+      const V pNE = Ops::load( l.pNE + x ); const V pN  = Ops::load( l.pN  + x ); const V pNW = Ops::load( l.pNW + x );
+      const V pW  = Ops::load( l.pW  + x ); const V pSW = Ops::load( l.pSW + x ); const V pS  = Ops::load( l.pS  + x );
+      const V pSE = Ops::load( l.pSE + x ); const V pE  = Ops::load( l.pE  + x ); const V pT  = Ops::load( l.pT  + x );
+      const V pTE = Ops::load( l.pTE + x ); const V pTN = Ops::load( l.pTN + x ); const V pTW = Ops::load( l.pTW + x );
+      const V pTS = Ops::load( l.pTS + x ); const V pB  = Ops::load( l.pB  + x ); const V pBE = Ops::load( l.pBE + x );
+      const V pBN = Ops::load( l.pBN + x ); const V pBW = Ops::load( l.pBW + x ); const V pBS = Ops::load( l.pBS + x );
+      const V pC  = Ops::load( l.pC  + x );
+
+      const V velX_trm = pE + pNE + pSE + pTE + pBE;
+      const V velY_trm = pN + pNW + pTN + pBN;
+      const V velZ_trm = pT + pTS + pTW;
+
+      const V rho = pC + pS + pW + pB + pSW + pBS + pBW + velX_trm + velY_trm + velZ_trm;
+
+      const V rho_inv = one / rho;
+
+      const V velX = rho_inv * ( velX_trm - pW  - pNW - pSW - pTW - pBW );
+      const V velY = rho_inv * ( velY_trm + pNE - pS  - pSW - pSE - pTS - pBS );
+      const V velZ = rho_inv * ( velZ_trm + pTN + pTE - pB  - pBN - pBS - pBW - pBE );
+
+      const V dir_indep_trm = one_third - half * ( velX * velX + velY * velY + velZ * velZ );
+
+      Ops::store( l.dC + x, omega_trm * pC + omega_w0 * rho * dir_indep_trm );
+
+      const V velXMY = velX - velY;
+      const V vel_trm_NW_SE = dir_indep_trm + three_halves * velXMY * velXMY;
+      Ops::store( l.dNW + x, omega_trm * pNW + omega_w2 * rho * ( vel_trm_NW_SE - velXMY ) );
+      Ops::store( l.dSE + x, omega_trm * pSE + omega_w2 * rho * ( vel_trm_NW_SE + velXMY ) );
+
+      const V velXPY = velX + velY;
+      const V vel_trm_NE_SW = dir_indep_trm + three_halves * velXPY * velXPY;
+      Ops::store( l.dNE + x, omega_trm * pNE + omega_w2 * rho * ( vel_trm_NE_SW + velXPY ) );
+      Ops::store( l.dSW + x, omega_trm * pSW + omega_w2 * rho * ( vel_trm_NE_SW - velXPY ) );
+
+      const V velXMZ = velX - velZ;
+      const V vel_trm_TW_BE = dir_indep_trm + three_halves * velXMZ * velXMZ;
+      Ops::store( l.dTW + x, omega_trm * pTW + omega_w2 * rho * ( vel_trm_TW_BE - velXMZ ) );
+      Ops::store( l.dBE + x, omega_trm * pBE + omega_w2 * rho * ( vel_trm_TW_BE + velXMZ ) );
+
+      const V velXPZ = velX + velZ;
+      const V vel_trm_TE_BW = dir_indep_trm + three_halves * velXPZ * velXPZ;
+      Ops::store( l.dTE + x, omega_trm * pTE + omega_w2 * rho * ( vel_trm_TE_BW + velXPZ ) );
+      Ops::store( l.dBW + x, omega_trm * pBW + omega_w2 * rho * ( vel_trm_TE_BW - velXPZ ) );
+
+      const V velYMZ = velY - velZ;
+      const V vel_trm_TS_BN = dir_indep_trm + three_halves * velYMZ * velYMZ;
+      Ops::store( l.dTS + x, omega_trm * pTS + omega_w2 * rho * ( vel_trm_TS_BN - velYMZ ) );
+      Ops::store( l.dBN + x, omega_trm * pBN + omega_w2 * rho * ( vel_trm_TS_BN + velYMZ ) );
+
+      const V velYPZ = velY + velZ;
+      const V vel_trm_TN_BS = dir_indep_trm + three_halves * velYPZ * velYPZ;
+      Ops::store( l.dTN + x, omega_trm * pTN + omega_w2 * rho * ( vel_trm_TN_BS + velYPZ ) );
+      Ops::store( l.dBS + x, omega_trm * pBS + omega_w2 * rho * ( vel_trm_TN_BS - velYPZ ) );
+
+      const V vel_trm_N_S = dir_indep_trm + three_halves * velY * velY;
+      Ops::store( l.dN + x, omega_trm * pN + omega_w1 * rho * ( vel_trm_N_S + velY ) );
+      Ops::store( l.dS + x, omega_trm * pS + omega_w1 * rho * ( vel_trm_N_S - velY ) );
+
+      const V vel_trm_E_W = dir_indep_trm + three_halves * velX * velX;
+      Ops::store( l.dE + x, omega_trm * pE + omega_w1 * rho * ( vel_trm_E_W + velX ) );
+      Ops::store( l.dW + x, omega_trm * pW + omega_w1 * rho * ( vel_trm_E_W - velX ) );
+
+      const V vel_trm_T_B = dir_indep_trm + three_halves * velZ * velZ;
+      Ops::store( l.dT + x, omega_trm * pT + omega_w1 * rho * ( vel_trm_T_B + velZ ) );
+      Ops::store( l.dB + x, omega_trm * pB + omega_w1 * rho * ( vel_trm_T_B - velZ ) );
+   }
+
+private:
+
+   const real_t omega_trm_;
+   const real_t omega_w0_;
+   const real_t omega_w1_;
+   const real_t omega_w2_;
+   const real_t one_third_;
+};
+
+} // namespace internal
+
+#endif // WALBERLA_LBM_SPLIT_PURE_SIMD
+
+
 ///////////////////////////////
 // Specialization for D3Q19: //
 // - compressible          //
@@ -790,7 +1055,43 @@ public:
    SplitPureSweep( const BlockDataID & src, const BlockDataID & dst ) :
       SweepBase<LatticeModel_T>( src, dst ) {}
 
-   void operator()( IBlock * const block );
+   void operator()( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getFields( block, src, dst );
+
+      streamCollide( src, dst, src->xyzSize() );
+      src->swapDataPointers( dst );
+   }
+
+   // 'inner' + 'frame' == 'operator()', see lbm::CellwiseSweep
+   void inner( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getBlockLocalFields( block, src, dst );
+
+      const CellInterval cells = innerCells< Stencil >( src->xyzSize() );
+      if( !cells.empty() )
+         streamCollide( src, dst, cells );
+   }
+
+   void frame( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getBlockLocalFields( block, src, dst );
+
+      const std::vector< CellInterval > cells = frameCells< Stencil >( src->xyzSize() );
+      for( auto interval = cells.begin(); interval != cells.end(); ++interval )
+         streamCollide( src, dst, *interval );
+      src->swapDataPointers( dst );
+      this->releaseBlockLocalDstField( block );
+   }
+
+   /// stream & collide for all cells in 'cells' (src and dst are NOT swapped)
+   void streamCollide( PdfField_T * const src, PdfField_T * const dst, const CellInterval & cells );
 
    void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
    void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
@@ -804,14 +1105,13 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
                                                                                   boost::mpl::bool_< LatticeModel_T::compressible >,
                                                                                   boost::is_same< typename LatticeModel_T::ForceModel::tag,
                                                                                                   force_model::None_tag > > >::type
-   >::operator()( IBlock * const block )
+   >::streamCollide( PdfField_T * const src, PdfField_T * const dst, const CellInterval & cells )
 {
-   PdfField_T * src( NULL );
-   PdfField_T * dst( NULL );
-
-   this->getFields( block, src, dst );
-
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
+   WALBERLA_ASSERT_EQUAL( src->xyzSize(), dst->xyzSize() );
    WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT( src->xyzSize().contains( cells ) );
 
    // constants used during stream/collide
 
@@ -825,7 +1125,21 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    // loop constants
 
-   const cell_idx_t xSize = cell_idx_c( src->xSize() );
+   const cell_idx_t xOff  = cells.xMin(); // x-lines start at x = xOff, x below is relative to xOff
+   const cell_idx_t xSize = cell_idx_c( cells.xSize() );
+
+#ifdef WALBERLA_LBM_SPLIT_PURE_SIMD
+   if( internal::split_pure_simd::isApplicable( src, dst ) )
+   {
+      const internal::SRTSplitPureCompressibleKernel kernel( omega_trm, omega_w0, omega_w1, omega_w2, one_third );
+
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp parallel for schedule(static),
+         internal::split_pure_simd::processLine( kernel, internal::split_pure_simd::D3Q19Line( src, dst, xOff, y, z ), xSize );
+      )
+
+      return;
+   }
+#endif
 
 #ifdef _OPENMP
    #pragma omp parallel
@@ -843,31 +1157,31 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    if( src->layout() == field::fzyx && dst->layout() == field::fzyx )
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp for schedule(static),
 
          using namespace stencil;
 
-         real_t * WALBERLA_RESTRICT pNE = &src->get(-1, y-1, z  , Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT pN  = &src->get(0 , y-1, z  , Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT pNW = &src->get(+1, y-1, z  , Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT pW  = &src->get(+1, y  , z  , Stencil::idx[W]);
-         real_t * WALBERLA_RESTRICT pSW = &src->get(+1, y+1, z  , Stencil::idx[SW]);
-         real_t * WALBERLA_RESTRICT pS  = &src->get(0 , y+1, z  , Stencil::idx[S]);
-         real_t * WALBERLA_RESTRICT pSE = &src->get(-1, y+1, z  , Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT pE  = &src->get(-1, y  , z  , Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT pT  = &src->get(0 , y  , z-1, Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT pTE = &src->get(-1, y  , z-1, Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT pTN = &src->get(0 , y-1, z-1, Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT pTW = &src->get(+1, y  , z-1, Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT pTS = &src->get(0 , y+1, z-1, Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT pB  = &src->get(0 , y  , z+1, Stencil::idx[B]);
-         real_t * WALBERLA_RESTRICT pBE = &src->get(-1, y  , z+1, Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT pBN = &src->get(0 , y-1, z+1, Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT pBW = &src->get(+1, y  , z+1, Stencil::idx[BW]);
-         real_t * WALBERLA_RESTRICT pBS = &src->get(0 , y+1, z+1, Stencil::idx[BS]);
-         real_t * WALBERLA_RESTRICT pC  = &src->get(0 , y  , z  , Stencil::idx[C]);
-
-         real_t * WALBERLA_RESTRICT dC = &dst->get(0,y,z,Stencil::idx[C]);
+         real_t * WALBERLA_RESTRICT pNE = &src->get(xOff-1, y-1, z  , Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT pN  = &src->get(xOff  , y-1, z  , Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT pNW = &src->get(xOff+1, y-1, z  , Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT pW  = &src->get(xOff+1, y  , z  , Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT pSW = &src->get(xOff+1, y+1, z  , Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT pS  = &src->get(xOff  , y+1, z  , Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT pSE = &src->get(xOff-1, y+1, z  , Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT pE  = &src->get(xOff-1, y  , z  , Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT pT  = &src->get(xOff  , y  , z-1, Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT pTE = &src->get(xOff-1, y  , z-1, Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT pTN = &src->get(xOff  , y-1, z-1, Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT pTW = &src->get(xOff+1, y  , z-1, Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT pTS = &src->get(xOff  , y+1, z-1, Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT pB  = &src->get(xOff  , y  , z+1, Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT pBE = &src->get(xOff-1, y  , z+1, Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT pBN = &src->get(xOff  , y-1, z+1, Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT pBW = &src->get(xOff+1, y  , z+1, Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT pBS = &src->get(xOff  , y+1, z+1, Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT pC  = &src->get(xOff  , y  , z  , Stencil::idx[C]);
+
+         real_t * WALBERLA_RESTRICT dC = &dst->get(xOff,y,z,Stencil::idx[C]);
 
          X_LOOP
          (
@@ -887,8 +1201,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
               dC[x] = omega_trm * pC[x] + omega_w0 * rho[x] * dir_indep_trm[x];
          )
 
-         real_t * WALBERLA_RESTRICT dNW = &dst->get(0,y,z,Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT dSE = &dst->get(0,y,z,Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT dNW = &dst->get(xOff,y,z,Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT dSE = &dst->get(xOff,y,z,Stencil::idx[SE]);
 
          X_LOOP
          (
@@ -899,8 +1213,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSE[x] = omega_trm * pSE[x] + omega_w2 * rho[x] * ( vel_trm_NW_SE + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dNE = &dst->get(0,y,z,Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT dSW = &dst->get(0,y,z,Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT dNE = &dst->get(xOff,y,z,Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT dSW = &dst->get(xOff,y,z,Stencil::idx[SW]);
 
          X_LOOP
          (
@@ -911,8 +1225,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSW[x] = omega_trm * pSW[x] + omega_w2 * rho[x] * ( vel_trm_NE_SW - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTW = &dst->get(0,y,z,Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT dBE = &dst->get(0,y,z,Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT dTW = &dst->get(xOff,y,z,Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT dBE = &dst->get(xOff,y,z,Stencil::idx[BE]);
 
          X_LOOP
          (
@@ -923,8 +1237,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBE[x] = omega_trm * pBE[x] + omega_w2 * rho[x] * ( vel_trm_TW_BE + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTE = &dst->get(0,y,z,Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT dBW = &dst->get(0,y,z,Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT dTE = &dst->get(xOff,y,z,Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT dBW = &dst->get(xOff,y,z,Stencil::idx[BW]);
 
 
          X_LOOP
@@ -936,8 +1250,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBW[x] = omega_trm * pBW[x] + omega_w2 * rho[x] * ( vel_trm_TE_BW - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTS = &dst->get(0,y,z,Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT dBN = &dst->get(0,y,z,Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT dTS = &dst->get(xOff,y,z,Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT dBN = &dst->get(xOff,y,z,Stencil::idx[BN]);
 
          X_LOOP
          (
@@ -948,8 +1262,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBN[x] = omega_trm * pBN[x] + omega_w2 * rho[x] * ( vel_trm_TS_BN + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTN = &dst->get(0,y,z,Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT dBS = &dst->get(0,y,z,Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT dTN = &dst->get(xOff,y,z,Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT dBS = &dst->get(xOff,y,z,Stencil::idx[BS]);
 
          X_LOOP
          (
@@ -960,8 +1274,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBS[x] = omega_trm * pBS[x] + omega_w2 * rho[x] * ( vel_trm_TN_BS - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dN = &dst->get(0,y,z,Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT dS = &dst->get(0,y,z,Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT dN = &dst->get(xOff,y,z,Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT dS = &dst->get(xOff,y,z,Stencil::idx[S]);
 
          X_LOOP
          (
@@ -971,8 +1285,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dS[x] = omega_trm * pS[x] + omega_w1 * rho[x] * ( vel_trm_N_S - velY[x] );
          )
 
-         real_t * WALBERLA_RESTRICT dE = &dst->get(0,y,z,Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT dW = &dst->get(0,y,z,Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT dE = &dst->get(xOff,y,z,Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT dW = &dst->get(xOff,y,z,Stencil::idx[W]);
 
          X_LOOP
          (
@@ -982,8 +1296,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dW[x] = omega_trm * pW[x] + omega_w1 * rho[x] * ( vel_trm_E_W - velX[x] );
          )
 
-         real_t * WALBERLA_RESTRICT dT = &dst->get(0,y,z,Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT dB = &dst->get(0,y,z,Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT dT = &dst->get(xOff,y,z,Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT dB = &dst->get(xOff,y,z,Stencil::idx[B]);
 
          X_LOOP
          (
@@ -993,35 +1307,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dB[x] = omega_trm * pB[x] + omega_w1 * rho[x] * ( vel_trm_T_B - velZ[x] );
          )
 
-       ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+       ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
    else // ==> src->layout() == field::zyxf || dst->layout() == field::zyxf
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp for schedule(static),
 
          using namespace stencil;
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z  , Stencil::idx[NE]);
-            const real_t dd_tmp_N  = src->get(x  , y-1, z  , Stencil::idx[N]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z  , Stencil::idx[NW]);
-            const real_t dd_tmp_W  = src->get(x+1, y  , z  , Stencil::idx[W]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z  , Stencil::idx[SW]);
-            const real_t dd_tmp_S  = src->get(x  , y+1, z  , Stencil::idx[S]);
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z  , Stencil::idx[SE]);
-            const real_t dd_tmp_E  = src->get(x-1, y  , z  , Stencil::idx[E]);
-            const real_t dd_tmp_T  = src->get(x  , y  , z-1, Stencil::idx[T]);
-            const real_t dd_tmp_TE = src->get(x-1, y  , z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_TN = src->get(x  , y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_TW = src->get(x+1, y  , z-1, Stencil::idx[TW]);
-            const real_t dd_tmp_TS = src->get(x  , y+1, z-1, Stencil::idx[TS]);
-            const real_t dd_tmp_B  = src->get(x  , y  , z+1, Stencil::idx[B]);
-            const real_t dd_tmp_BE = src->get(x-1, y  , z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_BN = src->get(x  , y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_BW = src->get(x+1, y  , z+1, Stencil::idx[BW]);
-            const real_t dd_tmp_BS = src->get(x  , y+1, z+1, Stencil::idx[BS]);
-            const real_t dd_tmp_C  = src->get(x  , y  , z  , Stencil::idx[C]);
+            const real_t dd_tmp_NE = src->get(xOff+x-1, y-1, z  , Stencil::idx[NE]);
+            const real_t dd_tmp_N  = src->get(xOff+x  , y-1, z  , Stencil::idx[N]);
+            const real_t dd_tmp_NW = src->get(xOff+x+1, y-1, z  , Stencil::idx[NW]);
+            const real_t dd_tmp_W  = src->get(xOff+x+1, y  , z  , Stencil::idx[W]);
+            const real_t dd_tmp_SW = src->get(xOff+x+1, y+1, z  , Stencil::idx[SW]);
+            const real_t dd_tmp_S  = src->get(xOff+x  , y+1, z  , Stencil::idx[S]);
+            const real_t dd_tmp_SE = src->get(xOff+x-1, y+1, z  , Stencil::idx[SE]);
+            const real_t dd_tmp_E  = src->get(xOff+x-1, y  , z  , Stencil::idx[E]);
+            const real_t dd_tmp_T  = src->get(xOff+x  , y  , z-1, Stencil::idx[T]);
+            const real_t dd_tmp_TE = src->get(xOff+x-1, y  , z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_TN = src->get(xOff+x  , y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_TW = src->get(xOff+x+1, y  , z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_TS = src->get(xOff+x  , y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_B  = src->get(xOff+x  , y  , z+1, Stencil::idx[B]);
+            const real_t dd_tmp_BE = src->get(xOff+x-1, y  , z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_BN = src->get(xOff+x  , y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_BW = src->get(xOff+x+1, y  , z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_BS = src->get(xOff+x  , y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_C  = src->get(xOff+x  , y  , z  , Stencil::idx[C]);
 
             const real_t velX_trm = dd_tmp_E + dd_tmp_NE + dd_tmp_SE + dd_tmp_TE + dd_tmp_BE;
             const real_t velY_trm = dd_tmp_N + dd_tmp_NW + dd_tmp_TN + dd_tmp_BN;
@@ -1036,7 +1350,7 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
             dir_indep_trm[x] = one_third - real_c(0.5) * ( velX[x] * velX[x] + velY[x] * velY[x] + velZ[x] * velZ[x] );
 
-            dst->get(x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * rho[x] * dir_indep_trm[x];
+            dst->get(xOff+x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * rho[x] * dir_indep_trm[x];
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1044,8 +1358,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] - velY[x];
             const real_t vel_trm_NW_SE = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[NW]) = omega_trm * src->get(x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * rho[x] * ( vel_trm_NW_SE - vel );
-            dst->get(x,y,z,Stencil::idx[SE]) = omega_trm * src->get(x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * rho[x] * ( vel_trm_NW_SE + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[NW]) = omega_trm * src->get(xOff+x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * rho[x] * ( vel_trm_NW_SE - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[SE]) = omega_trm * src->get(xOff+x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * rho[x] * ( vel_trm_NW_SE + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1053,8 +1367,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] + velY[x];
             const real_t vel_trm_NE_SW = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[NE]) = omega_trm * src->get(x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * rho[x] * ( vel_trm_NE_SW + vel );
-            dst->get(x,y,z,Stencil::idx[SW]) = omega_trm * src->get(x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * rho[x] * ( vel_trm_NE_SW - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[NE]) = omega_trm * src->get(xOff+x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * rho[x] * ( vel_trm_NE_SW + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[SW]) = omega_trm * src->get(xOff+x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * rho[x] * ( vel_trm_NE_SW - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1062,8 +1376,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] - velZ[x];
             const real_t vel_trm_TW_BE = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TW]) = omega_trm * src->get(x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * rho[x] * ( vel_trm_TW_BE - vel );
-            dst->get(x,y,z,Stencil::idx[BE]) = omega_trm * src->get(x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * rho[x] * ( vel_trm_TW_BE + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[TW]) = omega_trm * src->get(xOff+x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * rho[x] * ( vel_trm_TW_BE - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[BE]) = omega_trm * src->get(xOff+x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * rho[x] * ( vel_trm_TW_BE + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1071,8 +1385,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] + velZ[x];
             const real_t vel_trm_TE_BW = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TE]) = omega_trm * src->get(x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * rho[x] * ( vel_trm_TE_BW + vel );
-            dst->get(x,y,z,Stencil::idx[BW]) = omega_trm * src->get(x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * rho[x] * ( vel_trm_TE_BW - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[TE]) = omega_trm * src->get(xOff+x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * rho[x] * ( vel_trm_TE_BW + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[BW]) = omega_trm * src->get(xOff+x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * rho[x] * ( vel_trm_TE_BW - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1080,8 +1394,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velY[x] - velZ[x];
             const real_t vel_trm_TS_BN = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TS]) = omega_trm * src->get(x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * rho[x] * ( vel_trm_TS_BN - vel );
-            dst->get(x,y,z,Stencil::idx[BN]) = omega_trm * src->get(x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * rho[x] * ( vel_trm_TS_BN + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[TS]) = omega_trm * src->get(xOff+x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * rho[x] * ( vel_trm_TS_BN - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[BN]) = omega_trm * src->get(xOff+x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * rho[x] * ( vel_trm_TS_BN + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1089,35 +1403,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velY[x] + velZ[x];
             const real_t vel_trm_TN_BS = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TN]) = omega_trm * src->get(x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * rho[x] * ( vel_trm_TN_BS + vel );
-            dst->get(x,y,z,Stencil::idx[BS]) = omega_trm * src->get(x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * rho[x] * ( vel_trm_TN_BS - vel );
+            dst->get(xOff+x,y,z,Stencil::idx[TN]) = omega_trm * src->get(xOff+x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * rho[x] * ( vel_trm_TN_BS + vel );
+            dst->get(xOff+x,y,z,Stencil::idx[BS]) = omega_trm * src->get(xOff+x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * rho[x] * ( vel_trm_TN_BS - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_N_S = dir_indep_trm[x] + real_c(1.5) * velY[x] * velY[x];
 
-            dst->get(x,y,z,Stencil::idx[N]) = omega_trm * src->get(x, y-1, z, Stencil::idx[N]) + omega_w1 * rho[x] * ( vel_trm_N_S + velY[x] );
-            dst->get(x,y,z,Stencil::idx[S]) = omega_trm * src->get(x, y+1, z, Stencil::idx[S]) + omega_w1 * rho[x] * ( vel_trm_N_S - velY[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[N]) = omega_trm * src->get(xOff+x, y-1, z, Stencil::idx[N]) + omega_w1 * rho[x] * ( vel_trm_N_S + velY[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[S]) = omega_trm * src->get(xOff+x, y+1, z, Stencil::idx[S]) + omega_w1 * rho[x] * ( vel_trm_N_S - velY[x] );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_E_W = dir_indep_trm[x] + real_c(1.5) * velX[x] * velX[x];
 
-            dst->get(x,y,z,Stencil::idx[E]) = omega_trm * src->get(x-1, y, z, Stencil::idx[E]) + omega_w1 * rho[x] * ( vel_trm_E_W + velX[x] );
-            dst->get(x,y,z,Stencil::idx[W]) = omega_trm * src->get(x+1, y, z, Stencil::idx[W]) + omega_w1 * rho[x] * ( vel_trm_E_W - velX[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[E]) = omega_trm * src->get(xOff+x-1, y, z, Stencil::idx[E]) + omega_w1 * rho[x] * ( vel_trm_E_W + velX[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[W]) = omega_trm * src->get(xOff+x+1, y, z, Stencil::idx[W]) + omega_w1 * rho[x] * ( vel_trm_E_W - velX[x] );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_T_B = dir_indep_trm[x] + real_c(1.5) * velZ[x] * velZ[x];
 
-            dst->get(x,y,z,Stencil::idx[T]) = omega_trm * src->get(x, y, z-1, Stencil::idx[T]) + omega_w1 * rho[x] * ( vel_trm_T_B + velZ[x] );
-            dst->get(x,y,z,Stencil::idx[B]) = omega_trm * src->get(x, y, z+1, Stencil::idx[B]) + omega_w1 * rho[x] * ( vel_trm_T_B - velZ[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[T]) = omega_trm * src->get(xOff+x, y, z-1, Stencil::idx[T]) + omega_w1 * rho[x] * ( vel_trm_T_B + velZ[x] );
+            dst->get(xOff+x,y,z,Stencil::idx[B]) = omega_trm * src->get(xOff+x, y, z+1, Stencil::idx[B]) + omega_w1 * rho[x] * ( vel_trm_T_B - velZ[x] );
          }
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
 
    delete[] velX;
@@ -1129,8 +1443,6 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 #ifdef _OPENMP
    }
 #endif
-
-   src->swapDataPointers( dst );
 }
 
 template< typename LatticeModel_T >
@@ -129,7 +129,51 @@ class CellwiseSweep
          streamCollide( block, numberOfGhostLayersToInclude ); \
       } \
       \
-      void streamCollide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) ); \
+      void streamCollide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) ) \
+      { \
+         PdfField_T * src( NULL ); \
+         PdfField_T * dst( NULL ); \
+         this->getFields( block, src, dst ); \
+         \
+         WALBERLA_ASSERT_GREATER( src->nrOfGhostLayers(), numberOfGhostLayersToInclude ); \
+         WALBERLA_ASSERT_GREATER_EQUAL( dst->nrOfGhostLayers(), numberOfGhostLayersToInclude ); \
+         \
+         CellInterval cells = src->xyzSize(); \
+         cells.expand( cell_idx_c( numberOfGhostLayersToInclude ) ); \
+         streamCollide( block, src, dst, cells ); \
+         src->swapDataPointers( dst ); \
+      } \
+      \
+      /* 'inner' + 'frame' == 'streamCollide': 'inner' updates all cells that do not depend on ghost layer data */ \
+      /* (-> can be executed while the ghost layers are communicated), 'frame' updates the remaining cells and */ \
+      /* swaps src and dst. Both must be called for every block, 'inner' must be called first. Contrary to */ \
+      /* 'streamCollide', every block needs its own temporary dst field (see SweepBase::getBlockLocalDstField). */ \
+      void inner( IBlock * const block ) \
+      { \
+         PdfField_T * src( NULL ); \
+         PdfField_T * dst( NULL ); \
+         this->getBlockLocalFields( block, src, dst ); \
+         \
+         const CellInterval cells = innerCells< Stencil_T >( src->xyzSize() ); \
+         if( !cells.empty() ) \
+            streamCollide( block, src, dst, cells ); \
+      } \
+      \
+      void frame( IBlock * const block ) \
+      { \
+         PdfField_T * src( NULL ); \
+         PdfField_T * dst( NULL ); \
+         this->getBlockLocalFields( block, src, dst ); \
+         \
+         const std::vector< CellInterval > cells = frameCells< Stencil_T >( src->xyzSize() ); \
+         for( auto interval = cells.begin(); interval != cells.end(); ++interval ) \
+            streamCollide( block, src, dst, *interval ); \
+         src->swapDataPointers( dst ); \
+         this->releaseBlockLocalDstField( block ); \
+      } \
+      \
+      /* stream & collide for all cells in 'cells' (src and dst are NOT swapped) */ \
+      void streamCollide( IBlock * const block, PdfField_T * const src, PdfField_T * const dst, const CellInterval & cells ); \
       \
       void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) ); \
       void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) ); \
@@ -150,15 +194,12 @@ class CellwiseSweep
 #define WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( specialization) \
    template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T > \
    void CellwiseSweep< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T, typename boost::enable_if< specialization >::type \
-      >::streamCollide( IBlock * const block, const uint_t numberOfGhostLayersToInclude ) \
+      >::streamCollide( IBlock * const block, PdfField_T * const src, PdfField_T * const dst, const CellInterval & cells ) \
    { \
-      PdfField_T * src( NULL ); \
-      PdfField_T * dst( NULL ); \
-      \
-      this->getFields( block, src, dst ); \
-      \
-      WALBERLA_ASSERT_GREATER( src->nrOfGhostLayers(), numberOfGhostLayersToInclude ); \
-      WALBERLA_ASSERT_GREATER_EQUAL( dst->nrOfGhostLayers(), numberOfGhostLayersToInclude ); \
+      WALBERLA_ASSERT_NOT_NULLPTR( src ); \
+      WALBERLA_ASSERT_NOT_NULLPTR( dst ); \
+      WALBERLA_ASSERT_EQUAL( src->xyzSize(), dst->xyzSize() ); \
+      WALBERLA_ASSERT( dst->xyzSizeWithGhostLayer().contains( cells ) ); \
       \
       const auto & lm = src->latticeModel(); \
       dst->resetLatticeModel( lm ); /* required so that member functions for getting density and equilibrium velocity can be called for dst! */ \
@@ -167,7 +208,7 @@ class CellwiseSweep
       this->densityVelocityIn( *block ); \
       this->densityVelocityOut( *block );
 
-#define WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT() src->swapDataPointers( dst ); }
+#define WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT() }
 
 
 
@@ -0,0 +1,96 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InPlaceSweep.h
+//! \ingroup lbm
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "lbm/sweeps/InPlaceTimeStep.h"
+
+#include "core/DataTypes.h"
+#include "core/math/Vector3.h"
+
+
+
+namespace walberla {
+namespace lbm {
+
+//**********************************************************************************************************************
+/*!
+*   \brief Stream & collide sweep that operates in-place on a single PDF field (AA pattern)
+*
+*   Contrary to all other LB sweeps, no temporary destination field is allocated, which halves the memory required
+*   for storing the PDFs. Even and odd time steps are executed by different kernels ('even()' and 'odd()'),
+*   'operator()' selects the correct kernel depending on the shared lbm::InPlaceTimeStep object.
+*   The kernels are "pure" kernels, i.e., they are executed on all cells of a block (including obstacle cells).
+*
+*   A time step with the in-place sweep must be set up as follows:
+*     1. execute the in-place sweep on all blocks
+*     2. advance the lbm::InPlaceTimeStep object
+*     3. communicate the PDF field with an lbm::InPlacePdfFieldPackInfo
+*     4. execute the boundary handling (only boundary conditions that support the AA pattern can be used, see for
+*        example lbm::InPlaceNoSlip and lbm::InPlaceSimpleUBB)
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T, class Enable = void >
+class InPlaceSweep
+{
+   static_assert( never_true<LatticeModel_T>::value, "Instantiating 'lbm::InPlaceSweep' failed, possible reasons:\n"
+                                                     " - For your current LB lattice model, there is yet no implementation for class 'lbm::InPlaceSweep'.\n"
+                                                     "   Only SRT and TRT lattice models with constant relaxation parameters and no additional forces are supported.\n"
+                                                     " - You are providing more than just one template argument to class 'lbm::InPlaceSweep'.\n"
+                                                     "   'lbm::InPlaceSweep' only needs the type of the lattice model - no further template arguments are required!" );
+};
+
+
+
+namespace internal {
+
+template< typename LatticeModel_T >
+inline real_t getInPlaceDensityAndVelocity( Vector3< real_t > & velocity, const real_t * const pdfs )
+{
+   typedef typename LatticeModel_T::Stencil Stencil;
+
+   real_t rho = LatticeModel_T::compressible ? real_t(0) : real_t(1);
+   velocity = Vector3< real_t >( real_t(0) );
+
+   for( auto d = Stencil::begin(); d != Stencil::end(); ++d )
+   {
+      const real_t pdf = pdfs[ d.toIdx() ];
+      rho += pdf;
+      velocity[0] += real_c( d.cx() ) * pdf;
+      velocity[1] += real_c( d.cy() ) * pdf;
+      velocity[2] += real_c( d.cz() ) * pdf;
+   }
+
+   if( LatticeModel_T::compressible )
+      velocity *= real_t(1) / rho;
+
+   return rho;
+}
+
+} // namespace internal
+
+
+
+} // namespace lbm
+} // namespace walberla
+
+#include "lbm/srt/InPlaceSweep.impl.h"
+#include "lbm/trt/InPlaceSweep.impl.h"
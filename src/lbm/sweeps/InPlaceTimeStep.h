@@ -0,0 +1,79 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InPlaceTimeStep.h
+//! \ingroup lbm
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "core/DataTypes.h"
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Keeps track of the time step parity for the in-place (AA-pattern) streaming scheme
+*
+*   With the AA pattern, only one PDF field is required per block. Even and odd time steps use different kernels:
+*
+*   - even time step: every cell reads its own PDFs, collides, and writes the post-collision value of direction 'i'
+*                     into the slot of the inverse direction of the same cell (no neighbor access)
+*   - odd time step:  every cell gathers the PDFs of direction 'i' from the inverse slot of its neighbor at x - c_i,
+*                     collides, and writes the post-collision value of direction 'i' into slot 'i' of its neighbor at
+*                     x + c_i (both, reads and writes, touch the same memory locations -> no data races)
+*
+*   One instance of this class must be shared between the in-place sweep (lbm::InPlaceSweep), the in-place pack info
+*   (lbm::InPlacePdfFieldPackInfo), and all in-place boundary conditions of a simulation. The instance must be advanced
+*   (see 'advance()' / 'operator()') after the sweep has been executed on all blocks and before communication and
+*   boundary handling take place.
+*
+*   The PDF field only holds its "natural" state (= identical to the state of a two-grid stream-pull scheme) if an
+*   even time step is next ('isEven() == true'). After even time steps, the PDFs of every cell are stored in the slots
+*   of the inverse directions: the density can still be evaluated, the velocity, however, is reversed.
+*/
+//**********************************************************************************************************************
+
+class InPlaceTimeStep
+{
+public:
+
+   InPlaceTimeStep() : counter_( uint_t(0) ) {}
+
+   /// true if the next time step is an even time step (= the last executed time step was odd)
+   bool isEven() const { return ( counter_ & uint_t(1) ) == uint_t(0); }
+   /// true if the next time step is an odd time step (= the last executed time step was even)
+   bool isOdd() const { return !isEven(); }
+
+   uint_t counter() const { return counter_; }
+
+   void advance() { ++counter_; }
+   void operator()() { advance(); }
+
+private:
+
+   uint_t counter_;
+
+}; // class InPlaceTimeStep
+
+
+
+} // namespace lbm
+} // namespace walberla
@@ -0,0 +1,96 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InnerFrameSplit.h
+//! \ingroup lbm
+//! \brief Splitting of a block into the cells that can be updated without ghost layer data and the remaining frame
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "core/DataTypes.h"
+#include "core/cell/CellInterval.h"
+
+#include <vector>
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Returns all cells of 'cells' whose stream-pull update does not access any cell outside of 'cells'
+*
+*   For all stencils with a reach of one cell, this is 'cells' shrunk by one cell in every dimension of the stencil
+*   (2D stencils do not access neighbors in z-direction, hence, the z-extent remains unchanged). The returned interval
+*   is empty if 'cells' is too thin to have an interior.
+*/
+//**********************************************************************************************************************
+template< typename Stencil_T >
+inline CellInterval innerCells( const CellInterval & cells )
+{
+   const cell_idx_t dz = ( Stencil_T::D == uint_t(3) ) ? cell_idx_t(1) : cell_idx_t(0);
+
+   return CellInterval( cells.xMin() + cell_idx_t(1), cells.yMin() + cell_idx_t(1), cells.zMin() + dz,
+                        cells.xMax() - cell_idx_t(1), cells.yMax() - cell_idx_t(1), cells.zMax() - dz );
+}
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Returns disjoint intervals that cover all cells of 'cells' that are not contained in 'innerCells( cells )'
+*
+*   If 'cells' has an interior, the frame consists of (at most) six slabs: two xy-slabs (full size, 3D stencils only),
+*   two xz-slabs (without the cells of the xy-slabs), and two yz-slabs (only the interior y- and z-range). The slabs
+*   are ordered such that the first ones contain the longest x-lines. Otherwise, the frame is 'cells' itself.
+*/
+//**********************************************************************************************************************
+template< typename Stencil_T >
+inline std::vector< CellInterval > frameCells( const CellInterval & cells )
+{
+   std::vector< CellInterval > frame;
+
+   const CellInterval inner = innerCells< Stencil_T >( cells );
+
+   if( inner.empty() )
+   {
+      if( !cells.empty() )
+         frame.push_back( cells );
+      return frame;
+   }
+
+   if( Stencil_T::D == uint_t(3) )
+   {
+      frame.push_back( CellInterval( cells.xMin(), cells.yMin(), cells.zMin(), cells.xMax(), cells.yMax(), cells.zMin() ) );
+      frame.push_back( CellInterval( cells.xMin(), cells.yMin(), cells.zMax(), cells.xMax(), cells.yMax(), cells.zMax() ) );
+   }
+
+   frame.push_back( CellInterval( cells.xMin(), cells.yMin(), inner.zMin(), cells.xMax(), cells.yMin(), inner.zMax() ) );
+   frame.push_back( CellInterval( cells.xMin(), cells.yMax(), inner.zMin(), cells.xMax(), cells.yMax(), inner.zMax() ) );
+
+   frame.push_back( CellInterval( cells.xMin(), inner.yMin(), inner.zMin(), cells.xMin(), inner.yMax(), inner.zMax() ) );
+   frame.push_back( CellInterval( cells.xMax(), inner.yMin(), inner.zMin(), cells.xMax(), inner.yMax(), inner.zMax() ) );
+
+   return frame;
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
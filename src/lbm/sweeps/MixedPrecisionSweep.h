@@ -0,0 +1,235 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file MixedPrecisionSweep.h
+//! \ingroup lbm
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "lbm/field/MixedPrecisionPdfField.h"
+#include "lbm/field/Equilibrium.h"
+#include "lbm/lattice_model/CollisionModel.h"
+#include "lbm/lattice_model/EquilibriumDistribution.h"
+#include "lbm/lattice_model/ForceModel.h"
+
+#include "core/DataTypes.h"
+#include "core/debug/Debug.h"
+#include "core/math/Vector3.h"
+
+#include "domain_decomposition/IBlock.h"
+
+#include "field/SwapableCompare.h"
+#include "field/iterators/IteratorMacros.h"
+
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <limits>
+#include <set>
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+namespace internal {
+
+template< typename LatticeModel_T, class Enable = void >
+struct MixedPrecisionCollision
+{
+   static_assert( never_true<LatticeModel_T>::value, "For your current LB collision model, there is yet no implementation for class 'lbm::MixedPrecisionSweep'!" );
+};
+
+template< typename LatticeModel_T >
+struct MixedPrecisionCollision< LatticeModel_T, typename boost::enable_if< boost::is_same< typename LatticeModel_T::CollisionModel::tag,
+                                                                                          collision_model::SRT_tag > >::type >
+{
+   template< typename Cell_T >
+   static void collide( Cell_T & pdfs, const LatticeModel_T & lm, const Vector3< real_t > & velocity, const real_t rho )
+   {
+      typedef typename LatticeModel_T::Stencil Stencil_T;
+
+      const cell_idx_t x = pdfs.x();
+      const cell_idx_t y = pdfs.y();
+      const cell_idx_t z = pdfs.z();
+
+      const real_t omega = lm.collisionModel().omega( x, y, z, velocity, rho );
+
+      const auto commonForceTerms = lm.forceModel().template directionIndependentTerms< LatticeModel_T >( x, y, z, velocity, rho, omega, omega );
+
+      for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+      {
+         const real_t forceTerm = lm.forceModel().template forceTerm< LatticeModel_T >( x, y, z, velocity, rho, commonForceTerms, LatticeModel_T::w[ d.toIdx() ],
+                                                                                        real_c(d.cx()), real_c(d.cy()), real_c(d.cz()), omega, omega );
+
+         pdfs[ d.toIdx() ] = ( real_t(1.0) - omega ) * pdfs[ d.toIdx() ] +
+                                             omega   * EquilibriumDistribution< LatticeModel_T >::get( *d, velocity, rho ) +
+                             forceTerm;
+      }
+   }
+};
+
+template< typename LatticeModel_T >
+struct MixedPrecisionCollision< LatticeModel_T, typename boost::enable_if< boost::is_same< typename LatticeModel_T::CollisionModel::tag,
+                                                                                          collision_model::TRT_tag > >::type >
+{
+   template< typename Cell_T >
+   static void collide( Cell_T & pdfs, const LatticeModel_T & lm, Vector3< real_t > velocity, const real_t rho )
+   {
+      typedef typename LatticeModel_T::Stencil Stencil_T;
+
+      const cell_idx_t x = pdfs.x();
+      const cell_idx_t y = pdfs.y();
+      const cell_idx_t z = pdfs.z();
+
+      const real_t lambda_e = lm.collisionModel().lambda_e();
+      const real_t lambda_d = lm.collisionModel().lambda_d();
+
+      if (boost::is_same< typename LatticeModel_T::ForceModel::tag, force_model::Guo_tag >::value)
+         velocity -= real_c(0.5) * lm.forceModel().force(x,y,z);
+
+      const auto commonForceTerms = lm.forceModel().template directionIndependentTerms< LatticeModel_T >( x, y, z, velocity, rho, lambda_e, lambda_e );
+
+      const Cell_T pre( pdfs );
+
+      for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+      {
+         const real_t forceTerm = lm.forceModel().template forceTerm< LatticeModel_T >( x, y, z, velocity, rho, commonForceTerms, LatticeModel_T::w[ d.toIdx() ],
+                                                                                        real_c(d.cx()), real_c(d.cy()), real_c(d.cz()), lambda_e, lambda_e );
+
+         const real_t fsym  = EquilibriumDistribution< LatticeModel_T >::getSymmetricPart ( *d, velocity, rho );
+         const real_t fasym = EquilibriumDistribution< LatticeModel_T >::getAsymmetricPart( *d, velocity, rho );
+
+         const real_t f     = pre[ d.toIdx() ];
+         const real_t finv  = pre[ d.toInvIdx() ];
+
+         pdfs[ d.toIdx() ] = f - lambda_e * ( real_t( 0.5 ) * ( f + finv ) - fsym )
+                               - lambda_d * ( real_t( 0.5 ) * ( f - finv ) - fasym ) + forceTerm;
+      }
+   }
+};
+
+} // namespace internal
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Stream pull & collide sweep for MixedPrecisionPdfField (SRT and TRT, all stencils, all force models)
+*
+*   All PDFs of a cell are converted to 'real_t' while they are pulled from the neighbors, density, velocity, and the
+*   collision are evaluated in 'real_t' arithmetic, and the post-collision values are converted back to the storage type.
+*   Just like the pure sweeps (e.g. lbm::SplitPureSweep), all cells of the block are updated - boundary conditions must
+*   be treated in the ghost layer (or in obstacle cells) before the sweep is executed.
+*
+*   The destination field is created on demand (one per source field) and swapped with the source field after each
+*   call.
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T, typename Storage_T = float, bool ShiftedByWeight = true >
+class MixedPrecisionSweep
+{
+public:
+
+   typedef MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight > PdfField_T;
+   typedef typename LatticeModel_T::Stencil                                      Stencil;
+
+   MixedPrecisionSweep( const BlockDataID & pdfField ) : src_( pdfField ) {}
+
+   ~MixedPrecisionSweep() { for( auto field = dstFields_.begin(); field != dstFields_.end(); ++field ) delete *field; }
+
+   void operator()( IBlock * const block );
+
+private:
+
+   PdfField_T * getDstField( PdfField_T * const src );
+
+
+
+   const BlockDataID src_;
+   std::set< PdfField_T *, field::SwapableCompare< PdfField_T * > > dstFields_;
+};
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+void MixedPrecisionSweep< LatticeModel_T, Storage_T, ShiftedByWeight >::operator()( IBlock * const block )
+{
+   WALBERLA_ASSERT_NOT_NULLPTR( block );
+
+   PdfField_T * src = block->getData< PdfField_T >( src_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   PdfField_T * dst = getDstField( src );
+
+   WALBERLA_ASSERT_EQUAL( src->xyzSize(), dst->xyzSize() );
+
+   const LatticeModel_T & lm = src->latticeModel();
+   dst->resetLatticeModel( lm ); /* required so that member functions for getting density and equilibrium velocity can be called for dst! */
+
+   WALBERLA_FOR_ALL_CELLS_XYZ_OMP( src, omp parallel for schedule(static),
+
+      typename PdfField_T::DecodedCell pdfs( x, y, z );
+
+      // stream pull (+ conversion to real_t)
+      for( auto d = Stencil::begin(); d != Stencil::end(); ++d )
+         pdfs[ d.toIdx() ] = src->getPdf( x - d.cx(), y - d.cy(), z - d.cz(), d.toIdx() );
+
+      Vector3< real_t > velocity;
+      const real_t rho = src->getDensityAndEquilibriumVelocity( velocity, pdfs );
+
+      // collide (+ conversion to storage type)
+      internal::MixedPrecisionCollision< LatticeModel_T >::collide( pdfs, lm, velocity, rho );
+
+      dst->encode( pdfs );
+
+   ) // WALBERLA_FOR_ALL_CELLS_XYZ_OMP
+
+   src->swapDataPointers( dst );
+}
+
+
+
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+typename MixedPrecisionSweep< LatticeModel_T, Storage_T, ShiftedByWeight >::PdfField_T *
+MixedPrecisionSweep< LatticeModel_T, Storage_T, ShiftedByWeight >::getDstField( PdfField_T * const src )
+{
+   auto it = dstFields_.find( src );
+   if( it != dstFields_.end() )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( *it );
+      return *it;
+   }
+
+   PdfField_T * dst = src->cloneUninitialized();
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
+
+   // take care of proper thread<->memory assignment (first-touch allocation policy !)
+   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( dst,
+      for( uint_t f = uint_t(0); f < Stencil::Size; ++f )
+         dst->get(x,y,z,f) = std::numeric_limits< Storage_T >::quiet_NaN();
+   )
+   dstFields_.insert( dst );
+
+   return dst;
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
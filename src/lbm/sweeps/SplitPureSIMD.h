@@ -0,0 +1,199 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SplitPureSIMD.h
+//! \ingroup lbm
+//! \brief Helpers for the explicitly vectorized (simd module) fzyx kernels of the D3Q19 split pure sweeps
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "core/DataTypes.h"
+#include "core/debug/Debug.h"
+
+#include "field/Layout.h"
+
+#include "stencil/D3Q19.h"
+#include "stencil/Directions.h"
+
+#include <algorithm>
+
+//
+// The explicitly vectorized kernels are used for double precision builds if the simd module detected a real
+// instruction set extension at compile time (SSE2, SSE4, AVX, AVX2, or QPX). They can be disabled by defining
+// WALBERLA_LBM_SPLIT_PURE_NO_SIMD, which results in the auto-vectorized X_LOOP kernels being used instead.
+//
+
+#if defined( WALBERLA_DOUBLE_ACCURACY ) && !defined( WALBERLA_LBM_SPLIT_PURE_NO_SIMD )
+#  include "simd/SIMD.h"
+#  ifndef WALBERLA_USE_SCALAR_SIMD_EMULATION
+#     define WALBERLA_LBM_SPLIT_PURE_SIMD 1
+#  endif
+#endif
+
+
+
+#ifdef WALBERLA_LBM_SPLIT_PURE_SIMD
+
+namespace walberla {
+namespace lbm {
+namespace internal {
+namespace split_pure_simd {
+
+
+
+const cell_idx_t Width     = cell_idx_t(4);  // number of cells processed by one simd::double4_t
+const uint_t     Alignment = uint_t(32);     // sufficient for all instruction sets provided by the simd module
+
+
+
+/// Operations on one single cell (used for peeling and for the remaining cells at the end of a line)
+struct ScalarOps
+{
+   typedef double value_type;
+
+   static double broadcast( const double v ) { return v; }
+   static double load ( const double * const p ) { return *p; }
+   static void   store( double * const p, const double v ) { *p = v; }
+};
+
+/// Operations on 'Width' consecutive cells (loads may be unaligned, stores must be aligned)
+struct VectorOps
+{
+   typedef simd::double4_t value_type;
+
+   static value_type broadcast( const double v ) { return simd::make_double4( v ); }
+   static value_type load ( const double * const p ) { return simd::load_unaligned( p ); }
+   static void       store( double * const p, const value_type & v ) { simd::store_aligned( p, v ); }
+};
+
+
+
+/// The vectorized kernels require that all x-lines of the destination field share the same alignment so that one
+/// peel loop per line is sufficient. This is guaranteed if the allocated line length is a multiple of the simd width.
+template< typename PdfField_T >
+inline bool isApplicable( const PdfField_T * const src, const PdfField_T * const dst )
+{
+   return src->layout() == field::fzyx && dst->layout() == field::fzyx &&
+          ( dst->xAllocSize() % uint_c( Width ) ) == uint_t(0) &&
+          cell_idx_c( src->xSize() ) >= Width;
+}
+
+/// Number of cells that must be processed with scalar operations until 'p + peel' is aligned
+inline cell_idx_t peel( const double * const p, const cell_idx_t xSize )
+{
+   const uint_t misalignment = uint_c( reinterpret_cast< std::size_t >( p ) % Alignment );
+   WALBERLA_ASSERT_EQUAL( misalignment % sizeof(double), uint_t(0) );
+   const cell_idx_t cells = ( misalignment == uint_t(0) ) ? cell_idx_t(0) : cell_idx_c( ( Alignment - misalignment ) / sizeof(double) );
+   return std::min( cells, xSize );
+}
+
+
+
+/// Source (already shifted by the streaming offset) and destination pointers of one x-line of a D3Q19 fzyx PDF field
+/// that starts at cell (x,y,z)
+struct D3Q19Line
+{
+   template< typename PdfField_T >
+   D3Q19Line( const PdfField_T * const src, PdfField_T * const dst, const cell_idx_t x, const cell_idx_t y, const cell_idx_t z )
+   {
+      using namespace stencil;
+      typedef stencil::D3Q19 Stencil;
+
+      pNE = &src->get(x-1, y-1, z  , Stencil::idx[NE]);
+      pN  = &src->get(x  , y-1, z  , Stencil::idx[N]);
+      pNW = &src->get(x+1, y-1, z  , Stencil::idx[NW]);
+      pW  = &src->get(x+1, y  , z  , Stencil::idx[W]);
+      pSW = &src->get(x+1, y+1, z  , Stencil::idx[SW]);
+      pS  = &src->get(x  , y+1, z  , Stencil::idx[S]);
+      pSE = &src->get(x-1, y+1, z  , Stencil::idx[SE]);
+      pE  = &src->get(x-1, y  , z  , Stencil::idx[E]);
+      pT  = &src->get(x  , y  , z-1, Stencil::idx[T]);
+      pTE = &src->get(x-1, y  , z-1, Stencil::idx[TE]);
+      pTN = &src->get(x  , y-1, z-1, Stencil::idx[TN]);
+      pTW = &src->get(x+1, y  , z-1, Stencil::idx[TW]);
+      pTS = &src->get(x  , y+1, z-1, Stencil::idx[TS]);
+      pB  = &src->get(x  , y  , z+1, Stencil::idx[B]);
+      pBE = &src->get(x-1, y  , z+1, Stencil::idx[BE]);
+      pBN = &src->get(x  , y-1, z+1, Stencil::idx[BN]);
+      pBW = &src->get(x+1, y  , z+1, Stencil::idx[BW]);
+      pBS = &src->get(x  , y+1, z+1, Stencil::idx[BS]);
+      pC  = &src->get(x  , y  , z  , Stencil::idx[C]);
+
+      dNE = &dst->get(x,y,z,Stencil::idx[NE]);
+      dN  = &dst->get(x,y,z,Stencil::idx[N]);
+      dNW = &dst->get(x,y,z,Stencil::idx[NW]);
+      dW  = &dst->get(x,y,z,Stencil::idx[W]);
+      dSW = &dst->get(x,y,z,Stencil::idx[SW]);
+      dS  = &dst->get(x,y,z,Stencil::idx[S]);
+      dSE = &dst->get(x,y,z,Stencil::idx[SE]);
+      dE  = &dst->get(x,y,z,Stencil::idx[E]);
+      dT  = &dst->get(x,y,z,Stencil::idx[T]);
+      dTE = &dst->get(x,y,z,Stencil::idx[TE]);
+      dTN = &dst->get(x,y,z,Stencil::idx[TN]);
+      dTW = &dst->get(x,y,z,Stencil::idx[TW]);
+      dTS = &dst->get(x,y,z,Stencil::idx[TS]);
+      dB  = &dst->get(x,y,z,Stencil::idx[B]);
+      dBE = &dst->get(x,y,z,Stencil::idx[BE]);
+      dBN = &dst->get(x,y,z,Stencil::idx[BN]);
+      dBW = &dst->get(x,y,z,Stencil::idx[BW]);
+      dBS = &dst->get(x,y,z,Stencil::idx[BS]);
+      dC  = &dst->get(x,y,z,Stencil::idx[C]);
+   }
+
+   const double * WALBERLA_RESTRICT pNE; const double * WALBERLA_RESTRICT pN;  const double * WALBERLA_RESTRICT pNW;
+   const double * WALBERLA_RESTRICT pW;  const double * WALBERLA_RESTRICT pSW; const double * WALBERLA_RESTRICT pS;
+   const double * WALBERLA_RESTRICT pSE; const double * WALBERLA_RESTRICT pE;  const double * WALBERLA_RESTRICT pT;
+   const double * WALBERLA_RESTRICT pTE; const double * WALBERLA_RESTRICT pTN; const double * WALBERLA_RESTRICT pTW;
+   const double * WALBERLA_RESTRICT pTS; const double * WALBERLA_RESTRICT pB;  const double * WALBERLA_RESTRICT pBE;
+   const double * WALBERLA_RESTRICT pBN; const double * WALBERLA_RESTRICT pBW; const double * WALBERLA_RESTRICT pBS;
+   const double * WALBERLA_RESTRICT pC;
+
+   double * WALBERLA_RESTRICT dNE; double * WALBERLA_RESTRICT dN;  double * WALBERLA_RESTRICT dNW;
+   double * WALBERLA_RESTRICT dW;  double * WALBERLA_RESTRICT dSW; double * WALBERLA_RESTRICT dS;
+   double * WALBERLA_RESTRICT dSE; double * WALBERLA_RESTRICT dE;  double * WALBERLA_RESTRICT dT;
+   double * WALBERLA_RESTRICT dTE; double * WALBERLA_RESTRICT dTN; double * WALBERLA_RESTRICT dTW;
+   double * WALBERLA_RESTRICT dTS; double * WALBERLA_RESTRICT dB;  double * WALBERLA_RESTRICT dBE;
+   double * WALBERLA_RESTRICT dBN; double * WALBERLA_RESTRICT dBW; double * WALBERLA_RESTRICT dBS;
+   double * WALBERLA_RESTRICT dC;
+};
+
+
+
+/// Executes 'kernel.template cell< Ops >( line, x )' for all cells of one x-line: scalar peel loop until the
+/// destination is aligned, vectorized main loop, scalar loop for the remaining cells.
+template< typename Kernel_T >
+inline void processLine( const Kernel_T & kernel, const D3Q19Line & line, const cell_idx_t xSize )
+{
+   const cell_idx_t xPeel = peel( line.dC, xSize );
+
+   cell_idx_t x = cell_idx_t(0);
+   for( ; x < xPeel; ++x )
+      kernel.template cell< ScalarOps >( line, x );
+   for( ; x + Width <= xSize; x += Width )
+      kernel.template cell< VectorOps >( line, x );
+   for( ; x < xSize; ++x )
+      kernel.template cell< ScalarOps >( line, x );
+}
+
+
+
+} // namespace split_pure_simd
+} // namespace internal
+} // namespace lbm
+} // namespace walberla
+
+#endif // WALBERLA_LBM_SPLIT_PURE_SIMD
@@ -23,6 +23,7 @@
 
 #include "lbm/field/DensityVelocityCallback.h"
 #include "lbm/field/PdfField.h"
+#include "lbm/sweeps/InnerFrameSplit.h"
 #include "core/debug/Debug.h"
 #include "domain_decomposition/IBlock.h"
 #include "field/EvaluationFilter.h"
@@ -30,6 +31,7 @@
 #include "field/SwapableCompare.h"
 #include "field/iterators/IteratorMacros.h"
 
+#include <map>
 #include <set>
 #include <vector>
 
@@ -65,7 +67,13 @@ public:
       src_( src ), dstFromBlockData_( true ), dst_( dst ), filter_( _filter ),
       densityVelocityIn_( _densityVelocityIn ), densityVelocityOut_( _densityVelocityOut ) {}
 
-   virtual ~SweepBase() { for( auto field = dstFields_.begin(); field != dstFields_.end(); ++field ) delete *field; }
+   virtual ~SweepBase()
+   {
+      for( auto field = dstFields_.begin(); field != dstFields_.end(); ++field ) delete *field;
+      for( auto field = blockLocalDstFields_.begin(); field != blockLocalDstFields_.end(); ++field ) delete field->second;
+      for( auto field = unusedBlockLocalDstFields_.begin(); field != unusedBlockLocalDstFields_.end(); ++field ) delete *field;
+      for( auto field = releasedBlockLocalDstFields_.begin(); field != releasedBlockLocalDstFields_.end(); ++field ) delete *field;
+   }
 
    void filter( IBlock & block ) { filter_( block ); }
    bool filter( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const { return filter_(x,y,z); }
@@ -91,6 +99,16 @@ protected:
 
    inline void getFields( IBlock * const block, PdfField_T * & src, PdfField_T * & dst );
 
+   // The temporary dst field returned by getDstField is shared by all blocks of the same size. Sweeps that are split
+   // into 'inner' and 'frame' (see lbm::CellwiseSweep) execute 'inner' for all blocks before 'frame' is executed for
+   // the first block, hence, these sweeps need one temporary dst field per block. This field is only assigned to the
+   // block from 'inner' until it is released at the end of 'frame'. Once all blocks have been released, temporary
+   // fields that were not needed by any block are freed (-> no memory is kept for blocks that left the process).
+          PdfField_T * getBlockLocalDstField( IBlock * const block, PdfField_T * const src );
+          void         releaseBlockLocalDstField( IBlock * const block );
+
+   inline void getBlockLocalFields( IBlock * const block, PdfField_T * & src, PdfField_T * & dst );
+
 
 
    const BlockDataID src_;
@@ -98,6 +116,9 @@ protected:
    const bool dstFromBlockData_;
    const BlockDataID dst_;
    std::set< PdfField_T *, field::SwapableCompare< PdfField_T * > > dstFields_;
+   std::map< IBlock *, PdfField_T * > blockLocalDstFields_; // blocks between 'inner' and 'frame'
+   std::multiset< PdfField_T *, field::SwapableCompare< PdfField_T * > > unusedBlockLocalDstFields_;
+   std::vector< PdfField_T * > releasedBlockLocalDstFields_;
 
    Filter_T filter_;
    DensityVelocityIn_T densityVelocityIn_;
@@ -177,5 +198,99 @@ inline void SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVel
 
 
 
+template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T >
+typename SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >::PdfField_T *
+SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >::getBlockLocalDstField( IBlock * const block, PdfField_T * const src )
+{
+   WALBERLA_ASSERT_NOT_NULLPTR( block );
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+
+   if( dstFromBlockData_ )
+   {
+      PdfField_T * dst = block->getData<PdfField_T>( dst_ );
+      WALBERLA_ASSERT_NOT_NULLPTR( dst );
+      return dst;
+   }
+
+   auto it = blockLocalDstFields_.find( block );
+   if( it != blockLocalDstFields_.end() )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( it->second );
+      return it->second;
+   }
+
+   auto unused = unusedBlockLocalDstFields_.find( src );
+   if( unused != unusedBlockLocalDstFields_.end() )
+   {
+      PdfField_T * dst = *unused;
+      WALBERLA_ASSERT_NOT_NULLPTR( dst );
+      unusedBlockLocalDstFields_.erase( unused );
+#ifndef NDEBUG
+      std::fill( dst->beginWithGhostLayer(), dst->end(), std::numeric_limits< typename PdfField_T::value_type >::quiet_NaN() );
+#endif
+      blockLocalDstFields_[ block ] = dst;
+      return dst;
+   }
+
+   PdfField_T * dst = src->cloneUninitialized();
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
+
+   // take care of proper thread<->memory assignment (first-touch allocation policy !)
+   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( dst,
+      for( uint_t f = uint_t(0); f < LatticeModel_T::Stencil::Size; ++f )
+         dst->get(x,y,z,f) = std::numeric_limits< typename PdfField_T::value_type >::quiet_NaN();
+   )
+   blockLocalDstFields_[ block ] = dst;
+
+   return dst;
+}
+
+
+
+template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T >
+void SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >::releaseBlockLocalDstField( IBlock * const block )
+{
+   if( dstFromBlockData_ )
+      return;
+
+   auto it = blockLocalDstFields_.find( block );
+   if( it == blockLocalDstFields_.end() )
+      return;
+
+   releasedBlockLocalDstFields_.push_back( it->second );
+   blockLocalDstFields_.erase( it );
+
+   if( !blockLocalDstFields_.empty() )
+      return;
+
+   // all blocks are done: the fields that were not used by any block are no longer needed
+
+   for( auto field = unusedBlockLocalDstFields_.begin(); field != unusedBlockLocalDstFields_.end(); ++field )
+      delete *field;
+   unusedBlockLocalDstFields_.clear();
+
+   unusedBlockLocalDstFields_.insert( releasedBlockLocalDstFields_.begin(), releasedBlockLocalDstFields_.end() );
+   releasedBlockLocalDstFields_.clear();
+}
+
+
+
+template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T >
+inline void SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >::getBlockLocalFields( IBlock * const block,
+                                                                                                                   PdfField_T * & src, PdfField_T * & dst )
+{
+   WALBERLA_ASSERT_NOT_NULLPTR( block );
+
+   src = getSrcField( block );
+   dst = getBlockLocalDstField( block, src );
+
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
+
+   WALBERLA_ASSERT_EQUAL( src->xyzSize(), dst->xyzSize() );
+}
+
+
+
 } // namespace lbm
 } // namespace walberla
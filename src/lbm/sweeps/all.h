@@ -24,6 +24,9 @@
 
 #include "ActiveCellSweep.h"
 #include "CellwiseSweep.h"
+#include "InPlaceSweep.h"
+#include "InPlaceTimeStep.h"
+#include "MixedPrecisionSweep.h"
 #include "SplitPureSweep.h"
 #include "SplitSweep.h"
 #include "SweepWrappers.h"
@@ -25,6 +25,7 @@
 #include "lbm/lattice_model/D3Q27.h"
 #include "lbm/lattice_model/EquilibriumDistribution.h"
 #include "lbm/lattice_model/LatticeModelBase.h"
+#include "lbm/sweeps/InnerFrameSplit.h"
 #include "lbm/sweeps/StreamPull.h"
 #include "lbm/sweeps/SweepBase.h"
 
@@ -79,7 +80,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t lambda_e_scaled = real_t(0.5) * lambda_e; // 0.5 times the usual value ...
    const real_t lambda_d_scaled = real_t(0.5) * lambda_d; // ... due to the way of calculations
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       if( this->filter(x,y,z) )
       {
@@ -118,7 +119,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get( x, y, z, Stencil_T::idx[W] ) = vW - sym_E_W + asym_E_W;
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -224,7 +225,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t lambda_e_scaled = real_t(0.5) * lambda_e; // 0.5 times the usual value ...
    const real_t lambda_d_scaled = real_t(0.5) * lambda_d; // ... due to the way of calculations
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       if( this->filter(x,y,z) )
       {
@@ -292,7 +293,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get( x, y, z, Stencil_T::idx[B] ) = vB - sym_T_B + asym_T_B;
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -421,7 +422,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t lambda_e_scaled = real_t(0.5) * lambda_e; // 0.5 times the usual value ...
    const real_t lambda_d_scaled = real_t(0.5) * lambda_d; // ... due to the way of calculations
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       if( this->filter(x,y,z) )
       {
@@ -495,7 +496,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get( x, y, z, Stencil_T::idx[B] ) = vB - sym_T_B + asym_T_B;
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -633,7 +634,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t lambda_e_scaled = real_t(0.5) * lambda_e; // 0.5 times the usual value ...
    const real_t lambda_d_scaled = real_t(0.5) * lambda_d; // ... due to the way of calculations
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       if( this->filter(x,y,z) )
       {
@@ -703,7 +704,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get( x, y, z, Stencil_T::idx[B] ) = vB - sym_T_B + asym_T_B - three_w1 * force[2];
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -846,7 +847,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t lambda_d_scaled = real_t(0.5) * lambda_d; // ... due to the way of calculations
 
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       if( this->filter(x,y,z) )
       {
@@ -939,7 +940,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
 
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -1095,7 +1096,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t lambda_e_scaled = real_t(0.5) * lambda_e; // 0.5 times the usual value ...
    const real_t lambda_d_scaled = real_t(0.5) * lambda_d; // ... due to the way of calculations
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       if( this->filter(x,y,z) )
       {
@@ -1196,7 +1197,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get( x, y, z, Stencil_T::idx[BNE] ) = vBNE - sym_TSW_BNE + asym_TSW_BNE;
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -1365,7 +1366,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t lambda_e_scaled = real_t(0.5) * lambda_e; // 0.5 times the usual value ...
    const real_t lambda_d_scaled = real_t(0.5) * lambda_d; // ... due to the way of calculations
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( cells,
 
       if( this->filter(x,y,z) )
       {
@@ -1459,7 +1460,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          dst->get( x, y, z, Stencil_T::idx[BNE] ) = vBNE - sym_TSW_BNE + asym_TSW_BNE - three_w3 * (  -force[0] - force[1] + force[2] );
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
 
@@ -1625,7 +1626,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
 
    real_t pdfs[ Stencil_T::Size ];
 
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ_OMP( src, numberOfGhostLayersToInclude, omp for schedule(static),
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ_OMP( cells, omp for schedule(static),
 
       if( this->filter(x,y,z) )
       {
@@ -1664,7 +1665,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
          }
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ_OMP
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ_OMP
 
 #ifdef _OPENMP
    }
@@ -27,6 +27,7 @@
 
 #include "lbm/lattice_model/LatticeModelBase.h"
 #include "lbm/lattice_model/D3Q19.h"
+#include "lbm/sweeps/SplitPureSIMD.h"
 #include "lbm/sweeps/Streaming.h"
 #include "lbm/sweeps/SweepBase.h"
 #include "lbm/IntelCompilerOptimization.h"
@@ -55,6 +56,107 @@ namespace lbm {
 ///////////////////////////////////////////////////////
 
 
+#ifdef WALBERLA_LBM_SPLIT_PURE_SIMD
+
+namespace internal {
+
+/// Relaxation of the symmetric and anti-symmetric part of one pair of opposite directions (shared by the
+/// incompressible and the compressible D3Q19 TRT kernel)
+template< typename Ops >
+inline void trtSplitPureRelax( double * const dPos, double * const dNeg,
+                               const typename Ops::value_type & pPos, const typename Ops::value_type & pNeg,
+                               const typename Ops::value_type & vel, const typename Ops::value_type & fac,
+                               const typename Ops::value_type & t, const typename Ops::value_type & feq_common,
+                               const typename Ops::value_type & lambda_e_scaled, const typename Ops::value_type & lambda_d_scaled )
+{
+   typedef typename Ops::value_type V;
+
+   const V  sym = lambda_e_scaled * ( pPos + pNeg - fac * vel * vel - t * feq_common );
+   const V asym = lambda_d_scaled * ( pPos - pNeg - Ops::broadcast( real_t(3.0) ) * t * vel );
+
+   Ops::store( dPos, pPos - sym - asym );
+   Ops::store( dNeg, pNeg - sym + asym );
+}
+
+/// Fused stream & collide kernel of the incompressible D3Q19 TRT sweep for one vector/scalar of cells.
+/// The order of all floating point operations is identical to the X_LOOP implementation below, so both produce
+/// bit-identical results.
+class TRTSplitPureIncompressibleKernel
+{
+public:
+
+   TRTSplitPureIncompressibleKernel( const real_t lambda_e, const real_t lambda_e_scaled, const real_t lambda_d_scaled,
+                                     const real_t t0, const real_t t1x2, const real_t t2x2, const real_t fac1, const real_t fac2 ) :
+      lambda_e_( lambda_e ), lambda_e_scaled_( lambda_e_scaled ), lambda_d_scaled_( lambda_d_scaled ),
+      t0_( t0 ), t1x2_( t1x2 ), t2x2_( t2x2 ), fac1_( fac1 ), fac2_( fac2 ) {}
+
+   template< typename Ops >
+   inline void cell( const split_pure_simd::D3Q19Line & l, const cell_idx_t x ) const
+   {
+      typedef typename Ops::value_type V;
+
+      const V lambda_e = Ops::broadcast( lambda_e_ );
+      const V one_minus_lambda_e = Ops::broadcast( real_t(1.0) - lambda_e_ );
+      const V t0   = Ops::broadcast( t0_ );
+      const V t1x2 = Ops::broadcast( t1x2_ );
+      const V t2x2 = Ops::broadcast( t2x2_ );
+      const V fac1 = Ops::broadcast( fac1_ );
+      const V fac2 = Ops::broadcast( fac2_ );
+      const V three_halves = Ops::broadcast( real_t(1.5) );
+
+      const V lambda_e_scaled = Ops::broadcast( lambda_e_scaled_ );
+      const V lambda_d_scaled = Ops::broadcast( lambda_d_scaled_ );
+
+      const V pNE = Ops::load( l.pNE + x ); const V pN  = Ops::load( l.pN  + x ); const V pNW = Ops::load( l.pNW + x );
+      const V pW  = Ops::load( l.pW  + x ); const V pSW = Ops::load( l.pSW + x ); const V pS  = Ops::load( l.pS  + x );
+      const V pSE = Ops::load( l.pSE + x ); const V pE  = Ops::load( l.pE  + x ); const V pT  = Ops::load( l.pT  + x );
+      const V pTE = Ops::load( l.pTE + x ); const V pTN = Ops::load( l.pTN + x ); const V pTW = Ops::load( l.pTW + x );
+      const V pTS = Ops::load( l.pTS + x ); const V pB  = Ops::load( l.pB  + x ); const V pBE = Ops::load( l.pBE + x );
+      const V pBN = Ops::load( l.pBN + x ); const V pBW = Ops::load( l.pBW + x ); const V pBS = Ops::load( l.pBS + x );
+      const V pC  = Ops::load( l.pC  + x );
+
+      const V velX_trm = pE + pNE + pSE + pTE + pBE;
+      const V velY_trm = pN + pNW + pTN + pBN;
+      const V velZ_trm = pT + pTS + pTW;
+
+      const V rho = pC + pS + pW + pB + pSW + pBS + pBW + velX_trm + velY_trm + velZ_trm;
+
+      const V velX = velX_trm - pW  - pNW - pSW - pTW - pBW;
+      const V velY = velY_trm + pNE - pS  - pSW - pSE - pTS - pBS;
+      const V velZ = velZ_trm + pTN + pTE - pB  - pBN - pBS - pBW - pBE;
+
+      const V feq_common = rho - three_halves * ( velX * velX + velY * velY + velZ * velZ );
+
+      Ops::store( l.dC + x, pC * one_minus_lambda_e + lambda_e * t0 * feq_common );
+
+      trtSplitPureRelax< Ops >( l.dNE + x, l.dSW + x, pNE, pSW, velX + velY, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dSE + x, l.dNW + x, pSE, pNW, velX - velY, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dTE + x, l.dBW + x, pTE, pBW, velX + velZ, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dBE + x, l.dTW + x, pBE, pTW, velX - velZ, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dTN + x, l.dBS + x, pTN, pBS, velY + velZ, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dBN + x, l.dTS + x, pBN, pTS, velY - velZ, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dN  + x, l.dS  + x, pN,  pS,  velY,        fac1, t1x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dE  + x, l.dW  + x, pE,  pW,  velX,        fac1, t1x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dT  + x, l.dB  + x, pT,  pB,  velZ,        fac1, t1x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+   }
+
+private:
+
+   const real_t lambda_e_;
+   const real_t lambda_e_scaled_;
+   const real_t lambda_d_scaled_;
+   const real_t t0_;
+   const real_t t1x2_;
+   const real_t t2x2_;
+   const real_t fac1_;
+   const real_t fac2_;
+};
+
+} // namespace internal
+
+#endif // WALBERLA_LBM_SPLIT_PURE_SIMD
+
+
 ///////////////////////////////
 // Specialization for D3Q19: //
 // - incompressible          //
@@ -90,7 +192,43 @@ public:
    SplitPureSweep( const BlockDataID & src, const BlockDataID & dst ) :
       SweepBase<LatticeModel_T>( src, dst ) {}
 
-   void operator()( IBlock * const block );
+   void operator()( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getFields( block, src, dst );
+
+      streamCollide( src, dst, src->xyzSize() );
+      src->swapDataPointers( dst );
+   }
+
+   // 'inner' + 'frame' == 'operator()', see lbm::CellwiseSweep
+   void inner( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getBlockLocalFields( block, src, dst );
+
+      const CellInterval cells = innerCells< Stencil >( src->xyzSize() );
+      if( !cells.empty() )
+         streamCollide( src, dst, cells );
+   }
+
+   void frame( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getBlockLocalFields( block, src, dst );
+
+      const std::vector< CellInterval > cells = frameCells< Stencil >( src->xyzSize() );
+      for( auto interval = cells.begin(); interval != cells.end(); ++interval )
+         streamCollide( src, dst, *interval );
+      src->swapDataPointers( dst );
+      this->releaseBlockLocalDstField( block );
+   }
+
+   /// stream & collide for all cells in 'cells' (src and dst are NOT swapped)
+   void streamCollide( PdfField_T * const src, PdfField_T * const dst, const CellInterval & cells );
 
    void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
    void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
@@ -103,14 +241,13 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
                                                                                   boost::mpl::not_< boost::mpl::bool_< LatticeModel_T::compressible > >,
                                                                                   boost::is_same< typename LatticeModel_T::ForceModel::tag,
                                                                                                   force_model::None_tag > > >::type
-   >::operator()( IBlock * const block )                                       
+   >::streamCollide( PdfField_T * const src, PdfField_T * const dst, const CellInterval & cells )
 {
-   PdfField_T * src( NULL );
-   PdfField_T * dst( NULL );
-
-   this->getFields( block, src, dst );
-
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
+   WALBERLA_ASSERT_EQUAL( src->xyzSize(), dst->xyzSize() );
    WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT( src->xyzSize().contains( cells ) );
 
    // constants used during stream/collide
 
@@ -132,7 +269,21 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    // loop constants
 
-   const cell_idx_t xSize = cell_idx_c( src->xSize() );
+   const cell_idx_t xOff  = cells.xMin(); // x-lines start at x = xOff, x below is relative to xOff
+   const cell_idx_t xSize = cell_idx_c( cells.xSize() );
+
+#ifdef WALBERLA_LBM_SPLIT_PURE_SIMD
+   if( internal::split_pure_simd::isApplicable( src, dst ) )
+   {
+      const internal::TRTSplitPureIncompressibleKernel kernel( lambda_e, lambda_e_scaled, lambda_d_scaled, t0, t1x2, t2x2, fac1, fac2 );
+
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp parallel for schedule(static),
+         internal::split_pure_simd::processLine( kernel, internal::split_pure_simd::D3Q19Line( src, dst, xOff, y, z ), xSize );
+      )
+
+      return;
+   }
+#endif
 
 #ifdef _OPENMP
    #pragma omp parallel
@@ -148,31 +299,31 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    if( src->layout() == field::fzyx && dst->layout() == field::fzyx )
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp for schedule(static),
 
          using namespace stencil;
 
-         real_t * WALBERLA_RESTRICT pNE = &src->get(-1, y-1, z  , Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT pN  = &src->get(0 , y-1, z  , Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT pNW = &src->get(+1, y-1, z  , Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT pW  = &src->get(+1, y  , z  , Stencil::idx[W]);
-         real_t * WALBERLA_RESTRICT pSW = &src->get(+1, y+1, z  , Stencil::idx[SW]);
-         real_t * WALBERLA_RESTRICT pS  = &src->get(0 , y+1, z  , Stencil::idx[S]);
-         real_t * WALBERLA_RESTRICT pSE = &src->get(-1, y+1, z  , Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT pE  = &src->get(-1, y  , z  , Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT pT  = &src->get(0 , y  , z-1, Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT pTE = &src->get(-1, y  , z-1, Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT pTN = &src->get(0 , y-1, z-1, Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT pTW = &src->get(+1, y  , z-1, Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT pTS = &src->get(0 , y+1, z-1, Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT pB  = &src->get(0 , y  , z+1, Stencil::idx[B]);
-         real_t * WALBERLA_RESTRICT pBE = &src->get(-1, y  , z+1, Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT pBN = &src->get(0 , y-1, z+1, Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT pBW = &src->get(+1, y  , z+1, Stencil::idx[BW]);
-         real_t * WALBERLA_RESTRICT pBS = &src->get(0 , y+1, z+1, Stencil::idx[BS]);
-         real_t * WALBERLA_RESTRICT pC  = &src->get(0 , y  , z  , Stencil::idx[C]);
-
-         real_t * WALBERLA_RESTRICT dC = &dst->get(0,y,z,Stencil::idx[C]);
+         real_t * WALBERLA_RESTRICT pNE = &src->get(xOff-1, y-1, z  , Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT pN  = &src->get(xOff  , y-1, z  , Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT pNW = &src->get(xOff+1, y-1, z  , Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT pW  = &src->get(xOff+1, y  , z  , Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT pSW = &src->get(xOff+1, y+1, z  , Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT pS  = &src->get(xOff  , y+1, z  , Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT pSE = &src->get(xOff-1, y+1, z  , Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT pE  = &src->get(xOff-1, y  , z  , Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT pT  = &src->get(xOff  , y  , z-1, Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT pTE = &src->get(xOff-1, y  , z-1, Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT pTN = &src->get(xOff  , y-1, z-1, Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT pTW = &src->get(xOff+1, y  , z-1, Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT pTS = &src->get(xOff  , y+1, z-1, Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT pB  = &src->get(xOff  , y  , z+1, Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT pBE = &src->get(xOff-1, y  , z+1, Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT pBN = &src->get(xOff  , y-1, z+1, Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT pBW = &src->get(xOff+1, y  , z+1, Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT pBS = &src->get(xOff  , y+1, z+1, Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT pC  = &src->get(xOff  , y  , z  , Stencil::idx[C]);
+
+         real_t * WALBERLA_RESTRICT dC = &dst->get(xOff,y,z,Stencil::idx[C]);
 
          X_LOOP
          (
@@ -191,8 +342,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dC[x] = pC[x] * (real_t(1.0) - lambda_e) + lambda_e * t0 * feq_common[x];
          )
 
-         real_t * WALBERLA_RESTRICT dNE = &dst->get(0,y,z,Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT dSW = &dst->get(0,y,z,Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT dNE = &dst->get(xOff,y,z,Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT dSW = &dst->get(xOff,y,z,Stencil::idx[SW]);
 
          X_LOOP
          (
@@ -204,8 +355,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSW[x] = pSW[x] - sym_NE_SW + asym_NE_SW;
          )
 
-         real_t * WALBERLA_RESTRICT dSE = &dst->get(0,y,z,Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT dNW = &dst->get(0,y,z,Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT dSE = &dst->get(xOff,y,z,Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT dNW = &dst->get(xOff,y,z,Stencil::idx[NW]);
 
          X_LOOP
          (
@@ -217,8 +368,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dNW[x] = pNW[x] - sym_SE_NW + asym_SE_NW;
          )
 
-         real_t * WALBERLA_RESTRICT dTE = &dst->get(0,y,z,Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT dBW = &dst->get(0,y,z,Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT dTE = &dst->get(xOff,y,z,Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT dBW = &dst->get(xOff,y,z,Stencil::idx[BW]);
 
          X_LOOP
          (
@@ -230,8 +381,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBW[x] = pBW[x] - sym_TE_BW + asym_TE_BW;
          )
 
-         real_t * WALBERLA_RESTRICT dBE = &dst->get(0,y,z,Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT dTW = &dst->get(0,y,z,Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT dBE = &dst->get(xOff,y,z,Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT dTW = &dst->get(xOff,y,z,Stencil::idx[TW]);
 
          X_LOOP
          (
@@ -243,8 +394,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dTW[x] = pTW[x] - sym_BE_TW + asym_BE_TW;
          )
 
-         real_t * WALBERLA_RESTRICT dTN = &dst->get(0,y,z,Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT dBS = &dst->get(0,y,z,Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT dTN = &dst->get(xOff,y,z,Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT dBS = &dst->get(xOff,y,z,Stencil::idx[BS]);
 
          X_LOOP
          (
@@ -256,8 +407,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBS[x] = pBS[x] - sym_TN_BS + asym_TN_BS;
          )
 
-         real_t * WALBERLA_RESTRICT dBN = &dst->get(0,y,z,Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT dTS = &dst->get(0,y,z,Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT dBN = &dst->get(xOff,y,z,Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT dTS = &dst->get(xOff,y,z,Stencil::idx[TS]);
 
          X_LOOP
          (
@@ -269,8 +420,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dTS[x] = pTS[x] - sym_BN_TS + asym_BN_TS;
          )
 
-         real_t * WALBERLA_RESTRICT dN = &dst->get(0,y,z,Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT dS = &dst->get(0,y,z,Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT dN = &dst->get(xOff,y,z,Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT dS = &dst->get(xOff,y,z,Stencil::idx[S]);
 
          X_LOOP
          (
@@ -281,8 +432,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dS[x] = pS[x] - sym_N_S + asym_N_S;
          )
 
-         real_t * WALBERLA_RESTRICT dE = &dst->get(0,y,z,Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT dW = &dst->get(0,y,z,Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT dE = &dst->get(xOff,y,z,Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT dW = &dst->get(xOff,y,z,Stencil::idx[W]);
 
          X_LOOP
          (
@@ -293,8 +444,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dW[x] = pW[x] - sym_E_W + asym_E_W;
          )
 
-         real_t * WALBERLA_RESTRICT dT = &dst->get(0,y,z,Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT dB = &dst->get(0,y,z,Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT dT = &dst->get(xOff,y,z,Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT dB = &dst->get(xOff,y,z,Stencil::idx[B]);
 
          X_LOOP
          (
@@ -305,35 +456,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dB[x] = pB[x] - sym_T_B + asym_T_B;
          )
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
    else // ==> src->layout() == field::zyxf || dst->layout() == field::zyxf
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp for schedule(static),
 
          using namespace stencil;
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z  , Stencil::idx[NE]);
-            const real_t dd_tmp_N  = src->get(x  , y-1, z  , Stencil::idx[N]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z  , Stencil::idx[NW]);
-            const real_t dd_tmp_W  = src->get(x+1, y  , z  , Stencil::idx[W]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z  , Stencil::idx[SW]);
-            const real_t dd_tmp_S  = src->get(x  , y+1, z  , Stencil::idx[S]);
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z  , Stencil::idx[SE]);
-            const real_t dd_tmp_E  = src->get(x-1, y  , z  , Stencil::idx[E]);
-            const real_t dd_tmp_T  = src->get(x  , y  , z-1, Stencil::idx[T]);
-            const real_t dd_tmp_TE = src->get(x-1, y  , z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_TN = src->get(x  , y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_TW = src->get(x+1, y  , z-1, Stencil::idx[TW]);
-            const real_t dd_tmp_TS = src->get(x  , y+1, z-1, Stencil::idx[TS]);
-            const real_t dd_tmp_B  = src->get(x  , y  , z+1, Stencil::idx[B]);
-            const real_t dd_tmp_BE = src->get(x-1, y  , z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_BN = src->get(x  , y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_BW = src->get(x+1, y  , z+1, Stencil::idx[BW]);
-            const real_t dd_tmp_BS = src->get(x  , y+1, z+1, Stencil::idx[BS]);
-            const real_t dd_tmp_C  = src->get(x  , y  , z  , Stencil::idx[C]);
+            const real_t dd_tmp_NE = src->get(xOff+x-1, y-1, z  , Stencil::idx[NE]);
+            const real_t dd_tmp_N  = src->get(xOff+x  , y-1, z  , Stencil::idx[N]);
+            const real_t dd_tmp_NW = src->get(xOff+x+1, y-1, z  , Stencil::idx[NW]);
+            const real_t dd_tmp_W  = src->get(xOff+x+1, y  , z  , Stencil::idx[W]);
+            const real_t dd_tmp_SW = src->get(xOff+x+1, y+1, z  , Stencil::idx[SW]);
+            const real_t dd_tmp_S  = src->get(xOff+x  , y+1, z  , Stencil::idx[S]);
+            const real_t dd_tmp_SE = src->get(xOff+x-1, y+1, z  , Stencil::idx[SE]);
+            const real_t dd_tmp_E  = src->get(xOff+x-1, y  , z  , Stencil::idx[E]);
+            const real_t dd_tmp_T  = src->get(xOff+x  , y  , z-1, Stencil::idx[T]);
+            const real_t dd_tmp_TE = src->get(xOff+x-1, y  , z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_TN = src->get(xOff+x  , y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_TW = src->get(xOff+x+1, y  , z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_TS = src->get(xOff+x  , y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_B  = src->get(xOff+x  , y  , z+1, Stencil::idx[B]);
+            const real_t dd_tmp_BE = src->get(xOff+x-1, y  , z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_BN = src->get(xOff+x  , y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_BW = src->get(xOff+x+1, y  , z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_BS = src->get(xOff+x  , y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_C  = src->get(xOff+x  , y  , z  , Stencil::idx[C]);
 
             const real_t velX_trm = dd_tmp_E + dd_tmp_NE + dd_tmp_SE + dd_tmp_TE + dd_tmp_BE;
             const real_t velY_trm = dd_tmp_N + dd_tmp_NW + dd_tmp_TN + dd_tmp_BN;
@@ -347,124 +498,124 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
             feq_common[x] = rho - real_t(1.5) * ( velX[x] * velX[x] + velY[x] * velY[x] + velZ[x] * velZ[x] );
 
-            dst->get( x, y, z, Stencil::idx[C] ) = dd_tmp_C * (real_t(1.0) - lambda_e) + lambda_e * t0 * feq_common[x];
+            dst->get( xOff+x, y, z, Stencil::idx[C] ) = dd_tmp_C * (real_t(1.0) - lambda_e) + lambda_e * t0 * feq_common[x];
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z, Stencil::idx[NE]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z, Stencil::idx[SW]);
+            const real_t dd_tmp_NE = src->get(xOff+x-1, y-1, z, Stencil::idx[NE]);
+            const real_t dd_tmp_SW = src->get(xOff+x+1, y+1, z, Stencil::idx[SW]);
 
             const real_t velXPY = velX[x] + velY[x];
             const real_t  sym_NE_SW = lambda_e_scaled * ( dd_tmp_NE + dd_tmp_SW - fac2 * velXPY * velXPY - t2x2 * feq_common[x] );
             const real_t asym_NE_SW = lambda_d_scaled * ( dd_tmp_NE - dd_tmp_SW - real_t(3.0) * t2x2 * velXPY );
 
-            dst->get( x, y, z, Stencil::idx[NE] ) = dd_tmp_NE - sym_NE_SW - asym_NE_SW;
-            dst->get( x, y, z, Stencil::idx[SW] ) = dd_tmp_SW - sym_NE_SW + asym_NE_SW;
+            dst->get( xOff+x, y, z, Stencil::idx[NE] ) = dd_tmp_NE - sym_NE_SW - asym_NE_SW;
+            dst->get( xOff+x, y, z, Stencil::idx[SW] ) = dd_tmp_SW - sym_NE_SW + asym_NE_SW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z, Stencil::idx[SE]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z, Stencil::idx[NW]);
+            const real_t dd_tmp_SE = src->get(xOff+x-1, y+1, z, Stencil::idx[SE]);
+            const real_t dd_tmp_NW = src->get(xOff+x+1, y-1, z, Stencil::idx[NW]);
 
             const real_t velXMY = velX[x] - velY[x];
             const real_t  sym_SE_NW = lambda_e_scaled * ( dd_tmp_SE + dd_tmp_NW - fac2 * velXMY * velXMY - t2x2 * feq_common[x] );
             const real_t asym_SE_NW = lambda_d_scaled * ( dd_tmp_SE - dd_tmp_NW - real_t(3.0) * t2x2 * velXMY );
 
-            dst->get( x, y, z, Stencil::idx[SE] ) = dd_tmp_SE - sym_SE_NW - asym_SE_NW;
-            dst->get( x, y, z, Stencil::idx[NW] ) = dd_tmp_NW - sym_SE_NW + asym_SE_NW;
+            dst->get( xOff+x, y, z, Stencil::idx[SE] ) = dd_tmp_SE - sym_SE_NW - asym_SE_NW;
+            dst->get( xOff+x, y, z, Stencil::idx[NW] ) = dd_tmp_NW - sym_SE_NW + asym_SE_NW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_TE = src->get(x-1, y, z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_BW = src->get(x+1, y, z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_TE = src->get(xOff+x-1, y, z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_BW = src->get(xOff+x+1, y, z+1, Stencil::idx[BW]);
 
             const real_t velXPZ = velX[x] + velZ[x];
             const real_t  sym_TE_BW = lambda_e_scaled * ( dd_tmp_TE + dd_tmp_BW - fac2 * velXPZ * velXPZ - t2x2 * feq_common[x] );
             const real_t asym_TE_BW = lambda_d_scaled * ( dd_tmp_TE - dd_tmp_BW - real_t(3.0) * t2x2 * velXPZ );
 
-            dst->get( x, y, z, Stencil::idx[TE] ) = dd_tmp_TE - sym_TE_BW - asym_TE_BW;
-            dst->get( x, y, z, Stencil::idx[BW] ) = dd_tmp_BW - sym_TE_BW + asym_TE_BW;
+            dst->get( xOff+x, y, z, Stencil::idx[TE] ) = dd_tmp_TE - sym_TE_BW - asym_TE_BW;
+            dst->get( xOff+x, y, z, Stencil::idx[BW] ) = dd_tmp_BW - sym_TE_BW + asym_TE_BW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_BE = src->get(x-1, y, z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_TW = src->get(x+1, y, z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_BE = src->get(xOff+x-1, y, z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_TW = src->get(xOff+x+1, y, z-1, Stencil::idx[TW]);
 
             const real_t velXMZ = velX[x] - velZ[x];
             const real_t  sym_BE_TW = lambda_e_scaled * ( dd_tmp_BE + dd_tmp_TW - fac2 * velXMZ * velXMZ - t2x2 * feq_common[x] );
             const real_t asym_BE_TW = lambda_d_scaled * ( dd_tmp_BE - dd_tmp_TW - real_t(3.0) * t2x2 * velXMZ );
 
-            dst->get( x, y, z, Stencil::idx[BE] ) = dd_tmp_BE - sym_BE_TW - asym_BE_TW;
-            dst->get( x, y, z, Stencil::idx[TW] ) = dd_tmp_TW - sym_BE_TW + asym_BE_TW;
+            dst->get( xOff+x, y, z, Stencil::idx[BE] ) = dd_tmp_BE - sym_BE_TW - asym_BE_TW;
+            dst->get( xOff+x, y, z, Stencil::idx[TW] ) = dd_tmp_TW - sym_BE_TW + asym_BE_TW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_TN = src->get(x, y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_BS = src->get(x, y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_TN = src->get(xOff+x, y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_BS = src->get(xOff+x, y+1, z+1, Stencil::idx[BS]);
 
             const real_t velYPZ = velY[x] + velZ[x];
             const real_t  sym_TN_BS = lambda_e_scaled * ( dd_tmp_TN + dd_tmp_BS - fac2 * velYPZ * velYPZ - t2x2 * feq_common[x] );
             const real_t asym_TN_BS = lambda_d_scaled * ( dd_tmp_TN - dd_tmp_BS - real_t(3.0) * t2x2 * velYPZ );
 
-            dst->get( x, y, z, Stencil::idx[TN] ) = dd_tmp_TN - sym_TN_BS - asym_TN_BS;
-            dst->get( x, y, z, Stencil::idx[BS] ) = dd_tmp_BS - sym_TN_BS + asym_TN_BS;
+            dst->get( xOff+x, y, z, Stencil::idx[TN] ) = dd_tmp_TN - sym_TN_BS - asym_TN_BS;
+            dst->get( xOff+x, y, z, Stencil::idx[BS] ) = dd_tmp_BS - sym_TN_BS + asym_TN_BS;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_BN = src->get(x, y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_TS = src->get(x, y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_BN = src->get(xOff+x, y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_TS = src->get(xOff+x, y+1, z-1, Stencil::idx[TS]);
 
             const real_t velYMZ = velY[x] - velZ[x];
             const real_t  sym_BN_TS = lambda_e_scaled * ( dd_tmp_BN + dd_tmp_TS - fac2 * velYMZ * velYMZ - t2x2 * feq_common[x] );
             const real_t asym_BN_TS = lambda_d_scaled * ( dd_tmp_BN - dd_tmp_TS - real_t(3.0) * t2x2 * velYMZ );
 
-            dst->get( x, y, z, Stencil::idx[BN] ) = dd_tmp_BN - sym_BN_TS - asym_BN_TS;
-            dst->get( x, y, z, Stencil::idx[TS] ) = dd_tmp_TS - sym_BN_TS + asym_BN_TS;
+            dst->get( xOff+x, y, z, Stencil::idx[BN] ) = dd_tmp_BN - sym_BN_TS - asym_BN_TS;
+            dst->get( xOff+x, y, z, Stencil::idx[TS] ) = dd_tmp_TS - sym_BN_TS + asym_BN_TS;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_N  = src->get(x, y-1, z, Stencil::idx[N]);
-            const real_t dd_tmp_S  = src->get(x, y+1, z, Stencil::idx[S]);
+            const real_t dd_tmp_N  = src->get(xOff+x, y-1, z, Stencil::idx[N]);
+            const real_t dd_tmp_S  = src->get(xOff+x, y+1, z, Stencil::idx[S]);
 
             const real_t  sym_N_S = lambda_e_scaled * ( dd_tmp_N + dd_tmp_S - fac1 * velY[x] * velY[x] - t1x2 * feq_common[x] );
             const real_t asym_N_S = lambda_d_scaled * ( dd_tmp_N - dd_tmp_S - real_t(3.0) * t1x2 * velY[x] );
 
-            dst->get( x, y, z, Stencil::idx[N] ) = dd_tmp_N - sym_N_S - asym_N_S;
-            dst->get( x, y, z, Stencil::idx[S] ) = dd_tmp_S - sym_N_S + asym_N_S;
+            dst->get( xOff+x, y, z, Stencil::idx[N] ) = dd_tmp_N - sym_N_S - asym_N_S;
+            dst->get( xOff+x, y, z, Stencil::idx[S] ) = dd_tmp_S - sym_N_S + asym_N_S;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_E  = src->get(x-1, y, z, Stencil::idx[E]);
-            const real_t dd_tmp_W  = src->get(x+1, y, z, Stencil::idx[W]);
+            const real_t dd_tmp_E  = src->get(xOff+x-1, y, z, Stencil::idx[E]);
+            const real_t dd_tmp_W  = src->get(xOff+x+1, y, z, Stencil::idx[W]);
 
             const real_t  sym_E_W = lambda_e_scaled * ( dd_tmp_E + dd_tmp_W - fac1 * velX[x] * velX[x] - t1x2 * feq_common[x] );
             const real_t asym_E_W = lambda_d_scaled * ( dd_tmp_E - dd_tmp_W - real_t(3.0) * t1x2 * velX[x] );
 
-            dst->get( x, y, z, Stencil::idx[E] ) = dd_tmp_E - sym_E_W - asym_E_W;
-            dst->get( x, y, z, Stencil::idx[W] ) = dd_tmp_W - sym_E_W + asym_E_W;
+            dst->get( xOff+x, y, z, Stencil::idx[E] ) = dd_tmp_E - sym_E_W - asym_E_W;
+            dst->get( xOff+x, y, z, Stencil::idx[W] ) = dd_tmp_W - sym_E_W + asym_E_W;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_T  = src->get(x, y, z-1, Stencil::idx[T]);
-            const real_t dd_tmp_B  = src->get(x, y, z+1, Stencil::idx[B]);
+            const real_t dd_tmp_T  = src->get(xOff+x, y, z-1, Stencil::idx[T]);
+            const real_t dd_tmp_B  = src->get(xOff+x, y, z+1, Stencil::idx[B]);
 
             const real_t  sym_T_B = lambda_e_scaled * ( dd_tmp_T + dd_tmp_B - fac1 * velZ[x] * velZ[x] - t1x2 * feq_common[x] );
             const real_t asym_T_B = lambda_d_scaled * ( dd_tmp_T - dd_tmp_B - real_t(3.0) * t1x2 * velZ[x] );
 
-            dst->get( x, y, z, Stencil::idx[T] ) = dd_tmp_T - sym_T_B - asym_T_B;
-            dst->get( x, y, z, Stencil::idx[B] ) = dd_tmp_B - sym_T_B + asym_T_B;
+            dst->get( xOff+x, y, z, Stencil::idx[T] ) = dd_tmp_T - sym_T_B - asym_T_B;
+            dst->get( xOff+x, y, z, Stencil::idx[B] ) = dd_tmp_B - sym_T_B + asym_T_B;
          }
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
 
    delete[] velX;
@@ -475,8 +626,6 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 #ifdef _OPENMP
    }
 #endif
-
-   src->swapDataPointers( dst );
 }
 
 template< typename LatticeModel_T >
@@ -853,6 +1002,95 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
 
 
+#ifdef WALBERLA_LBM_SPLIT_PURE_SIMD
+
+namespace internal {
+
+/// Fused stream & collide kernel of the compressible D3Q19 TRT sweep for one vector/scalar of cells.
+/// The order of all floating point operations is identical to the X_LOOP implementation below, so both produce
+/// bit-identical results.
+class TRTSplitPureCompressibleKernel
+{
+public:
+
+   TRTSplitPureCompressibleKernel( const real_t lambda_e, const real_t lambda_e_scaled, const real_t lambda_d_scaled,
+                                   const real_t t0_0, const real_t t1x2_0, const real_t t2x2_0, const real_t inv2csq2 ) :
+      lambda_e_( lambda_e ), lambda_e_scaled_( lambda_e_scaled ), lambda_d_scaled_( lambda_d_scaled ),
+      t0_0_( t0_0 ), t1x2_0_( t1x2_0 ), t2x2_0_( t2x2_0 ), inv2csq2_( inv2csq2 ) {}
+
+   template< typename Ops >
+   inline void cell( const split_pure_simd::D3Q19Line & l, const cell_idx_t x ) const
+   {
+      typedef typename Ops::value_type V;
+
+      const V lambda_e = Ops::broadcast( lambda_e_ );
+      const V one_minus_lambda_e = Ops::broadcast( real_t(1.0) - lambda_e_ );
+      const V t0_0   = Ops::broadcast( t0_0_ );
+      const V t1x2_0 = Ops::broadcast( t1x2_0_ );
+      const V t2x2_0 = Ops::broadcast( t2x2_0_ );
+      const V inv2csq2 = Ops::broadcast( inv2csq2_ );
+      const V one = Ops::broadcast( real_t(1.0) );
+      const V three_halves = Ops::broadcast( real_t(1.5) );
+
+      const V lambda_e_scaled = Ops::broadcast( lambda_e_scaled_ );
+      const V lambda_d_scaled = Ops::broadcast( lambda_d_scaled_ );
+
+      const V pNE = Ops::load( l.pNE + x ); const V pN  = Ops::load( l.pN  + x ); const V pNW = Ops::load( l.pNW + x );
+      const V pW  = Ops::load( l.pW  + x ); const V pSW = Ops::load( l.pSW + x ); const V pS  = Ops::load( l.pS  + x );
+      const V pSE = Ops::load( l.pSE + x ); const V pE  = Ops::load( l.pE  + x ); const V pT  = Ops::load( l.pT  + x );
+      const V pTE = Ops::load( l.pTE + x ); const V pTN = Ops::load( l.pTN + x ); const V pTW = Ops::load( l.pTW + x );
+      const V pTS = Ops::load( l.pTS + x ); const V pB  = Ops::load( l.pB  + x ); const V pBE = Ops::load( l.pBE + x );
+      const V pBN = Ops::load( l.pBN + x ); const V pBW = Ops::load( l.pBW + x ); const V pBS = Ops::load( l.pBS + x );
+      const V pC  = Ops::load( l.pC  + x );
+
+      const V velX_trm = pE + pNE + pSE + pTE + pBE;
+      const V velY_trm = pN + pNW + pTN + pBN;
+      const V velZ_trm = pT + pTS + pTW;
+
+      const V rho = pC + pS + pW + pB + pSW + pBS + pBW + velX_trm + velY_trm + velZ_trm;
+
+      const V invRho = one / rho;
+
+      const V velX = invRho * ( velX_trm - pW  - pNW - pSW - pTW - pBW );
+      const V velY = invRho * ( velY_trm + pNE - pS  - pSW - pSE - pTS - pBS );
+      const V velZ = invRho * ( velZ_trm + pTN + pTE - pB  - pBN - pBS - pBW - pBE );
+
+      const V t1x2 = t1x2_0 * rho;
+      const V t2x2 = t2x2_0 * rho;
+      const V fac1 = t1x2_0 * rho * inv2csq2;
+      const V fac2 = t2x2_0 * rho * inv2csq2;
+
+      const V feq_common = one - three_halves * ( velX * velX + velY * velY + velZ * velZ );
+
+      Ops::store( l.dC + x, pC * one_minus_lambda_e + lambda_e * t0_0 * rho * feq_common );
+
+      trtSplitPureRelax< Ops >( l.dNE + x, l.dSW + x, pNE, pSW, velX + velY, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dSE + x, l.dNW + x, pSE, pNW, velX - velY, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dTE + x, l.dBW + x, pTE, pBW, velX + velZ, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dBE + x, l.dTW + x, pBE, pTW, velX - velZ, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dTN + x, l.dBS + x, pTN, pBS, velY + velZ, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dBN + x, l.dTS + x, pBN, pTS, velY - velZ, fac2, t2x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dN  + x, l.dS  + x, pN,  pS,  velY,        fac1, t1x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dE  + x, l.dW  + x, pE,  pW,  velX,        fac1, t1x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+      trtSplitPureRelax< Ops >( l.dT  + x, l.dB  + x, pT,  pB,  velZ,        fac1, t1x2, feq_common, lambda_e_scaled, lambda_d_scaled );
+   }
+
+private:
+
+   const real_t lambda_e_;
+   const real_t lambda_e_scaled_;
+   const real_t lambda_d_scaled_;
+   const real_t t0_0_;
+   const real_t t1x2_0_;
+   const real_t t2x2_0_;
+   const real_t inv2csq2_;
+};
+
+} // namespace internal
+
+#endif // WALBERLA_LBM_SPLIT_PURE_SIMD
+
+
 ///////////////////////////////
 // Specialization for D3Q19: //
 // - compressible            //
@@ -888,7 +1126,43 @@ public:
    SplitPureSweep( const BlockDataID & src, const BlockDataID & dst ) :
       SweepBase<LatticeModel_T>( src, dst ) {}
 
-   void operator()( IBlock * const block );
+   void operator()( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getFields( block, src, dst );
+
+      streamCollide( src, dst, src->xyzSize() );
+      src->swapDataPointers( dst );
+   }
+
+   // 'inner' + 'frame' == 'operator()', see lbm::CellwiseSweep
+   void inner( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getBlockLocalFields( block, src, dst );
+
+      const CellInterval cells = innerCells< Stencil >( src->xyzSize() );
+      if( !cells.empty() )
+         streamCollide( src, dst, cells );
+   }
+
+   void frame( IBlock * const block )
+   {
+      PdfField_T * src( NULL );
+      PdfField_T * dst( NULL );
+      this->getBlockLocalFields( block, src, dst );
+
+      const std::vector< CellInterval > cells = frameCells< Stencil >( src->xyzSize() );
+      for( auto interval = cells.begin(); interval != cells.end(); ++interval )
+         streamCollide( src, dst, *interval );
+      src->swapDataPointers( dst );
+      this->releaseBlockLocalDstField( block );
+   }
+
+   /// stream & collide for all cells in 'cells' (src and dst are NOT swapped)
+   void streamCollide( PdfField_T * const src, PdfField_T * const dst, const CellInterval & cells );
 
    void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
    void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
@@ -901,14 +1175,13 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
                                                                                   boost::mpl::bool_< LatticeModel_T::compressible >,
                                                                                   boost::is_same< typename LatticeModel_T::ForceModel::tag,
                                                                                                   force_model::None_tag > > >::type
-   >::operator()( IBlock * const block )
+   >::streamCollide( PdfField_T * const src, PdfField_T * const dst, const CellInterval & cells )
 {
-   PdfField_T * src( NULL );
-   PdfField_T * dst( NULL );
-
-   this->getFields( block, src, dst );
-
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
+   WALBERLA_ASSERT_EQUAL( src->xyzSize(), dst->xyzSize() );
    WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT( src->xyzSize().contains( cells ) );
 
    // constants used during stream/collide
 
@@ -928,7 +1201,21 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    // loop constants
 
-   const cell_idx_t xSize = cell_idx_c( src->xSize() );
+   const cell_idx_t xOff  = cells.xMin(); // x-lines start at x = xOff, x below is relative to xOff
+   const cell_idx_t xSize = cell_idx_c( cells.xSize() );
+
+#ifdef WALBERLA_LBM_SPLIT_PURE_SIMD
+   if( internal::split_pure_simd::isApplicable( src, dst ) )
+   {
+      const internal::TRTSplitPureCompressibleKernel kernel( lambda_e, lambda_e_scaled, lambda_d_scaled, t0_0, t1x2_0, t2x2_0, inv2csq2 );
+
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp parallel for schedule(static),
+         internal::split_pure_simd::processLine( kernel, internal::split_pure_simd::D3Q19Line( src, dst, xOff, y, z ), xSize );
+      )
+
+      return;
+   }
+#endif
 
 #ifdef _OPENMP
    #pragma omp parallel
@@ -949,31 +1236,31 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    if( src->layout() == field::fzyx && dst->layout() == field::fzyx )
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp for schedule(static),
 
          using namespace stencil;
 
-         real_t * WALBERLA_RESTRICT pNE = &src->get(-1, y-1, z  , Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT pN  = &src->get(0 , y-1, z  , Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT pNW = &src->get(+1, y-1, z  , Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT pW  = &src->get(+1, y  , z  , Stencil::idx[W]);
-         real_t * WALBERLA_RESTRICT pSW = &src->get(+1, y+1, z  , Stencil::idx[SW]);
-         real_t * WALBERLA_RESTRICT pS  = &src->get(0 , y+1, z  , Stencil::idx[S]);
-         real_t * WALBERLA_RESTRICT pSE = &src->get(-1, y+1, z  , Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT pE  = &src->get(-1, y  , z  , Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT pT  = &src->get(0 , y  , z-1, Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT pTE = &src->get(-1, y  , z-1, Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT pTN = &src->get(0 , y-1, z-1, Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT pTW = &src->get(+1, y  , z-1, Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT pTS = &src->get(0 , y+1, z-1, Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT pB  = &src->get(0 , y  , z+1, Stencil::idx[B]);
-         real_t * WALBERLA_RESTRICT pBE = &src->get(-1, y  , z+1, Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT pBN = &src->get(0 , y-1, z+1, Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT pBW = &src->get(+1, y  , z+1, Stencil::idx[BW]);
-         real_t * WALBERLA_RESTRICT pBS = &src->get(0 , y+1, z+1, Stencil::idx[BS]);
-         real_t * WALBERLA_RESTRICT pC  = &src->get(0 , y  , z  , Stencil::idx[C]);
-
-         real_t * WALBERLA_RESTRICT dC = &dst->get(0,y,z,Stencil::idx[C]);
+         real_t * WALBERLA_RESTRICT pNE = &src->get(xOff-1, y-1, z  , Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT pN  = &src->get(xOff  , y-1, z  , Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT pNW = &src->get(xOff+1, y-1, z  , Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT pW  = &src->get(xOff+1, y  , z  , Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT pSW = &src->get(xOff+1, y+1, z  , Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT pS  = &src->get(xOff  , y+1, z  , Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT pSE = &src->get(xOff-1, y+1, z  , Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT pE  = &src->get(xOff-1, y  , z  , Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT pT  = &src->get(xOff  , y  , z-1, Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT pTE = &src->get(xOff-1, y  , z-1, Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT pTN = &src->get(xOff  , y-1, z-1, Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT pTW = &src->get(xOff+1, y  , z-1, Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT pTS = &src->get(xOff  , y+1, z-1, Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT pB  = &src->get(xOff  , y  , z+1, Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT pBE = &src->get(xOff-1, y  , z+1, Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT pBN = &src->get(xOff  , y-1, z+1, Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT pBW = &src->get(xOff+1, y  , z+1, Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT pBS = &src->get(xOff  , y+1, z+1, Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT pC  = &src->get(xOff  , y  , z  , Stencil::idx[C]);
+
+         real_t * WALBERLA_RESTRICT dC = &dst->get(xOff,y,z,Stencil::idx[C]);
 
          X_LOOP
          (
@@ -998,8 +1285,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dC[x] = pC[x] * (real_t(1.0) - lambda_e) + lambda_e * t0_0 * rho * feq_common[x];
          )
 
-         real_t * WALBERLA_RESTRICT dNE = &dst->get(0,y,z,Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT dSW = &dst->get(0,y,z,Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT dNE = &dst->get(xOff,y,z,Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT dSW = &dst->get(xOff,y,z,Stencil::idx[SW]);
 
          X_LOOP
          (
@@ -1011,8 +1298,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSW[x] = pSW[x] - sym_NE_SW + asym_NE_SW;
          )
 
-         real_t * WALBERLA_RESTRICT dSE = &dst->get(0,y,z,Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT dNW = &dst->get(0,y,z,Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT dSE = &dst->get(xOff,y,z,Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT dNW = &dst->get(xOff,y,z,Stencil::idx[NW]);
 
          X_LOOP
          (
@@ -1024,8 +1311,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dNW[x] = pNW[x] - sym_SE_NW + asym_SE_NW;
          )
 
-         real_t * WALBERLA_RESTRICT dTE = &dst->get(0,y,z,Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT dBW = &dst->get(0,y,z,Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT dTE = &dst->get(xOff,y,z,Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT dBW = &dst->get(xOff,y,z,Stencil::idx[BW]);
 
          X_LOOP
          (
@@ -1037,8 +1324,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBW[x] = pBW[x] - sym_TE_BW + asym_TE_BW;
          )
 
-         real_t * WALBERLA_RESTRICT dBE = &dst->get(0,y,z,Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT dTW = &dst->get(0,y,z,Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT dBE = &dst->get(xOff,y,z,Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT dTW = &dst->get(xOff,y,z,Stencil::idx[TW]);
 
          X_LOOP
          (
@@ -1050,8 +1337,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dTW[x] = pTW[x] - sym_BE_TW + asym_BE_TW;
          )
 
-         real_t * WALBERLA_RESTRICT dTN = &dst->get(0,y,z,Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT dBS = &dst->get(0,y,z,Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT dTN = &dst->get(xOff,y,z,Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT dBS = &dst->get(xOff,y,z,Stencil::idx[BS]);
 
          X_LOOP
          (
@@ -1063,8 +1350,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBS[x] = pBS[x] - sym_TN_BS + asym_TN_BS;
          )
 
-         real_t * WALBERLA_RESTRICT dBN = &dst->get(0,y,z,Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT dTS = &dst->get(0,y,z,Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT dBN = &dst->get(xOff,y,z,Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT dTS = &dst->get(xOff,y,z,Stencil::idx[TS]);
 
          X_LOOP
          (
@@ -1076,8 +1363,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dTS[x] = pTS[x] - sym_BN_TS + asym_BN_TS;
          )
 
-         real_t * WALBERLA_RESTRICT dN = &dst->get(0,y,z,Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT dS = &dst->get(0,y,z,Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT dN = &dst->get(xOff,y,z,Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT dS = &dst->get(xOff,y,z,Stencil::idx[S]);
 
          X_LOOP
          (
@@ -1088,8 +1375,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dS[x] = pS[x] - sym_N_S + asym_N_S;
          )
 
-         real_t * WALBERLA_RESTRICT dE = &dst->get(0,y,z,Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT dW = &dst->get(0,y,z,Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT dE = &dst->get(xOff,y,z,Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT dW = &dst->get(xOff,y,z,Stencil::idx[W]);
 
          X_LOOP
          (
@@ -1100,8 +1387,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dW[x] = pW[x] - sym_E_W + asym_E_W;
          )
 
-         real_t * WALBERLA_RESTRICT dT = &dst->get(0,y,z,Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT dB = &dst->get(0,y,z,Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT dT = &dst->get(xOff,y,z,Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT dB = &dst->get(xOff,y,z,Stencil::idx[B]);
 
          X_LOOP
          (
@@ -1112,35 +1399,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dB[x] = pB[x] - sym_T_B + asym_T_B;
          )
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
    else // ==> src->layout() == field::zyxf || dst->layout() == field::zyxf
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( cells, omp for schedule(static),
 
          using namespace stencil;
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z  , Stencil::idx[NE]);
-            const real_t dd_tmp_N  = src->get(x  , y-1, z  , Stencil::idx[N]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z  , Stencil::idx[NW]);
-            const real_t dd_tmp_W  = src->get(x+1, y  , z  , Stencil::idx[W]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z  , Stencil::idx[SW]);
-            const real_t dd_tmp_S  = src->get(x  , y+1, z  , Stencil::idx[S]);
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z  , Stencil::idx[SE]);
-            const real_t dd_tmp_E  = src->get(x-1, y  , z  , Stencil::idx[E]);
-            const real_t dd_tmp_T  = src->get(x  , y  , z-1, Stencil::idx[T]);
-            const real_t dd_tmp_TE = src->get(x-1, y  , z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_TN = src->get(x  , y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_TW = src->get(x+1, y  , z-1, Stencil::idx[TW]);
-            const real_t dd_tmp_TS = src->get(x  , y+1, z-1, Stencil::idx[TS]);
-            const real_t dd_tmp_B  = src->get(x  , y  , z+1, Stencil::idx[B]);
-            const real_t dd_tmp_BE = src->get(x-1, y  , z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_BN = src->get(x  , y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_BW = src->get(x+1, y  , z+1, Stencil::idx[BW]);
-            const real_t dd_tmp_BS = src->get(x  , y+1, z+1, Stencil::idx[BS]);
-            const real_t dd_tmp_C  = src->get(x  , y  , z  , Stencil::idx[C]);
+            const real_t dd_tmp_NE = src->get(xOff+x-1, y-1, z  , Stencil::idx[NE]);
+            const real_t dd_tmp_N  = src->get(xOff+x  , y-1, z  , Stencil::idx[N]);
+            const real_t dd_tmp_NW = src->get(xOff+x+1, y-1, z  , Stencil::idx[NW]);
+            const real_t dd_tmp_W  = src->get(xOff+x+1, y  , z  , Stencil::idx[W]);
+            const real_t dd_tmp_SW = src->get(xOff+x+1, y+1, z  , Stencil::idx[SW]);
+            const real_t dd_tmp_S  = src->get(xOff+x  , y+1, z  , Stencil::idx[S]);
+            const real_t dd_tmp_SE = src->get(xOff+x-1, y+1, z  , Stencil::idx[SE]);
+            const real_t dd_tmp_E  = src->get(xOff+x-1, y  , z  , Stencil::idx[E]);
+            const real_t dd_tmp_T  = src->get(xOff+x  , y  , z-1, Stencil::idx[T]);
+            const real_t dd_tmp_TE = src->get(xOff+x-1, y  , z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_TN = src->get(xOff+x  , y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_TW = src->get(xOff+x+1, y  , z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_TS = src->get(xOff+x  , y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_B  = src->get(xOff+x  , y  , z+1, Stencil::idx[B]);
+            const real_t dd_tmp_BE = src->get(xOff+x-1, y  , z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_BN = src->get(xOff+x  , y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_BW = src->get(xOff+x+1, y  , z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_BS = src->get(xOff+x  , y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_C  = src->get(xOff+x  , y  , z  , Stencil::idx[C]);
 
             const real_t velX_trm = dd_tmp_E + dd_tmp_NE + dd_tmp_SE + dd_tmp_TE + dd_tmp_BE;
             const real_t velY_trm = dd_tmp_N + dd_tmp_NW + dd_tmp_TN + dd_tmp_BN;
@@ -1160,124 +1447,124 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
             feq_common[x] = real_t(1.0) - real_t(1.5) * ( velX[x] * velX[x] + velY[x] * velY[x] + velZ[x] * velZ[x] );
 
-            dst->get( x, y, z, Stencil::idx[C] ) = dd_tmp_C * (real_t(1.0) - lambda_e) + lambda_e * t0_0 * rho * feq_common[x];
+            dst->get( xOff+x, y, z, Stencil::idx[C] ) = dd_tmp_C * (real_t(1.0) - lambda_e) + lambda_e * t0_0 * rho * feq_common[x];
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z, Stencil::idx[NE]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z, Stencil::idx[SW]);
+            const real_t dd_tmp_NE = src->get(xOff+x-1, y-1, z, Stencil::idx[NE]);
+            const real_t dd_tmp_SW = src->get(xOff+x+1, y+1, z, Stencil::idx[SW]);
 
             const real_t velXPY = velX[x] + velY[x];
             const real_t  sym_NE_SW = lambda_e_scaled * ( dd_tmp_NE + dd_tmp_SW - fac2[x] * velXPY * velXPY - t2x2[x] * feq_common[x] );
             const real_t asym_NE_SW = lambda_d_scaled * ( dd_tmp_NE - dd_tmp_SW - real_t(3.0) * t2x2[x] * velXPY );
 
-            dst->get( x, y, z, Stencil::idx[NE] ) = dd_tmp_NE - sym_NE_SW - asym_NE_SW;
-            dst->get( x, y, z, Stencil::idx[SW] ) = dd_tmp_SW - sym_NE_SW + asym_NE_SW;
+            dst->get( xOff+x, y, z, Stencil::idx[NE] ) = dd_tmp_NE - sym_NE_SW - asym_NE_SW;
+            dst->get( xOff+x, y, z, Stencil::idx[SW] ) = dd_tmp_SW - sym_NE_SW + asym_NE_SW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z, Stencil::idx[SE]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z, Stencil::idx[NW]);
+            const real_t dd_tmp_SE = src->get(xOff+x-1, y+1, z, Stencil::idx[SE]);
+            const real_t dd_tmp_NW = src->get(xOff+x+1, y-1, z, Stencil::idx[NW]);
 
             const real_t velXMY = velX[x] - velY[x];
             const real_t  sym_SE_NW = lambda_e_scaled * ( dd_tmp_SE + dd_tmp_NW - fac2[x] * velXMY * velXMY - t2x2[x] * feq_common[x] );
             const real_t asym_SE_NW = lambda_d_scaled * ( dd_tmp_SE - dd_tmp_NW - real_t(3.0) * t2x2[x] * velXMY );
 
-            dst->get( x, y, z, Stencil::idx[SE] ) = dd_tmp_SE - sym_SE_NW - asym_SE_NW;
-            dst->get( x, y, z, Stencil::idx[NW] ) = dd_tmp_NW - sym_SE_NW + asym_SE_NW;
+            dst->get( xOff+x, y, z, Stencil::idx[SE] ) = dd_tmp_SE - sym_SE_NW - asym_SE_NW;
+            dst->get( xOff+x, y, z, Stencil::idx[NW] ) = dd_tmp_NW - sym_SE_NW + asym_SE_NW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_TE = src->get(x-1, y, z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_BW = src->get(x+1, y, z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_TE = src->get(xOff+x-1, y, z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_BW = src->get(xOff+x+1, y, z+1, Stencil::idx[BW]);
 
             const real_t velXPZ = velX[x] + velZ[x];
             const real_t  sym_TE_BW = lambda_e_scaled * ( dd_tmp_TE + dd_tmp_BW - fac2[x] * velXPZ * velXPZ - t2x2[x] * feq_common[x] );
             const real_t asym_TE_BW = lambda_d_scaled * ( dd_tmp_TE - dd_tmp_BW - real_t(3.0) * t2x2[x] * velXPZ );
 
-            dst->get( x, y, z, Stencil::idx[TE] ) = dd_tmp_TE - sym_TE_BW - asym_TE_BW;
-            dst->get( x, y, z, Stencil::idx[BW] ) = dd_tmp_BW - sym_TE_BW + asym_TE_BW;
+            dst->get( xOff+x, y, z, Stencil::idx[TE] ) = dd_tmp_TE - sym_TE_BW - asym_TE_BW;
+            dst->get( xOff+x, y, z, Stencil::idx[BW] ) = dd_tmp_BW - sym_TE_BW + asym_TE_BW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_BE = src->get(x-1, y, z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_TW = src->get(x+1, y, z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_BE = src->get(xOff+x-1, y, z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_TW = src->get(xOff+x+1, y, z-1, Stencil::idx[TW]);
 
             const real_t velXMZ = velX[x] - velZ[x];
             const real_t  sym_BE_TW = lambda_e_scaled * ( dd_tmp_BE + dd_tmp_TW - fac2[x] * velXMZ * velXMZ - t2x2[x] * feq_common[x] );
             const real_t asym_BE_TW = lambda_d_scaled * ( dd_tmp_BE - dd_tmp_TW - real_t(3.0) * t2x2[x] * velXMZ );
 
-            dst->get( x, y, z, Stencil::idx[BE] ) = dd_tmp_BE - sym_BE_TW - asym_BE_TW;
-            dst->get( x, y, z, Stencil::idx[TW] ) = dd_tmp_TW - sym_BE_TW + asym_BE_TW;
+            dst->get( xOff+x, y, z, Stencil::idx[BE] ) = dd_tmp_BE - sym_BE_TW - asym_BE_TW;
+            dst->get( xOff+x, y, z, Stencil::idx[TW] ) = dd_tmp_TW - sym_BE_TW + asym_BE_TW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_TN = src->get(x, y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_BS = src->get(x, y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_TN = src->get(xOff+x, y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_BS = src->get(xOff+x, y+1, z+1, Stencil::idx[BS]);
 
             const real_t velYPZ = velY[x] + velZ[x];
             const real_t  sym_TN_BS = lambda_e_scaled * ( dd_tmp_TN + dd_tmp_BS - fac2[x] * velYPZ * velYPZ - t2x2[x] * feq_common[x] );
             const real_t asym_TN_BS = lambda_d_scaled * ( dd_tmp_TN - dd_tmp_BS - real_t(3.0) * t2x2[x] * velYPZ );
 
-            dst->get( x, y, z, Stencil::idx[TN] ) = dd_tmp_TN - sym_TN_BS - asym_TN_BS;
-            dst->get( x, y, z, Stencil::idx[BS] ) = dd_tmp_BS - sym_TN_BS + asym_TN_BS;
+            dst->get( xOff+x, y, z, Stencil::idx[TN] ) = dd_tmp_TN - sym_TN_BS - asym_TN_BS;
+            dst->get( xOff+x, y, z, Stencil::idx[BS] ) = dd_tmp_BS - sym_TN_BS + asym_TN_BS;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_BN = src->get(x, y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_TS = src->get(x, y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_BN = src->get(xOff+x, y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_TS = src->get(xOff+x, y+1, z-1, Stencil::idx[TS]);
 
             const real_t velYMZ = velY[x] - velZ[x];
             const real_t  sym_BN_TS = lambda_e_scaled * ( dd_tmp_BN + dd_tmp_TS - fac2[x] * velYMZ * velYMZ - t2x2[x] * feq_common[x] );
             const real_t asym_BN_TS = lambda_d_scaled * ( dd_tmp_BN - dd_tmp_TS - real_t(3.0) * t2x2[x] * velYMZ );
 
-            dst->get( x, y, z, Stencil::idx[BN] ) = dd_tmp_BN - sym_BN_TS - asym_BN_TS;
-            dst->get( x, y, z, Stencil::idx[TS] ) = dd_tmp_TS - sym_BN_TS + asym_BN_TS;
+            dst->get( xOff+x, y, z, Stencil::idx[BN] ) = dd_tmp_BN - sym_BN_TS - asym_BN_TS;
+            dst->get( xOff+x, y, z, Stencil::idx[TS] ) = dd_tmp_TS - sym_BN_TS + asym_BN_TS;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_N  = src->get(x, y-1, z, Stencil::idx[N]);
-            const real_t dd_tmp_S  = src->get(x, y+1, z, Stencil::idx[S]);
+            const real_t dd_tmp_N  = src->get(xOff+x, y-1, z, Stencil::idx[N]);
+            const real_t dd_tmp_S  = src->get(xOff+x, y+1, z, Stencil::idx[S]);
 
             const real_t  sym_N_S = lambda_e_scaled * ( dd_tmp_N + dd_tmp_S - fac1[x] * velY[x] * velY[x] - t1x2[x] * feq_common[x] );
             const real_t asym_N_S = lambda_d_scaled * ( dd_tmp_N - dd_tmp_S - real_t(3.0) * t1x2[x] * velY[x] );
 
-            dst->get( x, y, z, Stencil::idx[N] ) = dd_tmp_N - sym_N_S - asym_N_S;
-            dst->get( x, y, z, Stencil::idx[S] ) = dd_tmp_S - sym_N_S + asym_N_S;
+            dst->get( xOff+x, y, z, Stencil::idx[N] ) = dd_tmp_N - sym_N_S - asym_N_S;
+            dst->get( xOff+x, y, z, Stencil::idx[S] ) = dd_tmp_S - sym_N_S + asym_N_S;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_E  = src->get(x-1, y, z, Stencil::idx[E]);
-            const real_t dd_tmp_W  = src->get(x+1, y, z, Stencil::idx[W]);
+            const real_t dd_tmp_E  = src->get(xOff+x-1, y, z, Stencil::idx[E]);
+            const real_t dd_tmp_W  = src->get(xOff+x+1, y, z, Stencil::idx[W]);
 
             const real_t  sym_E_W = lambda_e_scaled * ( dd_tmp_E + dd_tmp_W - fac1[x] * velX[x] * velX[x] - t1x2[x] * feq_common[x] );
             const real_t asym_E_W = lambda_d_scaled * ( dd_tmp_E - dd_tmp_W - real_t(3.0) * t1x2[x] * velX[x] );
 
-            dst->get( x, y, z, Stencil::idx[E] ) = dd_tmp_E - sym_E_W - asym_E_W;
-            dst->get( x, y, z, Stencil::idx[W] ) = dd_tmp_W - sym_E_W + asym_E_W;
+            dst->get( xOff+x, y, z, Stencil::idx[E] ) = dd_tmp_E - sym_E_W - asym_E_W;
+            dst->get( xOff+x, y, z, Stencil::idx[W] ) = dd_tmp_W - sym_E_W + asym_E_W;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_T  = src->get(x, y, z-1, Stencil::idx[T]);
-            const real_t dd_tmp_B  = src->get(x, y, z+1, Stencil::idx[B]);
+            const real_t dd_tmp_T  = src->get(xOff+x, y, z-1, Stencil::idx[T]);
+            const real_t dd_tmp_B  = src->get(xOff+x, y, z+1, Stencil::idx[B]);
 
             const real_t  sym_T_B = lambda_e_scaled * ( dd_tmp_T + dd_tmp_B - fac1[x] * velZ[x] * velZ[x] - t1x2[x] * feq_common[x] );
             const real_t asym_T_B = lambda_d_scaled * ( dd_tmp_T - dd_tmp_B - real_t(3.0) * t1x2[x] * velZ[x] );
 
-            dst->get( x, y, z, Stencil::idx[T] ) = dd_tmp_T - sym_T_B - asym_T_B;
-            dst->get( x, y, z, Stencil::idx[B] ) = dd_tmp_B - sym_T_B + asym_T_B;
+            dst->get( xOff+x, y, z, Stencil::idx[T] ) = dd_tmp_T - sym_T_B - asym_T_B;
+            dst->get( xOff+x, y, z, Stencil::idx[B] ) = dd_tmp_B - sym_T_B + asym_T_B;
          }
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
 
    delete[] velX;
@@ -1292,8 +1579,6 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 #ifdef _OPENMP
    }
 #endif
-
-   src->swapDataPointers( dst );
 }
 
 template< typename LatticeModel_T >
@@ -31,12 +31,12 @@ namespace lbm {
 
 
 
-template< typename LatticeModel_T, typename OutputType = float >
+template< typename LatticeModel_T, typename OutputType = float, typename Field_T = PdfField< LatticeModel_T > >
 class DensityVTKWriter : public vtk::BlockCellDataWriter< OutputType >
 {
 public:
 
-   typedef PdfField< LatticeModel_T > PdfField_T;
+   typedef Field_T PdfField_T;
 
    DensityVTKWriter( const ConstBlockDataID & pdf, const std::string & id ) :
       vtk::BlockCellDataWriter< OutputType >( id ), bdid_( pdf ), pdf_( NULL ) {}
@@ -58,12 +58,12 @@ protected:
 
 
 
-template< typename LatticeModel_T, typename OutputType = float >
+template< typename LatticeModel_T, typename OutputType = float, typename Field_T = PdfField< LatticeModel_T > >
 class DensitySIVTKWriter : public vtk::BlockCellDataWriter< OutputType >
 {
 public:
 
-   typedef PdfField< LatticeModel_T > PdfField_T;
+   typedef Field_T PdfField_T;
 
    DensitySIVTKWriter( const ConstBlockDataID & pdf, const real_t rho_SI, const std::string & id ) :
       vtk::BlockCellDataWriter< OutputType >( id ), bdid_( pdf ), pdf_( NULL ), rho_SI_( rho_SI ) {}
@@ -31,12 +31,12 @@ namespace lbm {
 
 
 
-template< typename LatticeModel_T, typename OutputType = float >
+template< typename LatticeModel_T, typename OutputType = float, typename Field_T = PdfField< LatticeModel_T > >
 class VelocityVTKWriter : public vtk::BlockCellDataWriter< OutputType, 3 >
 {
 public:
 
-   typedef PdfField< LatticeModel_T > PdfField_T;
+   typedef Field_T PdfField_T;
 
    VelocityVTKWriter( const ConstBlockDataID & pdfFieldId, const std::string & id ) :
       vtk::BlockCellDataWriter< OutputType, 3 >( id ), bdid_( pdfFieldId ), pdf_( NULL ) {}
@@ -58,12 +58,12 @@ protected:
 
 
 
-template< typename LatticeModel_T, typename OutputType = float >
+template< typename LatticeModel_T, typename OutputType = float, typename Field_T = PdfField< LatticeModel_T > >
 class VelocityMagnitudeVTKWriter : public vtk::BlockCellDataWriter< OutputType, 1 >
 {
 public:
 
-   typedef PdfField< LatticeModel_T > PdfField_T;
+   typedef Field_T PdfField_T;
 
    VelocityMagnitudeVTKWriter( const ConstBlockDataID & pdfFieldId, const std::string & id ) :
       vtk::BlockCellDataWriter< OutputType, 1 >( id ), bdid_( pdfFieldId ), pdf_( NULL ) {}
@@ -85,12 +85,12 @@ protected:
 
 
 
-template< typename LatticeModel_T, typename OutputType = float >
+template< typename LatticeModel_T, typename OutputType = float, typename Field_T = PdfField< LatticeModel_T > >
 class VelocitySIVTKWriter : public vtk::BlockCellDataWriter< OutputType, 3 >
 {
 public:
 
-   typedef PdfField< LatticeModel_T > PdfField_T;
+   typedef Field_T PdfField_T;
 
    VelocitySIVTKWriter( const ConstBlockDataID & pdfFieldId, const real_t dx_SI, const real_t dt_SI, const std::string & id ) :
       vtk::BlockCellDataWriter< OutputType, 3 >( id ), bdid_( pdfFieldId ), pdf_( NULL ), dxDividedByDt_SI_( dx_SI / dt_SI ) {}
@@ -113,12 +113,12 @@ protected:
 
 
 
-template< typename LatticeModel_T, typename OutputType = float >
+template< typename LatticeModel_T, typename OutputType = float, typename Field_T = PdfField< LatticeModel_T > >
 class VelocitySIMagnitudeVTKWriter : public vtk::BlockCellDataWriter< OutputType, 1 >
 {
 public:
 
-   typedef PdfField< LatticeModel_T > PdfField_T;
+   typedef Field_T PdfField_T;
 
    VelocitySIMagnitudeVTKWriter( const ConstBlockDataID & pdfFieldId, const real_t dx_SI, const real_t dt_SI, const std::string & id ) :
       vtk::BlockCellDataWriter< OutputType, 1 >( id ), bdid_( pdfFieldId ), pdf_( NULL ), dxDividedByDt_SI_( dx_SI / dt_SI ) {}
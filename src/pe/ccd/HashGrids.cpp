@@ -30,6 +30,8 @@
 
 #include "core/timing/TimingTree.h"
 
+#include <algorithm>
+
 namespace walberla{
 namespace pe{
 namespace ccd {
@@ -42,8 +44,11 @@ namespace ccd {
 
 //*************************************************************************************************
 /*!\brief Constructor for the HashGrid class.
+ *
+ * \param cellSpan The edge length of the cubic grid cells.
+ * \param skin The skin distance used for the contact generation (see HashGrids::setSkin()).
  */
-HashGrids::HashGrid::HashGrid( real_t cellSpan )
+HashGrids::HashGrid::HashGrid( real_t cellSpan, real_t skin )
 {
    // Initialization of all member variables and ...
    xCellCount_   = powerOfTwo( xCellCount ) ? xCellCount : 16;
@@ -72,6 +77,7 @@ HashGrids::HashGrid::HashGrid( real_t cellSpan )
 
    cellSpan_        = cellSpan;
    inverseCellSpan_ = real_c( 1 ) / cellSpan;
+   skin_            = skin;
 
    occupiedCells_.reserve( occupiedCellsVectorSize );
 
@@ -589,12 +595,18 @@ void HashGrids::HashGrid::enlarge()
  *
  * \param bodystorage Reference to the central body storage.
  * \param bodystorageShadowCopies Reference to the body storage containing all body shadow copies.
+ * \param skin Skin distance for the reuse of the candidate pairs (see setSkin()).
  */
-HashGrids::HashGrids( BodyStorage& globalStorage, BodyStorage& bodystorage, BodyStorage& bodystorageShadowCopies )
+HashGrids::HashGrids( BodyStorage& globalStorage, BodyStorage& bodystorage, BodyStorage& bodystorageShadowCopies,
+                      real_t skin )
    : globalStorage_(globalStorage)
    , bodystorage_( bodystorage )
    , bodystorageShadowCopies_( bodystorageShadowCopies )
    , observedBodyCount_(0)
+   , skin_( std::max( skin, real_t(0) ) )
+   , rebuildRequired_(true)
+   , numberOfRebuilds_(0)
+   , numberOfContactGenerations_(0)
 {
    nonGridBodies_.reserve( gridActivationThreshold );
 
@@ -672,6 +684,8 @@ void HashGrids::add( BodyID body )
    // Temporarily add the body to 'bodiesToAdd_'. As soon as "findContacts()" is called, all
    // bodies stored in 'bodiesToAdd_' are finally inserted into the data structure.
    bodiesToAdd_.push_back( body );
+
+   rebuildRequired_ = true;
 }
 //*************************************************************************************************
 
@@ -688,6 +702,7 @@ void HashGrids::add( BodyID body )
 void HashGrids::remove( BodyID body )
 {
    --observedBodyCount_;
+   rebuildRequired_ = true;
 
    HashGrid* grid = static_cast<HashGrid*>( body->getGrid() );
 
@@ -743,6 +758,10 @@ void HashGrids::clear()
    nonGridBodies_.clear();
 
    bodiesToAdd_.clear();
+
+   candidates_.clear();
+   referenceAABBs_.clear();
+   rebuildRequired_ = true;
 }
 //*************************************************************************************************
 
@@ -872,7 +891,7 @@ void HashGrids::update(WcTimingTree* tt)
 
             if( grid != NULL )
             {
-               real_t size     = body->getAABBSize();
+               real_t size     = body->getAABBSize() + skin_;
                real_t cellSpan = grid->getCellSpan();
 
                if( size >= cellSpan || size < ( cellSpan / hierarchyFactor ) ) {
@@ -895,7 +914,7 @@ void HashGrids::update(WcTimingTree* tt)
 
             if( grid != NULL )
             {
-               real_t size     = body->getAABBSize();
+               real_t size     = body->getAABBSize() + skin_;
                real_t cellSpan = grid->getCellSpan();
 
                if( size >= cellSpan || size < ( cellSpan / hierarchyFactor ) ) {
@@ -912,6 +931,38 @@ void HashGrids::update(WcTimingTree* tt)
    if (tt != NULL) tt->stop("Update");
 }
 
+//**Skin functions******************************************************************************
+//*************************************************************************************************
+/*!\brief Sets the skin distance for the reuse of the candidate pairs.
+ *
+ * \param skin The skin distance (0 disables the reuse of the candidate pairs).
+ * \return void
+ *
+ * If the skin distance is larger than 0, all pairs of bodies whose bounding boxes are closer than
+ * the skin distance are stored as candidates whenever the hash grids are updated and traversed.
+ * The following calls of generatePossibleContacts() only test these candidates for overlapping
+ * bounding boxes, until a bound of the bounding box of any finite body has moved by half of the
+ * skin distance or more, or bodies have been added or removed. The skin distance should therefore
+ * be chosen as a multiple of the typical displacement of the bodies per time step. Since the
+ * bodies are assigned to grids with cells that are larger than their bounding boxes extended by
+ * the skin distance, the skin distance should be small compared to the size of the bodies.
+ */
+void HashGrids::setSkin( real_t skin )
+{
+   skin_ = std::max( skin, real_t(0) );
+
+   // The grid associations of all bodies are adapted to the new skin during the next update.
+   for( auto gridIt = gridList_.begin(); gridIt != gridList_.end(); ++gridIt ) {
+      (*gridIt)->setSkin( skin_ );
+   }
+
+   candidates_.clear();
+   referenceAABBs_.clear();
+   rebuildRequired_ = true;
+}
+//*************************************************************************************************
+
+
 //**Implementation of ICCD interface ********************************************************
 //*************************************************************************************************
 /*!\brief Contact generation between colliding rigid bodies.
@@ -919,16 +970,76 @@ void HashGrids::update(WcTimingTree* tt)
  * \return Vector of possible contacts.
  *
  * This function generates all contacts between all registered rigid bodies. The contacts are
- * added to the contact container which can be retrieved via getPossibleContacts().
+ * added to the contact container which can be retrieved via getPossibleContacts(). If a skin
+ * distance is set (see setSkin()), the cached candidate pairs are reused as long as possible.
  */
 PossibleContacts& HashGrids::generatePossibleContacts( WcTimingTree* tt )
 {
    if (tt != NULL) tt->start("CCD");
 
    contacts_.clear();
+   ++numberOfContactGenerations_;
+
+   if( skin_ > real_t(0) )
+   {
+      if( isRebuildRequired() )
+      {
+         WALBERLA_LOG_DETAIL( "   Finding the candidate pairs via the hierarchical hash grids algorithm...");
+
+         candidates_.clear();
+         detect( candidates_, tt );
+         storeReferenceAABBs();
+         rebuildRequired_ = false;
+         ++numberOfRebuilds_;
+      }
+
+      if (tt != NULL) tt->start("Candidates");
+      // Only the cached candidates can have overlapping bounding boxes.
+      contacts_.reserve( candidates_.size() );
+      for( auto cIt = candidates_.begin(); cIt != candidates_.end(); ++cIt ) {
+         collide( cIt->first, cIt->second, contacts_ );
+      }
+      if (tt != NULL) tt->stop("Candidates");
+   }
+   else
+   {
+      WALBERLA_LOG_DETAIL( "   Finding the contacts via the hierarchical hash grids algorithm...");
+
+      detect( contacts_, tt );
+      ++numberOfRebuilds_;
+   }
+
+
+   WALBERLA_LOG_DETAIL_SECTION()
+   {
+      std::stringstream log;
+      if( contacts_.empty() )
+         log << "      no contacts found!\n";
+      else {
+         log << "      State of the contacts:\n";
+         for( auto cIt=contacts_.begin(); cIt!=contacts_.end(); ++cIt ) {
+            log << "possible Contact " << cIt->first->getSystemID() << " : " << cIt->second->getSystemID() << "\n";
+         }
+      }
+      WALBERLA_LOG_DETAIL( log.str() );
+   }
 
-   WALBERLA_LOG_DETAIL( "   Finding the contacts via the hierarchical hash grids algorithm...");
+   if (tt != NULL) tt->stop("CCD");
 
+   return contacts_;
+}
+
+
+//*************************************************************************************************
+/*!\brief Updates the data structure and generates all pairs of bodies with overlapping bounding
+ *        boxes (or bounding boxes that are closer than the skin distance).
+ *
+ * \param contacts Contact container for the generated pairs.
+ * \param tt Optional timing tree.
+ * \return void
+ */
+void HashGrids::detect( PossibleContacts& contacts, WcTimingTree* tt )
+{
    update(tt);
 
    if (tt != NULL) tt->start("Detection");
@@ -940,26 +1051,27 @@ PossibleContacts& HashGrids::generatePossibleContacts( WcTimingTree* tt )
 
       // Contact generation for all bodies stored in the currently processed grid 'grid'.
       BodyID* bodies     = NULL;
-      size_t  bodyCount = (*gridIt)->process( &bodies, contacts_ );
+      size_t  bodyCount = (*gridIt)->process( &bodies, contacts );
 
       if( bodyCount > 0 ) {
 
          // Test all bodies stored in 'grid' against bodies stored in grids with larger sized cells.
          auto nextGridIt = gridIt;
          for( ++nextGridIt; nextGridIt != gridList_.end(); ++nextGridIt ) {
-            (*nextGridIt)->processBodies( bodies, bodyCount, contacts_ );
+            (*nextGridIt)->processBodies( bodies, bodyCount, contacts );
          }
 
-         BodyID* bodiesEnd = bodies + bodyCount;
-         for( BodyID* a = bodies; a < bodiesEnd; ++a ) {
-            // Test all bodies stored in 'grid' against all bodies stored in 'nonGridBodies_'.
-            for( auto bIt = nonGridBodies_.begin(); bIt < nonGridBodies_.end(); ++bIt ) {
-               collide( *a, *bIt, contacts_ );
-            }
-            // Test all bodies stored in 'grid' against all bodies stored in 'globalStorage_'.
-            for( auto bIt = globalStorage_.begin(); bIt < globalStorage_.end(); ++bIt ) {
-               collide( *a, *bIt, contacts_ );
-            }
+         if( !nonGridBodies_.empty() || globalStorage_.size() > 0 ) {
+            processInParallel( bodyCount, contacts, [&]( const size_t i, PossibleContacts& threadContacts ) {
+               // Test all bodies stored in 'grid' against all bodies stored in 'nonGridBodies_'.
+               for( auto bIt = nonGridBodies_.begin(); bIt < nonGridBodies_.end(); ++bIt ) {
+                  collide( bodies[i], *bIt, threadContacts, skin_ );
+               }
+               // Test all bodies stored in 'grid' against all bodies stored in 'globalStorage_'.
+               for( auto bIt = globalStorage_.begin(); bIt < globalStorage_.end(); ++bIt ) {
+                  collide( bodies[i], *bIt, threadContacts, skin_ );
+               }
+            } );
          }
       }
 
@@ -969,34 +1081,89 @@ PossibleContacts& HashGrids::generatePossibleContacts( WcTimingTree* tt )
    for( auto aIt = nonGridBodies_.begin(); aIt < nonGridBodies_.end(); ++aIt ) {
       // Pairwise test (=> contact generation) for all bodies that are stored in 'nonGridBodies_'.
       for( auto bIt = aIt + 1; bIt < nonGridBodies_.end(); ++bIt ) {
-         collide( *aIt, *bIt, contacts_ );
+         collide( *aIt, *bIt, contacts, skin_ );
       }
 
       // Pairwise test (=> contact generation) for all bodies that are stored in 'nonGridBodies_' with global bodies.
       for( auto bIt = globalStorage_.begin(); bIt < globalStorage_.end(); ++bIt ) {
-         collide( *aIt, *bIt, contacts_ );
+         collide( *aIt, *bIt, contacts, skin_ );
       }
    }
    if (tt != NULL) tt->stop("Detection");
+}
+//*************************************************************************************************
 
-   WALBERLA_LOG_DETAIL_SECTION()
+
+//*************************************************************************************************
+/*!\brief Checks whether the cached candidate pairs have to be regenerated.
+ *
+ * \return \a true if bodies were added or removed, if the set of global bodies changed, or if a bound
+ *         of the bounding box of any finite body has moved by half of the skin distance or more since
+ *         the last rebuild.
+ *
+ * If every bound has moved by less than half of the skin distance, the distance of any two bounding
+ * boxes has decreased by less than the skin distance. Thus, all pairs of currently overlapping
+ * bounding boxes have been closer than the skin distance at the last rebuild.
+ */
+bool HashGrids::isRebuildRequired() const
+{
+   if( rebuildRequired_ || !bodiesToAdd_.empty() )
+      return true;
+
+   // The global storage is shared by all blocks and has no callbacks of the HashGrids. Any exchange of a
+   // global body must be detected, since the cached candidates would refer to the removed body.
+   if( globalStorage_.size() != referenceGlobalBodyIDs_.size() )
+      return true;
+   auto idIt = referenceGlobalBodyIDs_.begin();
+   for( auto bIt = globalStorage_.begin(); bIt != globalStorage_.end(); ++bIt, ++idIt ) {
+      if( bIt->getSystemID() != *idIt )
+         return true;
+   }
+
+   const real_t halfSkin = real_t(0.5) * skin_;
+   for( auto it = referenceAABBs_.begin(); it != referenceAABBs_.end(); ++it )
    {
-      std::stringstream log;
-      if( contacts_.empty() )
-         log << "      no contacts found!\n";
-      else {
-         log << "      State of the contacts:\n";
-         for( auto cIt=contacts_.begin(); cIt!=contacts_.end(); ++cIt ) {
-            log << "possible Contact " << cIt->first->getSystemID() << " : " << cIt->second->getSystemID() << "\n";
-         }
+      const AABB& aabb = it->first->getAABB();
+      const AABB& ref  = it->second;
+      for( uint_t i = 0; i < 3; ++i ) {
+         if( std::fabs( aabb.minCorner()[i] - ref.minCorner()[i] ) >= halfSkin ||
+             std::fabs( aabb.maxCorner()[i] - ref.maxCorner()[i] ) >= halfSkin )
+            return true;
       }
-      WALBERLA_LOG_DETAIL( log.str() );
    }
+   return false;
+}
+//*************************************************************************************************
 
-   if (tt != NULL) tt->stop("CCD");
 
-   return contacts_;
+//*************************************************************************************************
+/*!\brief Stores the bounding boxes of all finite bodies as reference for isRebuildRequired().
+ *
+ * \return void
+ */
+void HashGrids::storeReferenceAABBs()
+{
+   referenceAABBs_.clear();
+   referenceAABBs_.reserve( bodystorage_.size() + bodystorageShadowCopies_.size() + globalStorage_.size() );
+
+   for( auto bIt = bodystorage_.begin(); bIt != bodystorage_.end(); ++bIt ) {
+      if( bIt->isFinite() ) referenceAABBs_.push_back( std::make_pair( *bIt, bIt->getAABB() ) );
+   }
+   if( &bodystorage_ != &bodystorageShadowCopies_ ) {
+      for( auto bIt = bodystorageShadowCopies_.begin(); bIt != bodystorageShadowCopies_.end(); ++bIt ) {
+         if( bIt->isFinite() ) referenceAABBs_.push_back( std::make_pair( *bIt, bIt->getAABB() ) );
+      }
+   }
+   for( auto bIt = globalStorage_.begin(); bIt != globalStorage_.end(); ++bIt ) {
+      if( bIt->isFinite() ) referenceAABBs_.push_back( std::make_pair( *bIt, bIt->getAABB() ) );
+   }
+
+   referenceGlobalBodyIDs_.clear();
+   for( auto bIt = globalStorage_.begin(); bIt != globalStorage_.end(); ++bIt ) {
+      referenceGlobalBodyIDs_.push_back( bIt->getSystemID() );
+   }
 }
+//*************************************************************************************************
 
 
 //=================================================================================================
@@ -1016,7 +1183,9 @@ PossibleContacts& HashGrids::generatePossibleContacts( WcTimingTree* tt )
  */
 void HashGrids::addGrid( BodyID body )
 {
-   real_t size = ( body->isFinite() ) ? body->getAABBSize() : real_c( -1 );
+   // With a skin distance, the bodies have to be assigned to grids with cells that are larger than
+   // their bounding boxes extended by the skin in order to find all bodies within the skin distance.
+   real_t size = ( body->isFinite() ) ? body->getAABBSize() + skin_ : real_c( -1 );
 
    // If the body is finite in size, it must be assigned to a grid with suitably sized cells.
    if( size > 0 )
@@ -1028,7 +1197,7 @@ void HashGrids::addGrid( BodyID body )
          // If no hash grid yet exists in the hierarchy, an initial hash grid is created
          // based on the body's size.
 
-         grid = new HashGrid( size * std::sqrt( hierarchyFactor ) );
+         grid = new HashGrid( size * std::sqrt( hierarchyFactor ), skin_ );
       }
       else
       {
@@ -1046,7 +1215,7 @@ void HashGrids::addGrid( BodyID body )
                cellSpan /= hierarchyFactor;
                if( size < cellSpan ) {
                   while( size < cellSpan ) cellSpan /= hierarchyFactor;
-                  grid = new HashGrid( cellSpan * hierarchyFactor );
+                  grid = new HashGrid( cellSpan * hierarchyFactor, skin_ );
                   gridList_.insert( gIt, grid );
                }
 
@@ -1058,7 +1227,7 @@ void HashGrids::addGrid( BodyID body )
          }
 
          while( size >= cellSpan) cellSpan *= hierarchyFactor;
-         grid = new HashGrid( cellSpan );
+         grid = new HashGrid( cellSpan, skin_ );
       }
 
       grid->add( body );
@@ -1325,6 +1494,20 @@ const size_t HashGrids::gridActivationThreshold = 32;
 const real_t HashGrids::hierarchyFactor = real_c(2);
 //*************************************************************************************************
 
+
+//*************************************************************************************************
+/*!\brief Minimal number of work items (occupied cells or bodies) for a thread-parallel detection step.
+ *
+ * If OpenMP is enabled, the contact generation of each grid is distributed among all threads (see
+ * processInParallel()). For small numbers of cells or bodies, the overhead of starting a parallel
+ * region and merging the thread-local contact containers outweighs the gain, and the detection step
+ * is performed by the calling thread only.
+ *
+ * Possible settings: any integral value greater-or-equal to 0.
+ */
+const size_t HashGrids::parallelizationThreshold = 256;
+//*************************************************************************************************
+
 }  // namespace ccd
 
 }  // namespace pe
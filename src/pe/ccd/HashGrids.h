@@ -34,6 +34,7 @@
 #include <core/logging/Logging.h>
 #include <core/debug/Debug.h>
 #include <core/NonCopyable.h>
+#include <core/OpenMP.h>
 
 #include <cmath>
 #include <list>
@@ -78,6 +79,14 @@ namespace ccd {
  *
  * For further information and a much more detailed explanation of this algorithm see
  *     http://www10.informatik.uni-erlangen.de/Publications/Theses/2009/Schornbaum_SA09.pdf
+ *
+ * Optionally, the candidate pairs can be reused over several time steps (Verlet list approach,
+ * see setSkin()). In this mode, all pairs of bodies whose bounding boxes are closer than the skin
+ * distance are stored as candidates. As long as no bound of any bounding box has moved by half
+ * of the skin distance or more since the candidates were generated, every pair of overlapping
+ * bounding boxes is guaranteed to be among the candidates and the hash grids are neither updated
+ * nor traversed. Instead, the possible contacts are obtained by testing the cached candidates for
+ * overlapping bounding boxes. Adding or removing bodies always triggers a rebuild.
  */
 class HashGrids : public ICCD
 {
@@ -92,6 +101,7 @@ public:
    static const size_t minimalGridDensity;
    static const size_t gridActivationThreshold;
    static const real_t hierarchyFactor;
+   static const size_t parallelizationThreshold;
    //**********************************************************************************************
 
 private:
@@ -140,7 +150,7 @@ private:
       //**Constructor******************************************************************************
       /*!\name Constructor */
       //@{
-      explicit HashGrid( real_t cellSpan );
+      explicit HashGrid( real_t cellSpan, real_t skin );
       //@}
       //*******************************************************************************************
 
@@ -158,6 +168,13 @@ private:
       //@}
       //*******************************************************************************************
 
+      //**Setter functions*************************************************************************
+      /*!\name Setter functions */
+      //@{
+      void setSkin( real_t skin ) { skin_ = skin; }  //!< Setter for \a skin_.
+      //@}
+      //*******************************************************************************************
+
       //**Add/remove functions*********************************************************************
       /*!\name Add/remove functions */
       //@{
@@ -185,6 +202,12 @@ private:
       //**Utility functions************************************************************************
       /*!\name Utility functions */
       //@{
+      template< typename Contacts >
+      void processCell( const Cell* cell, BodyID* bodies, Contacts& contacts ) const;
+
+      template< typename Contacts >
+      void processBody( BodyID body, Contacts& contacts ) const;
+
       void initializeNeighborOffsets();
 
       size_t hash( BodyID body ) const;
@@ -218,6 +241,7 @@ private:
                                                  size of this hash grid is increased. */
 
       real_t cellSpan_;         //!< The grid's cell size (edge length of the underlying cubic grid cells).
+      real_t skin_;             //!< The skin distance used for the contact generation (see HashGrids::setSkin()).
       real_t inverseCellSpan_;  //!< The inverse cell size.
                               /*!< Required for replacing floating point divisions with multiplications
                                    during the hash computation. */
@@ -248,7 +272,8 @@ public:
    /*!\name Constructor */
    //@{
 //   HashGrids( BodyStorage& bodystorage );
-   HashGrids( BodyStorage& globalStorage, BodyStorage& bodystorage, BodyStorage& bodystorageShadowCopies );
+   HashGrids( BodyStorage& globalStorage, BodyStorage& bodystorage, BodyStorage& bodystorageShadowCopies,
+              real_t skin = real_t(0) );
    //@}
    //**********************************************************************************************
 
@@ -276,6 +301,22 @@ public:
    //@}
    //**********************************************************************************************
 
+   //**Skin functions******************************************************************************
+   /*!\name Skin functions */
+   //@{
+          void   setSkin( real_t skin );
+   inline real_t getSkin() const { return skin_; }  //!< Returns the skin distance (0 if the candidates are not reused).
+
+   /// number of generations of the candidate pairs / calls of generatePossibleContacts() since the last reset
+   inline size_t getNumberOfRebuilds()           const { return numberOfRebuilds_; }
+   inline size_t getNumberOfContactGenerations() const { return numberOfContactGenerations_; }
+   /// fraction of the calls of generatePossibleContacts() that regenerated the candidate pairs
+   inline real_t getRebuildFrequency() const
+   { return ( numberOfContactGenerations_ > 0 ) ? real_c( numberOfRebuilds_ ) / real_c( numberOfContactGenerations_ ) : real_t(1); }
+   inline void   resetStatistics() { numberOfRebuilds_ = 0; numberOfContactGenerations_ = 0; }
+   //@}
+   //**********************************************************************************************
+
    void    update(WcTimingTree* tt);
    //**Implementation of ICCD interface ********************************************************
    virtual PossibleContacts& generatePossibleContacts( WcTimingTree* tt = NULL );
@@ -287,7 +328,10 @@ protected:
    /*!\name Utility functions */
    //@{
    template< typename Contacts >
-   static inline void collide( BodyID a, BodyID b, Contacts& contacts );
+   static inline void collide( BodyID a, BodyID b, Contacts& contacts, real_t skin = real_t(0) );
+
+   template< typename Contacts, typename Kernel >
+   static void processInParallel( size_t n, Contacts& contacts, const Kernel& kernel );
    //@}
    //**********************************************************************************************
 
@@ -303,6 +347,10 @@ private:
    //**Utility functions***************************************************************************
    /*!\name Utility functions */
    //@{
+   void detect( PossibleContacts& contacts, WcTimingTree* tt );
+   bool isRebuildRequired() const;
+   void storeReferenceAABBs();
+
    static inline bool powerOfTwo( size_t number );
    //@}
    //**********************************************************************************************
@@ -334,6 +382,14 @@ private:
                                       faster than involving the far more complex mechanisms of the
                                       hierarchical hash grids. */
    int          observedBodyCount_;  /// number of bodies currently tracked by this hashgrid
+
+   real_t       skin_;           //!< Skin distance for the reuse of the candidate pairs (0: no reuse).
+   PossibleContacts candidates_; //!< Cached candidate pairs (only used if \a skin_ is larger than 0).
+   std::vector< std::pair<BodyID, AABB> > referenceAABBs_;  //!< Bounding boxes of all finite bodies at the last rebuild.
+   std::vector< walberla::id_t > referenceGlobalBodyIDs_;  //!< System IDs of the global bodies at the last rebuild.
+   bool         rebuildRequired_;  //!< Set if bodies were added or removed since the last rebuild.
+   size_t       numberOfRebuilds_;            //!< Number of generations of the candidate pairs.
+   size_t       numberOfContactGenerations_;  //!< Number of calls of generatePossibleContacts().
    //@}
    //**********************************************************************************************
 };
@@ -360,6 +416,8 @@ private:
  * contacts are added to the contact container \a contacts. Moreover, a linear array that contains
  * (handles to) all bodies that are stored in this grid is returned in order to being able to check
  * these bodies against other bodies that are stored in grids with larger sized cells.
+ *
+ * The occupied cells are processed in parallel if OpenMP is enabled (see processInParallel()).
  */
 template< typename Contacts >  // Contact container type
 size_t HashGrids::HashGrid::process( BodyID** gridBodies, Contacts& contacts ) const
@@ -367,54 +425,18 @@ size_t HashGrids::HashGrid::process( BodyID** gridBodies, Contacts& contacts ) c
    BodyID* bodies = new BodyID[ bodyCount_ ];
    *gridBodies    = bodies;
 
-   // Iterate through all cells that are occupied by bodies (=> 'occupiedCells_') and ...
-   for( typename CellVector::const_iterator cell = occupiedCells_.begin(); cell < occupiedCells_.end(); ++cell )
-   {
-      BodyVector* cellBodies = (*cell)->bodies_;
-
-      // ... perform pairwise collision checks within each of these cells.
-      for( auto aIt = cellBodies->begin(); aIt < cellBodies->end(); ++aIt ) {
-         auto end = cellBodies->begin();
-         if ((*aIt)->isFixed())
-         {
-            end = cellBodies->begin() + ((*cell)->lastNonFixedBody_ + 1);
-         } else
-         {
-            end = cellBodies->end();
-         }
-         for( auto bIt = aIt + 1; bIt < end; ++bIt ) {
-            WALBERLA_ASSERT( !((*aIt)->isFixed() && (*bIt)->isFixed()), "collision between two fixed bodies" );
-            HashGrids::collide( *aIt, *bIt, contacts );
-         }
-         *(bodies++) = *aIt;
-      }
-
-      // Moreover, check all the bodies that are stored in the currently processed cell against all
-      // bodies that are stored in the first half of all directly adjacent cells.
-      for( unsigned int i = 0; i < 13; ++i )
-      {
-         Cell*       nbCell   = (*cell) + (*cell)->neighborOffset_[i];
-         BodyVector* nbBodies = nbCell->bodies_;
-
-         if( nbBodies != NULL )
-         {
-            for( auto aIt = cellBodies->begin(); aIt < cellBodies->end(); ++aIt ) {
-               auto endNeighbour = nbBodies->begin();
-               if ((*aIt)->isFixed())
-               {
-                  endNeighbour = nbBodies->begin() + (nbCell->lastNonFixedBody_ + 1);
-               } else
-               {
-                  endNeighbour = nbBodies->end();
-               }
-               for( auto bIt = nbBodies->begin(); bIt < endNeighbour; ++bIt ) {
-                  WALBERLA_ASSERT( !((*aIt)->isFixed() && (*bIt)->isFixed()), "collision between two fixed bodies" );
-                  HashGrids::collide( *aIt, *bIt, contacts );
-               }
-            }
-         }
-      }
+   // The bodies of each occupied cell are stored consecutively in 'bodies' (in the order of 'occupiedCells_').
+   std::vector<size_t> bodyOffset( occupiedCells_.size() );
+   size_t offset = 0;
+   for( size_t i = 0; i < occupiedCells_.size(); ++i ) {
+      bodyOffset[i] = offset;
+      offset += occupiedCells_[i]->bodies_->size();
    }
+   WALBERLA_ASSERT_EQUAL( offset, bodyCount_ );
+
+   processInParallel( occupiedCells_.size(), contacts, [&]( const size_t i, Contacts& threadContacts ) {
+      processCell( occupiedCells_[i], bodies + bodyOffset[i], threadContacts );
+   } );
 
    return bodyCount_;
 }
@@ -433,27 +455,59 @@ size_t HashGrids::HashGrid::process( BodyID** gridBodies, Contacts& contacts ) c
  *
  * This function generates all contacts between the rigid bodies that are stored in \a bodies and
  * all the rigid bodies that are assigned to this grid. The contacts are added to the contact
- * container \a contacts.
+ * container \a contacts. The bodies are processed in parallel if OpenMP is enabled.
  */
 template< typename Contacts >  // Contact container type
 void HashGrids::HashGrid::processBodies( BodyID* bodies, size_t bodyCount, Contacts& contacts ) const
 {
-   // For each body 'a' that is stored in 'bodies' ...
-   for( BodyID* aIt = bodies; aIt < bodies + bodyCount; ++aIt )
-   {
-      // ... calculate the body's cell association (=> "hash()") within this hash grid and ...
-      Cell* cell = cell_ + hash( *aIt );
-
-      // ... check 'a' against every body that is stored in this or in any of the directly adjacent
-      // cells. Note: one entry in the offset array of a cell is always referring back to the cell
-      // itself. As a consequence, a specific cell X and all of its neighbors can be addressed by
-      // simply iterating through all entries of X's offset array!
-      for( unsigned int i = 0; i < 27; ++i )
+   processInParallel( bodyCount, contacts, [&]( const size_t i, Contacts& threadContacts ) {
+      processBody( bodies[i], threadContacts );
+   } );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Generates all contacts between the bodies of one (occupied) cell and between these bodies and
+ *        the bodies of the first half of all directly adjacent cells.
+ *
+ * \param cell The processed cell.
+ * \param bodies Array that receives (handles to) all the bodies that are stored in \a cell.
+ * \param contacts Contact container for the generated contacts.
+ * \return void
+ */
+template< typename Contacts >  // Contact container type
+void HashGrids::HashGrid::processCell( const Cell* cell, BodyID* bodies, Contacts& contacts ) const
+{
+   BodyVector* cellBodies = cell->bodies_;
+
+   // Perform pairwise collision checks within the cell.
+   for( auto aIt = cellBodies->begin(); aIt < cellBodies->end(); ++aIt ) {
+      auto end = cellBodies->begin();
+      if ((*aIt)->isFixed())
+      {
+         end = cellBodies->begin() + (cell->lastNonFixedBody_ + 1);
+      } else
       {
-         Cell*       nbCell   = cell + cell->neighborOffset_[i];
-         BodyVector* nbBodies = nbCell->bodies_;
+         end = cellBodies->end();
+      }
+      for( auto bIt = aIt + 1; bIt < end; ++bIt ) {
+         WALBERLA_ASSERT( !((*aIt)->isFixed() && (*bIt)->isFixed()), "collision between two fixed bodies" );
+         HashGrids::collide( *aIt, *bIt, contacts, skin_ );
+      }
+      *(bodies++) = *aIt;
+   }
 
-         if( nbBodies != NULL ) {
+   // Moreover, check all the bodies that are stored in the cell against all bodies that are stored
+   // in the first half of all directly adjacent cells.
+   for( unsigned int i = 0; i < 13; ++i )
+   {
+      const Cell* nbCell   = cell + cell->neighborOffset_[i];
+      BodyVector* nbBodies = nbCell->bodies_;
+
+      if( nbBodies != NULL )
+      {
+         for( auto aIt = cellBodies->begin(); aIt < cellBodies->end(); ++aIt ) {
             auto endNeighbour = nbBodies->begin();
             if ((*aIt)->isFixed())
             {
@@ -462,9 +516,9 @@ void HashGrids::HashGrid::processBodies( BodyID* bodies, size_t bodyCount, Conta
             {
                endNeighbour = nbBodies->end();
             }
-            for( auto bIt = nbBodies->begin(); bIt != endNeighbour; ++bIt ) {
+            for( auto bIt = nbBodies->begin(); bIt < endNeighbour; ++bIt ) {
                WALBERLA_ASSERT( !((*aIt)->isFixed() && (*bIt)->isFixed()), "collision between two fixed bodies" );
-               HashGrids::collide( *aIt, *bIt, contacts );
+               HashGrids::collide( *aIt, *bIt, contacts, skin_ );
             }
          }
       }
@@ -473,6 +527,48 @@ void HashGrids::HashGrid::processBodies( BodyID* bodies, size_t bodyCount, Conta
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Checks a body (that is stored in another grid) for collisions with the bodies that are
+ *        stored in this grid.
+ *
+ * \param body The body that is checked.
+ * \param contacts Contact container for the generated contacts.
+ * \return void
+ */
+template< typename Contacts >  // Contact container type
+void HashGrids::HashGrid::processBody( BodyID body, Contacts& contacts ) const
+{
+   // Calculate the body's cell association (=> "hash()") within this hash grid and ...
+   const Cell* cell = cell_ + hash( body );
+
+   // ... check the body against every body that is stored in this or in any of the directly adjacent
+   // cells. Note: one entry in the offset array of a cell is always referring back to the cell
+   // itself. As a consequence, a specific cell X and all of its neighbors can be addressed by
+   // simply iterating through all entries of X's offset array!
+   for( unsigned int i = 0; i < 27; ++i )
+   {
+      const Cell* nbCell   = cell + cell->neighborOffset_[i];
+      BodyVector* nbBodies = nbCell->bodies_;
+
+      if( nbBodies != NULL ) {
+         auto endNeighbour = nbBodies->begin();
+         if (body->isFixed())
+         {
+            endNeighbour = nbBodies->begin() + (nbCell->lastNonFixedBody_ + 1);
+         } else
+         {
+            endNeighbour = nbBodies->end();
+         }
+         for( auto bIt = nbBodies->begin(); bIt != endNeighbour; ++bIt ) {
+            WALBERLA_ASSERT( !(body->isFixed() && (*bIt)->isFixed()), "collision between two fixed bodies" );
+            HashGrids::collide( body, *bIt, contacts, skin_ );
+         }
+      }
+   }
+}
+//*************************************************************************************************
+
+
 
 
 //=================================================================================================
@@ -488,17 +584,19 @@ void HashGrids::HashGrid::processBodies( BodyID* bodies, size_t bodyCount, Conta
  * \param a The first body.
  * \param b The second body.
  * \param contacts Contact container for the generated contacts.
+ * \param skin Bodies whose bounding boxes are closer than this distance are considered colliding.
  * \return void
  */
 template< typename Contacts >  // Contact container type
-void HashGrids::collide( BodyID a, BodyID b, Contacts& contacts )
+void HashGrids::collide( BodyID a, BodyID b, Contacts& contacts, real_t skin )
 {
    //make sure to always check in the correct order (a<b)
    if (a->getSystemID() > b->getSystemID())
       std::swap(a, b);
 
    if( ( !a->hasInfiniteMass() || !b->hasInfiniteMass() ) &&        // Ignoring contacts between two fixed bodies
-       ( a->getAABB().intersects( b->getAABB() ) ) )  // Testing for overlapping bounding boxes
+       ( skin > real_t(0) ? a->getAABB().intersects( b->getAABB(), skin )     // Testing for overlapping bounding boxes
+                          : a->getAABB().intersects( b->getAABB() ) ) )
    {
       //FineDetector::collide( a, b, contacts );
       contacts.push_back( std::make_pair(a, b) );
@@ -507,6 +605,57 @@ void HashGrids::collide( BodyID a, BodyID b, Contacts& contacts )
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Executes \a kernel for all work items 0, ..., \a n - 1 (in parallel if OpenMP is enabled).
+ *
+ * \param n The number of work items.
+ * \param contacts Contact container for the generated contacts.
+ * \param kernel Function object that is called as kernel( i, threadContacts ) for every work item i.
+ * \return void
+ *
+ * Every thread processes one contiguous range of work items and collects the generated contacts in
+ * a thread-local container. Afterwards, these containers are appended to \a contacts in the order
+ * of the ranges. As a consequence, the contacts (and their order) are identical to serial execution,
+ * independent of the number of threads. Small numbers of work items (see parallelizationThreshold)
+ * as well as calls from within an active parallel region are processed serially.
+ */
+template< typename Contacts, typename Kernel >  // Contact container type, work item function type
+void HashGrids::processInParallel( size_t n, Contacts& contacts, const Kernel& kernel )
+{
+#ifdef _OPENMP
+   const int threads = omp_get_max_threads();
+   if( threads > 1 && n >= parallelizationThreshold && !omp_in_parallel() )
+   {
+      std::vector<Contacts> threadContacts( static_cast<size_t>( threads ) );
+
+      #pragma omp parallel num_threads( threads )
+      {
+         // the team may be smaller than requested, so the ranges depend on the actual number of threads
+         const size_t t     = static_cast<size_t>( omp_get_thread_num() );
+         const size_t team  = static_cast<size_t>( omp_get_num_threads() );
+         const size_t begin = ( n *   t               ) / team;
+         const size_t end   = ( n * ( t + size_t(1) ) ) / team;
+         for( size_t i = begin; i < end; ++i )
+            kernel( i, threadContacts[t] );
+      }
+
+      size_t size = contacts.size();
+      for( auto it = threadContacts.begin(); it != threadContacts.end(); ++it )
+         size += it->size();
+      contacts.reserve( size );
+
+      for( auto it = threadContacts.begin(); it != threadContacts.end(); ++it )
+         contacts.insert( contacts.end(), it->begin(), it->end() );
+      return;
+   }
+#endif
+
+   for( size_t i = 0; i < n; ++i )
+      kernel( i, contacts );
+}
+//*************************************************************************************************
+
+
 }  // namespace ccd
 
 }  // namespace pe
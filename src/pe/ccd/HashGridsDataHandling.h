@@ -32,21 +32,25 @@ namespace ccd {
 
 class HashGridsDataHandling : public blockforest::AlwaysInitializeBlockDataHandling<HashGrids>{
 public:
-   HashGridsDataHandling(const shared_ptr<BodyStorage>& globalStorage, const BlockDataID& storageID) : globalStorage_(globalStorage), storageID_(storageID) {}
+   HashGridsDataHandling(const shared_ptr<BodyStorage>& globalStorage, const BlockDataID& storageID, const real_t skin = real_t(0))
+      : globalStorage_(globalStorage), storageID_(storageID), skin_(skin) {}
    HashGrids * initialize( IBlock * const block )
    {
       Storage* storage = block->getData< Storage >( storageID_ );
-      return new HashGrids(*globalStorage_, (*storage)[0], (*storage)[1]);
+      return new HashGrids(*globalStorage_, (*storage)[0], (*storage)[1], skin_);
    }
 private:
    shared_ptr<BodyStorage>  globalStorage_;
    BlockDataID              storageID_;
+   real_t                   skin_;
 };
 
+/// \param skin skin distance for the reuse of the candidate pairs over several time steps (see HashGrids::setSkin)
 inline
-shared_ptr<HashGridsDataHandling> createHashGridsDataHandling(const shared_ptr<BodyStorage>& globalStorage,const BlockDataID& storageID)
+shared_ptr<HashGridsDataHandling> createHashGridsDataHandling(const shared_ptr<BodyStorage>& globalStorage,const BlockDataID& storageID,
+                                                              const real_t skin = real_t(0))
 {
-   return make_shared<HashGridsDataHandling>( globalStorage, storageID );
+   return make_shared<HashGridsDataHandling>( globalStorage, storageID, skin );
 }
 
 }
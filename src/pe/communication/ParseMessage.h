@@ -24,6 +24,7 @@
 
 #include "pe/rigidbody/BodyStorage.h"
 #include "pe/communication/DynamicMarshalling.h"
+#include "pe/communication/RigidBodyCompactUpdateNotification.h"
 #include "pe/communication/RigidBodyCopyNotification.h"
 #include "pe/communication/RigidBodyDeletionNotification.h"
 #include "pe/communication/RigidBodyForceNotification.h"
@@ -47,6 +48,26 @@ namespace walberla {
 namespace pe {
 namespace communication {
 
+/// applies the parameters of a (compact) rigid body update notification to the shadow copy of the body
+template <typename UpdateParameters>
+void applyUpdateNotification(Owner sender, UpdateParameters& objparam, const domain_decomposition::BlockStorage& blockStorage, IBlock& block, BodyStorage& shadowStorage)
+{
+   WALBERLA_UNUSED(sender);
+
+   auto bodyIt = shadowStorage.find( objparam.sid_ );
+   WALBERLA_ASSERT_UNEQUAL( bodyIt, shadowStorage.end() );
+   BodyID b( *bodyIt );
+
+   WALBERLA_ASSERT( b->MPITrait.getOwner().blockID_ == sender.blockID_, "Update notifications must be sent by owner.\n" << b->MPITrait.getOwner().blockID_ << " != "<< sender.blockID_ );
+   WALBERLA_ASSERT( b->isRemote(), "Update notification must only concern shadow copies." );
+
+   correctBodyPosition(blockStorage.getDomain(), block.getAABB().center(), objparam.gpos_);
+   b->setPosition   ( objparam.gpos_ );
+   b->setOrientation( objparam.q_    );
+   b->setLinearVel  ( objparam.v_    );
+   b->setAngularVel ( objparam.w_    );
+}
+
 template <typename BodyTypeTuple>
 void parseMessage(Owner sender, mpi::RecvBuffer& rb, const domain_decomposition::BlockStorage& blockStorage, IBlock& block, BodyStorage& localStorage, BodyStorage& shadowStorage)
 {
@@ -86,20 +107,21 @@ void parseMessage(Owner sender, mpi::RecvBuffer& rb, const domain_decomposition:
 
             WALBERLA_LOG_DETAIL( "Received rigid body update notification for body " << objparam.sid_ << " from neighboring process with rank " << sender << ":\nv = " << objparam.v_ << "\nw = " << objparam.w_ << "\nposition = " << objparam.gpos_ << "\nquaternion = " << objparam.q_);
 
-            auto bodyIt = shadowStorage.find( objparam.sid_ );
-            WALBERLA_ASSERT_UNEQUAL( bodyIt, shadowStorage.end() );
-            BodyID b( *bodyIt );
+            applyUpdateNotification( sender, objparam, blockStorage, block, shadowStorage );
+
+            WALBERLA_LOG_DETAIL( "Processed rigid body update notification.");//:\n" << b );
+
+            break;
+         }
+         case rigidBodyCompactUpdateNotification: {
+            typename RigidBodyCompactUpdateNotification::Parameters objparam;
+            unmarshal( rb, objparam );
 
-            WALBERLA_ASSERT( b->MPITrait.getOwner().blockID_ == sender.blockID_, "Update notifications must be sent by owner.\n" << b->MPITrait.getOwner().blockID_ << " != "<< sender.blockID_ );
-            WALBERLA_ASSERT( b->isRemote(), "Update notification must only concern shadow copies." );
+            WALBERLA_LOG_DETAIL( "Received rigid body compact update notification for body " << objparam.sid_ << " from neighboring process with rank " << sender << ":\nv = " << objparam.v_ << "\nw = " << objparam.w_ << "\nposition = " << objparam.gpos_ << "\nquaternion = " << objparam.q_);
 
-            correctBodyPosition(blockStorage.getDomain(), block.getAABB().center(), objparam.gpos_);
-            b->setPosition   ( objparam.gpos_ );
-            b->setOrientation( objparam.q_    );
-            b->setLinearVel  ( objparam.v_    );
-            b->setAngularVel ( objparam.w_    );
+            applyUpdateNotification( sender, objparam, blockStorage, block, shadowStorage );
 
-            WALBERLA_LOG_DETAIL( "Processed rigid body update notification.");//:\n" << b );
+            WALBERLA_LOG_DETAIL( "Processed rigid body compact update notification.");
 
             break;
          }
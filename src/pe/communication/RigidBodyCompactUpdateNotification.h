@@ -0,0 +1,136 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file RigidBodyCompactUpdateNotification.h
+//! \brief Header file for the RigidBodyCompactUpdateNotification class
+//
+//======================================================================================================================
+
+#pragma once
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <pe/rigidbody/RigidBody.h>
+#include "NotificationType.h"
+#include "Marshalling.h"
+
+#include <cmath>
+
+
+namespace walberla {
+namespace pe {
+namespace communication {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Wrapper class for compact rigid body updates.
+ *
+ * In contrast to the RigidBodyUpdateNotification, the orientation and the linear and angular
+ * velocities are quantized to single precision. The position is transmitted in full precision
+ * since the contact detection on the receiving process depends on it.
+ */
+class RigidBodyCompactUpdateNotification {
+public:
+   struct Parameters {
+      id_t sid_;
+      Vec3 gpos_, v_, w_;
+      Quat q_;
+   };
+
+   inline explicit RigidBodyCompactUpdateNotification( const RigidBody& b ) : body_(b) {}
+   const RigidBody& body_;
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Marshalling compact rigid body updates.
+ *
+ * \param buffer The buffer to be filled.
+ * \param obj The object to be marshalled.
+ * \return void
+ *
+ * The update consists of the position, and the quantized orientation and linear and angular
+ * velocities.
+ */
+template< typename Buffer >
+inline void marshal( Buffer& buffer, const RigidBodyCompactUpdateNotification& obj ) {
+
+   buffer << obj.body_.getSystemID();
+   buffer << obj.body_.getPosition();
+   const Quat& q = obj.body_.getQuaternion();
+   for( uint_t i = 0; i < 4; ++i )
+      buffer << static_cast<float>( q[i] );
+   for( uint_t i = 0; i < 3; ++i )
+      buffer << static_cast<float>( obj.body_.getLinearVel()[i] );
+   for( uint_t i = 0; i < 3; ++i )
+      buffer << static_cast<float>( obj.body_.getAngularVel()[i] );
+
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Unmarshalling compact rigid body updates.
+ *
+ * \param buffer The buffer from where to read.
+ * \param objparam The object to be reconstructed.
+ * \return void
+ *
+ * The quantized orientation is normalized again.
+ */
+template< typename Buffer >
+inline void unmarshal( Buffer& buffer, typename RigidBodyCompactUpdateNotification::Parameters& objparam ) {
+   buffer >> objparam.sid_;
+   buffer >> objparam.gpos_;
+
+   float q[4];
+   for( uint_t i = 0; i < 4; ++i )
+      buffer >> q[i];
+   const real_t ilen = real_t(1) / std::sqrt( real_c(q[0]) * real_c(q[0]) + real_c(q[1]) * real_c(q[1]) +
+                                              real_c(q[2]) * real_c(q[2]) + real_c(q[3]) * real_c(q[3]) );
+   objparam.q_ = Quat( real_c(q[0]) * ilen, real_c(q[1]) * ilen, real_c(q[2]) * ilen, real_c(q[3]) * ilen );
+
+   float v[3];
+   for( uint_t i = 0; i < 3; ++i )
+      buffer >> v[i];
+   objparam.v_ = Vec3( real_c(v[0]), real_c(v[1]), real_c(v[2]) );
+   for( uint_t i = 0; i < 3; ++i )
+      buffer >> v[i];
+   objparam.w_ = Vec3( real_c(v[0]), real_c(v[1]), real_c(v[2]) );
+
+}
+//*************************************************************************************************
+
+//*************************************************************************************************
+/*!\brief Returns the notification type of a compact rigid body update.
+ * \return The notification type of a compact rigid body update.
+ */
+template<>
+inline NotificationType notificationType< RigidBodyCompactUpdateNotification >() {
+   return rigidBodyCompactUpdateNotification;
+}
+//*************************************************************************************************
+
+}  // namespace communication
+}  // namespace pe
+}  // namespace walberla
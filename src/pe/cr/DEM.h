@@ -34,12 +34,23 @@
 
 #include "domain_decomposition/BlockStorage.h"
 
+#include <vector>
+
 namespace walberla {
 namespace pe {
 namespace cr {
 
 /**
  * \ingroup pe
+ *
+ * Thread parallelism (see setThreadParallel): the treated contacts of a block are scheduled in levels, such that every
+ * body is part of at most one contact per level and the contacts of every body are resolved in their original order.
+ * The contacts of a level are resolved concurrently by the OpenMP threads, except for contacts with global bodies, which
+ * are resolved by a single thread after the other contacts of the level. Afterwards, the local bodies are integrated
+ * concurrently. The forces and trajectories of all non-global bodies are thus identical to the serial resolution, and
+ * the results are independent of the number of threads. Only the summation order of the forces acting on global bodies
+ * differs from the serial resolution. The contact resolver must only modify the bodies of the contact it is called for.
+ * The levels are assigned with the DEMBodyTrait of the bodies.
  */
 template< typename Integrator, typename ContactResolver >
 class DEMSolver : public ICR
@@ -59,6 +70,12 @@ public:
    /// Advances the simulation dt seconds.
    void timestep( const real_t dt );
 
+   /// Resolves the contacts and integrates the bodies with OpenMP threads (default if compiled with OpenMP).
+   /// Blocks with less than parallelizationThreshold contacts / bodies, runs with a single OpenMP thread, and builds
+   /// without OpenMP use the serial resolution and integration.
+   void setThreadParallel( bool threadParallel ) { threadParallel_ = threadParallel; }
+   bool isThreadParallel() const { return threadParallel_; }
+
    inline Integrator                getIntegrator()                const { return integrate_; }
    inline ContactResolver           getContactResolver()           const { return resolveContact_; }
    virtual inline real_t            getMaximumPenetration()        const WALBERLA_OVERRIDE { return maxPenetration_; }
@@ -77,6 +94,19 @@ private:
    real_t                            maxPenetration_;
    size_t                            numberOfContacts_;
    size_t                            numberOfContactsTreated_;
+
+   bool                              threadParallel_;
+
+   /// Minimal number of contacts / bodies of a block for which OpenMP threads are used
+   static const size_t               parallelizationThreshold = 256;
+
+   inline bool useThreads( size_t numberOfItems ) const;
+   void resolveContactsInLevels( Contacts& contacts, const math::AABB& blockAABB, real_t dt );
+   void integrateInParallel( BodyStorage& localStorage, real_t dt );
+
+   std::vector< size_t >             bucketOfContact_;  // level * 2 (+1 for contacts with global bodies)
+   std::vector< size_t >             bucketBegin_;
+   std::vector< ContactID >          scheduledContacts_;
 };
 
 class DEM : public DEMSolver<IntegrateImplicitEuler, ResolveContactSpringDashpotHaffWerner>
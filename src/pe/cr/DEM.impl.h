@@ -36,6 +36,10 @@
 #include "pe/synchronization/SyncForces.h"
 
 #include "core/logging/all.h"
+#include "core/OpenMP.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace walberla {
 namespace pe {
@@ -60,6 +64,11 @@ DEMSolver<Integrator,ContactResolver>::DEMSolver(
    , maxPenetration_(0)
    , numberOfContacts_(0)
    , numberOfContactsTreated_(0)
+#ifdef _OPENMP
+   , threadParallel_(true)
+#else
+   , threadParallel_(false)
+#endif
 {
 
 }
@@ -81,14 +90,21 @@ void DEMSolver<Integrator,ContactResolver>::timestep( real_t dt )
       Contacts& cont = fcd->generateContacts( ccd->getPossibleContacts() );
       if (tt_ != NULL) tt_->stop("FCD");
 
-      for (auto cIt = cont.begin(); cIt != cont.end(); ++cIt){
-         const real_t overlap( -cIt->getDistance() );
-         if( overlap > maxPenetration_ )
-            maxPenetration_ = overlap;
-         if (shouldContactBeTreated( &(*cIt), currentBlock.getAABB() ))
-         {
-            ++numberOfContactsTreated_;
-            resolveContact_( &(*cIt), dt);
+      if( useThreads( cont.size() ) )
+      {
+         resolveContactsInLevels( cont, currentBlock.getAABB(), dt );
+      }
+      else
+      {
+         for (auto cIt = cont.begin(); cIt != cont.end(); ++cIt){
+            const real_t overlap( -cIt->getDistance() );
+            if( overlap > maxPenetration_ )
+               maxPenetration_ = overlap;
+            if (shouldContactBeTreated( &(*cIt), currentBlock.getAABB() ))
+            {
+               ++numberOfContactsTreated_;
+               resolveContact_( &(*cIt), dt);
+            }
          }
       }
 
@@ -116,32 +132,39 @@ void DEMSolver<Integrator,ContactResolver>::timestep( real_t dt )
 
       if (tt_ != NULL) tt_->start("Integration");
 
-      for( auto bodyIt = localStorage.begin(); bodyIt != localStorage.end(); ++bodyIt )
+      if( useThreads( localStorage.size() ) )
       {
-         WALBERLA_LOG_DETAIL( "Time integration of body with system id " << bodyIt->getSystemID());// << "\n" << *bodyIt );
+         integrateInParallel( localStorage, dt );
+      }
+      else
+      {
+         for( auto bodyIt = localStorage.begin(); bodyIt != localStorage.end(); ++bodyIt )
+         {
+            WALBERLA_LOG_DETAIL( "Time integration of body with system id " << bodyIt->getSystemID());// << "\n" << *bodyIt );
 
-         // Resetting the contact node and removing all attached contacts
-      //      bodyIt->resetNode();
-         bodyIt->clearContacts();
+            // Resetting the contact node and removing all attached contacts
+         //      bodyIt->resetNode();
+            bodyIt->clearContacts();
 
-         // Checking the state of the body
-         WALBERLA_ASSERT( bodyIt->checkInvariants(), "Invalid body state detected" );
-         WALBERLA_ASSERT( !bodyIt->hasSuperBody(), "Invalid superordinate body detected" );
+            // Checking the state of the body
+            WALBERLA_ASSERT( bodyIt->checkInvariants(), "Invalid body state detected" );
+            WALBERLA_ASSERT( !bodyIt->hasSuperBody(), "Invalid superordinate body detected" );
          
-         // Moving the body according to the acting forces (don't move a sleeping body)
-         if( bodyIt->isAwake() && !bodyIt->hasInfiniteMass() )
-         {
-            integrate_( *bodyIt, dt, *this );
-         }
+            // Moving the body according to the acting forces (don't move a sleeping body)
+            if( bodyIt->isAwake() && !bodyIt->hasInfiniteMass() )
+            {
+               integrate_( *bodyIt, dt, *this );
+            }
          
-         // Resetting the acting forces
-         bodyIt->resetForceAndTorque();
+            // Resetting the acting forces
+            bodyIt->resetForceAndTorque();
          
-         // Checking the state of the rigid body
-         WALBERLA_ASSERT( bodyIt->checkInvariants(), "Invalid body state detected" );
+            // Checking the state of the rigid body
+            WALBERLA_ASSERT( bodyIt->checkInvariants(), "Invalid body state detected" );
 
-         // Resetting the acting forces
-         bodyIt->resetForceAndTorque();
+            // Resetting the acting forces
+            bodyIt->resetForceAndTorque();
+         }
       }
 
       if (tt_ != NULL) tt_->stop("Integration");
@@ -155,6 +178,169 @@ void DEMSolver<Integrator,ContactResolver>::timestep( real_t dt )
    }
 }
 
+//*************************************************************************************************
+/*!\brief Returns whether the contacts / bodies of a block are processed by OpenMP threads.
+ *
+ * \param numberOfItems The number of contacts / bodies of the block.
+ * \return true if thread parallelism is enabled, more than one thread is available, and the block has enough items.
+ */
+template< typename Integrator, typename ContactResolver >
+inline bool DEMSolver<Integrator,ContactResolver>::useThreads( size_t numberOfItems ) const
+{
+#ifdef _OPENMP
+   return threadParallel_ && numberOfItems >= parallelizationThreshold && omp_get_max_threads() > 1 && !omp_in_parallel();
+#else
+   WALBERLA_UNUSED( numberOfItems );
+   return false;
+#endif
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Resolves the treated contacts of a block in levels (see DEMSolver).
+ *
+ * \param contacts The contacts of the block.
+ * \param blockAABB The AABB of the block.
+ * \param dt Time step size.
+ * \return void
+ *
+ * The level of a contact is the first level after the levels of all previous contacts of its two
+ * bodies, global bodies are not taken into account. Every level is split into the contacts without
+ * global bodies, which are resolved concurrently, and the contacts with global bodies, which are
+ * resolved by a single thread.
+ */
+template< typename Integrator, typename ContactResolver >
+void DEMSolver<Integrator,ContactResolver>::resolveContactsInLevels( Contacts& contacts, const math::AABB& blockAABB, real_t dt )
+{
+   const size_t untreated = std::numeric_limits<size_t>::max();
+
+   bucketOfContact_.resize( contacts.size() );
+   size_t numberOfBuckets( 0 );
+
+   for( size_t i = 0; i < contacts.size(); ++i )
+   {
+      ContactID c = &contacts[i];
+
+      const real_t overlap( -c->getDistance() );
+      if( overlap > maxPenetration_ )
+         maxPenetration_ = overlap;
+
+      if( !shouldContactBeTreated( c, blockAABB ) )
+      {
+         bucketOfContact_[i] = untreated;
+         continue;
+      }
+      ++numberOfContactsTreated_;
+
+      BodyID b1( c->getBody1()->getTopSuperBody() );
+      BodyID b2( c->getBody2()->getTopSuperBody() );
+
+      size_t level( 0 );
+      if( !b1->isGlobal() ) level = std::max( level, b1->level_ );
+      if( !b2->isGlobal() ) level = std::max( level, b2->level_ );
+      if( !b1->isGlobal() ) b1->level_ = level + 1;
+      if( !b2->isGlobal() ) b2->level_ = level + 1;
+
+      bucketOfContact_[i] = size_t(2) * level + ( ( b1->isGlobal() || b2->isGlobal() ) ? size_t(1) : size_t(0) );
+      numberOfBuckets = std::max( numberOfBuckets, bucketOfContact_[i] + size_t(1) );
+   }
+
+   // counting sort of the treated contacts into the buckets (stable, i.e., in the original order within a bucket)
+   bucketBegin_.assign( numberOfBuckets + size_t(1), size_t(0) );
+   for( size_t i = 0; i < contacts.size(); ++i )
+      if( bucketOfContact_[i] != untreated )
+         ++bucketBegin_[ bucketOfContact_[i] + size_t(1) ];
+   for( size_t b = 0; b < numberOfBuckets; ++b )
+      bucketBegin_[b + size_t(1)] += bucketBegin_[b];
+
+   scheduledContacts_.resize( bucketBegin_[numberOfBuckets] );
+   for( size_t i = 0; i < contacts.size(); ++i )
+   {
+      if( bucketOfContact_[i] != untreated )
+      {
+         scheduledContacts_[ bucketBegin_[ bucketOfContact_[i] ]++ ] = &contacts[i];
+         contacts[i].getBody1()->getTopSuperBody()->level_ = size_t(0);
+         contacts[i].getBody2()->getTopSuperBody()->level_ = size_t(0);
+      }
+   }
+   for( size_t b = numberOfBuckets; b > size_t(0); --b )
+      bucketBegin_[b] = bucketBegin_[b - size_t(1)];
+   bucketBegin_[0] = size_t(0);
+
+#ifdef _OPENMP
+   if( scheduledContacts_.size() >= parallelizationThreshold && omp_get_max_threads() > 1 && !omp_in_parallel() )
+   {
+      #pragma omp parallel
+      {
+         for( size_t bucket = 0; bucket < numberOfBuckets; ++bucket )
+         {
+            const int begin = int_c( bucketBegin_[bucket] );
+            const int end   = int_c( bucketBegin_[bucket + size_t(1)] );
+
+            if( bucket % size_t(2) == size_t(0) )
+            {
+               // no two contacts of a level share a non-global body
+               #pragma omp for schedule(static)
+               for( int i = begin; i < end; ++i )
+                  resolveContact_( scheduledContacts_[ size_t(i) ], dt );
+            }
+            else
+            {
+               #pragma omp single
+               {
+                  for( int i = begin; i < end; ++i )
+                     resolveContact_( scheduledContacts_[ size_t(i) ], dt );
+               }
+            }
+         }
+      }
+      return;
+   }
+#endif
+
+   for( auto cIt = scheduledContacts_.begin(); cIt != scheduledContacts_.end(); ++cIt )
+      resolveContact_( *cIt, dt );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Integrates the local bodies of a block with OpenMP threads.
+ *
+ * \param localStorage The local bodies of the block.
+ * \param dt Time step size.
+ * \return void
+ */
+template< typename Integrator, typename ContactResolver >
+void DEMSolver<Integrator,ContactResolver>::integrateInParallel( BodyStorage& localStorage, real_t dt )
+{
+   const int numberOfBodies = int_c( localStorage.size() );
+
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(static) if( numberOfBodies >= int_c( parallelizationThreshold ) && !omp_in_parallel() )
+#endif
+   for( int i = 0; i < numberOfBodies; ++i )
+   {
+      BodyID body = localStorage.at( size_t(i) );
+
+      body->clearContacts();
+
+      WALBERLA_ASSERT( body->checkInvariants(), "Invalid body state detected" );
+      WALBERLA_ASSERT( !body->hasSuperBody(), "Invalid superordinate body detected" );
+
+      if( body->isAwake() && !body->hasInfiniteMass() )
+      {
+         integrate_( body, dt, *this );
+      }
+
+      body->resetForceAndTorque();
+
+      WALBERLA_ASSERT( body->checkInvariants(), "Invalid body state detected" );
+   }
+}
+//*************************************************************************************************
+
 }  // namespace cr
 } // namespace pe
 }  // namespace walberla
@@ -0,0 +1,40 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file DEMBodyTrait.h
+//! \brief Body data used by the thread parallel contact resolution of the DEM solver
+//
+//======================================================================================================================
+
+#pragma once
+
+#include <cstddef>
+
+namespace walberla {
+namespace pe {
+namespace cr {
+
+class DEMBodyTrait
+{
+public:
+   DEMBodyTrait() : level_( 0 ) {}
+
+   size_t level_; //level of the last scheduled contact of the body plus one, zero outside of the contact scheduling
+
+};
+
+}
+} // namespace pe
+}  // namespace walberla
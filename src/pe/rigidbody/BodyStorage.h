@@ -35,6 +35,7 @@
 #include <core/ptrvector/policies/PtrDelete.h>
 #include <core/ptrvector/PtrVector.h>
 #include <pe/rigidbody/RigidBody.h>
+#include <pe/rigidbody/SystemIDIndex.h>
 #include <pe/Types.h>
 
 #include <functional>
@@ -55,7 +56,8 @@ namespace pe {
 /*!\brief Body storage of the rigid body simulation world.
  *
  * A BodyStorage is a data structure for storing rigid bodies. It supports efficient insertion and
- * deletion operations.
+ * deletion operations. Bodies are found by their system ID with a hash index (see SystemIDIndex),
+ * lookup, insertion and removal take constant expected time.
  */
 class BodyStorage : private NonCopyable
 {
@@ -148,7 +150,7 @@ private:
    /*!\name Member variables */
    //@{
    Bodies bodies_;  //!< The rigid bodies contained in the simulation world.
-   std::map<id_t, SizeType> bodyIDs_;   //!< The association of system IDs to rigid bodies.
+   SystemIDIndex<SizeType> bodyIDs_;   //!< The association of system IDs to rigid bodies.
 
    std::map< std::string, std::function<void (BodyID)> > addCallbacks_;
    std::map< std::string, std::function<void (BodyID)> > removeCallbacks_;
@@ -408,11 +410,11 @@ inline ConstBodyID BodyStorage::at( SizeType index ) const
 
 inline BodyStorage::Iterator BodyStorage::find( id_t sid )
 {
-   std::map<id_t, SizeType>::const_iterator pos = bodyIDs_.find( sid );
-   if( pos == bodyIDs_.end() )
+   const SizeType pos = bodyIDs_.find( sid );
+   if( pos == SystemIDIndex<SizeType>::npos )
       return bodies_.end();
 
-   return bodies_.begin() + static_cast<Bodies::Iterator::difference_type>(pos->second);
+   return bodies_.begin() + static_cast<Bodies::Iterator::difference_type>(pos);
 }
 //*************************************************************************************************
 
@@ -430,11 +432,11 @@ inline BodyStorage::Iterator BodyStorage::find( id_t sid )
 
 inline BodyStorage::ConstIterator BodyStorage::find( id_t sid ) const
 {
-   std::map<id_t, SizeType>::const_iterator pos = bodyIDs_.find( sid );
-   if( pos == bodyIDs_.end() )
+   const SizeType pos = bodyIDs_.find( sid );
+   if( pos == SystemIDIndex<SizeType>::npos )
       return bodies_.end();
 
-   return bodies_.begin() + static_cast<Bodies::Iterator::difference_type>(pos->second);
+   return bodies_.begin() + static_cast<Bodies::Iterator::difference_type>(pos);
 }
 //*************************************************************************************************
 
@@ -490,14 +492,14 @@ inline BodyStorage::ConstIterator BodyStorage::find( ConstBodyID body ) const
  * \return void
  *
  * This function adds a rigid body to the body storage. Adding bodies with non-unique system ID or
- * adding the same body multiple times results in undefined behaviour. The time complexity is
- * logarithmic unless reallocation occurs.
+ * adding the same body multiple times results in undefined behaviour. The expected time complexity
+ * is constant unless reallocation occurs.
  */
 
 inline void BodyStorage::add( BodyID body )
 {
-   WALBERLA_ASSERT( bodyIDs_.find( body->getSystemID() ) == bodyIDs_.end(), "Body with same system ID already added." );
-   bodyIDs_[ body->getSystemID() ] = bodies_.size();
+   WALBERLA_ASSERT( bodyIDs_.find( body->getSystemID() ) == SystemIDIndex<SizeType>::npos, "Body with same system ID already added." );
+   bodyIDs_.insert( body->getSystemID(), bodies_.size() );
    bodies_.pushBack( body );
 
    for (auto it = addCallbacks_.begin(); it != addCallbacks_.end(); ++it)
@@ -516,26 +518,24 @@ inline void BodyStorage::add( BodyID body )
  *
  * This function removes a body from the body storage. \a sid must be a valid system id.
  * Invalidates all iterators pointing at or past
- * the element to be removed. The time complexity is logarithmic unless reallocation occurs.
+ * the element to be removed. The expected time complexity is constant unless reallocation occurs.
  * The last element is swapped to the actual position and the length is reduced by one.
  */
 
 inline void BodyStorage::remove( const id_t sid )
 {
-   std::map<id_t, SizeType>::iterator it = bodyIDs_.find( sid );
-   WALBERLA_ASSERT( it != bodyIDs_.end(), "The body's system ID was not registered." );
-
-   // Move last element to deleted place and update the system ID to index mapping.
-   SizeType i = it->second;
+   const SizeType i = bodyIDs_.find( sid );
+   WALBERLA_ASSERT( i != SystemIDIndex<SizeType>::npos, "The body's system ID was not registered." );
 
    for (auto cb = removeCallbacks_.begin(); cb != removeCallbacks_.end(); ++cb)
    {
       cb->second( bodies_[i] );
    }
 
-   bodyIDs_[ bodies_.back()->getSystemID() ] = i;
+   // Move last element to deleted place and update the system ID to index mapping.
+   bodyIDs_.update( bodies_.back()->getSystemID(), i );
    std::swap( bodies_[i], bodies_.back() );
-   bodyIDs_.erase( it );
+   bodyIDs_.erase( sid );
    bodies_.popBack();
 }
 //*************************************************************************************************
@@ -549,7 +549,7 @@ inline void BodyStorage::remove( const id_t sid )
  *
  * This function removes a body from the body storage. \a pos must be a valid iterator and the
  * rigid body pointer referred to must be valid. Invalidates all iterators pointing at or past
- * the element to be removed. The time complexity is logarithmic unless reallocation occurs.
+ * the element to be removed. The expected time complexity is constant unless reallocation occurs.
  */
 
 inline BodyStorage::ConstIterator BodyStorage::remove( ConstIterator pos )
@@ -568,7 +568,7 @@ inline BodyStorage::ConstIterator BodyStorage::remove( ConstIterator pos )
  *
  * This function removes a body from the body storage. \a pos must be a valid iterator and the
  * rigid body pointer referred to must be valid. Invalidates all iterators pointing at or past
- * the element to be removed. The time complexity is logarithmic unless reallocation occurs.
+ * the element to be removed. The expected time complexity is constant unless reallocation occurs.
  */
 
 inline BodyStorage::Iterator BodyStorage::remove( Iterator pos )
@@ -587,7 +587,7 @@ inline BodyStorage::Iterator BodyStorage::remove( Iterator pos )
  *
  * This function removes a body from the body storage. \a body must be a valid rigid body poitner
  * and must be registered in the body storage. Invalidates all iterators pointing at or past
- * the element to be removed. The time complexity is logarithmic unless reallocation occurs.
+ * the element to be removed. The expected time complexity is constant unless reallocation occurs.
  */
 
 inline void BodyStorage::remove( BodyID body )
@@ -605,26 +605,24 @@ inline void BodyStorage::remove( BodyID body )
  * This function releases a body from the body storage. The released rigid body is not destroyed.
  * \a sid must be a valid rigid body system id
  * and must be registered in the body storage. Invalidates all iterators pointing at or past
- * the element to be released. The time complexity is logarithmic unless reallocation occurs.
+ * the element to be released. The expected time complexity is constant unless reallocation occurs.
  * Last element is swapped to the actual position and length is reduced by 1.
  */
 
 inline void BodyStorage::release( const id_t sid )
 {
-   std::map<id_t, SizeType>::iterator it = bodyIDs_.find( sid );
-   WALBERLA_ASSERT( it != bodyIDs_.end(), "The body's system ID was not registered." );
-
-   // Move last element to deleted place and update the system ID to index mapping.
-   SizeType i = it->second;
+   const SizeType i = bodyIDs_.find( sid );
+   WALBERLA_ASSERT( i != SystemIDIndex<SizeType>::npos, "The body's system ID was not registered." );
 
    for (auto cb = removeCallbacks_.begin(); cb != removeCallbacks_.end(); ++cb)
    {
       cb->second( bodies_[i] );
    }
 
-   bodyIDs_[ bodies_.back()->getSystemID() ] = i;
+   // Move last element to deleted place and update the system ID to index mapping.
+   bodyIDs_.update( bodies_.back()->getSystemID(), i );
    std::swap( bodies_[i], bodies_.back() );
-   bodyIDs_.erase( it );
+   bodyIDs_.erase( sid );
    bodies_.releaseBack();
 }
 //*************************************************************************************************
@@ -638,7 +636,7 @@ inline void BodyStorage::release( const id_t sid )
  * This function releases a body from the body storage. The released rigid body is not destroyed.
  * \a body must be a valid rigid body pointer
  * and must be registered in the body storage. Invalidates all iterators pointing at or past
- * the element to be released. The time complexity is logarithmic unless reallocation occurs.
+ * the element to be released. The expected time complexity is constant unless reallocation occurs.
  */
 
 inline BodyStorage::ConstIterator BodyStorage::release( ConstIterator pos )
@@ -658,7 +656,7 @@ inline BodyStorage::ConstIterator BodyStorage::release( ConstIterator pos )
  * This function releases a body from the body storage. The released rigid body is not destroyed.
  * \a body must be a valid rigid body pointer
  * and must be registered in the body storage. Invalidates all iterators pointing at or past
- * the element to be released. The time complexity is logarithmic unless reallocation occurs.
+ * the element to be released. The expected time complexity is constant unless reallocation occurs.
  */
 
 inline BodyStorage::Iterator BodyStorage::release( Iterator pos )
@@ -678,7 +676,7 @@ inline BodyStorage::Iterator BodyStorage::release( Iterator pos )
  * This function releases a body from the body storage. The released rigid body is not destroyed.
  * \a body must be a valid rigid body pointer
  * and must be registered in the body storage. Invalidates all iterators pointing at or past
- * the element to be released. The time complexity is logarithmic unless reallocation occurs.
+ * the element to be released. The expected time complexity is constant unless reallocation occurs.
  */
 
 inline void BodyStorage::release( BodyID body )
@@ -765,16 +763,11 @@ inline void          BodyStorage::clearRemoveCallbacks       ( )
 
 inline void BodyStorage::validate()
 {
-   std::vector<bool> tmp(bodies_.size());
-   std::map<id_t, SizeType>::iterator it = bodyIDs_.begin();
-   while( it != bodyIDs_.end() ) {
-      WALBERLA_ASSERT(tmp[it->second] == false, "Two system IDs point to the same storage index.");
-      tmp[it->second] = true;
-      WALBERLA_ASSERT(bodies_[it->second]->getSystemID() == it->first, "The mapping of system ID to storage index is wrong since the system ID does not match with the stored body.");
-      ++it;
+   for( SizeType i = 0; i < bodies_.size(); ++i ) {
+      WALBERLA_ASSERT(bodyIDs_.find( bodies_[i]->getSystemID() ) == i, "The mapping of system ID to storage index is wrong since the system ID does not match with the stored body.");
    }
 
-   WALBERLA_ASSERT( bodyIDs_.size() == bodies_.size(), "The mapping is missing some system IDs." );
+   WALBERLA_ASSERT( bodyIDs_.size() == bodies_.size(), "The mapping contains system IDs of bodies that are not stored." );
 }
 //*************************************************************************************************
 
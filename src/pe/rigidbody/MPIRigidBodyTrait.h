@@ -20,7 +20,12 @@
 
 #pragma once
 
+#include "pe/Types.h"
+
 #include "blockforest/BlockID.h"
+#include "core/debug/Debug.h"
+#include "core/math/Quaternion.h"
+#include "core/math/Vector3.h"
 
 #include "Owner.h"
 
@@ -56,6 +61,12 @@ public:
    typedef ShadowOwners::iterator        ShadowOwnersIterator;       //!< Iterator over the connected processes.
    typedef ShadowOwners::const_iterator  ConstShadowOwnersIterator;  //!< ConstIterator over the connected processes.
    typedef size_t                        SizeType;
+
+   //! State of the rigid body that was last sent to the shadow owners (see CompactShadowUpdates).
+   struct SyncState {
+      Vec3 gpos_, v_, w_;
+      Quat q_;
+   };
    //**********************************************************************************************
 
    //**Constructor*********************************************************************************
@@ -109,6 +120,16 @@ public:
    //@}
    //**********************************************************************************************
 
+   //** functions to store the last synchronized state ********************************************
+   /*!\name last synchronized state functions */
+   //@{
+   inline void                 setSyncState  ( const SyncState& state );
+   inline const SyncState&     getSyncState  () const;
+   inline bool                 hasSyncState  () const;
+   inline void                 resetSyncState();
+   //@}
+   //**********************************************************************************************
+
 private:
    //**Member variables****************************************************************************
    /*!\name Member variables */
@@ -116,6 +137,8 @@ private:
    ShadowOwners shadowOwners_;    //!< Vector of all processes the rigid body intersects with.
    BlockStates  blockStates_;
    Owner        owner_;    //!< Rank of the process owning the rigid body.
+   SyncState    syncState_;     //!< State last sent to the shadow owners.
+   bool         hasSyncState_;  //!< Whether syncState_ is valid for all shadow owners.
    //@}
    //**********************************************************************************************
 };
@@ -128,7 +151,7 @@ private:
  * \param body The body ID of this rigid body.
  */
 inline MPIRigidBodyTrait::MPIRigidBodyTrait( )
-   : owner_( )
+   : owner_( ), hasSyncState_( false )
 {}
 //*************************************************************************************************
 
@@ -140,12 +163,16 @@ inline MPIRigidBodyTrait::MPIRigidBodyTrait( )
  * \return void
  *
  * This function registers the given remote process with the rigid body. In case the process is
- * already registered, it is not registered again. This call has linear complexity.
+ * already registered, it is not registered again. This call has linear complexity. Registering
+ * a new process resets the last synchronized state.
  */
 inline void MPIRigidBodyTrait::registerShadowOwner( const Owner& owner )
 {
    if( !isShadowOwnerRegistered( owner ) )
+   {
       shadowOwners_.push_back( owner );
+      resetSyncState();
+   }
 }
 //*************************************************************************************************
 
@@ -307,6 +334,7 @@ inline const Owner& MPIRigidBodyTrait::getOwner() const
 inline void MPIRigidBodyTrait::setOwner(const Owner& owner)
 {
    owner_ = owner;
+   resetSyncState();
 }
 //*************************************************************************************************
 
@@ -334,5 +362,34 @@ inline size_t MPIRigidBodyTrait::getBlockStateSize() const
    return blockStates_.size();
 }
 
+//*************************************************************************************************
+/*!\brief Stores the state that was sent to all shadow owners.
+ *
+ * \param state The sent state.
+ * \return void
+ */
+inline void MPIRigidBodyTrait::setSyncState( const SyncState& state )
+{
+   syncState_    = state;
+   hasSyncState_ = true;
+}
+//*************************************************************************************************
+
+inline const MPIRigidBodyTrait::SyncState& MPIRigidBodyTrait::getSyncState() const
+{
+   WALBERLA_ASSERT( hasSyncState_ );
+   return syncState_;
+}
+
+inline bool MPIRigidBodyTrait::hasSyncState() const
+{
+   return hasSyncState_;
+}
+
+inline void MPIRigidBodyTrait::resetSyncState()
+{
+   hasSyncState_ = false;
+}
+
 }  // namespace pe
 }  // namespace walberla
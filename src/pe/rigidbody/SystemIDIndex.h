@@ -0,0 +1,298 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SystemIDIndex.h
+//! \brief Hash index from system IDs to storage indices
+//
+//======================================================================================================================
+
+#pragma once
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <core/DataTypes.h>
+#include <core/debug/Debug.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace walberla {
+namespace pe {
+
+
+
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Association of the system IDs of rigid bodies to their index in a body storage.
+ *
+ * The index is an open addressing hash table with linear probing. Erased entries are not marked
+ * as deleted but the following entries of the probe sequence are shifted back, therefore lookups
+ * never have to skip tombstones, even after many insertions and removals. The load factor is kept
+ * at or below 1/2. Lookup, insertion, update and removal take constant expected time.
+ */
+template< typename SizeType >
+class SystemIDIndex
+{
+public:
+   //**Constants***********************************************************************************
+   static const SizeType npos;  //!< Returned by find() if the system ID is not contained.
+   //**********************************************************************************************
+
+   //**Constructors********************************************************************************
+   /*!\name Constructors */
+   //@{
+   SystemIDIndex() : size_( 0 ), mask_( 0 ) {}
+   //@}
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   inline size_t   size    () const { return size_; }
+   inline size_t   capacity() const { return slots_.size(); }
+   inline SizeType find    ( const id_t sid ) const;
+   //@}
+   //**********************************************************************************************
+
+   //**Modification functions**********************************************************************
+   /*!\name Modification functions */
+   //@{
+   inline void insert( const id_t sid, const SizeType index );
+   inline void update( const id_t sid, const SizeType index );
+   inline void erase ( const id_t sid );
+   inline void clear ();
+   //@}
+   //**********************************************************************************************
+
+private:
+   //**Type definitions****************************************************************************
+   struct Slot
+   {
+      Slot() : sid( 0 ), index( npos ) {}
+      id_t     sid;
+      SizeType index;  //!< npos marks an empty slot.
+   };
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   inline size_t home  ( const id_t sid ) const;
+   inline size_t lookup( const id_t sid ) const;
+   inline void   rehash( const size_t capacity );
+   //@}
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   /*!\name Member variables */
+   //@{
+   std::vector<Slot> slots_;  //!< The hash table, the number of slots is zero or a power of two.
+   size_t            size_;   //!< The number of occupied slots.
+   size_t            mask_;   //!< The number of slots minus one.
+   //@}
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+template< typename SizeType >
+const SizeType SystemIDIndex<SizeType>::npos = std::numeric_limits<SizeType>::max();
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the storage index of the body with the given system ID.
+ *
+ * \param sid The system ID.
+ * \return The storage index or npos if the system ID is not contained.
+ */
+template< typename SizeType >
+inline SizeType SystemIDIndex<SizeType>::find( const id_t sid ) const
+{
+   if( size_ == 0 )
+      return npos;
+   return slots_[ lookup( sid ) ].index;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the first slot of the probe sequence of the given system ID.
+ *
+ * The system IDs of a process differ in the low bits only (see UniqueID), therefore the bits are
+ * mixed (finalizer of the SplitMix64 generator) before the slot is selected.
+ */
+template< typename SizeType >
+inline size_t SystemIDIndex<SizeType>::home( const id_t sid ) const
+{
+   uint64_t h = static_cast<uint64_t>( sid );
+   h = ( h ^ ( h >> 30 ) ) * uint64_t( 0xbf58476d1ce4e5b9ULL );
+   h = ( h ^ ( h >> 27 ) ) * uint64_t( 0x94d049bb133111ebULL );
+   h =   h ^ ( h >> 31 );
+   return static_cast<size_t>( h ) & mask_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the slot that contains the given system ID or the empty slot that ends its probe sequence.
+ */
+template< typename SizeType >
+inline size_t SystemIDIndex<SizeType>::lookup( const id_t sid ) const
+{
+   WALBERLA_ASSERT( !slots_.empty() );
+
+   size_t i = home( sid );
+   while( slots_[i].index != npos && slots_[i].sid != sid )
+      i = ( i + 1 ) & mask_;
+   return i;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Reinserts all entries into a table with the given number of slots (a power of two).
+ */
+template< typename SizeType >
+inline void SystemIDIndex<SizeType>::rehash( const size_t capacity )
+{
+   std::vector<Slot> old( capacity );
+   old.swap( slots_ );
+   mask_ = capacity - 1;
+
+   for( auto slot = old.begin(); slot != old.end(); ++slot )
+   {
+      if( slot->index != npos )
+         slots_[ lookup( slot->sid ) ] = *slot;
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  MODIFICATION FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Adds a system ID that is not contained yet.
+ *
+ * \param sid The system ID.
+ * \param index The storage index, must not be npos.
+ * \return void
+ */
+template< typename SizeType >
+inline void SystemIDIndex<SizeType>::insert( const id_t sid, const SizeType index )
+{
+   WALBERLA_ASSERT_UNEQUAL( index, npos );
+
+   if( 2 * ( size_ + 1 ) > slots_.size() )
+      rehash( slots_.empty() ? size_t(16) : 2 * slots_.size() );
+
+   Slot& slot = slots_[ lookup( sid ) ];
+   WALBERLA_ASSERT_EQUAL( slot.index, npos, "System ID " << sid << " is already contained." );
+   slot.sid   = sid;
+   slot.index = index;
+   ++size_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Changes the storage index of a contained system ID.
+ *
+ * \param sid The system ID.
+ * \param index The new storage index, must not be npos.
+ * \return void
+ */
+template< typename SizeType >
+inline void SystemIDIndex<SizeType>::update( const id_t sid, const SizeType index )
+{
+   WALBERLA_ASSERT_UNEQUAL( index, npos );
+
+   Slot& slot = slots_[ lookup( sid ) ];
+   WALBERLA_ASSERT_UNEQUAL( slot.index, npos, "System ID " << sid << " is not contained." );
+   slot.index = index;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Removes a contained system ID.
+ *
+ * \param sid The system ID.
+ * \return void
+ *
+ * The following entries of the probe sequence are shifted back into the gap (backward shift
+ * deletion), so no tombstones are left behind.
+ */
+template< typename SizeType >
+inline void SystemIDIndex<SizeType>::erase( const id_t sid )
+{
+   size_t gap = lookup( sid );
+   WALBERLA_ASSERT_UNEQUAL( slots_[gap].index, npos, "System ID " << sid << " is not contained." );
+
+   for( size_t i = ( gap + 1 ) & mask_; slots_[i].index != npos; i = ( i + 1 ) & mask_ )
+   {
+      // the entry may be moved into the gap if its home slot is not in the cyclic range (gap, i]
+      const size_t h = home( slots_[i].sid );
+      if( ( ( i - h ) & mask_ ) >= ( ( i - gap ) & mask_ ) )
+      {
+         slots_[gap] = slots_[i];
+         gap = i;
+      }
+   }
+
+   slots_[gap] = Slot();
+   --size_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Removes all system IDs (the number of slots is kept).
+ *
+ * \return void
+ */
+template< typename SizeType >
+inline void SystemIDIndex<SizeType>::clear()
+{
+   std::fill( slots_.begin(), slots_.end(), Slot() );
+   size_ = 0;
+}
+//*************************************************************************************************
+
+}  // namespace pe
+}  // namespace walberla
@@ -0,0 +1,117 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file CompactShadowUpdates.h
+//! \brief Settings and statistics of the compact shadow copy updates
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "pe/rigidbody/RigidBody.h"
+
+#include "core/DataTypes.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace walberla {
+namespace pe {
+
+///
+/// \brief Settings and statistics of the compact shadow copy updates (see syncNextNeighborsCompact() and
+///        syncShadowOwnersCompact()).
+///
+/// Instead of a RigidBodyUpdateNotification, the owner of a body sends a RigidBodyCompactUpdateNotification with
+/// the orientation and the velocities quantized to single precision. The updates of a body are skipped entirely
+/// as long as its state deviates from the last sent state by at most the given tolerances (e.g. for resting bodies).
+///
+/// The last sent state is stored in the MPIRigidBodyTrait of the body and reset whenever a shadow owner is
+/// registered or the owner of the body changes, which forces an update in the next synchronization. Thus, the state
+/// of all shadow copies deviates from the state of the owner by at most the tolerances (plus the quantization
+/// error), as long as the shadow copies are not modified locally between two synchronizations.
+///
+class CompactShadowUpdates
+{
+public:
+   /// all tolerances are compared to the maximum norm of the deviation, zero tolerances only skip unchanged bodies
+   CompactShadowUpdates( real_t positionTolerance, real_t orientationTolerance, real_t velocityTolerance )
+      : positionTolerance_( positionTolerance ), orientationTolerance_( orientationTolerance ),
+        velocityTolerance_( velocityTolerance ), numberOfUpdates_( 0 ), numberOfSkippedUpdates_( 0 ) {}
+
+   real_t getPositionTolerance()    const { return positionTolerance_; }
+   real_t getOrientationTolerance() const { return orientationTolerance_; }
+   real_t getVelocityTolerance()    const { return velocityTolerance_; }
+
+   /// whether the updates of the body can be skipped
+   inline bool isSkippable( const RigidBody& b ) const;
+   /// stores the current state of the body as the last sent state
+   inline void setSent( RigidBody& b ) const;
+
+   /// counts the sent / skipped update notifications (one per shadow owner)
+   void countUpdate( bool skipped ) { if( skipped ) ++numberOfSkippedUpdates_; else ++numberOfUpdates_; }
+
+   uint_t getNumberOfUpdates()        const { return numberOfUpdates_; }
+   uint_t getNumberOfSkippedUpdates() const { return numberOfSkippedUpdates_; }
+   void   resetStatistics() { numberOfUpdates_ = 0; numberOfSkippedUpdates_ = 0; }
+
+private:
+   static real_t maxDeviation( const Vec3& a, const Vec3& b )
+   {
+      return std::max( std::fabs( a[0] - b[0] ), std::max( std::fabs( a[1] - b[1] ), std::fabs( a[2] - b[2] ) ) );
+   }
+
+   real_t positionTolerance_;
+   real_t orientationTolerance_;
+   real_t velocityTolerance_;
+
+   uint_t numberOfUpdates_;
+   uint_t numberOfSkippedUpdates_;
+};
+
+
+
+inline bool CompactShadowUpdates::isSkippable( const RigidBody& b ) const
+{
+   if( !b.MPITrait.hasSyncState() )
+      return false;
+
+   const MPIRigidBodyTrait::SyncState& sent = b.MPITrait.getSyncState();
+
+   const Quat& q = b.getQuaternion();
+   real_t orientationDeviation( 0 );
+   for( uint_t i = 0; i < 4; ++i )
+      orientationDeviation = std::max( orientationDeviation, std::fabs( q[i] - sent.q_[i] ) );
+
+   return maxDeviation( b.getPosition(), sent.gpos_ ) <= positionTolerance_ &&
+          orientationDeviation <= orientationTolerance_ &&
+          maxDeviation( b.getLinearVel(),  sent.v_ ) <= velocityTolerance_ &&
+          maxDeviation( b.getAngularVel(), sent.w_ ) <= velocityTolerance_;
+}
+
+
+
+inline void CompactShadowUpdates::setSent( RigidBody& b ) const
+{
+   MPIRigidBodyTrait::SyncState state;
+   state.gpos_ = b.getPosition();
+   state.q_    = b.getQuaternion();
+   state.v_    = b.getLinearVel();
+   state.w_    = b.getAngularVel();
+   b.MPITrait.setSyncState( state );
+}
+
+}  // namespace pe
+}  // namespace walberla
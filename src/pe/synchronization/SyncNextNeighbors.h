@@ -25,6 +25,7 @@
 
 #include "pe/communication/ParseMessage.h"
 #include "pe/communication/DynamicMarshalling.h"
+#include "pe/communication/RigidBodyCompactUpdateNotification.h"
 #include "pe/communication/RigidBodyCopyNotification.h"
 #include "pe/communication/RigidBodyDeletionNotification.h"
 #include "pe/communication/RigidBodyForceNotification.h"
@@ -36,6 +37,7 @@
 #include "pe/communication/RigidBodyVelocityUpdateNotification.h"
 #include "pe/communication/PackNotification.h"
 
+#include "CompactShadowUpdates.h"
 #include "RemoveAndNotify.h"
 
 #include "blockforest/BlockForest.h"
@@ -46,7 +48,7 @@ namespace walberla {
 namespace pe {
 
 template <typename BodyTypeTuple>
-void generateSynchonizationMessages(mpi::BufferSystem& bs, const Block& block, BodyStorage& localStorage, BodyStorage& shadowStorage, const real_t dx, const bool syncNonCommunicatingBodies)
+void generateSynchonizationMessages(mpi::BufferSystem& bs, const Block& block, BodyStorage& localStorage, BodyStorage& shadowStorage, const real_t dx, const bool syncNonCommunicatingBodies, CompactShadowUpdates* compact = NULL)
 {
    using namespace walberla::pe::communication;
 
@@ -95,6 +97,9 @@ void generateSynchonizationMessages(mpi::BufferSystem& bs, const Block& block, B
 
       WALBERLA_LOG_DETAIL( "Processing local body " << b->getSystemID() );
 
+      // Compact updates: bodies that stay locally owned are skipped if their state did not change significantly.
+      const bool skipUpdate = compact != NULL && block.getAABB().contains( gpos ) && compact->isSkippable( *b );
+
       // Update (nearest) neighbor processes.
       for( uint_t nb = uint_t(0); nb < block.getNeighborhoodSize(); ++nb )
       {
@@ -106,9 +111,21 @@ void generateSynchonizationMessages(mpi::BufferSystem& bs, const Block& block, B
             if( body->MPITrait.isShadowOwnerRegistered( nbProcess ) ) {
                mpi::SendBuffer& buffer( bs.sendBuffer(nbProcess.rank_) );
 
-               WALBERLA_LOG_DETAIL( "Sending update notification for body " << b->getSystemID() << " to process " << (nbProcess) );
+               if( compact != NULL )
+               {
+                  compact->countUpdate( skipUpdate );
+                  if( !skipUpdate )
+                  {
+                     WALBERLA_LOG_DETAIL( "Sending compact update notification for body " << b->getSystemID() << " to process " << (nbProcess) );
+
+                     packNotification(me, nbProcess, buffer, RigidBodyCompactUpdateNotification( *b ));
+                  }
+               } else
+               {
+                  WALBERLA_LOG_DETAIL( "Sending update notification for body " << b->getSystemID() << " to process " << (nbProcess) );
 
-               packNotification(me, nbProcess, buffer, RigidBodyUpdateNotification( *b ));
+                  packNotification(me, nbProcess, buffer, RigidBodyUpdateNotification( *b ));
+               }
             }
             else {
                mpi::SendBuffer& buffer( bs.sendBuffer(nbProcess.rank_) );
@@ -138,6 +155,10 @@ void generateSynchonizationMessages(mpi::BufferSystem& bs, const Block& block, B
          }
       }
 
+      // All shadow owners received the current state (or a new shadow owner reset the last sent state).
+      if( compact != NULL && !skipUpdate )
+         compact->setSent( *b );
+
       // Update remote processes (no intersections possible; (long-range) interactions only).
       // TODO iterate over all processes attached bodies are owned by (skipping nearest neighbors)
       // depending on registration send update or copy
@@ -235,8 +256,10 @@ void generateSynchonizationMessages(mpi::BufferSystem& bs, const Block& block, B
    WALBERLA_LOG_DETAIL( "Assembling of body synchronization message ended." );
 }
 
+namespace internal {
+
 template <typename BodyTypeTuple>
-void syncNextNeighbors( BlockForest& forest, BlockDataID storageID, WcTimingTree* tt = NULL, const real_t dx = real_t(0), const bool syncNonCommunicatingBodies = false )
+void syncNextNeighbors( BlockForest& forest, BlockDataID storageID, WcTimingTree* tt, const real_t dx, const bool syncNonCommunicatingBodies, CompactShadowUpdates* compact )
 {
    if (tt != NULL) tt->start("Sync");
    if (tt != NULL) tt->start("Assembling Body Synchronization");
@@ -258,7 +281,7 @@ void syncNextNeighbors( BlockForest& forest, BlockDataID storageID, WcTimingTree
             bs.sendBuffer(neighborRank) << walberla::uint8_c(0);
          }
       }
-      generateSynchonizationMessages<BodyTypeTuple>(bs, *block, *localStorage, *shadowStorage, dx, syncNonCommunicatingBodies);
+      generateSynchonizationMessages<BodyTypeTuple>(bs, *block, *localStorage, *shadowStorage, dx, syncNonCommunicatingBodies, compact);
    }
    if (tt != NULL) tt->stop("Assembling Body Synchronization");
 
@@ -293,5 +316,21 @@ void syncNextNeighbors( BlockForest& forest, BlockDataID storageID, WcTimingTree
    if (tt != NULL) tt->stop("Sync");
 }
 
+} // namespace internal
+
+template <typename BodyTypeTuple>
+void syncNextNeighbors( BlockForest& forest, BlockDataID storageID, WcTimingTree* tt = NULL, const real_t dx = real_t(0), const bool syncNonCommunicatingBodies = false )
+{
+   internal::syncNextNeighbors<BodyTypeTuple>( forest, storageID, tt, dx, syncNonCommunicatingBodies, NULL );
+}
+
+/// Same as syncNextNeighbors(), but the shadow copies are updated with compact update notifications and updates of
+/// bodies whose state did not change beyond the tolerances of \a compact are skipped (see CompactShadowUpdates).
+template <typename BodyTypeTuple>
+void syncNextNeighborsCompact( BlockForest& forest, BlockDataID storageID, CompactShadowUpdates& compact, WcTimingTree* tt = NULL, const real_t dx = real_t(0), const bool syncNonCommunicatingBodies = false )
+{
+   internal::syncNextNeighbors<BodyTypeTuple>( forest, storageID, tt, dx, syncNonCommunicatingBodies, &compact );
+}
+
 }  // namespace pe
 }  // namespace walberla
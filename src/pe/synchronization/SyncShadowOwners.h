@@ -29,6 +29,7 @@
 
 #include "pe/communication/ParseMessage.h"
 #include "pe/communication/DynamicMarshalling.h"
+#include "pe/communication/RigidBodyCompactUpdateNotification.h"
 #include "pe/communication/RigidBodyCopyNotification.h"
 #include "pe/communication/RigidBodyDeletionNotification.h"
 #include "pe/communication/RigidBodyForceNotification.h"
@@ -40,6 +41,7 @@
 #include "pe/communication/RigidBodyVelocityUpdateNotification.h"
 #include "pe/communication/PackNotification.h"
 
+#include "CompactShadowUpdates.h"
 #include "RemoveAndNotify.h"
 
 #include "core/timing/TimingTree.h"
@@ -48,7 +50,7 @@ namespace walberla {
 namespace pe {
 
 template <typename BodyTypeTuple>
-void updateAndMigrate( BlockForest& forest, BlockDataID storageID, const bool syncNonCommunicatingBodies )
+void updateAndMigrate( BlockForest& forest, BlockDataID storageID, const bool syncNonCommunicatingBodies, CompactShadowUpdates* compact = NULL )
 {
    using namespace walberla::pe::communication;
    //==========================================================
@@ -102,13 +104,25 @@ void updateAndMigrate( BlockForest& forest, BlockDataID storageID, const bool sy
          }
 
          // Update
+         // Compact updates: bodies that stay locally owned are skipped if their state did not change significantly.
+         const bool skipUpdate = compact != NULL && blkAABB.contains( b->getPosition() ) && compact->isSkippable( *b );
          for (auto it = b->MPITrait.beginShadowOwners(); it != b->MPITrait.endShadowOwners(); ++it)
          {
-            WALBERLA_LOG_DETAIL( "Sending update notification for body " << b->getSystemID() << " to process " << (*it) );
             mpi::SendBuffer& sb = bs.sendBuffer(it->rank_);
             if (sb.isEmpty()) sb << walberla::uint8_c(0);
-            packNotification(me, *it, sb, RigidBodyUpdateNotification( *b ));
+            if (compact != NULL)
+            {
+               compact->countUpdate( skipUpdate );
+               if (skipUpdate) continue;
+               WALBERLA_LOG_DETAIL( "Sending compact update notification for body " << b->getSystemID() << " to process " << (*it) );
+               packNotification(me, *it, sb, RigidBodyCompactUpdateNotification( *b ));
+            } else
+            {
+               WALBERLA_LOG_DETAIL( "Sending update notification for body " << b->getSystemID() << " to process " << (*it) );
+               packNotification(me, *it, sb, RigidBodyUpdateNotification( *b ));
+            }
          }
+         if (compact != NULL && !skipUpdate) compact->setSent( *b );
          if (!blkAABB.contains( b->getPosition() ))
          {
             Owner owner( findContainingProcess( block, b->getPosition() ) );
@@ -356,8 +370,10 @@ void checkAndResolveOverlap( BlockForest& forest, BlockDataID storageID, const r
    WALBERLA_LOG_DETAIL( "Parsing of Check&Resolve ended." );
 }
 
+namespace internal {
+
 template <typename BodyTypeTuple>
-void syncShadowOwners( BlockForest& forest, BlockDataID storageID, WcTimingTree* tt = NULL, const real_t dx = real_t(0), const bool syncNonCommunicatingBodies = false )
+void syncShadowOwners( BlockForest& forest, BlockDataID storageID, WcTimingTree* tt, const real_t dx, const bool syncNonCommunicatingBodies, CompactShadowUpdates* compact )
 {
    if (tt != NULL) tt->start("Sync");
 
@@ -365,7 +381,7 @@ void syncShadowOwners( BlockForest& forest, BlockDataID storageID, WcTimingTree*
    // STEP1: Update & Migrate
    //==========================================================
    if (tt != NULL) tt->start("Update&Migrate");
-   updateAndMigrate<BodyTypeTuple>( forest, storageID, syncNonCommunicatingBodies);
+   updateAndMigrate<BodyTypeTuple>( forest, storageID, syncNonCommunicatingBodies, compact );
    if (tt != NULL) tt->stop("Update&Migrate");
 
    //==========================================================
@@ -378,5 +394,21 @@ void syncShadowOwners( BlockForest& forest, BlockDataID storageID, WcTimingTree*
    if (tt != NULL) tt->stop("Sync");
 }
 
+} // namespace internal
+
+template <typename BodyTypeTuple>
+void syncShadowOwners( BlockForest& forest, BlockDataID storageID, WcTimingTree* tt = NULL, const real_t dx = real_t(0), const bool syncNonCommunicatingBodies = false )
+{
+   internal::syncShadowOwners<BodyTypeTuple>( forest, storageID, tt, dx, syncNonCommunicatingBodies, NULL );
+}
+
+/// Same as syncShadowOwners(), but the shadow copies are updated with compact update notifications and updates of
+/// bodies whose state did not change beyond the tolerances of \a compact are skipped (see CompactShadowUpdates).
+template <typename BodyTypeTuple>
+void syncShadowOwnersCompact( BlockForest& forest, BlockDataID storageID, CompactShadowUpdates& compact, WcTimingTree* tt = NULL, const real_t dx = real_t(0), const bool syncNonCommunicatingBodies = false )
+{
+   internal::syncShadowOwners<BodyTypeTuple>( forest, storageID, tt, dx, syncNonCommunicatingBodies, &compact );
+}
+
 }
 }
@@ -32,6 +32,8 @@
 #include "pe/rigidbody/Sphere.h"
 #include "pe/utility/Distance.h"
 
+#include "pe_coupling/utility/SpherePairSearch.h"
+
 namespace walberla {
 namespace pe_coupling {
 namespace discrete_particle_methods {
@@ -62,6 +64,7 @@ public:
       , dynamicViscosity_( dynamicViscosity )
       , cutOffDistance_( cutOffDistance )
       , minimalGapSize_( minimalGapSize )
+      , pairSearch_( cutOffDistance )
    { }
 
    void operator()();
@@ -85,6 +88,8 @@ private:
    real_t cutOffDistance_;
    real_t minimalGapSize_;
 
+   SpherePairSearch pairSearch_;
+
 }; // class LubricationForceEvaluator
 
 
@@ -94,26 +99,12 @@ void LubricationForceEvaluator::operator ()()
 
    for (auto blockIt = blockStorage_->begin(); blockIt != blockStorage_->end(); ++blockIt)
    {
-      // loop over all rigid bodies
-      for( auto body1It = pe::BodyIterator::begin( *blockIt, bodyStorageID_ ); body1It != pe::BodyIterator::end(); ++body1It )
+      // sphere-sphere lubrication for all pairs of the block (local bodies and shadow copies) within the cut off distance,
+      // in the same order as a nested loop over all bodies to avoid double forces
+      pairSearch_.update( *blockIt, bodyStorageID_ );
+      for( auto pairIt = pairSearch_.begin(); pairIt != pairSearch_.end(); ++pairIt )
       {
-         // lubrication forces for spheres
-         if ( body1It->getTypeID() == pe::Sphere::getStaticTypeID() )
-         {
-            pe::SphereID sphereI = static_cast<pe::SphereID> ( *body1It );
-
-            auto copyBody1It = body1It;
-            // loop over all rigid bodies after current body1 to avoid double forces
-            for( auto body2It = (++copyBody1It); body2It != pe::BodyIterator::end(); ++body2It )
-            {
-               // sphere-sphere lubrication
-               if ( body2It->getTypeID() == pe::Sphere::getStaticTypeID() )
-               {
-                  pe::SphereID sphereJ = static_cast<pe::SphereID>( *body2It );
-                  treatLubricationSphrSphr( sphereI, sphereJ, blockIt->getAABB() );
-               }
-            }
-         }
+         treatLubricationSphrSphr( pairIt->first, pairIt->second, blockIt->getAABB() );
       }
 
       // lubrication correction for local bodies with global bodies (for example sphere-plane)
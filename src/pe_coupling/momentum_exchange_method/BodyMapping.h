@@ -33,9 +33,12 @@
 #include "pe/rigidbody/BodyIterators.h"
 
 #include "pe_coupling/mapping/BodyBBMapping.h"
+#include "pe_coupling/momentum_exchange_method/BodyMappingCache.h"
 #include "pe_coupling/utility/BodySelectorFunctions.h"
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 namespace walberla {
 namespace pe_coupling {
@@ -54,6 +57,10 @@ namespace pe_coupling {
  * It is not required that the mapping has been initialized with one of the free functions from below.
  *
  * The 'mappingBodySelectorFct' can be used to decide which bodies should be mapped or not.
+ *
+ * With a BodyMappingCache (see setBodyMappingCache), the mapping is incremental: only the shell of cells close to the body
+ * surface is visited and the inside/outside test is only carried out for cells that could have changed their state since
+ * the cached reference state. The resulting flags and body field entries are identical to the ones of the complete mapping.
  */
 template< typename BoundaryHandling_T >
 class BodyMapping
@@ -76,6 +83,9 @@ public:
      obstacle_( obstacle ), formerObstacle_( formerObstacle ), mappingBodySelectorFct_( mappingBodySelectorFct )
    {}
 
+   /// Enables the incremental mapping with the given cache, which can also be shared with the PDFReconstruction.
+   void setBodyMappingCache( const shared_ptr<BodyMappingCache> & cache ) { cache_ = cache; }
+
    void operator()( IBlock * const block )
    {
       WALBERLA_ASSERT_NOT_NULLPTR( block );
@@ -100,16 +110,43 @@ public:
       const real_t dy = blockStorage_->dy( blockStorage_->getLevel(*block) );
       const real_t dz = blockStorage_->dz( blockStorage_->getLevel(*block) );
 
+      std::vector< Cell > * formerObstacleCells = NULL;
+      if( cache_ )
+      {
+         cache_->beginMapping( *blockStorage_, *block, dx, dy, dz );
+
+         // the cache has to know the cell bounding boxes of all bodies to detect bodies that overlap
+         for( auto bodyIt = pe::BodyIterator::begin(*block, bodyStorageID_); bodyIt != pe::BodyIterator::end(); ++bodyIt )
+         {
+            if( mappingBodySelectorFct_(*bodyIt) )
+               cache_->addBody( *block, *bodyIt, getCellBB( *bodyIt, *block, *blockStorage_, flagField->nrOfGhostLayers() ) );
+         }
+         for( auto bodyIt = globalBodyStorage_->begin(); bodyIt != globalBodyStorage_->end(); ++bodyIt)
+         {
+            if( mappingBodySelectorFct_(*bodyIt))
+               cache_->addBody( *block, *bodyIt, getCellBB( *bodyIt, *block, *blockStorage_, flagField->nrOfGhostLayers() ) );
+         }
+
+         // keep only the cells that have not been reconstructed yet
+         formerObstacleCells = &( cache_->getFormerObstacleCells( *block ) );
+         formerObstacleCells->erase( std::remove_if( formerObstacleCells->begin(), formerObstacleCells->end(),
+                                                     [&]( const Cell & cell ){ return !isFlagSet( flagField->get( cell ), formerObstacle ); } ),
+                                     formerObstacleCells->end() );
+      }
+
       for( auto bodyIt = pe::BodyIterator::begin(*block, bodyStorageID_); bodyIt != pe::BodyIterator::end(); ++bodyIt )
       {
          if( mappingBodySelectorFct_(*bodyIt) )
-            mapBodyAndUpdateMapping(*bodyIt, block, boundaryHandling, flagField , bodyField, obstacle, formerObstacle, dx, dy, dz);
+            mapBodyAndUpdateMapping(*bodyIt, block, boundaryHandling, flagField , bodyField, obstacle, formerObstacle, dx, dy, dz, formerObstacleCells);
       }
       for( auto bodyIt = globalBodyStorage_->begin(); bodyIt != globalBodyStorage_->end(); ++bodyIt)
       {
          if( mappingBodySelectorFct_(*bodyIt))
-            mapBodyAndUpdateMapping(*bodyIt, block, boundaryHandling, flagField , bodyField, obstacle, formerObstacle, dx, dy, dz);
+            mapBodyAndUpdateMapping(*bodyIt, block, boundaryHandling, flagField , bodyField, obstacle, formerObstacle, dx, dy, dz, formerObstacleCells);
       }
+
+      if( cache_ )
+         cache_->endMapping( *block );
    }
 
 private:
@@ -117,7 +154,7 @@ private:
    void mapBodyAndUpdateMapping(pe::BodyID body, IBlock * const block,
                                 BoundaryHandling_T * boundaryHandling, FlagField_T * flagField, BodyField_T * bodyField,
                                 const flag_t & obstacle, const flag_t & formerObstacle,
-                                real_t dx, real_t dy, real_t dz)
+                                real_t dx, real_t dy, real_t dz, std::vector< Cell > * formerObstacleCells )
    {
       // policy: every body manages only its own flags
 
@@ -125,6 +162,24 @@ private:
 
       Vector3<real_t> startCellCenter = blockStorage_->getBlockLocalCellCenter( *block, cellBB.min() );
 
+      BodyMappingCache::BodyCells * cachedCells = cache_ ? cache_->getBodyCells( *block, body, cellBB, startCellCenter ) : NULL;
+
+      if( cachedCells != NULL && !cachedCells->visitAllCells() )
+      {
+         // all other cells have kept their state since the previous mapping
+         uint_t numberOfTestedCells( 0 );
+         mapShellCells( body, cachedCells->getShellCells(), *cachedCells, cellBB, startCellCenter, boundaryHandling, flagField, bodyField,
+                        obstacle, formerObstacle, dx, dy, dz, formerObstacleCells, numberOfTestedCells );
+         mapOverlappingCells( body, cachedCells->getOverlaps(), *cachedCells, cellBB, boundaryHandling, flagField, bodyField,
+                              obstacle, formerObstacle, formerObstacleCells );
+         mapOverlappingCells( body, cachedCells->getPreviousOverlaps(), *cachedCells, cellBB, boundaryHandling, flagField, bodyField,
+                              obstacle, formerObstacle, formerObstacleCells );
+         cache_->countCellTests( cellBB.numCells(), numberOfTestedCells );
+         return;
+      }
+
+      uint_t numberOfTestedCells( 0 );
+
       real_t cz = startCellCenter[2];
       for( cell_idx_t z = cellBB.zMin(); z <= cellBB.zMax(); ++z )
       {
@@ -134,52 +189,129 @@ private:
             real_t cx = startCellCenter[0];
             for( cell_idx_t x = cellBB.xMin(); x <= cellBB.xMax(); ++x )
             {
-
-               flag_t & cellFlagPtr = flagField->get(x,y,z);
-
-               if( body->containsPoint(cx,cy,cz) )
+               bool inside( false );
+               if( cachedCells == NULL )
                {
-                  // cell is inside body
-                  if( !isFlagSet( cellFlagPtr, obstacle ) )
-                  {
-                     // cell is not yet an obstacle cell
-                     if( isFlagSet( cellFlagPtr, formerObstacle ) )
-                     {
-                        // cell was marked as former obstacle, e.g. by another body that has moved away
-                        boundaryHandling->setBoundary( obstacle, x, y, z );
-                        removeFlag( cellFlagPtr, formerObstacle );
-                     }
-                     else
-                     {
-                        // set obstacle flag
-                        boundaryHandling->forceBoundary( obstacle, x, y, z );
-                     }
-                  }
-                  // let pointer from body field point to this body
-                  (*bodyField)(x,y,z) = body;
+                  inside = body->containsPoint(cx,cy,cz);
                }
-               else
+               else if( cachedCells->isRefreshing() )
                {
-                  // cell is outside body
-                  if( isFlagSet( cellFlagPtr, obstacle ) && ((*bodyField)(x, y, z) == body) )
-                  {
-                     // cell was previously occupied by this body
-                     boundaryHandling->removeBoundary( obstacle, x, y, z );
-                     addFlag( cellFlagPtr, formerObstacle );
-                     // entry at (*bodyField)(x,y,z) should still point to the previous body.
-                     // If during initialization the overlap between neighboring blocks
-                     // was chosen correctly/large enough, the body should still be on this block.
-                     // The body information is needed in the PDF restoration step.
-                     // There, the flag will be removed and replaced by a domain flag after restoration.
-                  }
+                  inside = cachedCells->testAndStore( body, Cell(x,y,z), Vector3<real_t>(cx,cy,cz) );
+                  ++numberOfTestedCells;
+               }
+               else if( !cachedCells->isKnown( Cell(x,y,z), inside ) )
+               {
+                  inside = body->containsPoint(cx,cy,cz);
+                  ++numberOfTestedCells;
                }
 
+               updateCell( body, inside, x, y, z, boundaryHandling, flagField, bodyField, obstacle, formerObstacle, formerObstacleCells );
+
                cx += dx;
             }
             cy += dy;
          }
          cz += dz;
       }
+
+      if( cachedCells != NULL )
+         cache_->countCellTests( cellBB.numCells(), numberOfTestedCells );
+   }
+
+   void mapShellCells( pe::BodyID body, const std::vector< BodyMappingCache::ShellCell > & shellCells, const BodyMappingCache::BodyCells & cachedCells,
+                       const CellInterval & cellBB, const Vector3<real_t> & startCellCenter,
+                       BoundaryHandling_T * boundaryHandling, FlagField_T * flagField, BodyField_T * bodyField,
+                       const flag_t & obstacle, const flag_t & formerObstacle,
+                       real_t dx, real_t dy, real_t dz, std::vector< Cell > * formerObstacleCells, uint_t & numberOfTestedCells )
+   {
+      for( auto shellCell = shellCells.begin(); shellCell != shellCells.end(); ++shellCell )
+      {
+         // the cached cells can cover a larger bounding box than the current one
+         const Cell & cell = shellCell->cell;
+         if( !cellBB.contains( cell ) )
+            continue;
+
+         bool inside( false );
+         if( !cachedCells.isKnown( shellCell->index, inside ) )
+         {
+            inside = body->containsPoint( startCellCenter[0] + real_c( cell.x() - cellBB.xMin() ) * dx,
+                                          startCellCenter[1] + real_c( cell.y() - cellBB.yMin() ) * dy,
+                                          startCellCenter[2] + real_c( cell.z() - cellBB.zMin() ) * dz );
+            ++numberOfTestedCells;
+         }
+
+         updateCell( body, inside, cell.x(), cell.y(), cell.z(), boundaryHandling, flagField, bodyField, obstacle, formerObstacle, formerObstacleCells );
+      }
+   }
+
+   void mapOverlappingCells( pe::BodyID body, const std::vector< CellInterval > & overlaps, const BodyMappingCache::BodyCells & cachedCells,
+                             const CellInterval & cellBB, BoundaryHandling_T * boundaryHandling, FlagField_T * flagField, BodyField_T * bodyField,
+                             const flag_t & obstacle, const flag_t & formerObstacle, std::vector< Cell > * formerObstacleCells )
+   {
+      // cells inside of the body might have been overwritten by other bodies (visiting a cell twice does not change the result)
+      for( auto overlap = overlaps.begin(); overlap != overlaps.end(); ++overlap )
+      {
+         CellInterval cells( *overlap );
+         cells.intersect( cellBB );
+         for( cell_idx_t z = cells.zMin(); z <= cells.zMax(); ++z )
+         {
+            for( cell_idx_t y = cells.yMin(); y <= cells.yMax(); ++y )
+            {
+               size_t cellIndex = cachedCells.index( Cell( cells.xMin(), y, z ) );
+               for( cell_idx_t x = cells.xMin(); x <= cells.xMax(); ++x, ++cellIndex )
+               {
+                  if( cachedCells.isInteriorCell( cellIndex ) )
+                     updateCell( body, true, x, y, z, boundaryHandling, flagField, bodyField, obstacle, formerObstacle, formerObstacleCells );
+               }
+            }
+         }
+      }
+   }
+
+   void updateCell( pe::BodyID body, bool inside, cell_idx_t x, cell_idx_t y, cell_idx_t z,
+                    BoundaryHandling_T * boundaryHandling, FlagField_T * flagField, BodyField_T * bodyField,
+                    const flag_t & obstacle, const flag_t & formerObstacle, std::vector< Cell > * formerObstacleCells )
+   {
+      flag_t & cellFlagPtr = flagField->get(x,y,z);
+
+      if( inside )
+      {
+         // cell is inside body
+         if( !isFlagSet( cellFlagPtr, obstacle ) )
+         {
+            // cell is not yet an obstacle cell
+            if( isFlagSet( cellFlagPtr, formerObstacle ) )
+            {
+               // cell was marked as former obstacle, e.g. by another body that has moved away
+               boundaryHandling->setBoundary( obstacle, x, y, z );
+               removeFlag( cellFlagPtr, formerObstacle );
+            }
+            else
+            {
+               // set obstacle flag
+               boundaryHandling->forceBoundary( obstacle, x, y, z );
+            }
+         }
+         // let pointer from body field point to this body
+         (*bodyField)(x,y,z) = body;
+      }
+      else
+      {
+         // cell is outside body
+         if( isFlagSet( cellFlagPtr, obstacle ) && ((*bodyField)(x, y, z) == body) )
+         {
+            // cell was previously occupied by this body
+            boundaryHandling->removeBoundary( obstacle, x, y, z );
+            addFlag( cellFlagPtr, formerObstacle );
+            if( formerObstacleCells != NULL )
+               formerObstacleCells->push_back( Cell(x,y,z) );
+            // entry at (*bodyField)(x,y,z) should still point to the previous body.
+            // If during initialization the overlap between neighboring blocks
+            // was chosen correctly/large enough, the body should still be on this block.
+            // The body information is needed in the PDF restoration step.
+            // There, the flag will be removed and replaced by a domain flag after restoration.
+         }
+      }
    }
 
    shared_ptr<StructuredBlockStorage> blockStorage_;
@@ -194,6 +326,8 @@ private:
 
    std::function<bool(pe::BodyID)> mappingBodySelectorFct_;
 
+   shared_ptr<BodyMappingCache> cache_;
+
 }; // class BodyMapping
 
 
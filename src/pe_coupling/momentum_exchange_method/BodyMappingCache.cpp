@@ -0,0 +1,299 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BodyMappingCache.cpp
+//! \ingroup pe_coupling
+//
+//======================================================================================================================
+
+#include "pe_coupling/momentum_exchange_method/BodyMappingCache.h"
+
+#include "pe/rigidbody/Box.h"
+#include "pe/rigidbody/Capsule.h"
+#include "pe/rigidbody/Sphere.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace walberla {
+namespace pe_coupling {
+
+namespace {
+
+// shape parameters of the body types with a surface distance function
+bool getShape( pe::ConstBodyID body, pe::Vec3 & shape, bool & rotationInvariant )
+{
+   if( body->getTypeID() == pe::Sphere::getStaticTypeID() )
+   {
+      shape = pe::Vec3( static_cast<pe::ConstSphereID>( body )->getRadius(), real_t(0), real_t(0) );
+      rotationInvariant = true;
+      return true;
+   }
+   if( body->getTypeID() == pe::Box::getStaticTypeID() )
+   {
+      shape = static_cast<pe::ConstBoxID>( body )->getLengths();
+      rotationInvariant = false;
+      return true;
+   }
+   if( body->getTypeID() == pe::Capsule::getStaticTypeID() )
+   {
+      pe::ConstCapsuleID capsule = static_cast<pe::ConstCapsuleID>( body );
+      shape = pe::Vec3( capsule->getRadius(), capsule->getLength(), real_t(0) );
+      rotationInvariant = false;
+      return true;
+   }
+   return false;
+}
+
+// distance of a point to the body surface, negative inside of the body
+real_t getSignedDistance( pe::ConstBodyID body, const Vector3<real_t> & point )
+{
+   if( body->getTypeID() == pe::Sphere::getStaticTypeID() )
+   {
+      pe::ConstSphereID sphere = static_cast<pe::ConstSphereID>( body );
+      return ( point - sphere->getPosition() ).length() - sphere->getRadius();
+   }
+   if( body->getTypeID() == pe::Box::getStaticTypeID() )
+   {
+      return static_cast<pe::ConstBoxID>( body )->getDistance( point );
+   }
+   WALBERLA_ASSERT_EQUAL( body->getTypeID(), pe::Capsule::getStaticTypeID() );
+   return static_cast<pe::ConstCapsuleID>( body )->getDistance( point );
+}
+
+} // anonymous namespace
+
+
+
+bool BodyMappingCache::BodyCells::testAndStore( pe::ConstBodyID body, const Cell & cell, const Vector3<real_t> & center )
+{
+   WALBERLA_ASSERT( refresh_ );
+
+   const size_t i = index( cell );
+   const real_t signedDistance = getSignedDistance( body, center );
+
+   // the sign of the distance agrees with containsPoint apart from round-off, which only matters directly at the surface
+   const bool inside = ( std::fabs( signedDistance ) > surfaceTolerance_ ) ? ( signedDistance < real_t(0) ) : body->containsPoint( center );
+
+   inside_[i] = inside ? uint8_t(1) : uint8_t(0);
+   // the distance is only a valid clearance if it agrees with the tested state
+   clearance_[i] = ( inside == ( signedDistance < real_t(0) ) ) ? std::fabs( signedDistance ) : real_t(0);
+
+   // cells are stored in ascending z,y,x order
+   if( clearance_[i] <= shellThickness_ )
+      shellCells_.push_back( ShellCell( cell, i ) );
+
+   return inside;
+}
+
+
+
+void BodyMappingCache::addBody( const IBlock & block, pe::ConstBodyID body, const CellInterval & cellBB )
+{
+   auto blockIt = blocks_.find( &block );
+   WALBERLA_ASSERT( blockIt != blocks_.end() );
+   BlockCells & blockCells = blockIt->second;
+
+   BodyCells & cells = blockCells.bodies[ body->getSystemID() ];
+   WALBERLA_ASSERT_NOT_IDENTICAL( cells.visit_, blockCells.visit, "body " << body->getSystemID() << " is added twice" );
+
+   // state of the previous mapping is only valid if the body was mapped on this block in the previous mapping
+   const bool mappedBefore = ( cells.visit_ + uint_t(1) == blockCells.visit );
+   cells.previousCellBB_ = mappedBefore ? cells.currentCellBB_ : CellInterval();
+   cells.currentCellBB_  = cellBB;
+   cells.visit_          = blockCells.visit;
+   cells.previousOverlaps_.swap( cells.overlaps_ );
+   cells.overlaps_.clear();
+
+   blockCells.addedBodies.push_back( &cells );
+}
+
+
+
+void BodyMappingCache::beginMapping( const StructuredBlockStorage & blockStorage, const IBlock & block, real_t dx, real_t dy, real_t dz )
+{
+   // a new block while all local blocks are already cached: some of the cached blocks have left the process
+   if( blocks_.size() >= blockStorage.getNumberOfBlocks() && blocks_.find( &block ) == blocks_.end() )
+      removeBlocksNotIn( blockStorage );
+
+   BlockCells & blockCells = blocks_[ &block ];
+
+   // a different block at the same address (e.g. after load balancing) invalidates all cached states
+   const Vector3<real_t> cellSize( dx, dy, dz );
+   if( !( blockCells.aabb == block.getAABB() ) || blockCells.cellSize != cellSize )
+   {
+      blockCells.aabb = block.getAABB();
+      blockCells.cellSize = cellSize;
+      blockCells.bodies.clear();
+      blockCells.formerObstacleCells.clear();
+   }
+
+   ++blockCells.visit;
+   blockCells.addedBodies.clear();
+   blockCells.overlapsDetected = false;
+}
+
+
+
+void BodyMappingCache::removeBlocksNotIn( const StructuredBlockStorage & blockStorage )
+{
+   std::set< const IBlock * > localBlocks;
+   for( auto block = blockStorage.begin(); block != blockStorage.end(); ++block )
+      localBlocks.insert( block.get() );
+
+   for( auto blockIt = blocks_.begin(); blockIt != blocks_.end(); )
+   {
+      if( localBlocks.find( blockIt->first ) == localBlocks.end() )
+         blockIt = blocks_.erase( blockIt );
+      else
+         ++blockIt;
+   }
+}
+
+
+
+void BodyMappingCache::detectOverlaps( BlockCells & blockCells )
+{
+   // sweep along x over the cell bounding boxes of all added bodies
+   std::vector< BodyCells * > & bodies = blockCells.addedBodies;
+   std::sort( bodies.begin(), bodies.end(), []( const BodyCells * lhs, const BodyCells * rhs )
+                                            { return lhs->currentCellBB_.xMin() < rhs->currentCellBB_.xMin(); } );
+
+   for( auto bodyIt = bodies.begin(); bodyIt != bodies.end(); ++bodyIt )
+   {
+      const CellInterval & cellBB = ( *bodyIt )->currentCellBB_;
+      if( cellBB.empty() )
+         continue;
+
+      for( auto otherIt = bodyIt + 1; otherIt != bodies.end() && ( *otherIt )->currentCellBB_.xMin() <= cellBB.xMax(); ++otherIt )
+      {
+         if( cellBB.overlaps( ( *otherIt )->currentCellBB_ ) )
+         {
+            CellInterval overlap( cellBB );
+            overlap.intersect( ( *otherIt )->currentCellBB_ );
+            ( *bodyIt )->overlaps_.push_back( overlap );
+            ( *otherIt )->overlaps_.push_back( overlap );
+         }
+      }
+   }
+
+   blockCells.overlapsDetected = true;
+}
+
+
+
+void BodyMappingCache::endMapping( const IBlock & block )
+{
+   auto blockIt = blocks_.find( &block );
+   WALBERLA_ASSERT( blockIt != blocks_.end() );
+   BlockCells & blockCells = blockIt->second;
+
+   // remove bodies that have left the block
+   for( auto bodyIt = blockCells.bodies.begin(); bodyIt != blockCells.bodies.end(); )
+   {
+      if( bodyIt->second.visit_ != blockCells.visit )
+         bodyIt = blockCells.bodies.erase( bodyIt );
+      else
+         ++bodyIt;
+   }
+
+   std::vector< Cell > & cells = blockCells.formerObstacleCells;
+   std::sort( cells.begin(), cells.end() );
+   cells.erase( std::unique( cells.begin(), cells.end() ), cells.end() );
+}
+
+
+
+BodyMappingCache::BodyCells * BodyMappingCache::getBodyCells( const IBlock & block, pe::ConstBodyID body, const CellInterval & cellBB,
+                                                              const Vector3<real_t> & cellBBMinCenter )
+{
+   auto blockIt = blocks_.find( &block );
+   WALBERLA_ASSERT( blockIt != blocks_.end() );
+   BlockCells & blockCells = blockIt->second;
+
+   pe::Vec3 shape;
+   bool rotationInvariant( false );
+   if( cellBB.empty() || !getShape( body, shape, rotationInvariant ) )
+      return NULL;
+
+   if( !blockCells.overlapsDetected )
+      detectOverlaps( blockCells );
+
+   auto bodyIt = blockCells.bodies.find( body->getSystemID() );
+   WALBERLA_ASSERT( bodyIt != blockCells.bodies.end() && bodyIt->second.visit_ == blockCells.visit,
+                    "body " << body->getSystemID() << " has not been added to the cache" );
+   BodyCells & cells = bodyIt->second;
+   WALBERLA_ASSERT_EQUAL( cells.currentCellBB_, cellBB );
+
+   const real_t minDx = std::min( blockCells.cellSize[0], std::min( blockCells.cellSize[1], blockCells.cellSize[2] ) );
+
+   // displacement of all cell centers relative to the body since the reference state:
+   // translation plus rotation around the reference position
+   bool refresh = cells.clearance_.empty() || cells.rotationInvariant_ != rotationInvariant ||
+                  !( cells.shape_ == shape ) || !cells.cellBB_.contains( cellBB );
+   real_t displacement( real_t(0) );
+   if( !refresh )
+   {
+      const real_t translation = ( body->getPosition() - cells.position_ ).length();
+      displacement = translation;
+      if( !rotationInvariant )
+      {
+         const pe::Quat rotation( body->getQuaternion() * cells.orientation_.getInverse() );
+         const real_t sinHalfAngle = std::sqrt( rotation[1] * rotation[1] + rotation[2] * rotation[2] + rotation[3] * rotation[3] );
+         const real_t angle = real_t(2) * std::atan2( sinHalfAngle, std::fabs( rotation[0] ) );
+         displacement += angle * ( cells.maxCellDistance_ + translation );
+      }
+      refresh = displacement > real_t(0.5) * minDx;
+   }
+
+   // the state of a cell can only change within the shell, which is filled during the refresh
+   cells.shellThickness_ = ( real_t(0.5) + real_t(1e-6) ) * minDx;
+   cells.surfaceTolerance_ = real_t(1e-6) * minDx;
+
+   if( refresh )
+   {
+      cells.shellCells_.clear();
+      cells.position_          = body->getPosition();
+      cells.orientation_       = body->getQuaternion();
+      cells.shape_             = shape;
+      cells.rotationInvariant_ = rotationInvariant;
+      cells.cellBB_            = cellBB;
+      cells.clearance_.resize( cellBB.numCells() );
+      cells.inside_.resize( cellBB.numCells() );
+
+      const Vector3<real_t> extent( real_c( cellBB.xSize() - uint_t(1) ) * blockCells.cellSize[0],
+                                    real_c( cellBB.ySize() - uint_t(1) ) * blockCells.cellSize[1],
+                                    real_c( cellBB.zSize() - uint_t(1) ) * blockCells.cellSize[2] );
+      cells.maxCellDistance_ = real_t(0);
+      for( uint_t corner = uint_t(0); corner < uint_t(8); ++corner )
+      {
+         const Vector3<real_t> cornerCenter( cellBBMinCenter[0] + ( ( corner & uint_t(1) ) ? extent[0] : real_t(0) ),
+                                             cellBBMinCenter[1] + ( ( corner & uint_t(2) ) ? extent[1] : real_t(0) ),
+                                             cellBBMinCenter[2] + ( ( corner & uint_t(4) ) ? extent[2] : real_t(0) ) );
+         cells.maxCellDistance_ = std::max( cells.maxCellDistance_, ( cornerCenter - cells.position_ ).length() );
+      }
+   }
+
+   cells.refresh_ = refresh;
+   cells.visitAllCells_ = refresh || cellBB != cells.previousCellBB_;
+   // safety margin for the round-off errors of the distance and displacement calculations
+   cells.displacement_ = displacement + real_t(1e-6) * minDx;
+
+   return &cells;
+}
+
+} // namespace pe_coupling
+} // namespace walberla
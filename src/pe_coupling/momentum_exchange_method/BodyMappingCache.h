@@ -0,0 +1,221 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BodyMappingCache.h
+//! \ingroup pe_coupling
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "core/DataTypes.h"
+#include "core/cell/Cell.h"
+#include "core/cell/CellInterval.h"
+#include "core/debug/Debug.h"
+#include "core/math/AABB.h"
+#include "core/math/Quaternion.h"
+#include "domain_decomposition/IBlock.h"
+#include "domain_decomposition/StructuredBlockStorage.h"
+
+#include "pe/Types.h"
+
+#include <map>
+#include <vector>
+
+namespace walberla {
+namespace pe_coupling {
+
+/*!\brief Cache for the incremental mapping of moving bodies with BodyMapping (see BodyMapping::setBodyMappingCache).
+ *
+ * For every body and block, the inside/outside state of all cells of the body's cell bounding box is stored together
+ * with the distance of the cell centers to the body surface, both for a reference position and orientation of the body.
+ * As long as the body has moved less than this distance since the reference state (translation plus the displacement
+ * due to the rotation), the state of a cell can not have changed and the containsPoint test of the cell is skipped.
+ * The reference state is renewed if the displacement exceeds half a cell or the cell bounding box grows.
+ *
+ * Since the displacement never exceeds half a cell until the next renewal, only the shell of cells that are closer to the
+ * body surface than half a cell have to be visited by the mapping at all. All other cells keep the state and thus the
+ * flags and body field entries of the previous mapping. Only the cells inside of the body that are covered by the cell
+ * bounding box of another mapped body (in the current or previous mapping) are visited additionally, since the other
+ * body might have overwritten them.
+ * All cells are visited if the reference state is renewed or the cell bounding box has changed.
+ * It is assumed that the flags and body field entries of the bodies are not altered by anything but the mapping with
+ * this cache and the PDFReconstruction between two mappings.
+ *
+ * The surface distance is available for spheres, boxes, and capsules. All other bodies are always mapped completely.
+ *
+ * Additionally, the cells that are marked as 'formerObstacle' by the mapping are collected, such that the
+ * PDFReconstruction (see PDFReconstruction::setBodyMappingCache) only has to visit these cells.
+ *
+ * The cache is shared by all copies of the sweeps it is set to. The cached states of blocks that are no longer part of
+ * the block storage (e.g., after load balancing) are removed by beginMapping.
+ */
+class BodyMappingCache
+{
+public:
+
+   /// Cell close to the body surface and its index in the cached cell states
+   struct ShellCell
+   {
+      ShellCell( const Cell & c, size_t i ) : cell( c ), index( i ) {}
+      Cell   cell;
+      size_t index;
+   };
+
+   /// Cached cell states of one body on one block
+   class BodyCells
+   {
+   public:
+
+      BodyCells() : maxCellDistance_( real_t(0) ), rotationInvariant_( false ), refresh_( true ), visitAllCells_( true ),
+                    displacement_( real_t(0) ), shellThickness_( real_t(0) ),
+                    surfaceTolerance_( real_t(0) ), visit_( uint_t(0) ) {}
+
+      /// returns true if the cell state is known without testing it ('inside' is set accordingly)
+      inline bool isKnown( const Cell & cell, bool & inside ) const { return isKnown( index( cell ), inside ); }
+      inline bool isKnown( size_t cellIndex,  bool & inside ) const;
+
+      /// tests a cell (with cell center 'center') and stores its state in a renewed reference state
+      bool testAndStore( pe::ConstBodyID body, const Cell & cell, const Vector3<real_t> & center );
+
+      bool isRefreshing() const { return refresh_; }
+
+      /// if false, only the shell cells and the interior cells within the overlaps have to be visited by the mapping
+      bool visitAllCells() const { return visitAllCells_; }
+
+      /// cells close to the body surface, in ascending z,y,x order
+      const std::vector< ShellCell > & getShellCells() const { return shellCells_; }
+
+      /// intersections of the cell bounding box with the ones of other bodies in the current and the previous mapping
+      const std::vector< CellInterval > & getOverlaps()         const { return overlaps_; }
+      const std::vector< CellInterval > & getPreviousOverlaps() const { return previousOverlaps_; }
+
+      /// returns true if the cell is inside of the body and not a shell cell
+      inline bool isInteriorCell( const Cell & cell ) const { return isInteriorCell( index( cell ) ); }
+      inline bool isInteriorCell( size_t cellIndex ) const;
+
+      inline size_t index( const Cell & cell ) const;
+
+   private:
+
+      friend class BodyMappingCache;
+
+      pe::Vec3     position_;        // reference state
+      pe::Quat     orientation_;
+      pe::Vec3     shape_;
+      CellInterval cellBB_;
+      real_t       maxCellDistance_; // maximal distance of the centers of the cells of cellBB_ to position_
+      bool         rotationInvariant_;
+
+      std::vector< real_t >  clearance_;  // distance of the cell center to the body surface in the reference state
+      std::vector< uint8_t > inside_;
+      std::vector< ShellCell > shellCells_;
+
+      CellInterval currentCellBB_;   // state of the current mapping
+      CellInterval previousCellBB_;
+      bool   refresh_;
+      bool   visitAllCells_;
+      std::vector< CellInterval > overlaps_;
+      std::vector< CellInterval > previousOverlaps_;
+      real_t displacement_;
+      real_t shellThickness_;
+      real_t surfaceTolerance_;
+      uint_t visit_;
+   };
+
+   BodyMappingCache() : numberOfCellTests_( uint_t(0) ), numberOfSkippedCellTests_( uint_t(0) ) {}
+
+   /// to be called by the mapping for all bodies of a block, in mapping order, before the bodies are mapped
+   void addBody( const IBlock & block, pe::ConstBodyID body, const CellInterval & cellBB );
+
+   /// to be called by the mapping before the bodies are added / after all bodies of a block are mapped
+   void beginMapping( const StructuredBlockStorage & blockStorage, const IBlock & block, real_t dx, real_t dy, real_t dz );
+   void endMapping  ( const IBlock & block );
+
+   /// returns the cached cell states of a body for the current mapping, or NULL if the body can not be cached
+   BodyCells * getBodyCells( const IBlock & block, pe::ConstBodyID body, const CellInterval & cellBB,
+                             const Vector3<real_t> & cellBBMinCenter );
+
+   /// cells of the block that were marked as 'formerObstacle' by the mapping (in ascending z,y,x order after endMapping)
+   std::vector< Cell > & getFormerObstacleCells( const IBlock & block ) { return blocks_[ &block ].formerObstacleCells; }
+
+   /// to be called by the mapping for every mapped body: number of cells of the cell bounding box and of actually tested cells
+   void countCellTests( uint_t numberOfCells, uint_t numberOfTestedCells )
+   {
+      WALBERLA_ASSERT_GREATER_EQUAL( numberOfCells, numberOfTestedCells );
+      numberOfCellTests_        += numberOfTestedCells;
+      numberOfSkippedCellTests_ += numberOfCells - numberOfTestedCells;
+   }
+
+   /// number of containsPoint tests that were carried out / skipped since the last reset
+   uint_t getNumberOfCellTests()        const { return numberOfCellTests_; }
+   uint_t getNumberOfSkippedCellTests() const { return numberOfSkippedCellTests_; }
+   void   resetCounters() { numberOfCellTests_ = uint_t(0); numberOfSkippedCellTests_ = uint_t(0); }
+
+private:
+
+   struct BlockCells
+   {
+      BlockCells() : visit( uint_t(0) ), overlapsDetected( false ) {}
+
+      math::AABB aabb;
+      Vector3<real_t> cellSize;
+      uint_t visit;
+      std::map< walberla::id_t, BodyCells > bodies;
+      std::vector< BodyCells * > addedBodies;
+      bool overlapsDetected;
+      std::vector< Cell > formerObstacleCells;
+   };
+
+   void detectOverlaps( BlockCells & blockCells );
+   void removeBlocksNotIn( const StructuredBlockStorage & blockStorage );
+
+   std::map< const IBlock *, BlockCells > blocks_;
+
+   uint_t numberOfCellTests_;
+   uint_t numberOfSkippedCellTests_;
+
+}; // class BodyMappingCache
+
+
+
+inline size_t BodyMappingCache::BodyCells::index( const Cell & cell ) const
+{
+   WALBERLA_ASSERT( cellBB_.contains( cell ) );
+   return ( uint_c( cell.z() - cellBB_.zMin() ) * cellBB_.ySize() + uint_c( cell.y() - cellBB_.yMin() ) ) * cellBB_.xSize()
+          + uint_c( cell.x() - cellBB_.xMin() );
+}
+
+inline bool BodyMappingCache::BodyCells::isInteriorCell( size_t cellIndex ) const
+{
+   WALBERLA_ASSERT( !refresh_ );
+   return inside_[cellIndex] != uint8_t(0) && clearance_[cellIndex] > shellThickness_;
+}
+
+inline bool BodyMappingCache::BodyCells::isKnown( size_t cellIndex, bool & inside ) const
+{
+   if( refresh_ )
+      return false;
+
+   if( clearance_[cellIndex] > displacement_ )
+   {
+      inside = ( inside_[cellIndex] != uint8_t(0) );
+      return true;
+   }
+   return false;
+}
+
+} // namespace pe_coupling
+} // namespace walberla
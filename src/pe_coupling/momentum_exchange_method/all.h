@@ -25,3 +25,4 @@
 #include "boundary/all.h"
 #include "restoration/all.h"
 #include "BodyMapping.h"
+#include "BodyMappingCache.h"
@@ -24,6 +24,7 @@
 
 #include "pe/rigidbody/BodyIterators.h"
 #include "pe_coupling/mapping/BodyBBMapping.h"
+#include "pe_coupling/momentum_exchange_method/BodyMappingCache.h"
 #include "pe_coupling/utility/BodySelectorFunctions.h"
 
 #include "core/debug/Debug.h"
@@ -52,6 +53,10 @@ namespace pe_coupling {
 *
 * The 'movingBodySelectorFct' can be used to decide which bodies should be check for reconstruction
 * (only used when 'optimizeForSmallObstacleFraction' is chosen).
+*
+* If the bodies are mapped incrementally with a BodyMappingCache (see BodyMapping::setBodyMappingCache), the same cache
+* can be set here. Then, only the 'formerObstacle' cells collected by the mapping are visited. This requires that all
+* moving bodies are mapped with this cache and that the reconstruction is carried out after every mapping.
 */
 //**************************************************************************************************************************************
 
@@ -80,6 +85,9 @@ public:
       optimizeForSmallObstacleFraction_( optimizeForSmallObstacleFraction )
    {}
 
+   /// Restricts the reconstruction to the 'formerObstacle' cells collected by the incremental body mapping.
+   void setBodyMappingCache( const shared_ptr<BodyMappingCache> & cache ) { cache_ = cache; }
+
    void operator()( IBlock * const block );
 
 private:
@@ -131,6 +139,8 @@ private:
 
    const bool optimizeForSmallObstacleFraction_;
 
+   shared_ptr<BodyMappingCache> cache_;
+
 };
 
 
@@ -156,6 +166,34 @@ void PDFReconstruction< LatticeModel_T, BoundaryHandling_T, Reconstructer_T >
    const flag_t formerObstacle = flagField->getFlag( formerObstacle_ );
    const flag_t fluid          = flagField->getFlag( fluid_ );
 
+   if( cache_ )
+   {
+      // the cells are sorted in the same (z,y,x) order as in the loops over cell intervals
+      std::vector< Cell > & formerObstacleCells = cache_->getFormerObstacleCells( *block );
+
+      // reconstruct all missing PDFs (only inside the domain, ghost layer values get communicated)
+      const CellInterval domainCells = flagField->xyzSize();
+      for( auto cell = formerObstacleCells.begin(); cell != formerObstacleCells.end(); ++cell )
+      {
+         if( domainCells.contains( *cell ) && isFlagSet( flagField->get( *cell ), formerObstacle ) )
+            reconstructor_( cell->x(), cell->y(), cell->z(), block );
+      }
+
+      // update the flags from formerObstacle to fluid (inside domain & in ghost layers)
+      for( auto cell = formerObstacleCells.begin(); cell != formerObstacleCells.end(); ++cell )
+      {
+         if( isFlagSet( flagField->get( *cell ), formerObstacle ) )
+         {
+            boundaryHandling->setDomain( fluid, cell->x(), cell->y(), cell->z() );
+            removeFlag( flagField->get( *cell ), formerObstacle );
+            bodyField->get( *cell ) = NULL;
+         }
+      }
+
+      formerObstacleCells.clear();
+      return;
+   }
+
    // reconstruct all missing PDFs (only inside the domain, ghost layer values get communicated)
    if( optimizeForSmallObstacleFraction_ )
    {
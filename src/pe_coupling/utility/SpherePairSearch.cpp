@@ -0,0 +1,133 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SpherePairSearch.cpp
+//! \ingroup pe_coupling
+//
+//======================================================================================================================
+
+#include "pe_coupling/utility/SpherePairSearch.h"
+
+#include "pe/rigidbody/BodyIterators.h"
+#include "pe/rigidbody/Sphere.h"
+#include "pe/utility/Distance.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace walberla {
+namespace pe_coupling {
+
+void SpherePairSearch::update( IBlock & block, const BlockDataID & bodyStorageID )
+{
+   spheres_.clear();
+   pairs_.clear();
+
+   for( auto bodyIt = pe::BodyIterator::begin( block, bodyStorageID ); bodyIt != pe::BodyIterator::end(); ++bodyIt )
+   {
+      if( bodyIt->getTypeID() == pe::Sphere::getStaticTypeID() )
+         spheres_.push_back( static_cast<pe::SphereID>( *bodyIt ) );
+   }
+
+   const size_t numSpheres = spheres_.size();
+   if( numSpheres < size_t(2) )
+      return;
+
+   // bounding box of the sphere centers and largest radius
+   pe::Vec3 minCorner( spheres_[0]->getPosition() );
+   pe::Vec3 maxCorner( spheres_[0]->getPosition() );
+   real_t maxRadius( spheres_[0]->getRadius() );
+   for( size_t i = 1; i < numSpheres; ++i )
+   {
+      const pe::Vec3 & pos = spheres_[i]->getPosition();
+      for( uint_t d = 0; d < 3; ++d )
+      {
+         minCorner[d] = std::min( minCorner[d], pos[d] );
+         maxCorner[d] = std::max( maxCorner[d], pos[d] );
+      }
+      maxRadius = std::max( maxRadius, spheres_[i]->getRadius() );
+   }
+
+   // the center distance of a pair within the cut off distance is at most 2 * maxRadius + cutOffDistance,
+   // so such pairs are always located in neighboring cells (a small safety margin accounts for round-off);
+   // the number of cells is limited to about the number of spheres for sparse configurations
+   const real_t interactionRange = ( real_t(2) * maxRadius + std::max( cutOffDistance_, real_t(0) ) ) * ( real_t(1) + real_t(1e-6) );
+   const uint_t maxCellsPerDim = uint_c( std::cbrt( real_c( numSpheres ) ) ) + uint_t(1);
+
+   uint_t cells[3];
+   real_t invCellSize[3];
+   for( uint_t d = 0; d < 3; ++d )
+   {
+      const real_t extent = maxCorner[d] - minCorner[d];
+      const real_t cellSize = std::max( interactionRange, extent / real_c( maxCellsPerDim ) );
+      cells[d] = ( cellSize > real_t(0) ) ? std::min( uint_c( extent / cellSize ) + uint_t(1), maxCellsPerDim ) : uint_t(1);
+      invCellSize[d] = ( cellSize > real_t(0) ) ? real_t(1) / cellSize : real_t(0);
+   }
+   const size_t numCells = cells[0] * cells[1] * cells[2];
+
+   // counting sort of the spheres into the cells
+   cellOfSphere_.resize( numSpheres );
+   cellBegin_.assign( numCells + size_t(1), size_t(0) );
+   for( size_t i = 0; i < numSpheres; ++i )
+   {
+      const pe::Vec3 & pos = spheres_[i]->getPosition();
+      uint_t c[3];
+      for( uint_t d = 0; d < 3; ++d )
+         c[d] = std::min( uint_c( ( pos[d] - minCorner[d] ) * invCellSize[d] ), cells[d] - uint_t(1) );
+      cellOfSphere_[i] = ( c[2] * cells[1] + c[1] ) * cells[0] + c[0];
+      ++cellBegin_[ cellOfSphere_[i] + size_t(1) ];
+   }
+   for( size_t c = 0; c < numCells; ++c )
+      cellBegin_[c + size_t(1)] += cellBegin_[c];
+
+   sortedSpheres_.resize( numSpheres );
+   for( size_t i = 0; i < numSpheres; ++i )
+      sortedSpheres_[ cellBegin_[ cellOfSphere_[i] ]++ ] = i;
+   for( size_t c = numCells; c > size_t(0); --c )
+      cellBegin_[c] = cellBegin_[c - size_t(1)];
+   cellBegin_[0] = size_t(0);
+
+   // pairs in the order of a nested loop over all spheres ( j > i )
+   for( size_t i = 0; i < numSpheres; ++i )
+   {
+      const size_t cell = cellOfSphere_[i];
+      const uint_t cx =   cell % cells[0];
+      const uint_t cy = ( cell / cells[0] ) % cells[1];
+      const uint_t cz =   cell / ( cells[0] * cells[1] );
+
+      candidates_.clear();
+      for( uint_t z = ( cz > 0 ? cz - 1 : 0 ); z <= std::min( cz + 1, cells[2] - 1 ); ++z )
+         for( uint_t y = ( cy > 0 ? cy - 1 : 0 ); y <= std::min( cy + 1, cells[1] - 1 ); ++y )
+            for( uint_t x = ( cx > 0 ? cx - 1 : 0 ); x <= std::min( cx + 1, cells[0] - 1 ); ++x )
+            {
+               const size_t neighborCell = ( z * cells[1] + y ) * cells[0] + x;
+               for( size_t k = cellBegin_[neighborCell]; k < cellBegin_[neighborCell + size_t(1)]; ++k )
+               {
+                  // same comparison as in the lubrication force evaluation (also keeps pairs with invalid distances)
+                  const size_t j = sortedSpheres_[k];
+                  if( j > i && !( pe::getSurfaceDistance( spheres_[i], spheres_[j] ) > cutOffDistance_ ) )
+                     candidates_.push_back( j );
+               }
+            }
+
+      std::sort( candidates_.begin(), candidates_.end() );
+
+      for( auto j = candidates_.begin(); j != candidates_.end(); ++j )
+         pairs_.push_back( SpherePair( spheres_[i], spheres_[*j] ) );
+   }
+}
+
+} // pe_coupling
+} // walberla
@@ -0,0 +1,81 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SpherePairSearch.h
+//! \ingroup pe_coupling
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "core/DataTypes.h"
+#include "domain_decomposition/BlockDataID.h"
+#include "domain_decomposition/IBlock.h"
+
+#include "pe/Types.h"
+
+#include <utility>
+#include <vector>
+
+namespace walberla {
+namespace pe_coupling {
+
+/*!\brief Finds all pairs of spheres of a block whose surface distance is not larger than a cut off distance.
+ *
+ * All spheres of the block (local bodies and shadow copies) are sorted into a uniform cell list with cells
+ * that are at least as large as the largest possible center distance of such a pair, so only the spheres of
+ * the 27 surrounding cells have to be checked. The search is linear in the number of spheres instead of
+ * quadratic as a comparison of all pairs.
+ *
+ * The pairs are listed in the order of a nested loop over the pe::BodyIterator of the block ( sphereI before
+ * sphereJ in iteration order ), such that forces accumulated pair by pair are bitwise identical to the ones of
+ * such a loop. Pairs are selected with pe::getSurfaceDistance, i.e. with the same distance as the lubrication
+ * force evaluation.
+ *
+ * Used by LubricationCorrection and discrete_particle_methods::LubricationForceEvaluator.
+ */
+class SpherePairSearch
+{
+public:
+
+   typedef std::pair< pe::SphereID, pe::SphereID > SpherePair;
+   typedef std::vector< SpherePair >::const_iterator const_iterator;
+
+   explicit SpherePairSearch( real_t cutOffDistance ) : cutOffDistance_( cutOffDistance ) { }
+
+   void update( IBlock & block, const BlockDataID & bodyStorageID );
+
+   const_iterator begin() const { return pairs_.begin(); }
+   const_iterator end()   const { return pairs_.end(); }
+   size_t         size()  const { return pairs_.size(); }
+
+   real_t getCutOffDistance() const { return cutOffDistance_; }
+
+private:
+
+   real_t cutOffDistance_;
+
+   // buffers are kept to avoid reallocations in every time step
+   std::vector< pe::SphereID > spheres_;       // all spheres of the block in iteration order
+   std::vector< size_t >       cellOfSphere_;
+   std::vector< size_t >       cellBegin_;     // first entry of each cell in sortedSpheres_ (plus end)
+   std::vector< size_t >       sortedSpheres_; // sphere indices sorted by cell
+   std::vector< size_t >       candidates_;
+   std::vector< SpherePair >   pairs_;
+
+}; // class SpherePairSearch
+
+} // pe_coupling
+} // walberla
@@ -28,4 +28,5 @@
 #include "ForceTorqueOnBodiesResetter.h"
 #include "ForceTorqueOnBodiesScaler.h"
 #include "LubricationCorrection.h"
+#include "SpherePairSearch.h"
 #include "TimeStep.h"
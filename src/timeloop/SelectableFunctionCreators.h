@@ -132,6 +132,55 @@ namespace timeloop {
    typedef FuncCreator<void (IBlock*) > Sweep;
 
 
+   //*******************************************************************************************************************
+   /*!\brief Sweep that overlaps the ghost layer communication with computation
+    *
+    * The sweep is split into a part that does not need any ghost layer data ('inner') and the remaining part ('frame').
+    * In every time step, the SweepTimeloop then executes:
+    *   start communication -> 'inner' on all blocks -> wait for communication -> 'frame' on all blocks
+    * A sweep class that provides the member functions 'inner( IBlock * )' and 'frame( IBlock * )' (for example
+    * lbm::SplitPureSweep or lbm::CellwiseSweep) can be passed directly as a shared pointer:
+      \code
+      timeloop.add() << OverlappingSweep( sweep, communication.getStartCommunicateFunctor(),
+                                          communication.getWaitFunctor(), "LB stream & collide" );
+      \endcode
+    * Contrary to Sweep, the OverlappingSweep is selected only based on the global selectors (and not on the block
+    * state), since the communication involves all blocks. Boundary handling that writes into the ghost layers must
+    * NOT be executed between starting the communication and 'frame' (the communication overwrites the ghost layers).
+    */
+   //*******************************************************************************************************************
+   struct OverlappingSweep
+   {
+      OverlappingSweep( std::function< void ( IBlock * ) > inner, std::function< void ( IBlock * ) > frame,
+                        std::function< void () > startCommunication, std::function< void () > waitForCommunication,
+                        const std::string& identifier   = std::string(),
+                        const Set<SUID>&   required     = Set<SUID>::emptySet(),
+                        const Set<SUID>&   incompatible = Set<SUID>::emptySet() ) :
+         inner_( inner ), frame_( frame ), startCommunication_( startCommunication ), waitForCommunication_( waitForCommunication ),
+         identifier_( identifier ), requiredSelectors_( required ), incompatibleSelectors_( incompatible ) {}
+
+      template< typename Sweep_T >
+      OverlappingSweep( const shared_ptr< Sweep_T > & sweep,
+                        std::function< void () > startCommunication, std::function< void () > waitForCommunication,
+                        const std::string& identifier   = std::string(),
+                        const Set<SUID>&   required     = Set<SUID>::emptySet(),
+                        const Set<SUID>&   incompatible = Set<SUID>::emptySet() ) :
+         inner_( [sweep]( IBlock * const block ) { sweep->inner( block ); } ),
+         frame_( [sweep]( IBlock * const block ) { sweep->frame( block ); } ),
+         startCommunication_( startCommunication ), waitForCommunication_( waitForCommunication ),
+         identifier_( identifier ), requiredSelectors_( required ), incompatibleSelectors_( incompatible ) {}
+
+      std::function< void ( IBlock * ) > inner_;
+      std::function< void ( IBlock * ) > frame_;
+      std::function< void () >           startCommunication_;
+      std::function< void () >           waitForCommunication_;
+
+      std::string                        identifier_;
+      Set<SUID>                          requiredSelectors_;
+      Set<SUID>                          incompatibleSelectors_;
+   };
+
+
    template<typename SweepClass>
    void executeSweepOnBlock ( IBlock * block, BlockDataID bdID )
    {
@@ -169,6 +218,12 @@ namespace timeloop {
          return *this;
       }
 
+      SweepAdder& operator<<( const OverlappingSweep & sw )
+      {
+         overlappingSweep.add ( sw, sw.requiredSelectors_, sw.incompatibleSelectors_, sw.identifier_ );
+         return *this;
+      }
+
 
       template < typename SweepClass >
       SweepAdder & operator<< ( const SweepOnBlock<SweepClass> & sw )
@@ -193,6 +248,7 @@ namespace timeloop {
       std::vector<AfterFunction>  afterFuncs;
 
       selectable::SetSelectableObject<Sweep, SUID > sweep;
+      selectable::SetSelectableObject<OverlappingSweep, SUID > overlappingSweep;
 
       uint_t id_;
    };
@@ -22,11 +22,30 @@
 #include "SweepTimeloop.h"
 #include "core/Abort.h"
 
+#include <string>
+#include <vector>
+
 
 namespace walberla {
 namespace timeloop {
 
 
+static const std::string InnerPart              ( "inner" );
+static const std::string FramePart              ( "frame" );
+static const std::string StartCommunicationPart ( "communication start" );
+static const std::string WaitPart               ( "communication wait" );
+static const std::string HiddenCommunicationPart( "hidden communication" );
+
+static const std::vector< std::string > overlappingSweepTimers = { StartCommunicationPart, InnerPart, WaitPart, FramePart,
+                                                                   HiddenCommunicationPart };
+
+static std::string timerName( const std::string & identifier, const std::string & part )
+{
+   return identifier + " (" + part + ")";
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////   Execution of Timeloop  ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -44,29 +63,36 @@ void SweepTimeloop::doTimeStep(const Set<SUID> &selectors)
       for( size_t j=0; j < s.beforeFuncs.size(); ++j )
          executeSelectable(s.beforeFuncs[j].selectableFunc_,selectors,"Pre-Sweep Function");
 
-      // Loop over all blocks
-      for( BlockStorage::iterator bi = blockStorage_.begin(); bi != blockStorage_.end(); ++bi )
+      if( !s.overlappingSweep.empty() )
       {
-         if( s.sweep.empty() )
+         executeOverlappingSweep( s, selectors );
+      }
+      else
+      {
+         // Loop over all blocks
+         for( BlockStorage::iterator bi = blockStorage_.begin(); bi != blockStorage_.end(); ++bi )
          {
-            WALBERLA_ABORT("Selecting Sweep " << sweepIt->first << ": " <<
-                           "No sweep has been registered! Did you only register a BeforeFunction or AfterFunction?" );
-         }
+            if( s.sweep.empty() )
+            {
+               WALBERLA_ABORT("Selecting Sweep " << sweepIt->first << ": " <<
+                              "No sweep has been registered! Did you only register a BeforeFunction or AfterFunction?" );
+            }
 
-         Sweep * selectedSweep = s.sweep.getUnique( selectors + bi->getState() );
-         if( !selectedSweep )
-            WALBERLA_ABORT("Selecting Sweep " << sweepIt->first << ": " <<
-                           "Ambiguous, or no sweep selected. Check your selector " <<
-                            selectors + bi->getState() << std::endl << s.sweep);
+            Sweep * selectedSweep = s.sweep.getUnique( selectors + bi->getState() );
+            if( !selectedSweep )
+               WALBERLA_ABORT("Selecting Sweep " << sweepIt->first << ": " <<
+                              "Ambiguous, or no sweep selected. Check your selector " <<
+                               selectors + bi->getState() << std::endl << s.sweep);
 
-         WALBERLA_LOG_PROGRESS_SECTION()
-         {
-            std::string sweepName;
-            s.sweep.getUnique( selectors + bi->getState(), sweepName );
-            WALBERLA_LOG_PROGRESS("Running sweep \"" << sweepName << "\" on block " << bi->getId() );
-         }
+            WALBERLA_LOG_PROGRESS_SECTION()
+            {
+               std::string sweepName;
+               s.sweep.getUnique( selectors + bi->getState(), sweepName );
+               WALBERLA_LOG_PROGRESS("Running sweep \"" << sweepName << "\" on block " << bi->getId() );
+            }
 
-         (selectedSweep->function_)( bi.get() );
+            (selectedSweep->function_)( bi.get() );
+         }
       }
 
       // select and execute after functions
@@ -91,6 +117,9 @@ void SweepTimeloop::doTimeStep(const Set<SUID> &selectors, WcTimingPool &timing)
          // loop over all possibilites in selectable object
          for( auto it = s.sweep.begin(); it != s.sweep.end(); ++it )
             timing.registerTimer( it.identifier() );
+         for( auto it = s.overlappingSweep.begin(); it != s.overlappingSweep.end(); ++it )
+            for( auto part = overlappingSweepTimers.begin(); part != overlappingSweepTimers.end(); ++part )
+               timing.registerTimer( timerName( it.identifier(), *part ) );
       }
       firstRun_ = false;
    }
@@ -105,22 +134,29 @@ void SweepTimeloop::doTimeStep(const Set<SUID> &selectors, WcTimingPool &timing)
       for( size_t j=0; j < s.beforeFuncs.size(); ++j )
          executeSelectable( s.beforeFuncs[j].selectableFunc_, selectors, "Pre-Sweep Function", timing );
 
-      for( BlockStorage::iterator bi = blockStorage_.begin(); bi != blockStorage_.end(); ++bi )
+      if( !s.overlappingSweep.empty() )
       {
-         std::string sweepName;
-         Sweep * selectedSweep = s.sweep.getUnique( selectors + bi->getState(), sweepName );
+         executeOverlappingSweep( s, selectors, timing );
+      }
+      else
+      {
+         for( BlockStorage::iterator bi = blockStorage_.begin(); bi != blockStorage_.end(); ++bi )
+         {
+            std::string sweepName;
+            Sweep * selectedSweep = s.sweep.getUnique( selectors + bi->getState(), sweepName );
 
-         if( !selectedSweep )
-            WALBERLA_ABORT("Selecting Sweep " << sweepIt->first << ": " <<
-                           "Ambiguous, or no sweep selected. Check your selector " <<
-                            selectors + bi->getState() << std::endl << s.sweep);
+            if( !selectedSweep )
+               WALBERLA_ABORT("Selecting Sweep " << sweepIt->first << ": " <<
+                              "Ambiguous, or no sweep selected. Check your selector " <<
+                               selectors + bi->getState() << std::endl << s.sweep);
 
-         WALBERLA_LOG_PROGRESS("Running sweep \"" << sweepName << "\" on block " << bi->getId() );
+            WALBERLA_LOG_PROGRESS("Running sweep \"" << sweepName << "\" on block " << bi->getId() );
 
-         // loop over all blocks
-         timing[sweepName].start();
-            (selectedSweep->function_)( bi.get() );
-         timing[sweepName].end();
+            // loop over all blocks
+            timing[sweepName].start();
+               (selectedSweep->function_)( bi.get() );
+            timing[sweepName].end();
+         }
       }
 
       // select and execute after functions
@@ -131,6 +167,111 @@ void SweepTimeloop::doTimeStep(const Set<SUID> &selectors, WcTimingPool &timing)
 
 
 
+void SweepTimeloop::executeOverlappingSweep( SweepAdder & s, const Set<SUID> &selectors )
+{
+   if( !s.sweep.empty() )
+      WALBERLA_ABORT("Selecting Sweep " << s.id_ << ": A Sweep and an OverlappingSweep must not be registered together!" );
+
+   std::string sweepName;
+   OverlappingSweep * selectedSweep = s.overlappingSweep.getUnique( selectors, sweepName );
+   if( !selectedSweep )
+      WALBERLA_ABORT("Selecting Sweep " << s.id_ << ": " <<
+                     "Ambiguous, or no overlapping sweep selected. Check your selector " <<
+                      selectors << std::endl << s.overlappingSweep);
+
+   WALBERLA_LOG_PROGRESS("Running overlapping sweep \"" << sweepName << "\"" );
+
+   (selectedSweep->startCommunication_)();
+   if( !overlapCommunication_ )
+      (selectedSweep->waitForCommunication_)();
+
+   for( BlockStorage::iterator bi = blockStorage_.begin(); bi != blockStorage_.end(); ++bi )
+      (selectedSweep->inner_)( bi.get() );
+
+   if( overlapCommunication_ )
+      (selectedSweep->waitForCommunication_)();
+
+   for( BlockStorage::iterator bi = blockStorage_.begin(); bi != blockStorage_.end(); ++bi )
+      (selectedSweep->frame_)( bi.get() );
+}
+
+void SweepTimeloop::executeOverlappingSweep( SweepAdder & s, const Set<SUID> &selectors, WcTimingPool &timing )
+{
+   if( !s.sweep.empty() )
+      WALBERLA_ABORT("Selecting Sweep " << s.id_ << ": A Sweep and an OverlappingSweep must not be registered together!" );
+
+   std::string sweepName;
+   OverlappingSweep * selectedSweep = s.overlappingSweep.getUnique( selectors, sweepName );
+   if( !selectedSweep )
+      WALBERLA_ABORT("Selecting Sweep " << s.id_ << ": " <<
+                     "Ambiguous, or no overlapping sweep selected. Check your selector " <<
+                      selectors << std::endl << s.overlappingSweep);
+
+   WALBERLA_LOG_PROGRESS("Running overlapping sweep \"" << sweepName << "\"" );
+
+   WcTimer & startTimer  = timing[ timerName( sweepName, StartCommunicationPart ) ];
+   WcTimer & innerTimer  = timing[ timerName( sweepName, InnerPart ) ];
+   WcTimer & waitTimer   = timing[ timerName( sweepName, WaitPart ) ];
+   WcTimer & frameTimer  = timing[ timerName( sweepName, FramePart ) ];
+   WcTimer & hiddenTimer = timing[ timerName( sweepName, HiddenCommunicationPart ) ];
+
+   startTimer.start();
+      (selectedSweep->startCommunication_)();
+   startTimer.end();
+
+   // without overlap, nothing happens between starting and waiting -> 'hidden' is (almost) zero
+   hiddenTimer.start();
+   if( overlapCommunication_ )
+   {
+      for( BlockStorage::iterator bi = blockStorage_.begin(); bi != blockStorage_.end(); ++bi )
+      {
+         innerTimer.start();
+            (selectedSweep->inner_)( bi.get() );
+         innerTimer.end();
+      }
+   }
+   hiddenTimer.end();
+
+   waitTimer.start();
+      (selectedSweep->waitForCommunication_)();
+   waitTimer.end();
+
+   if( !overlapCommunication_ )
+   {
+      for( BlockStorage::iterator bi = blockStorage_.begin(); bi != blockStorage_.end(); ++bi )
+      {
+         innerTimer.start();
+            (selectedSweep->inner_)( bi.get() );
+         innerTimer.end();
+      }
+   }
+
+   for( BlockStorage::iterator bi = blockStorage_.begin(); bi != blockStorage_.end(); ++bi )
+   {
+      frameTimer.start();
+         (selectedSweep->frame_)( bi.get() );
+      frameTimer.end();
+   }
+}
+
+
+
+double hiddenCommunicationFraction( const WcTimingPool & timing, const std::string & identifier )
+{
+   const std::string hiddenName = timerName( identifier, HiddenCommunicationPart );
+   const std::string waitName   = timerName( identifier, WaitPart );
+
+   if( !timing.timerExists( hiddenName ) || !timing.timerExists( waitName ) )
+      return 0.0;
+
+   const double hidden = timing[ hiddenName ].total();
+   const double total  = hidden + timing[ waitName ].total();
+
+   return ( total > 0.0 ) ? ( hidden / total ) : 0.0;
+}
+
+
+
 } // namespace timeloop
 } // namespace walberla
 
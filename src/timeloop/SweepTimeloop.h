@@ -109,6 +109,17 @@ namespace timeloop {
       timeloop.add() << SweepOnBlock<MyLBMClass>( MyLBMClassCreator(pdfFieldID) );
       \endcode
     *
+    * \section sweepTimeloop_overlap Overlapping Communication and Computation
+    *
+    * Instead of a Sweep, an OverlappingSweep can be registered. It consists of a function that starts the ghost layer
+    * communication, a function that waits for its completion, and a sweep that is split into an 'inner' and a 'frame'
+    * part (see OverlappingSweep). The 'inner' part is executed on all blocks while the messages are in flight.
+    * The overlap can be switched off with setCommunicationOverlap( false ) (communication is then completed before
+    * 'inner' is executed), e.g., for measuring its benefit.
+    * When running with a timing pool, the communication, 'inner', and 'frame' parts are timed separately. Additionally,
+    * the time spent between starting and waiting for the communication is recorded as "<identifier> (hidden
+    * communication)", see hiddenCommunicationFraction().
+    *
     * \ingroup timeloop
     */
    //*******************************************************************************************************************
@@ -121,12 +132,12 @@ namespace timeloop {
       //@{
 
       SweepTimeloop( BlockStorage & blockStorage, uint_t nrOfTimeSteps )
-         : Timeloop(nrOfTimeSteps), blockStorage_(blockStorage), nextId_(0),firstRun_(true)
+         : Timeloop(nrOfTimeSteps), blockStorage_(blockStorage), nextId_(0),firstRun_(true), overlapCommunication_(true)
       {}
 
       SweepTimeloop( const shared_ptr<StructuredBlockStorage> & structuredBlockStorage, uint_t nrOfTimeSteps )
          : Timeloop(nrOfTimeSteps), blockStorage_( structuredBlockStorage->getBlockStorage() ),
-           nextId_(0), firstRun_(true)
+           nextId_(0), firstRun_(true), overlapCommunication_(true)
       {}
 
       virtual ~SweepTimeloop()
@@ -154,6 +165,10 @@ namespace timeloop {
          sweepsToDelete_.push_back( sweep.id_ );
       }
 
+      /// if false, OverlappingSweeps wait for the communication to complete before the 'inner' part is executed
+      void setCommunicationOverlap( const bool overlap ) { overlapCommunication_ = overlap; }
+      bool communicationOverlap() const { return overlapCommunication_; }
+
       //@}
       //****************************************************************************************************************
 
@@ -169,14 +184,34 @@ namespace timeloop {
       virtual void doTimeStep(const Set<SUID> &selectors);
       virtual void doTimeStep(const Set<SUID> &selectors, WcTimingPool &tp);
 
+      void executeOverlappingSweep( SweepAdder & s, const Set<SUID> &selectors );
+      void executeOverlappingSweep( SweepAdder & s, const Set<SUID> &selectors, WcTimingPool &tp );
+
       uint_t nextId_;
       std::vector<uint_t> sweepsToDelete_;
       std::map< uint_t,SweepAdder* > sweeps_;
 
       bool firstRun_; ///< required to register timer in doTimeStep( selectors, timingPool)
+
+      bool overlapCommunication_;
    };
 
 
+
+   //*******************************************************************************************************************
+   /*!\brief Fraction of the communication time of an OverlappingSweep that was hidden behind the 'inner' part
+    *
+    * Computed from the timers of the OverlappingSweep 'identifier' as
+    *    hidden / ( hidden + wait )
+    * where 'hidden' is the time between starting the communication and waiting for it, and 'wait' is the time spent
+    * waiting. Since the communication may have completed before the 'inner' part finished, this is an upper bound
+    * (exact whenever the communication is still in flight when waiting starts). Returns zero if no such timers exist
+    * (or nothing was timed). Pass a reduced timing pool (see WcTimingPool::getReduced()) for a global value.
+    */
+   //*******************************************************************************************************************
+   double hiddenCommunicationFraction( const WcTimingPool & timing, const std::string & identifier );
+
+
 } // namespace timeloop
 } // namespace walberla
 
@@ -193,6 +228,7 @@ namespace walberla {
 
    using timeloop::Sweep;
    using timeloop::SweepOnBlock;
+   using timeloop::OverlappingSweep;
    using timeloop::BeforeFunction;
    using timeloop::AfterFunction;
 }
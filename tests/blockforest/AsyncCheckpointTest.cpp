@@ -0,0 +1,192 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file AsyncCheckpointTest.cpp
+//! \brief Checks that the asynchronous checkpoints are identical to the files written by saveToFile / saveBlockData
+//!        and contain the state at the time of the snapshot
+//
+//======================================================================================================================
+
+#include "blockforest/AsyncCheckpoint.h"
+#include "blockforest/SetupBlockForest.h"
+#include "blockforest/StructuredBlockForest.h"
+#include "blockforest/loadbalancing/StaticCurve.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Random.h"
+#include "core/mpi/Environment.h"
+
+#include "field/AddToStorage.h"
+#include "field/Field.h"
+
+#include <fstream>
+#include <iterator>
+
+
+namespace async_checkpoint_test {
+
+using namespace walberla;
+using walberla::uint8_t;
+
+typedef field::GhostLayerField<double, 2> FieldType;
+
+const SUID Empty( "empty" );
+const Set<SUID> None( Set<SUID>::emptySet() );
+
+static void refinementSelectionFunction( SetupBlockForest& forest )
+{
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+      if( block->getAABB().contains( Vector3<real_t>( real_t(75) ) ) )
+            if( !block->hasFather() )
+               block->setMarker( true );
+}
+
+static void workloadMemorySUIDAssignmentFunction( SetupBlockForest& forest )
+{
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+   {
+      block->setMemory( memory_t(1) );
+      block->setWorkload( workload_t(1) );
+      if( block->getAABB().contains( Vector3<real_t>( real_t(25) ) ) )
+         block->addState( Empty );
+   }
+}
+
+static void fill( StructuredBlockForest & sbf, const BlockDataID & fieldId, const double offset )
+{
+   for( auto it = sbf.begin( None, Empty ); it != sbf.end(); ++it )
+   {
+      auto field = it->getData< FieldType >( fieldId );
+      for( auto dataIt = field->begin(); dataIt != field->end(); ++dataIt )
+         *dataIt = offset + math::realRandom< FieldType::value_type >();
+   }
+}
+
+static void checkIdenticalFiles( const std::string & file, const std::string & reference )
+{
+   WALBERLA_ROOT_SECTION()
+   {
+      std::ifstream ifile( file.c_str(), std::ifstream::binary );
+      std::ifstream iref( reference.c_str(), std::ifstream::binary );
+      std::vector< char > data( ( std::istreambuf_iterator<char>( ifile ) ), std::istreambuf_iterator<char>() );
+      std::vector< char > ref( ( std::istreambuf_iterator<char>( iref ) ), std::istreambuf_iterator<char>() );
+
+      WALBERLA_CHECK_GREATER( ref.size(), 0 );
+      WALBERLA_CHECK_EQUAL( data.size(), ref.size(), "size of file \"" << file << "\" differs from \"" << reference << "\"" );
+      WALBERLA_CHECK( data == ref, "file \"" << file << "\" differs from \"" << reference << "\"" );
+   }
+}
+
+static void checkIdenticalFields( StructuredBlockForest & sbf, const BlockDataID & fieldId, const BlockDataID & referenceId )
+{
+   for( auto it = sbf.begin( None, Empty ); it != sbf.end(); ++it )
+   {
+      auto field     = it->getData< FieldType >( fieldId );
+      auto reference = it->getData< FieldType >( referenceId );
+
+      auto refIt = reference->begin();
+      for( auto dataIt = field->begin(); dataIt != field->end(); ++dataIt, ++refIt )
+         WALBERLA_CHECK_IDENTICAL( *dataIt, *refIt );
+   }
+}
+
+int main( int argc, char* argv[] )
+{
+   debug::enterTestMode();
+
+   mpi::Environment mpiEnv( argc, argv );
+
+   MPIManager::instance()->useWorldComm();
+
+   SetupBlockForest sforest;
+
+   sforest.addRefinementSelectionFunction( refinementSelectionFunction );
+   sforest.addWorkloadMemorySUIDAssignmentFunction( workloadMemorySUIDAssignmentFunction );
+
+   sforest.init( AABB( 0, 0, 0, 100, 100, 100 ), uint_t(2), uint_t(2), uint_t(2), true, false, false );
+
+   sforest.balanceLoad( blockforest::StaticLevelwiseCurveBalance(true), uint_c( MPIManager::instance()->numProcesses() ) );
+
+   auto sbf = make_shared<StructuredBlockForest>( make_shared< BlockForest >( uint_c( MPIManager::instance()->rank() ), sforest, true ),
+                                                  uint_t(10), uint_t(8), uint_t(14) );
+
+   auto dataHandling = make_shared< field::DefaultBlockDataHandling< FieldType > >( sbf, uint_t(1), 0.0, field::zyxf );
+   auto fieldId = sbf->addBlockData( dataHandling, "Field", None, Empty );
+
+   math::seedRandomGenerator( numeric_cast<std::mt19937::result_type>( MPIManager::instance()->rank() ) );
+
+   blockforest::AsyncCheckpoint checkpoint( sbf->getBlockForestPointer() );
+
+   // first checkpoint: the reference files are written synchronously at the time of the snapshot
+
+   fill( *sbf, fieldId, 0.0 );
+   sbf->getBlockForest().saveToFile( "async_checkpoint_reference.sbf" );
+   sbf->saveBlockData( "async_checkpoint_reference1.dat", fieldId );
+   sbf->getBlockForest().saveToFile( "async_checkpoint_reference_states.sbf", Set<SUID>( Empty ) );
+
+   checkpoint.saveToFile( "async_checkpoint.sbf" );
+   checkpoint.saveBlockData( "async_checkpoint1.dat", fieldId );
+   checkpoint.saveToFile( "async_checkpoint_states.sbf", Set<SUID>( Empty ) );
+   checkpoint.start();
+   WALBERLA_CHECK( checkpoint.isWriting() );
+
+   // the time stepping continues (and modifies the data) while the checkpoint is written, the next
+   // checkpoint is staged while the first one may still be in progress
+
+   fill( *sbf, fieldId, 1.0 );
+   checkpoint.test();
+   sbf->saveBlockData( "async_checkpoint_reference2.dat", fieldId );
+   checkpoint.saveBlockData( "async_checkpoint2.dat", fieldId );
+   fill( *sbf, fieldId, 2.0 );
+
+   checkpoint.start(); // completes the first checkpoint
+   WALBERLA_CHECK( checkpoint.isWriting() );
+   WALBERLA_CHECK_GREATER( checkpoint.getBytes(), 0 );
+   WALBERLA_CHECK_GREATER_EQUAL( checkpoint.getBandwidth(), 0.0 );
+   WALBERLA_CHECK_GREATER_EQUAL( checkpoint.getOverlapTime(), 0.0 );
+
+   fill( *sbf, fieldId, 3.0 );
+   while( !checkpoint.test() ) {}
+   checkpoint.wait();
+   WALBERLA_CHECK( !checkpoint.isWriting() );
+
+   WALBERLA_MPI_BARRIER()
+
+   checkIdenticalFiles( "async_checkpoint.sbf", "async_checkpoint_reference.sbf" );
+   checkIdenticalFiles( "async_checkpoint_states.sbf", "async_checkpoint_reference_states.sbf" );
+   checkIdenticalFiles( "async_checkpoint1.dat", "async_checkpoint_reference1.dat" );
+   checkIdenticalFiles( "async_checkpoint2.dat", "async_checkpoint_reference2.dat" );
+
+   // the checkpoints can be loaded with the usual functions
+
+   auto loaded1Id = sbf->loadBlockData( "async_checkpoint1.dat", dataHandling, "Loaded1", None, Empty );
+   auto loaded2Id = sbf->loadBlockData( "async_checkpoint2.dat", dataHandling, "Loaded2", None, Empty );
+   auto reference1Id = sbf->loadBlockData( "async_checkpoint_reference1.dat", dataHandling, "Reference1", None, Empty );
+   auto reference2Id = sbf->loadBlockData( "async_checkpoint_reference2.dat", dataHandling, "Reference2", None, Empty );
+   checkIdenticalFields( *sbf, loaded1Id, reference1Id );
+   checkIdenticalFields( *sbf, loaded2Id, reference2Id );
+
+   auto loadedForest = make_shared< BlockForest >( uint_c( MPIManager::instance()->rank() ), "async_checkpoint.sbf", true );
+   WALBERLA_CHECK_EQUAL( loadedForest->getNumberOfBlocks(), sbf->getBlockForest().getNumberOfBlocks() );
+
+   return EXIT_SUCCESS;
+}
+
+}
+
+int main( int argc, char* argv[] )
+{
+   return async_checkpoint_test::main( argc, argv );
+}
@@ -0,0 +1,240 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file ChunkedBlockDataIOTest.cpp
+//! \brief Checks the (compressed) chunked block data files, the data is loaded into a block forest with a different
+//!        distribution of the blocks to the processes
+//
+//======================================================================================================================
+
+#include "blockforest/SetupBlockForest.h"
+#include "blockforest/StructuredBlockForest.h"
+#include "blockforest/loadbalancing/StaticCurve.h"
+
+#include "core/Compression.h"
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Random.h"
+#include "core/mpi/Environment.h"
+
+#include "field/AddToStorage.h"
+#include "field/Field.h"
+
+#include <fstream>
+
+
+namespace chunked_block_data_io_test {
+
+using namespace walberla;
+using walberla::uint8_t;
+
+typedef field::GhostLayerField< double, 2 >  FieldType;
+typedef field::GhostLayerField< uint8_t, 1 > FlagFieldType;
+
+const SUID Empty( "empty" );
+const Set<SUID> None( Set<SUID>::emptySet() );
+
+static void refinementSelectionFunction( SetupBlockForest& forest )
+{
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+      if( block->getAABB().contains( Vector3<real_t>( real_t(75) ) ) )
+            if( !block->hasFather() )
+               block->setMarker( true );
+}
+
+static void workloadMemorySUIDAssignmentFunction( SetupBlockForest& forest )
+{
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+   {
+      block->setMemory( memory_t(1) );
+      block->setWorkload( workload_t(1) );
+      if( block->getAABB().contains( Vector3<real_t>( real_t(25) ) ) )
+         block->addState( Empty );
+   }
+}
+
+/// assigns the blocks to the processes in the reversed order of the curve
+static uint_t reversedCurveBalance( SetupBlockForest & forest, const uint_t numberOfProcesses, const memory_t perProcessMemoryLimit )
+{
+   const uint_t processes = blockforest::StaticLevelwiseCurveBalance( true )( forest, numberOfProcesses, perProcessMemoryLimit );
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+      block->assignTargetProcess( processes - uint_t(1) - block->getTargetProcess() );
+   return processes;
+}
+
+static shared_ptr< StructuredBlockForest > createBlockForest( const bool reversed )
+{
+   SetupBlockForest sforest;
+
+   sforest.addRefinementSelectionFunction( refinementSelectionFunction );
+   sforest.addWorkloadMemorySUIDAssignmentFunction( workloadMemorySUIDAssignmentFunction );
+
+   sforest.init( AABB( 0, 0, 0, 100, 100, 100 ), uint_t(2), uint_t(2), uint_t(2), true, false, false );
+
+   if( reversed )
+      sforest.balanceLoad( reversedCurveBalance, uint_c( MPIManager::instance()->numProcesses() ) );
+   else
+      sforest.balanceLoad( blockforest::StaticLevelwiseCurveBalance(true), uint_c( MPIManager::instance()->numProcesses() ) );
+
+   return make_shared<StructuredBlockForest>( make_shared< BlockForest >( uint_c( MPIManager::instance()->rank() ), sforest, true ),
+                                              uint_t(10), uint_t(8), uint_t(14) );
+}
+
+/// value of a cell that only depends on the block and the cell, not on the process
+static double value( const IBlock & block, const Cell & cell, const uint_t f )
+{
+   const real_t x = block.getAABB().xMin() + real_c( cell.x() );
+   const real_t y = block.getAABB().yMin() + real_c( cell.y() );
+   const real_t z = block.getAABB().zMin() + real_c( cell.z() );
+   return std::sin( double_c( x ) * 0.1 + double_c( f ) ) * std::cos( double_c( y ) * 0.2 ) + double_c( z ) * 1e-3;
+}
+
+static uint8_t flag( const Cell & cell )
+{
+   return ( cell.x() < cell_idx_t(1) || cell.z() > cell_idx_t(12) ) ? uint8_t(2) : uint8_t(1);
+}
+
+static void checkCompression()
+{
+   std::vector< uint8_t > data( uint_t(100000) );
+   for( uint_t i = 0; i != data.size(); ++i )
+      data[i] = ( i % uint_t(1000) < uint_t(900) ) ? uint8_t(0) : uint8_c( i % uint_t(7) );
+
+   std::vector< uint8_t > random( uint_t(100000) );
+   for( uint_t i = 0; i != random.size(); ++i )
+      random[i] = uint8_c( math::intRandom( 0, 255 ) );
+
+   for( uint_t size : { uint_t(0), uint_t(1), uint_t(3), uint_t(4), uint_t(17), uint_t(100000) } )
+   {
+      for( auto input : { &data, &random } )
+      {
+         std::vector< uint8_t > compressed( uint_t(3), uint8_t(42) ); // data is appended
+         const uint_t compressedSize = compress( &((*input)[0]), size, compressed );
+         WALBERLA_CHECK_EQUAL( compressedSize + uint_t(3), compressed.size() );
+
+         std::vector< uint8_t > decompressed( size + uint_t(1) );
+         decompress( &(compressed[3]), compressedSize, &(decompressed[0]), size );
+         for( uint_t i = 0; i != size; ++i )
+            WALBERLA_CHECK_EQUAL( decompressed[i], (*input)[i] );
+
+         if( input == &data && size == uint_t(100000) )
+            WALBERLA_CHECK_LESS( compressedSize, size / uint_t(20) );
+         if( input == &random )
+            WALBERLA_CHECK_LESS_EQUAL( compressedSize, size + size / uint_t(100) + uint_t(10) );
+      }
+   }
+}
+
+static uint_t fileSize( const std::string & file )
+{
+   std::ifstream ifile( file.c_str(), std::ifstream::binary | std::ifstream::ate );
+   return uint_c( static_cast< std::streamoff >( ifile.tellg() ) );
+}
+
+int main( int argc, char* argv[] )
+{
+   debug::enterTestMode();
+
+   mpi::Environment mpiEnv( argc, argv );
+
+   MPIManager::instance()->useWorldComm();
+
+   checkCompression();
+
+   auto sbf = createBlockForest( false );
+
+   auto dataHandling = make_shared< field::DefaultBlockDataHandling< FieldType > >( sbf, uint_t(2), 0.0, field::zyxf );
+   auto flagHandling = make_shared< field::DefaultBlockDataHandling< FlagFieldType > >( sbf, uint_t(1), uint8_t(0), field::zyxf );
+   auto fieldId = sbf->addBlockData( dataHandling, "Field", None, Empty );
+   auto flagId  = sbf->addBlockData( flagHandling, "Flags" );
+
+   for( auto it = sbf->begin(); it != sbf->end(); ++it )
+   {
+      auto flags = it->getData< FlagFieldType >( flagId );
+      for( auto dataIt = flags->begin(); dataIt != flags->end(); ++dataIt )
+         *dataIt = flag( dataIt.cell() );
+
+      if( it->getState().contains( Empty ) )
+         continue;
+
+      auto field = it->getData< FieldType >( fieldId );
+      for( auto dataIt = field->begin(); dataIt != field->end(); ++dataIt )
+         *dataIt = value( *it, dataIt.cell(), uint_c( dataIt.f() ) );
+   }
+
+   sbf->saveChunkedBlockData( "chunked_block_field.dat", fieldId, false );
+   sbf->saveChunkedBlockData( "chunked_block_field_compressed.dat", fieldId );
+   sbf->saveChunkedBlockData( "chunked_block_flags.dat", flagId );
+   sbf->saveChunkedBlockData( "chunked_block_flags_uncompressed.dat", flagId, false );
+
+   WALBERLA_MPI_BARRIER()
+
+   WALBERLA_ROOT_SECTION()
+   {
+      const uint_t fieldSize = fileSize( "chunked_block_field.dat" );
+      const uint_t flagSize  = fileSize( "chunked_block_flags_uncompressed.dat" );
+      const uint_t compressedFlagSize = fileSize( "chunked_block_flags.dat" );
+      WALBERLA_LOG_INFO( "field: " << fieldSize << " bytes (compressed: " << fileSize( "chunked_block_field_compressed.dat" ) << " bytes), " <<
+                         "flag field: " << flagSize << " bytes (compressed: " << compressedFlagSize << " bytes)" );
+      WALBERLA_CHECK_LESS_EQUAL( fileSize( "chunked_block_field_compressed.dat" ), fieldSize );
+      WALBERLA_CHECK_LESS( compressedFlagSize * uint_t(10), flagSize );
+   }
+
+   // the blocks are distributed differently when the data is loaded
+
+   auto reversed = createBlockForest( true );
+
+   auto loadedFieldHandling = make_shared< field::DefaultBlockDataHandling< FieldType > >( reversed, uint_t(2), 0.0, field::zyxf );
+   auto loadedFlagHandling  = make_shared< field::DefaultBlockDataHandling< FlagFieldType > >( reversed, uint_t(1), uint8_t(0), field::zyxf );
+
+   std::vector< BlockDataID > loadedFieldIds;
+   loadedFieldIds.push_back( reversed->loadChunkedBlockData( "chunked_block_field.dat", loadedFieldHandling, "Field", None, Empty ) );
+   loadedFieldIds.push_back( reversed->loadChunkedBlockData( "chunked_block_field_compressed.dat", loadedFieldHandling, "Compressed field", None, Empty ) );
+   std::vector< BlockDataID > loadedFlagIds;
+   loadedFlagIds.push_back( reversed->loadChunkedBlockData( "chunked_block_flags.dat", loadedFlagHandling, "Flags" ) );
+   loadedFlagIds.push_back( reversed->loadChunkedBlockData( "chunked_block_flags_uncompressed.dat", loadedFlagHandling, "Uncompressed flags" ) );
+
+   for( auto it = reversed->begin(); it != reversed->end(); ++it )
+   {
+      for( auto id = loadedFlagIds.begin(); id != loadedFlagIds.end(); ++id )
+      {
+         auto flags = it->getData< FlagFieldType >( *id );
+         for( auto dataIt = flags->begin(); dataIt != flags->end(); ++dataIt )
+            WALBERLA_CHECK_EQUAL( *dataIt, flag( dataIt.cell() ) );
+      }
+
+      if( it->getState().contains( Empty ) )
+      {
+         for( auto id = loadedFieldIds.begin(); id != loadedFieldIds.end(); ++id )
+            WALBERLA_CHECK( !it->isBlockDataAllocated( *id ) );
+         continue;
+      }
+
+      for( auto id = loadedFieldIds.begin(); id != loadedFieldIds.end(); ++id )
+      {
+         auto field = it->getData< FieldType >( *id );
+         for( auto dataIt = field->begin(); dataIt != field->end(); ++dataIt )
+            WALBERLA_CHECK_IDENTICAL( *dataIt, value( *it, dataIt.cell(), uint_c( dataIt.f() ) ) );
+      }
+   }
+
+   return EXIT_SUCCESS;
+}
+
+}
+
+int main( int argc, char* argv[] )
+{
+   return chunked_block_data_io_test::main( argc, argv );
+}
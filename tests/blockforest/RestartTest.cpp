@@ -0,0 +1,229 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file RestartTest.cpp
+//! \brief Saves a block forest and its block data on N processes ("save") and restarts it on M processes
+//!        ("load <N>"), the restarted block structure must match the structure that was saved
+//
+//======================================================================================================================
+
+#include "blockforest/Initialization.h"
+#include "blockforest/SetupBlockForest.h"
+#include "blockforest/StructuredBlockForest.h"
+#include "blockforest/loadbalancing/StaticCurve.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/mpi/Environment.h"
+#include "core/mpi/Reduce.h"
+
+#include "field/AddToStorage.h"
+#include "field/Field.h"
+
+#include <boost/lexical_cast.hpp>
+
+
+namespace restart_test {
+
+using namespace walberla;
+using walberla::uint8_t;
+
+typedef field::GhostLayerField< double, 2 >  FieldType;
+typedef field::GhostLayerField< uint8_t, 1 > FlagFieldType;
+
+const SUID Empty( "empty" );
+const Set<SUID> None( Set<SUID>::emptySet() );
+
+static void rootBlockExclusionFunction( std::vector< uint8_t > & excludeBlock, const SetupBlockForest::RootBlockAABB & aabb )
+{
+   for( uint_t i = 0; i != excludeBlock.size(); ++i )
+      if( aabb( i ).contains( Vector3<real_t>( real_t(125), real_t(75), real_t(75) ) ) )
+         excludeBlock[i] = uint8_t(1);
+}
+
+static void refinementSelectionFunction( SetupBlockForest& forest )
+{
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+      if( block->getAABB().contains( Vector3<real_t>( real_t(60) ) ) && block->getLevel() < uint_t(2) )
+         block->setMarker( true );
+}
+
+static void workloadMemorySUIDAssignmentFunction( SetupBlockForest& forest )
+{
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+   {
+      block->setMemory( memory_t(1) );
+      block->setWorkload( workload_t(1) );
+      if( block->getAABB().contains( Vector3<real_t>( real_t(25) ) ) )
+         block->addState( Empty );
+   }
+}
+
+/// assigns the blocks to the processes in the reversed order of the curve (differs from the default of the restart)
+static uint_t reversedCurveBalance( SetupBlockForest & forest, const uint_t numberOfProcesses, const memory_t perProcessMemoryLimit )
+{
+   const uint_t processes = blockforest::StaticLevelwiseCurveBalance( true )( forest, numberOfProcesses, perProcessMemoryLimit );
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+      block->assignTargetProcess( processes - uint_t(1) - block->getTargetProcess() );
+   return processes;
+}
+
+static void createSetupBlockForest( SetupBlockForest & sforest, const bool reversed )
+{
+   sforest.addRootBlockExclusionFunction( rootBlockExclusionFunction );
+   sforest.addRefinementSelectionFunction( refinementSelectionFunction );
+   sforest.addWorkloadMemorySUIDAssignmentFunction( workloadMemorySUIDAssignmentFunction );
+
+   sforest.init( AABB( 0, 0, 0, 150, 100, 100 ), uint_t(3), uint_t(2), uint_t(2), true, false, false );
+
+   if( reversed )
+      sforest.balanceLoad( reversedCurveBalance, uint_c( MPIManager::instance()->numProcesses() ) );
+   else
+      sforest.balanceLoad( blockforest::StaticLevelwiseCurveBalance( true ), uint_c( MPIManager::instance()->numProcesses() ) );
+}
+
+/// value of a cell that only depends on the block and the cell, not on the process
+static double value( const IBlock & block, const Cell & cell, const uint_t f )
+{
+   const real_t x = block.getAABB().xMin() + real_c( cell.x() );
+   const real_t y = block.getAABB().yMin() + real_c( cell.y() );
+   const real_t z = block.getAABB().zMin() + real_c( cell.z() );
+   return std::sin( double_c( x ) * 0.1 + double_c( f ) ) * std::cos( double_c( y ) * 0.2 ) + double_c( z ) * 1e-3;
+}
+
+static uint8_t flag( const IBlock & block, const Cell & cell )
+{
+   return ( cell.x() < cell_idx_t(1) || block.getAABB().zMin() > real_t(50) ) ? uint8_t(2) : uint8_t(1);
+}
+
+static std::string filename( const std::string & file, const uint_t processes )
+{
+   return "restart_" + std::to_string( processes ) + "_" + file;
+}
+
+static void save()
+{
+   const uint_t processes = uint_c( MPIManager::instance()->numProcesses() );
+
+   SetupBlockForest sforest;
+   createSetupBlockForest( sforest, true );
+
+   auto sbf = make_shared< StructuredBlockForest >( make_shared< BlockForest >( uint_c( MPIManager::instance()->rank() ), sforest, false ),
+                                                    uint_t(10), uint_t(8), uint_t(14) );
+
+   auto fieldHandling = make_shared< field::DefaultBlockDataHandling< FieldType > >( sbf, uint_t(2), 0.0, field::zyxf );
+   auto flagHandling  = make_shared< field::DefaultBlockDataHandling< FlagFieldType > >( sbf, uint_t(1), uint8_t(0), field::zyxf );
+   auto fieldId = sbf->addBlockData( fieldHandling, "Field", None, Empty );
+   auto flagId  = sbf->addBlockData( flagHandling, "Flags" );
+
+   for( auto it = sbf->begin(); it != sbf->end(); ++it )
+   {
+      auto flags = it->getData< FlagFieldType >( flagId );
+      for( auto dataIt = flags->begin(); dataIt != flags->end(); ++dataIt )
+         *dataIt = flag( *it, dataIt.cell() );
+
+      if( it->getState().contains( Empty ) )
+         continue;
+
+      auto field = it->getData< FieldType >( fieldId );
+      for( auto dataIt = field->begin(); dataIt != field->end(); ++dataIt )
+         *dataIt = value( *it, dataIt.cell(), uint_c( dataIt.f() ) );
+   }
+
+   sbf->getBlockForest().saveToFile( filename( "forest.sbf", processes ) );
+   sbf->saveChunkedBlockData( filename( "field.dat", processes ), fieldId );
+   sbf->saveChunkedBlockData( filename( "flags.dat", processes ), flagId );
+}
+
+static void load( const uint_t savedProcesses )
+{
+   const uint_t processes = uint_c( MPIManager::instance()->numProcesses() );
+   const uint_t rank = uint_c( MPIManager::instance()->rank() );
+
+   auto forest = blockforest::createBlockForestFromFile( filename( "forest.sbf", savedProcesses ), true );
+
+   // reference: the same block structure, with the saved assignment if the number of processes did not change and
+   // the default space filling curve otherwise
+
+   SetupBlockForest sforest;
+   createSetupBlockForest( sforest, processes == savedProcesses );
+
+   WALBERLA_CHECK_EQUAL( mpi::allReduce( forest->getNumberOfBlocks(), mpi::SUM ), sforest.getNumberOfBlocks() );
+   WALBERLA_CHECK_EQUAL( forest->getDepth(), sforest.getDepth() );
+
+   std::vector< const SetupBlock * > referenceBlocks;
+   sforest.getProcessSpecificBlocks( referenceBlocks, rank );
+   WALBERLA_CHECK_EQUAL( forest->getNumberOfBlocks(), referenceBlocks.size() );
+
+   for( auto reference = referenceBlocks.begin(); reference != referenceBlocks.end(); ++reference )
+   {
+      const IBlock * block = forest->getBlock( (*reference)->getId() );
+      WALBERLA_CHECK_NOT_NULLPTR( block, "Block " << (*reference)->getId() << " is missing on process " << rank );
+      WALBERLA_CHECK_EQUAL( block->getAABB(), (*reference)->getAABB() );
+      WALBERLA_CHECK_EQUAL( block->getState(), (*reference)->getState() );
+   }
+
+   // block data: every process only reads the chunks of its own blocks
+
+   auto sbf = make_shared< StructuredBlockForest >( forest, uint_t(10), uint_t(8), uint_t(14) );
+
+   auto fieldHandling = make_shared< field::DefaultBlockDataHandling< FieldType > >( sbf, uint_t(2), 0.0, field::zyxf );
+   auto flagHandling  = make_shared< field::DefaultBlockDataHandling< FlagFieldType > >( sbf, uint_t(1), uint8_t(0), field::zyxf );
+   auto fieldId = sbf->loadChunkedBlockData( filename( "field.dat", savedProcesses ), fieldHandling, "Field", None, Empty );
+   auto flagId  = sbf->loadChunkedBlockData( filename( "flags.dat", savedProcesses ), flagHandling, "Flags" );
+
+   for( auto it = sbf->begin(); it != sbf->end(); ++it )
+   {
+      auto flags = it->getData< FlagFieldType >( flagId );
+      for( auto dataIt = flags->begin(); dataIt != flags->end(); ++dataIt )
+         WALBERLA_CHECK_EQUAL( *dataIt, flag( *it, dataIt.cell() ) );
+
+      if( it->getState().contains( Empty ) )
+      {
+         WALBERLA_CHECK( !it->isBlockDataAllocated( fieldId ) );
+         continue;
+      }
+
+      auto field = it->getData< FieldType >( fieldId );
+      for( auto dataIt = field->begin(); dataIt != field->end(); ++dataIt )
+         WALBERLA_CHECK_IDENTICAL( *dataIt, value( *it, dataIt.cell(), uint_c( dataIt.f() ) ) );
+   }
+}
+
+int main( int argc, char* argv[] )
+{
+   debug::enterTestMode();
+
+   mpi::Environment mpiEnv( argc, argv );
+
+   MPIManager::instance()->useWorldComm();
+
+   std::vector<std::string> args( argv, argv + argc );
+
+   if( args.size() == 2 && args[1] == "save" )
+      save();
+   else if( args.size() == 3 && args[1] == "load" )
+      load( boost::lexical_cast<uint_t>( args[2] ) );
+   else
+      WALBERLA_ABORT( "USAGE:\n\n" << args[0] << " save\n" << args[0] << " load <NUMBER_OF_PROCESSES_OF_THE_SAVED_RUN>" );
+
+   return EXIT_SUCCESS;
+}
+
+}
+
+int main( int argc, char* argv[] )
+{
+   return restart_test::main( argc, argv );
+}
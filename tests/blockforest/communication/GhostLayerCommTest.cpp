@@ -22,6 +22,7 @@
 
 #include "blockforest/Initialization.h"
 #include "blockforest/communication/UniformBufferedScheme.h"
+#include "blockforest/communication/UniformDirectScheme.h"
 
 #include "core/DataTypes.h"
 #include "core/debug/Debug.h"
@@ -32,11 +33,14 @@
 
 #include "field/AddToStorage.h"
 #include "field/communication/PackInfo.h"
+#include "field/communication/UniformMPIDatatypeInfo.h"
 
 #include "stencil/D3Q19.h"
 
 #include "timeloop/SweepTimeloop.h"
 
+#include <cstring>
+#include <functional>
 #include <iostream>
 
 
@@ -253,11 +257,32 @@ int main(int argc, char **argv)
    timeLoop.add() << Sweep ( CompareSweep(srcField, srcFieldGlb) );
 
 
-   // small local fields
-   blockforest::communication::UniformBufferedScheme<stencil::D3Q19> scheme(blocks);
-   scheme.addPackInfo( make_shared<field::communication::PackInfo< PdfField > >(srcField) );
+   // small local fields: buffered communication (default), or bufferless communication with MPI datatypes
+   // ("--direct-comm": one message per block and direction, "--neighbor-comm": one MPI-3 neighborhood collective)
+   bool directComm   = false;
+   bool neighborComm = false;
+   for( int i = 1; i < argc; ++i )
+   {
+      if( std::strcmp( argv[i], "--direct-comm" )   == 0 ) directComm = true;
+      if( std::strcmp( argv[i], "--neighbor-comm" ) == 0 ) directComm = neighborComm = true;
+   }
+
+   std::function< void () > commFunction;
+   if( directComm )
+   {
+      blockforest::communication::UniformDirectScheme<stencil::D3Q19> scheme(blocks);
+      scheme.addDataToCommunicate( make_shared<field::communication::UniformMPIDatatypeInfo< PdfField > >(srcField) );
+      scheme.useNeighborCollectives( neighborComm );
+      commFunction = scheme;
+   }
+   else
+   {
+      blockforest::communication::UniformBufferedScheme<stencil::D3Q19> scheme(blocks);
+      scheme.addPackInfo( make_shared<field::communication::PackInfo< PdfField > >(srcField) );
+      commFunction = scheme;
+   }
 
-   timeLoop.add() << BeforeFunction( scheme )
+   timeLoop.add() << BeforeFunction( commFunction )
                   << Sweep ( StreamingSweep<stencil::D3Q19>( srcField, dstField ) );
 
    // big global fields
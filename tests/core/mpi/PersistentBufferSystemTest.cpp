@@ -0,0 +1,250 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file PersistentBufferSystemTest.cpp
+//! \ingroup core
+//! \brief Compares BufferSystem communication with persistent MPI requests to the default (MPI_Isend/MPI_Irecv) mode
+//
+//======================================================================================================================
+
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/mpi/BufferSystem.h"
+#include "core/mpi/Environment.h"
+#include "core/mpi/MPIManager.h"
+#include "core/timing/Timer.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+
+using namespace walberla;
+using mpi::BufferSystem;
+using mpi::MPIRank;
+
+
+
+/// periodic 1D neighborhood (contains only the own rank if executed on one process)
+std::set< MPIRank > neighbors()
+{
+   const int numProcesses = MPIManager::instance()->numProcesses();
+   const int rank         = MPIManager::instance()->worldRank();
+
+   std::set< MPIRank > result;
+   result.insert( ( rank - 1 + numProcesses ) % numProcesses );
+   result.insert( ( rank + 1 ) % numProcesses );
+   return result;
+}
+
+
+
+/// content of the message that is sent from 'sender' to 'receiver' in step 'step'
+double value( const MPIRank sender, const MPIRank receiver, const uint_t step, const uint_t i )
+{
+   return double( sender ) * 1000.0 + double( receiver ) + double( step ) * 0.25 + double( i ) * 1e-3;
+}
+
+
+
+/// executes one communication step and returns all received values (per sender rank)
+std::map< MPIRank, std::vector< double > > communicate( BufferSystem & bs, const uint_t step, const uint_t messageSize )
+{
+   const MPIRank rank = MPIManager::instance()->worldRank();
+   const std::set< MPIRank > ranks = neighbors();
+
+   for( auto receiver = ranks.begin(); receiver != ranks.end(); ++receiver )
+      for( uint_t i = 0; i < messageSize; ++i )
+         bs.sendBuffer( *receiver ) << value( rank, *receiver, step, i );
+
+   bs.sendAll();
+
+   std::map< MPIRank, std::vector< double > > received;
+   for( auto it = bs.begin(); it != bs.end(); ++it )
+   {
+      WALBERLA_CHECK_EQUAL( ranks.count( it.rank() ), uint_t(1) );
+      std::vector< double > & values = received[ it.rank() ];
+      while( !it.buffer().isEmpty() )
+      {
+         double v;
+         it.buffer() >> v;
+         values.push_back( v );
+      }
+   }
+   WALBERLA_CHECK_EQUAL( received.size(), ranks.size() );
+   return received;
+}
+
+
+
+/// both buffer systems are used for the same communication pattern, the received messages must be identical
+void compareWithDefaultMode()
+{
+   const MPIRank rank = MPIManager::instance()->worldRank();
+   const std::set< MPIRank > ranks = neighbors();
+
+   BufferSystem reference ( MPI_COMM_WORLD, 0 );
+   BufferSystem persistent( MPI_COMM_WORLD, 1 );
+   persistent.usePersistentRequests( true );
+
+   WALBERLA_CHECK( !reference.usesPersistentRequests() );
+   WALBERLA_CHECK(  persistent.usesPersistentRequests() );
+
+   reference.setReceiverInfo ( ranks, false );
+   persistent.setReceiverInfo( ranks, false );
+
+   uint_t messageSize = uint_t(17);
+   uint_t setups = uint_t(0);
+
+   for( uint_t step = 0; step < uint_t(20); ++step )
+   {
+      if( step == uint_t(10) ) // message size changes once -> requests have to be created again
+      {
+         messageSize = uint_t(1000);
+         reference.sizeHasChanged();
+         persistent.sizeHasChanged();
+      }
+
+      const bool sizeCommunicated = persistent.isSizeCommunicatedInNextStep();
+      WALBERLA_CHECK_EQUAL( sizeCommunicated, reference.isSizeCommunicatedInNextStep() );
+
+      const auto expected = communicate( reference, step, messageSize );
+      const auto actual   = communicate( persistent, step, messageSize );
+
+      WALBERLA_CHECK( expected == actual, "Received messages differ in step " << step );
+      for( auto sender = actual.begin(); sender != actual.end(); ++sender )
+      {
+         WALBERLA_CHECK_EQUAL( sender->second.size(), messageSize );
+         for( uint_t i = 0; i < messageSize; ++i )
+            WALBERLA_CHECK_IDENTICAL( sender->second[i], value( sender->first, rank, step, i ) );
+      }
+
+      if( sizeCommunicated )
+      {
+         // sizes are exchanged with MPI_Isend/MPI_Irecv, persistent requests are not touched
+         WALBERLA_CHECK_EQUAL( persistent.persistentRequestSetups(), setups );
+      }
+      else if( step == uint_t(1) || step == uint_t(11) )
+      {
+         // first step with known sizes (after a size change): one send and one receive request per neighbor
+         WALBERLA_CHECK_EQUAL( persistent.persistentRequestSetups(), setups + uint_t(2) * ranks.size() );
+         setups = persistent.persistentRequestSetups();
+      }
+      else
+      {
+         // requests are reused
+         WALBERLA_CHECK_EQUAL( persistent.persistentRequestSetups(), setups );
+      }
+   }
+
+   WALBERLA_CHECK_EQUAL( reference.persistentRequestSetups(), uint_t(0) );
+
+   // switching back to the default mode during the lifetime of the buffer system
+   persistent.usePersistentRequests( false );
+   const auto expected = communicate( reference, uint_t(20), messageSize );
+   const auto actual   = communicate( persistent, uint_t(20), messageSize );
+   WALBERLA_CHECK( expected == actual );
+
+   // copies keep the communication mode
+   BufferSystem copy( persistent );
+   WALBERLA_CHECK( !copy.usesPersistentRequests() );
+   persistent.usePersistentRequests( true );
+   copy = persistent;
+   WALBERLA_CHECK( copy.usesPersistentRequests() );
+}
+
+
+
+/// after the communication partners change, the send requests of the previous receivers are freed
+void changePartners()
+{
+   const int numProcesses = MPIManager::instance()->numProcesses();
+   const MPIRank rank     = MPIManager::instance()->worldRank();
+   const MPIRank left     = ( rank - 1 + numProcesses ) % numProcesses;
+   const MPIRank right    = ( rank + 1 ) % numProcesses;
+
+   BufferSystem bs( MPI_COMM_WORLD, 3 );
+   bs.usePersistentRequests( true );
+   bs.setReceiverInfo( neighbors(), false );
+
+   for( uint_t step = 0; step < uint_t(3); ++step )
+      communicate( bs, step, uint_t(8) );
+   WALBERLA_CHECK_EQUAL( bs.persistentSendRequests(), neighbors().size() );
+
+   // from now on, messages are only sent to the right neighbor (and received from the left neighbor)
+   std::set< MPIRank > senders;
+   senders.insert( left );
+   bs.setReceiverInfo( senders, false );
+
+   for( uint_t step = 3; step < uint_t(6); ++step )
+   {
+      bs.sendBuffer( right ) << value( rank, right, step, uint_t(0) );
+      bs.sendAll();
+
+      uint_t messages = uint_t(0);
+      for( auto it = bs.begin(); it != bs.end(); ++it )
+      {
+         WALBERLA_CHECK_EQUAL( it.rank(), left );
+         double v;
+         it.buffer() >> v;
+         WALBERLA_CHECK_IDENTICAL( v, value( left, rank, step, uint_t(0) ) );
+         ++messages;
+      }
+      WALBERLA_CHECK_EQUAL( messages, uint_t(1) );
+   }
+   WALBERLA_CHECK_EQUAL( bs.persistentSendRequests(), uint_t(1) );
+}
+
+
+
+/// small messages with constant size: time per communication step with and without persistent requests
+void measureStepTime( const uint_t steps )
+{
+   for( int usePersistent = 0; usePersistent <= 1; ++usePersistent )
+   {
+      BufferSystem bs( MPI_COMM_WORLD, 2 );
+      bs.usePersistentRequests( usePersistent == 1 );
+      bs.setReceiverInfo( neighbors(), false );
+
+      communicate( bs, uint_t(0), uint_t(8) ); // size exchange
+
+      WcTimer timer;
+      WALBERLA_MPI_WORLD_BARRIER();
+      timer.start();
+      for( uint_t step = 1; step <= steps; ++step )
+         communicate( bs, step, uint_t(8) );
+      timer.end();
+
+      WALBERLA_LOG_INFO_ON_ROOT( ( usePersistent == 1 ? "persistent requests: " : "MPI_Isend/MPI_Irecv: " )
+                                 << ( 1e6 * timer.last() / double( steps ) ) << " us per communication step" );
+   }
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment mpiEnv( argc, argv );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "Comparing persistent requests with the default communication mode..." );
+   compareWithDefaultMode();
+   changePartners();
+
+   measureStepTime( uint_t(1000) );
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file FieldAllocationBenchmark.cpp
+//! \ingroup field
+//! \brief Allocates, (shallow) copies, and destroys fields concurrently from all OpenMP threads and checks the
+//!        reference counting of the field allocators
+//
+//======================================================================================================================
+
+#include "field/GhostLayerField.h"
+
+#include "core/DataTypes.h"
+#include "core/OpenMP.h"
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/timing/Timer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+
+using namespace walberla;
+
+
+/// element type that counts its constructor and destructor calls (from all threads)
+struct Counted
+{
+   Counted()  { constructorCalls.fetch_add( uint_t(1), std::memory_order_relaxed ); }
+   ~Counted() { destructorCalls.fetch_add( uint_t(1), std::memory_order_relaxed ); }
+
+   static std::atomic< uint_t > constructorCalls;
+   static std::atomic< uint_t > destructorCalls;
+};
+std::atomic< uint_t > Counted::constructorCalls( uint_t(0) );
+std::atomic< uint_t > Counted::destructorCalls( uint_t(0) );
+
+
+
+/// element type with an alignment requirement larger than the alignment guaranteed by 'new' and by the allocation header
+struct alignas(128) OverAligned
+{
+   double value;
+};
+
+
+
+/// every element of a field of over-aligned elements must be properly aligned, including the ghost layers
+void testOverAlignedElements()
+{
+   auto allocator = make_shared< field::StdFieldAlloc< OverAligned > >();
+   for( uint_t size = uint_t(1); size < uint_t(5); ++size )
+   {
+      GhostLayerField< OverAligned, 1 > field( size, size, size, uint_t(1), field::fzyx, allocator );
+      for( auto it = field.beginWithGhostLayer(); it != field.end(); ++it )
+         WALBERLA_CHECK_EQUAL( reinterpret_cast< std::uintptr_t >( &(*it) ) % alignof( OverAligned ), std::uintptr_t(0) );
+   }
+}
+
+
+
+int numberOfThreads()
+{
+#ifdef _OPENMP
+   return omp_get_max_threads();
+#else
+   return 1;
+#endif
+}
+
+
+
+/// In every iteration, every thread allocates a field, creates two shallow copies and one deep copy, and destroys all
+/// of them again. All threads share the same allocator object.
+template< typename T, uint_t fSize >
+void benchmark( const shared_ptr< field::FieldAllocator<T> > & allocator, const uint_t iterations, const uint_t size,
+                const std::string & name )
+{
+   typedef GhostLayerField< T, fSize > Field_T;
+
+   WcTimer timer;
+   timer.start();
+
+   #ifdef _OPENMP
+   #pragma omp parallel
+   #endif
+   {
+      for( uint_t i = 0; i < iterations; ++i )
+      {
+         Field_T * field = new Field_T( size, size, size, uint_t(1), field::fzyx, allocator );
+         WALBERLA_CHECK_EQUAL( allocator->referenceCount( field->data() ), uint_t(1) );
+
+         Field_T * shallowCopy0 = field->cloneShallowCopy();
+         Field_T * shallowCopy1 = shallowCopy0->cloneShallowCopy();
+         WALBERLA_CHECK_EQUAL( allocator->referenceCount( field->data() ), uint_t(3) );
+
+         Field_T * deepCopy = field->cloneUninitialized();
+         WALBERLA_CHECK_EQUAL( allocator->referenceCount( deepCopy->data() ), uint_t(1) );
+
+         delete field;
+         WALBERLA_CHECK_EQUAL( allocator->referenceCount( shallowCopy1->data() ), uint_t(2) );
+         delete shallowCopy0;
+         WALBERLA_CHECK_EQUAL( allocator->referenceCount( shallowCopy1->data() ), uint_t(1) );
+         delete shallowCopy1;
+         delete deepCopy;
+      }
+   }
+
+   timer.end();
+
+   const double allocations = double( numberOfThreads() ) * double( iterations ) * 2.0;
+   WALBERLA_LOG_INFO( name << ": " << numberOfThreads() << " thread(s), " << iterations << " iterations per thread, "
+                      << timer.last() << " s (" << ( allocations / timer.last() ) << " allocations + deallocations per second)" );
+}
+
+
+
+template< typename Allocator_T >
+void testConstructorCalls( const uint_t iterations, const std::string & name )
+{
+   const uint_t calls = Counted::constructorCalls.load();
+   WALBERLA_CHECK_EQUAL( calls, Counted::destructorCalls.load() );
+
+   benchmark< Counted, 2 >( make_shared< Allocator_T >(), iterations, uint_t(3), name );
+
+   // every constructed element was destroyed exactly once, although the elements were created by different threads
+   WALBERLA_CHECK_GREATER( Counted::constructorCalls.load(), calls );
+   WALBERLA_CHECK_EQUAL( Counted::constructorCalls.load(), Counted::destructorCalls.load() );
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   const uint_t iterations = ( argc > 1 ) ? uint_c( std::atoi( argv[1] ) ) : uint_t(2000);
+
+   benchmark< real_t, 19 >( make_shared< field::AllocateAligned< real_t, 32 > >(), iterations, uint_t(8), "AllocateAligned<real_t,32>, 8^3 x 19" );
+   benchmark< real_t, 19 >( make_shared< field::StdFieldAlloc< real_t > >(), iterations, uint_t(8), "StdFieldAlloc<real_t>, 8^3 x 19" );
+   benchmark< uint8_t, 1 >( make_shared< field::AllocateAligned< uint8_t, 64 > >(), iterations, uint_t(5), "AllocateAligned<uint8_t,64>, 5^3" );
+
+   testConstructorCalls< field::AllocateAligned< Counted, 32 > >( iterations, "AllocateAligned<Counted,32>, 3^3 x 2" );
+   testConstructorCalls< field::StdFieldAlloc< Counted > >( iterations, "StdFieldAlloc<Counted>, 3^3 x 2" );
+
+   testOverAlignedElements();
+
+   return EXIT_SUCCESS;
+}
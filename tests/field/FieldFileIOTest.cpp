@@ -35,6 +35,9 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <fstream>
+#include <iterator>
+
 
 namespace mpi_file_io_test {
    
@@ -67,6 +70,38 @@ static void workloadMemorySUIDAssignmentFunction( SetupBlockForest& forest )
 }
 
 
+template< typename FieldType >
+static void checkIdenticalFields( StructuredBlockForest & sbf, const BlockDataID & originalFieldId, const BlockDataID & readFieldId )
+{
+   for( auto it = sbf.begin(); it != sbf.end(); ++it )
+   {
+      auto originalField = it->getData< FieldType >( originalFieldId );
+      auto readField     = it->getData< FieldType >( readFieldId );
+
+      auto readIt = readField->begin();
+      for( auto origIt = originalField->begin(); origIt != originalField->end(); ++origIt, ++readIt )
+         WALBERLA_CHECK_IDENTICAL( *origIt, *readIt );
+   }
+}
+
+
+
+static void checkIdenticalFiles( const std::string & file, const std::string & reference )
+{
+   WALBERLA_ROOT_SECTION()
+   {
+      std::ifstream ifile( file.c_str(), std::ifstream::binary );
+      std::ifstream iref( reference.c_str(), std::ifstream::binary );
+      std::vector< char > data( ( std::istreambuf_iterator<char>( ifile ) ), std::istreambuf_iterator<char>() );
+      std::vector< char > ref( ( std::istreambuf_iterator<char>( iref ) ), std::istreambuf_iterator<char>() );
+
+      WALBERLA_CHECK_EQUAL( data.size(), ref.size(), "size of file \"" << file << "\" differs from \"" << reference << "\"" );
+      WALBERLA_CHECK( data == ref, "file \"" << file << "\" differs from \"" << reference << "\"" );
+   }
+}
+
+
+
 int main( int argc, char* argv[] )
 {
    typedef field::GhostLayerField<double, 3> FieldType;
@@ -83,17 +118,20 @@ int main( int argc, char* argv[] )
    uint_t xBlockSize = 3;
    uint_t yBlockSize = 5;
    uint_t zBlockSize = 7;
+   uint_t aggregators = 0;
    
-   if( args.size() == 5 )
+   if( args.size() == 5 || args.size() == 6 )
    {
       numBlocks  = boost::lexical_cast<uint_t>( args[1] );
       xBlockSize = boost::lexical_cast<uint_t>( args[2] );
       yBlockSize = boost::lexical_cast<uint_t>( args[3] );
       zBlockSize = boost::lexical_cast<uint_t>( args[4] );
+      if( args.size() == 6 )
+         aggregators = boost::lexical_cast<uint_t>( args[5] );
    }
-   else if( args.size() > 5 )
+   else if( args.size() > 6 )
    {
-      WALBERLA_ABORT( "USAGE:\n\n" << args[0] << " <NUMBER_OF_COARSE_BLOCKS> <X_BLOCK_SIZE> <Y_BLOCK_SIZE> <Z_BLOCK_SIZE>" );
+      WALBERLA_ABORT( "USAGE:\n\n" << args[0] << " <NUMBER_OF_COARSE_BLOCKS> <X_BLOCK_SIZE> <Y_BLOCK_SIZE> <Z_BLOCK_SIZE> [<AGGREGATORS>]" );
    }
 
    SetupBlockForest sforest;
@@ -113,6 +151,9 @@ int main( int argc, char* argv[] )
 
    auto originalFieldId = field::addToStorage< FieldType >( sbf, "OriginalField" );
    auto readFieldId     = field::addToStorage< FieldType >( sbf, "ReadField" );
+   auto collectiveReadFieldId = field::addToStorage< FieldType >( sbf, "CollectiveReadField" );
+   auto roundsReadFieldId     = field::addToStorage< FieldType >( sbf, "RoundsReadField" );
+   auto mixedReadFieldId      = field::addToStorage< FieldType >( sbf, "MixedReadField" );
 
    math::seedRandomGenerator( numeric_cast<std::mt19937::result_type>( MPIManager::instance()->rank() ) );
 
@@ -124,6 +165,15 @@ int main( int argc, char* argv[] )
          *dataIt = math::realRandom< FieldType::value_type >();
    }
 
+   // only the inner cells are written
+   uint_t numElements( 0 );
+   for( auto it = sbf->begin(); it != sbf->end(); ++it )
+   {
+      auto field = it->getData< FieldType >( originalFieldId );
+      numElements += field->xSize() * field->ySize() * field->zSize() * field->fSize();
+   }
+   const double gigabytes = double_c( mpi::allReduce( numElements, mpi::SUM ) * sizeof( FieldType::value_type ) ) / 1e9;
+
    WcTimer timer;
 
    WALBERLA_MPI_BARRIER();
@@ -131,24 +181,48 @@ int main( int argc, char* argv[] )
    field::writeToFile<FieldType>( "mpiFile.wlb", sbf->getBlockStorage(), originalFieldId );
    WALBERLA_MPI_BARRIER();
    timer.end();
-   WALBERLA_LOG_INFO_ON_ROOT( "Writing took " << timer.last() << "s" );
+   WALBERLA_LOG_INFO_ON_ROOT( "Writing took " << timer.last() << "s (" << ( gigabytes / timer.last() ) << " GB/s)" );
 
    WALBERLA_MPI_BARRIER();
    timer.start();
    field::readFromFile<FieldType>( "mpiFile.wlb", sbf->getBlockStorage(), readFieldId );
    WALBERLA_MPI_BARRIER();
    timer.end();
-   WALBERLA_LOG_INFO_ON_ROOT( "Reading took " << timer.last() << "s" );
+   WALBERLA_LOG_INFO_ON_ROOT( "Reading took " << timer.last() << "s (" << ( gigabytes / timer.last() ) << " GB/s)" );
 
-   for( auto it = sbf->begin(); it != sbf->end(); ++it )
-   {
-      auto originalField = it->getData< FieldType >( originalFieldId );
-      auto readField     = it->getData< FieldType >( readFieldId );
+   // collective mode: one buffered write / read per process, the file is identical
 
-      auto readIt = readField->begin();
-      for( auto origIt = originalField->begin(); origIt != originalField->end(); ++origIt, ++readIt )
-         WALBERLA_CHECK_IDENTICAL( *origIt, *readIt );
-   }
+   const field::CollectiveIO collectiveIO( aggregators );
+
+   WALBERLA_MPI_BARRIER();
+   timer.start();
+   field::writeToFile<FieldType>( "mpiFileCollective.wlb", sbf->getBlockStorage(), originalFieldId, collectiveIO );
+   WALBERLA_MPI_BARRIER();
+   timer.end();
+   WALBERLA_LOG_INFO_ON_ROOT( "Collective writing took " << timer.last() << "s (" << ( gigabytes / timer.last() ) << " GB/s)" );
+
+   WALBERLA_MPI_BARRIER();
+   timer.start();
+   field::readFromFile<FieldType>( "mpiFileCollective.wlb", sbf->getBlockStorage(), collectiveReadFieldId, collectiveIO );
+   WALBERLA_MPI_BARRIER();
+   timer.end();
+   WALBERLA_LOG_INFO_ON_ROOT( "Collective reading took " << timer.last() << "s (" << ( gigabytes / timer.last() ) << " GB/s)" );
+
+   // small staging buffers: the blocks are written / read in several collective rounds
+
+   const field::CollectiveIO roundsIO( aggregators, uint_t(0), uint_t(3) * sizeof( FieldType::value_type ) * xBlockSize * yBlockSize * zBlockSize );
+   field::writeToFile<FieldType>( "mpiFileCollectiveRounds.wlb", sbf->getBlockStorage(), originalFieldId, roundsIO );
+   field::readFromFile<FieldType>( "mpiFileCollective.wlb", sbf->getBlockStorage(), roundsReadFieldId, roundsIO );
+
+   field::readFromFile<FieldType>( "mpiFileCollective.wlb", sbf->getBlockStorage(), mixedReadFieldId );
+
+   checkIdenticalFiles( "mpiFileCollective.wlb", "mpiFile.wlb" );
+   checkIdenticalFiles( "mpiFileCollectiveRounds.wlb", "mpiFile.wlb" );
+
+   checkIdenticalFields< FieldType >( *sbf, originalFieldId, readFieldId );
+   checkIdenticalFields< FieldType >( *sbf, originalFieldId, collectiveReadFieldId );
+   checkIdenticalFields< FieldType >( *sbf, originalFieldId, roundsReadFieldId );
+   checkIdenticalFields< FieldType >( *sbf, originalFieldId, mixedReadFieldId );
 
    return EXIT_SUCCESS;
 }
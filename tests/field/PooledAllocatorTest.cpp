@@ -0,0 +1,209 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file PooledAllocatorTest.cpp
+//! \ingroup field
+//! \brief Tests the recycling of memory by field::PooledAllocator, directly and across BlockForest::refresh() cycles
+//
+//======================================================================================================================
+
+#include "field/AddToStorage.h"
+#include "field/GhostLayerField.h"
+#include "field/allocation/PooledAllocator.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/StructuredBlockForest.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/mpi/Environment.h"
+
+#include <algorithm>
+#include <cstdint>
+
+
+using namespace walberla;
+
+typedef GhostLayerField< real_t, 3 >                 ScalarField_T;
+typedef field::PooledAllocator< real_t, uint_t(32) > Allocator_T;
+
+
+
+template< typename Field_T >
+void checkAlignment( const Field_T & field, const uint_t alignment )
+{
+   for( cell_idx_t z = -cell_idx_c( field.nrOfGhostLayers() ); z < cell_idx_c( field.zSize() + field.nrOfGhostLayers() ); ++z )
+      for( cell_idx_t y = -cell_idx_c( field.nrOfGhostLayers() ); y < cell_idx_c( field.ySize() + field.nrOfGhostLayers() ); ++y )
+         for( cell_idx_t f = 0; f < cell_idx_c( field.fSize() ); ++f )
+            WALBERLA_CHECK_EQUAL( reinterpret_cast< std::uintptr_t >( &field.get( 0, y, z, f ) ) % alignment, 0 );
+}
+
+
+
+void testSizeClasses()
+{
+   for( uint_t bytes = uint_t(1); bytes < uint_t(100000); bytes += uint_t(7) )
+   {
+      const uint_t sizeClass = Allocator_T::sizeClass( bytes );
+      WALBERLA_CHECK_GREATER_EQUAL( sizeClass, bytes );
+      WALBERLA_CHECK_LESS_EQUAL( sizeClass, std::max( uint_t(64), bytes + bytes / uint_t(8) ) );
+      WALBERLA_CHECK_EQUAL( Allocator_T::sizeClass( sizeClass ), sizeClass );
+   }
+}
+
+
+
+void testRecycling()
+{
+   auto allocator = make_shared< Allocator_T >();
+
+   ScalarField_T * field = new ScalarField_T( 10, 8, 6, 1, real_t(1), field::fzyx, allocator );
+   const real_t * memory = field->data();
+   delete field;
+
+   WALBERLA_CHECK_EQUAL( allocator->hits(), uint_t(0) );
+   WALBERLA_CHECK_EQUAL( allocator->misses(), uint_t(1) );
+   WALBERLA_CHECK_EQUAL( allocator->pooledBuffers(), uint_t(1) );
+
+   // same size -> recycled
+   field = new ScalarField_T( 10, 8, 6, 1, real_t(2), field::fzyx, allocator );
+   WALBERLA_CHECK_EQUAL( field->data(), memory );
+   WALBERLA_CHECK_EQUAL( allocator->hits(), uint_t(1) );
+   WALBERLA_CHECK_EQUAL( allocator->pooledBuffers(), uint_t(0) );
+   checkAlignment( *field, uint_t(32) );
+   for( auto cell = field->beginWithGhostLayer(); cell != field->end(); ++cell )
+      WALBERLA_CHECK_FLOAT_EQUAL( *cell, real_t(2) );
+
+   // clones and shallow copies use the same allocator
+   ScalarField_T * clone = field->clone();
+   ScalarField_T * shallowCopy = field->cloneShallowCopy();
+   WALBERLA_CHECK_EQUAL( allocator->misses(), uint_t(2) );
+   delete field;
+   WALBERLA_CHECK_EQUAL( allocator->pooledBuffers(), uint_t(0) ); // still used by the shallow copy
+   delete shallowCopy;
+   delete clone;
+   WALBERLA_CHECK_EQUAL( allocator->pooledBuffers(), uint_t(2) );
+
+   // different number of ghost layers -> different alignment offset -> memory must not be recycled
+   field = new ScalarField_T( 8, 8, 6, 2, real_t(3), field::fzyx, allocator );
+   WALBERLA_CHECK_EQUAL( allocator->misses(), uint_t(3) );
+   checkAlignment( *field, uint_t(32) );
+   delete field;
+
+   WALBERLA_LOG_INFO( *allocator );
+
+   allocator->release();
+   WALBERLA_CHECK_EQUAL( allocator->pooledBuffers(), uint_t(0) );
+   WALBERLA_CHECK_EQUAL( allocator->pooledBytes(), uint_t(0) );
+
+   // limited pool size
+   auto limited = make_shared< Allocator_T >( uint_t(0) );
+   delete new ScalarField_T( 10, 8, 6, 1, real_t(1), field::fzyx, limited );
+   delete new ScalarField_T( 10, 8, 6, 1, real_t(1), field::fzyx, limited );
+   WALBERLA_CHECK_EQUAL( limited->hits(), uint_t(0) );
+   WALBERLA_CHECK_EQUAL( limited->misses(), uint_t(2) );
+}
+
+
+
+/// refines all blocks in even and coarsens them again in odd refresh cycles
+class AlternatingRefinement
+{
+public:
+   AlternatingRefinement() : cycle_( uint_t(0) ) {}
+
+   void operator()( std::vector< std::pair< const Block *, uint_t > > & minTargetLevels,
+                    std::vector< const Block * > &, const BlockForest & )
+   {
+      for( auto it = minTargetLevels.begin(); it != minTargetLevels.end(); ++it )
+         it->second = ( cycle_ % uint_t(2) == uint_t(0) ) ? uint_t(1) : uint_t(0);
+      ++cycle_;
+   }
+
+private:
+   uint_t cycle_;
+};
+
+
+
+void testRefresh()
+{
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(1), uint_t(1), // blocks
+                                                      uint_t(8), uint_t(8), uint_t(8), // cells
+                                                      real_t(1),
+                                                      uint_t(1), uint_t(1), uint_t(1), // processes
+                                                      false, false, false );
+
+   auto allocator = make_shared< Allocator_T >();
+   const BlockDataID fieldId = field::addToStorage< ScalarField_T >( blocks, "pooled field", real_t(1), field::fzyx, uint_t(1), false,
+                                                                     std::function< void ( ScalarField_T *, IBlock * const ) >(),
+                                                                     Set<SUID>::emptySet(), Set<SUID>::emptySet(), allocator );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+      WALBERLA_CHECK_EQUAL( block->getData< ScalarField_T >( fieldId )->getAllocator(), allocator );
+
+   WALBERLA_CHECK_EQUAL( allocator->misses(), uint_t(2) );
+
+   auto & forest = blocks->getBlockForest();
+   forest.recalculateBlockLevelsInRefresh( true );
+   forest.allowRefreshChangingDepth( true );
+   forest.allowMultipleRefreshCycles( false );
+   forest.setRefreshMinTargetLevelDeterminationFunction( AlternatingRefinement() );
+
+   uint_t missesAfterFirstRefinement = uint_t(0);
+
+   const uint_t cycles = uint_t(4);
+   for( uint_t cycle = uint_t(0); cycle < cycles; ++cycle )
+   {
+      blocks->refresh();
+
+      WALBERLA_CHECK_EQUAL( blocks->size(), ( cycle % uint_t(2) == uint_t(0) ) ? uint_t(16) : uint_t(2) );
+
+      for( auto block = blocks->begin(); block != blocks->end(); ++block )
+      {
+         const ScalarField_T * field = block->getData< ScalarField_T >( fieldId );
+         WALBERLA_CHECK_EQUAL( field->getAllocator(), allocator );
+         checkAlignment( *field, uint_t(32) );
+         for( auto cell = field->begin(); cell != field->end(); ++cell )
+            WALBERLA_CHECK_FLOAT_EQUAL( *cell, real_t(1) );
+      }
+
+      WALBERLA_LOG_INFO( "refresh cycle " << cycle << ": " << *allocator );
+
+      if( cycle == uint_t(0) )
+         missesAfterFirstRefinement = allocator->misses();
+   }
+
+   // only the first refinement requires new memory, all later refresh cycles are served from the pool
+   WALBERLA_CHECK_LESS_EQUAL( missesAfterFirstRefinement, uint_t(2) + uint_t(16) );
+   WALBERLA_CHECK_EQUAL( allocator->misses(), missesAfterFirstRefinement );
+   WALBERLA_CHECK_EQUAL( allocator->hits() + allocator->misses(), uint_t(2) + uint_t(16) + uint_t(2) + uint_t(16) + uint_t(2) );
+   WALBERLA_CHECK_GREATER( allocator->hitRate(), 0.5 );
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   testSizeClasses();
+   testRecycling();
+   testRefresh();
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,318 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InPlaceSweepTest.cpp
+//! \ingroup lbm
+//! \brief Compares the in-place (AA pattern) sweep to a two-grid collide/stream reference on multiple blocks
+//
+//======================================================================================================================
+
+#include "lbm/boundary/InPlaceNoSlip.h"
+#include "lbm/boundary/InPlaceSimpleUBB.h"
+#include "lbm/boundary/NoSlip.h"
+#include "lbm/boundary/SimpleUBB.h"
+#include "lbm/communication/InPlacePdfFieldPackInfo.h"
+#include "lbm/communication/PdfFieldPackInfo.h"
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/lattice_model/D3Q27.h"
+#include "lbm/sweeps/CellwiseSweep.h"
+#include "lbm/sweeps/InPlaceSweep.h"
+#include "lbm/sweeps/SweepWrappers.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
+
+#include "boundary/BoundaryHandling.h"
+
+#include "core/Abort.h"
+#include "core/debug/Debug.h"
+#include "core/debug/TestSubsystem.h"
+#include "core/mpi/Environment.h"
+#include "core/mpi/MPIManager.h"
+
+#include "field/AddToStorage.h"
+#include "field/FlagField.h"
+
+#include "timeloop/SweepTimeloop.h"
+
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+
+
+
+using namespace walberla;
+using walberla::uint_t;
+
+typedef walberla::uint8_t    flag_t;
+typedef FlagField< flag_t >  FlagField_T;
+
+const FlagUID  Fluid_Flag( "fluid" );
+const FlagUID    UBB_Flag( "velocity bounce back" );
+const FlagUID NoSlip_Flag( "no slip" );
+
+const uint_t FieldSize        = uint_t(8);
+const uint_t FieldGhostLayers = uint_t(1);
+const uint_t TimeSteps        = uint_t(20);
+const real_t GlobalOmega      = real_t(1.4);
+const real_t GlobalLambdaE    = real_t(1.8);
+const real_t GlobalLambdaD    = real_t(1.7);
+const real_t Velocity         = real_t(0.05);
+
+#ifdef WALBERLA_DOUBLE_ACCURACY
+const real_t Epsilon = real_t(1e-12);
+#else
+const real_t Epsilon = real_t(1e-5);
+#endif
+
+
+
+// Couette flow (periodic in x- and y-direction) with an obstacle that spans all eight blocks
+
+template< typename FlagField_T, typename BoundaryHandling_T >
+void setupBoundaries( BoundaryHandling_T * handling, FlagField_T * flagField, IBlock * const block, const StructuredBlockStorage * const storage )
+{
+   CellInterval domainBB = storage->getDomainCellBB();
+   storage->transformGlobalToBlockLocalCellInterval( domainBB, *block );
+
+   domainBB.xMin() -= cell_idx_c( FieldGhostLayers );
+   domainBB.xMax() += cell_idx_c( FieldGhostLayers );
+   domainBB.yMin() -= cell_idx_c( FieldGhostLayers );
+   domainBB.yMax() += cell_idx_c( FieldGhostLayers );
+   domainBB.zMin() -= cell_idx_c( FieldGhostLayers );
+   domainBB.zMax() += cell_idx_c( FieldGhostLayers );
+
+   // no slip BOTTOM
+   CellInterval bottom( domainBB.xMin(), domainBB.yMin(), domainBB.zMin(), domainBB.xMax(), domainBB.yMax(), domainBB.zMin() );
+   handling->forceBoundary( NoSlip_Flag, bottom );
+
+   // velocity bounce back TOP
+   CellInterval top( domainBB.xMin(), domainBB.yMin(), domainBB.zMax(), domainBB.xMax(), domainBB.yMax(), domainBB.zMax() );
+   handling->forceBoundary( UBB_Flag, top );
+
+   // no slip OBSTACLE
+   CellInterval obstacle( cell_idx_c( FieldSize ) - 3, cell_idx_c( FieldSize ) - 2, cell_idx_c( FieldSize ) - 2,
+                          cell_idx_c( FieldSize ) + 1, cell_idx_c( FieldSize ) + 2, cell_idx_c( FieldSize ) + 1 );
+   storage->transformGlobalToBlockLocalCellInterval( obstacle, *block );
+   obstacle.intersect( flagField->xyzSizeWithGhostLayer() );
+   if( !obstacle.empty() )
+      handling->forceBoundary( NoSlip_Flag, obstacle );
+
+   handling->fillWithDomain( domainBB );
+}
+
+
+
+template< typename LatticeModel_T >
+class ReferenceBoundaryHandling
+{
+public:
+
+   typedef lbm::NoSlip< LatticeModel_T, flag_t >    NoSlip_T;
+   typedef lbm::SimpleUBB< LatticeModel_T, flag_t > UBB_T;
+
+   typedef boost::tuples::tuple< NoSlip_T, UBB_T > BoundaryConditions_T;
+
+   typedef BoundaryHandling< FlagField_T, typename LatticeModel_T::Stencil, BoundaryConditions_T > BoundaryHandling_T;
+
+   ReferenceBoundaryHandling( const BlockDataID & flagField, const BlockDataID & pdfField ) :
+      flagField_( flagField ), pdfField_( pdfField ) {}
+
+   BoundaryHandling_T * operator()( IBlock* const block, const StructuredBlockStorage* const storage ) const
+   {
+      FlagField_T * flagField = block->getData< FlagField_T >( flagField_ );
+      lbm::PdfField< LatticeModel_T > * pdfField = block->getData< lbm::PdfField< LatticeModel_T > >( pdfField_ );
+
+      const auto fluid = flagField->flagExists( Fluid_Flag ) ? flagField->getFlag( Fluid_Flag ) : flagField->registerFlag( Fluid_Flag );
+
+      BoundaryHandling_T * handling = new BoundaryHandling_T( "reference boundary handling", flagField, fluid,
+            boost::tuples::make_tuple( NoSlip_T( "no slip", NoSlip_Flag, pdfField ),
+                                          UBB_T( "velocity bounce back", UBB_Flag, pdfField, Velocity, real_c(0), real_c(0) ) ) );
+
+      setupBoundaries( handling, flagField, block, storage );
+      return handling;
+   }
+
+private:
+
+   const BlockDataID flagField_;
+   const BlockDataID  pdfField_;
+};
+
+
+
+template< typename LatticeModel_T >
+class InPlaceBoundaryHandling
+{
+public:
+
+   typedef lbm::InPlaceNoSlip< LatticeModel_T, flag_t >    NoSlip_T;
+   typedef lbm::InPlaceSimpleUBB< LatticeModel_T, flag_t > UBB_T;
+
+   typedef boost::tuples::tuple< NoSlip_T, UBB_T > BoundaryConditions_T;
+
+   typedef BoundaryHandling< FlagField_T, typename LatticeModel_T::Stencil, BoundaryConditions_T > BoundaryHandling_T;
+
+   InPlaceBoundaryHandling( const BlockDataID & flagField, const BlockDataID & pdfField, const shared_ptr< lbm::InPlaceTimeStep > & timeStep ) :
+      flagField_( flagField ), pdfField_( pdfField ), timeStep_( timeStep ) {}
+
+   BoundaryHandling_T * operator()( IBlock* const block, const StructuredBlockStorage* const storage ) const
+   {
+      FlagField_T * flagField = block->getData< FlagField_T >( flagField_ );
+      lbm::PdfField< LatticeModel_T > * pdfField = block->getData< lbm::PdfField< LatticeModel_T > >( pdfField_ );
+
+      const auto fluid = flagField->flagExists( Fluid_Flag ) ? flagField->getFlag( Fluid_Flag ) : flagField->registerFlag( Fluid_Flag );
+
+      BoundaryHandling_T * handling = new BoundaryHandling_T( "in-place boundary handling", flagField, fluid,
+            boost::tuples::make_tuple( NoSlip_T( "no slip", NoSlip_Flag, pdfField, timeStep_ ),
+                                          UBB_T( "velocity bounce back", UBB_Flag, pdfField, timeStep_, Velocity, real_c(0), real_c(0) ) ) );
+
+      setupBoundaries( handling, flagField, block, storage );
+      return handling;
+   }
+
+private:
+
+   const BlockDataID flagField_;
+   const BlockDataID  pdfField_;
+
+   shared_ptr< lbm::InPlaceTimeStep > timeStep_;
+};
+
+
+
+template< typename LatticeModel_T >
+void test( const shared_ptr< StructuredBlockForest > & blocks, const LatticeModel_T & latticeModel, const field::Layout layout, const std::string & name )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   WALBERLA_LOG_INFO_ON_ROOT( "Testing " << name << " ..." );
+
+   const Vector3< real_t > initialVelocity( Velocity, Velocity / real_t(2), Velocity / real_t(4) );
+
+   BlockDataID referenceFlagFieldId = field::addFlagFieldToStorage< FlagField_T >( blocks, "reference flag field " + name, FieldGhostLayers );
+   BlockDataID   inPlaceFlagFieldId = field::addFlagFieldToStorage< FlagField_T >( blocks, "in-place flag field " + name, FieldGhostLayers );
+
+   BlockDataID referencePdfFieldId = lbm::addPdfFieldToStorage( blocks, "reference pdf field " + name, latticeModel, initialVelocity, real_t(1),
+                                                                FieldGhostLayers, layout );
+   BlockDataID   inPlacePdfFieldId = lbm::addPdfFieldToStorage( blocks, "in-place pdf field " + name, latticeModel, initialVelocity, real_t(1),
+                                                                FieldGhostLayers, layout );
+
+   auto timeStep = make_shared< lbm::InPlaceTimeStep >();
+
+   BlockDataID referenceBoundaryHandlingId = blocks->addStructuredBlockData< typename ReferenceBoundaryHandling< LatticeModel_T >::BoundaryHandling_T >(
+            ReferenceBoundaryHandling< LatticeModel_T >( referenceFlagFieldId, referencePdfFieldId ), "reference boundary handling " + name );
+   BlockDataID   inPlaceBoundaryHandlingId = blocks->addStructuredBlockData< typename InPlaceBoundaryHandling< LatticeModel_T >::BoundaryHandling_T >(
+            InPlaceBoundaryHandling< LatticeModel_T >( inPlaceFlagFieldId, inPlacePdfFieldId, timeStep ), "in-place boundary handling " + name );
+
+   SweepTimeloop timeloop( blocks->getBlockStorage(), TimeSteps );
+
+   // reference: collide -> communication -> boundary handling -> stream (= same order of operations as the AA pattern)
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > referenceCommunication( blocks );
+   referenceCommunication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( referencePdfFieldId ) );
+
+   auto referenceSweep = lbm::makeCellwiseSweep< LatticeModel_T, FlagField_T >( referencePdfFieldId, referenceFlagFieldId, Fluid_Flag );
+
+   timeloop.add() << Sweep( lbm::makeCollideSweep( referenceSweep ), "reference collide" );
+   timeloop.add() << BeforeFunction( referenceCommunication, "reference communication" )
+                  << Sweep( ReferenceBoundaryHandling< LatticeModel_T >::BoundaryHandling_T::getBlockSweep( referenceBoundaryHandlingId ), "reference boundary" );
+   timeloop.add() << Sweep( lbm::makeStreamSweep( referenceSweep ), "reference stream" );
+
+   // in-place: sweep -> advance time step -> communication -> boundary handling
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > inPlaceCommunication( blocks );
+   inPlaceCommunication.addPackInfo( make_shared< lbm::InPlacePdfFieldPackInfo< LatticeModel_T > >( inPlacePdfFieldId, timeStep ) );
+
+   timeloop.add() << Sweep( lbm::InPlaceSweep< LatticeModel_T >( inPlacePdfFieldId, timeStep ), "in-place sweep" )
+                  << AfterFunction( [timeStep](){ timeStep->advance(); }, "in-place time step" )
+                  << AfterFunction( inPlaceCommunication, "in-place communication" );
+   timeloop.add() << Sweep( InPlaceBoundaryHandling< LatticeModel_T >::BoundaryHandling_T::getBlockSweep( inPlaceBoundaryHandlingId ), "in-place boundary" );
+
+   timeloop.run();
+
+   WALBERLA_CHECK( timeStep->isEven() );
+   WALBERLA_CHECK_EQUAL( timeStep->counter(), TimeSteps );
+
+   uint_t fluidCells( uint_t(0) );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdfField_T  * referenceField = block->template getData< PdfField_T >( referencePdfFieldId );
+      PdfField_T  *   inPlaceField = block->template getData< PdfField_T >( inPlacePdfFieldId );
+      FlagField_T *      flagField = block->template getData< FlagField_T >( referenceFlagFieldId );
+
+      const auto fluid = flagField->getFlag( Fluid_Flag );
+
+      for( auto cell = flagField->beginXYZ(); cell != flagField->end(); ++cell )
+      {
+         if( !isFlagSet( cell, fluid ) )
+            continue;
+
+         const cell_idx_t x = cell.x();
+         const cell_idx_t y = cell.y();
+         const cell_idx_t z = cell.z();
+
+         for( uint_t f = uint_t(0); f < LatticeModel_T::Stencil::Size; ++f )
+            WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( referenceField->get(x,y,z,f), inPlaceField->get(x,y,z,f), Epsilon,
+                                                name << ", cell " << Cell(x,y,z) << ", f = " << f );
+
+         WALBERLA_CHECK_FLOAT_UNEQUAL( inPlaceField->getVelocity(x,y,z).length(), real_t(0) );
+
+         ++fluidCells;
+      }
+   }
+
+   WALBERLA_CHECK_GREATER( fluidCells, uint_t(0) );
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   const uint_t processes = uint_c( MPIManager::instance()->numProcesses() );
+   if( processes != uint_t(1) && processes != uint_t(2) && processes != uint_t(4) && processes != uint_t(8) )
+      WALBERLA_ABORT( "The number of processes must be equal to 1, 2, 4, or 8!" );
+
+   const uint_t xProcesses = ( processes >= uint_t(2) ) ? uint_t(2) : uint_t(1);
+   const uint_t yProcesses = ( processes >= uint_t(4) ) ? uint_t(2) : uint_t(1);
+   const uint_t zProcesses = ( processes == uint_t(8) ) ? uint_t(2) : uint_t(1);
+
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(2), uint_t(2),
+                                                      FieldSize, FieldSize, FieldSize,
+                                                      real_c(1.0),
+                                                      xProcesses, yProcesses, zProcesses,
+                                                      true, true, false ); // periodicity
+
+   typedef lbm::D3Q19< lbm::collision_model::SRT, false > D3Q19_SRT_INCOMP;
+   typedef lbm::D3Q19< lbm::collision_model::SRT, true  > D3Q19_SRT_COMP;
+   typedef lbm::D3Q19< lbm::collision_model::TRT, false > D3Q19_TRT_INCOMP;
+   typedef lbm::D3Q27< lbm::collision_model::SRT, false > D3Q27_SRT_INCOMP;
+   typedef lbm::D3Q27< lbm::collision_model::TRT, true  > D3Q27_TRT_COMP;
+
+   test( blocks, D3Q19_SRT_INCOMP( lbm::collision_model::SRT( GlobalOmega ) ), field::fzyx, "D3Q19 SRT incomp fzyx" );
+   test( blocks, D3Q19_SRT_INCOMP( lbm::collision_model::SRT( GlobalOmega ) ), field::zyxf, "D3Q19 SRT incomp zyxf" );
+   test( blocks, D3Q19_SRT_COMP( lbm::collision_model::SRT( GlobalOmega ) ), field::fzyx, "D3Q19 SRT comp fzyx" );
+   test( blocks, D3Q19_TRT_INCOMP( lbm::collision_model::TRT( GlobalLambdaE, GlobalLambdaD ) ), field::fzyx, "D3Q19 TRT incomp fzyx" );
+   test( blocks, D3Q27_SRT_INCOMP( lbm::collision_model::SRT( GlobalOmega ) ), field::zyxf, "D3Q27 SRT incomp zyxf" );
+   test( blocks, D3Q27_TRT_COMP( lbm::collision_model::TRT( GlobalLambdaE, GlobalLambdaD ) ), field::fzyx, "D3Q27 TRT comp fzyx" );
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,225 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file MixedPrecisionSweepTest.cpp
+//! \ingroup lbm
+//! \brief Compares MixedPrecisionSweep (float and double storage, with and without shifting by the lattice weights) to
+//!        the double precision SplitPureSweep for a decaying shear wave
+//
+//======================================================================================================================
+
+#include "lbm/communication/PdfFieldPackInfo.h"
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/MixedPrecisionPdfField.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/sweeps/MixedPrecisionSweep.h"
+#include "lbm/sweeps/SplitPureSweep.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
+
+#include "core/Abort.h"
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/math/Constants.h"
+#include "core/mpi/Environment.h"
+#include "core/mpi/MPIManager.h"
+#include "core/mpi/Reduce.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+
+
+using namespace walberla;
+using walberla::uint_t;
+
+const uint_t XSize     = uint_t(6);
+const uint_t YSize     = uint_t(16);
+const uint_t ZSize     = uint_t(4);
+const uint_t TimeSteps = uint_t(50);
+
+const real_t GlobalOmega   = real_t(1.4);
+const real_t GlobalLambdaE = real_t(1.8);
+const real_t GlobalLambdaD = real_t(1.7);
+const real_t Velocity      = real_t(0.02);
+
+#ifdef WALBERLA_DOUBLE_ACCURACY
+const real_t Epsilon = real_t(1e-12);
+#else
+const real_t Epsilon = real_t(1e-5);
+#endif
+
+
+
+template< typename LatticeModel_T, typename Field_T >
+void initShearWave( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & fieldId )
+{
+   const real_t ny = real_c( blocks->getNumberOfYCells() );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      Field_T * field = block->template getData< Field_T >( fieldId );
+      for( auto cell = field->beginWithGhostLayerXYZ(); cell != field->end(); ++cell )
+      {
+         Cell global( cell.cell() );
+         blocks->transformBlockLocalToGlobalCell( global, *block );
+         const real_t phase = real_t(2) * math::M_PI * ( real_c( global.y() ) + real_c(0.5) ) / ny;
+         field->setDensityAndVelocity( cell.x(), cell.y(), cell.z(), Vector3< real_t >( Velocity * std::sin( phase ), real_t(0), real_t(0) ),
+                                       real_t(1) + real_c(0.001) * std::cos( phase ) );
+      }
+   }
+}
+
+
+
+/// runs the shear wave with MixedPrecisionSweep and returns the maximal deviation of the velocity (relative to the
+/// amplitude of the wave) and of the density from the double precision reference
+template< typename LatticeModel_T, typename Storage_T, bool ShiftedByWeight >
+std::pair< real_t, real_t > run( const shared_ptr< StructuredBlockForest > & blocks, const LatticeModel_T & latticeModel,
+                                 const BlockDataID & referenceId, const std::string & name )
+{
+   typedef lbm::PdfField< LatticeModel_T >                                           Reference_T;
+   typedef lbm::MixedPrecisionPdfField< LatticeModel_T, Storage_T, ShiftedByWeight > PdfField_T;
+
+   const BlockDataID fieldId = blocks->addStructuredBlockData< PdfField_T >(
+            [&latticeModel]( IBlock * const block, StructuredBlockStorage * const storage ) {
+               return new PdfField_T( storage->getNumberOfXCells( *block ), storage->getNumberOfYCells( *block ),
+                                      storage->getNumberOfZCells( *block ), latticeModel, false, Vector3< real_t >( real_t(0) ), real_t(1),
+                                      uint_t(1), field::fzyx );
+            }, name );
+
+   initShearWave< LatticeModel_T, PdfField_T >( blocks, fieldId );
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > communication( blocks );
+   communication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T, PdfField_T > >( fieldId ) );
+
+   lbm::MixedPrecisionSweep< LatticeModel_T, Storage_T, ShiftedByWeight > sweep( fieldId );
+
+   for( uint_t t = 0; t != TimeSteps; ++t )
+   {
+      communication();
+      for( auto block = blocks->begin(); block != blocks->end(); ++block )
+         sweep( &*block );
+   }
+
+   real_t velocityError( real_t(0) );
+   real_t densityError( real_t(0) );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      const Reference_T * reference = block->template getData< Reference_T >( referenceId );
+      const PdfField_T  * field     = block->template getData< PdfField_T >( fieldId );
+
+      for( auto cell = reference->beginXYZ(); cell != reference->end(); ++cell )
+      {
+         const cell_idx_t x = cell.x();
+         const cell_idx_t y = cell.y();
+         const cell_idx_t z = cell.z();
+
+         velocityError = std::max( velocityError, ( field->getVelocity(x,y,z) - reference->getVelocity(x,y,z) ).length() / Velocity );
+         densityError  = std::max( densityError, std::fabs( field->getDensity(x,y,z) - reference->getDensity(x,y,z) ) );
+      }
+   }
+
+   mpi::allReduceInplace( velocityError, mpi::MAX );
+   mpi::allReduceInplace( densityError, mpi::MAX );
+
+   WALBERLA_LOG_INFO_ON_ROOT( name << ": max. relative velocity error = " << velocityError << ", max. density error = " << densityError );
+
+   return std::make_pair( velocityError, densityError );
+}
+
+
+
+template< typename LatticeModel_T >
+void test( const shared_ptr< StructuredBlockForest > & blocks, const LatticeModel_T & latticeModel, const std::string & name )
+{
+   typedef lbm::PdfField< LatticeModel_T > Reference_T;
+
+   WALBERLA_LOG_INFO_ON_ROOT( "Testing " << name << " ..." );
+
+   const BlockDataID referenceId = lbm::addPdfFieldToStorage( blocks, "reference " + name, latticeModel, uint_t(1), field::fzyx );
+   initShearWave< LatticeModel_T, Reference_T >( blocks, referenceId );
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > communication( blocks );
+   communication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( referenceId ) );
+
+   lbm::SplitPureSweep< LatticeModel_T > sweep( referenceId );
+
+   for( uint_t t = 0; t != TimeSteps; ++t )
+   {
+      communication();
+      for( auto block = blocks->begin(); block != blocks->end(); ++block )
+         sweep( &*block );
+   }
+
+   // double storage: only differs from the reference in the order of the floating point operations
+
+   const auto doubleStorage = run< LatticeModel_T, double, false >( blocks, latticeModel, referenceId, name + " (double)" );
+   WALBERLA_CHECK_LESS( doubleStorage.first,  Epsilon );
+   WALBERLA_CHECK_LESS( doubleStorage.second, Epsilon );
+
+   const auto doubleStorageShifted = run< LatticeModel_T, double, true >( blocks, latticeModel, referenceId, name + " (double, shifted)" );
+   WALBERLA_CHECK_LESS( doubleStorageShifted.first,  Epsilon );
+   WALBERLA_CHECK_LESS( doubleStorageShifted.second, Epsilon );
+
+   // float storage
+
+   const auto floatStorage = run< LatticeModel_T, float, false >( blocks, latticeModel, referenceId, name + " (float)" );
+   const auto floatStorageShifted = run< LatticeModel_T, float, true >( blocks, latticeModel, referenceId, name + " (float, shifted)" );
+
+   WALBERLA_CHECK_LESS( floatStorage.first, real_t(1e-3) );
+   WALBERLA_CHECK_LESS( floatStorageShifted.first, real_t(1e-3) );
+
+#ifdef WALBERLA_DOUBLE_ACCURACY
+   if( LatticeModel_T::compressible )
+   {
+      WALBERLA_CHECK_LESS( floatStorageShifted.first,  floatStorage.first );
+      WALBERLA_CHECK_LESS( floatStorageShifted.second, floatStorage.second );
+   }
+#endif
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   const uint_t processes = uint_c( MPIManager::instance()->numProcesses() );
+   if( processes != uint_t(1) && processes != uint_t(2) )
+      WALBERLA_ABORT( "The number of processes must be equal to 1 or 2!" );
+
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(1), uint_t(1),
+                                                      XSize, YSize, ZSize,
+                                                      real_c(1.0),
+                                                      processes, uint_t(1), uint_t(1),
+                                                      true, true, true ); // periodicity
+
+   typedef lbm::D3Q19< lbm::collision_model::SRT, false > D3Q19_SRT_INCOMP;
+   typedef lbm::D3Q19< lbm::collision_model::SRT, true  > D3Q19_SRT_COMP;
+   typedef lbm::D3Q19< lbm::collision_model::TRT, true  > D3Q19_TRT_COMP;
+
+   test( blocks, D3Q19_SRT_INCOMP( lbm::collision_model::SRT( GlobalOmega ) ), "D3Q19 SRT incomp" );
+   test( blocks, D3Q19_SRT_COMP( lbm::collision_model::SRT( GlobalOmega ) ), "D3Q19 SRT comp" );
+   test( blocks, D3Q19_TRT_COMP( lbm::collision_model::TRT( GlobalLambdaE, GlobalLambdaD ) ), "D3Q19 TRT comp" );
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,228 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file OverlappingSweepTest.cpp
+//! \ingroup lbm
+//! \brief Checks that splitting SplitPureSweep and CellwiseSweep into 'inner' and 'frame' (executed as OverlappingSweep
+//!        by the SweepTimeloop, with and without overlap) produces bit-identical results to the unsplit sweeps
+//
+//======================================================================================================================
+
+#include "lbm/communication/PdfFieldPackInfo.h"
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D2Q9.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/sweeps/CellwiseSweep.h"
+#include "lbm/sweeps/SplitPureSweep.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/math/Constants.h"
+#include "core/mpi/Environment.h"
+#include "core/mpi/MPIManager.h"
+
+#include "timeloop/SweepTimeloop.h"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+
+
+
+using namespace walberla;
+using walberla::uint_t;
+
+// x-size is not a multiple of the simd width -> the vectorized split pure kernels also have to treat remaining cells
+const uint_t XSize     = uint_t(13);
+const uint_t YSize     = uint_t(6);
+const uint_t ZSize     = uint_t(5);
+const uint_t TimeSteps = uint_t(10);
+
+const real_t GlobalOmega   = real_t(1.4);
+const real_t GlobalLambdaE = real_t(1.8);
+const real_t GlobalLambdaD = real_t(1.7);
+const real_t Velocity      = real_t(0.02);
+
+
+
+template< typename LatticeModel_T >
+void initialize( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & fieldId )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   const real_t nx = real_c( blocks->getNumberOfXCells() );
+   const real_t ny = real_c( blocks->getNumberOfYCells() );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdfField_T * field = block->template getData< PdfField_T >( fieldId );
+      for( auto cell = field->beginXYZ(); cell != field->end(); ++cell )
+      {
+         Cell global( cell.cell() );
+         blocks->transformBlockLocalToGlobalCell( global, *block );
+         const real_t phaseX = real_t(2) * math::M_PI * ( real_c( global.x() ) + real_c(0.5) ) / nx;
+         const real_t phaseY = real_t(2) * math::M_PI * ( real_c( global.y() ) + real_c(0.5) ) / ny;
+         const real_t vz = ( LatticeModel_T::Stencil::D == uint_t(3) ) ? Velocity * std::cos( phaseX ) : real_t(0);
+         field->setDensityAndVelocity( cell.x(), cell.y(), cell.z(), Vector3< real_t >( Velocity * std::sin( phaseY ), real_t(0), vz ),
+                                       real_t(1) + real_c(0.001) * std::cos( phaseX + phaseY ) );
+      }
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+void checkBitIdentical( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & referenceId, const BlockDataID & fieldId,
+                        const std::string & name )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      const PdfField_T * reference = block->template getData< PdfField_T >( referenceId );
+      const PdfField_T * field     = block->template getData< PdfField_T >( fieldId );
+
+      for( auto cell = reference->beginXYZ(); cell != reference->end(); ++cell )
+      {
+         for( uint_t f = 0; f != LatticeModel_T::Stencil::Size; ++f )
+         {
+            const real_t expected = cell.getF( f );
+            const real_t actual   = field->get( cell.x(), cell.y(), cell.z(), f );
+            WALBERLA_CHECK_EQUAL( std::memcmp( &expected, &actual, sizeof(real_t) ), 0,
+                                  name << ": cell " << cell.cell() << ", f " << f << ": " << expected << " != " << actual );
+         }
+      }
+   }
+}
+
+
+
+/// 'makeSweep' returns a shared pointer to a new sweep (with the member functions 'inner' and 'frame') for a PDF field
+template< typename LatticeModel_T, typename SweepFactory_T >
+void test( const shared_ptr< StructuredBlockForest > & blocks, const LatticeModel_T & latticeModel, const field::Layout layout,
+           const SweepFactory_T & makeSweep, const std::string & name )
+{
+   typedef blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > Communication_T;
+
+   WALBERLA_LOG_INFO_ON_ROOT( "Testing " << name );
+
+   // reference: communication, then the unsplit sweep
+
+   const BlockDataID referenceId = lbm::addPdfFieldToStorage( blocks, name + " (reference)", latticeModel, uint_t(1), layout );
+   initialize< LatticeModel_T >( blocks, referenceId );
+
+   Communication_T referenceCommunication( blocks );
+   referenceCommunication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( referenceId ) );
+
+   auto referenceSweep = makeSweep( referenceId );
+
+   for( uint_t t = 0; t != TimeSteps; ++t )
+   {
+      referenceCommunication();
+      for( auto block = blocks->begin(); block != blocks->end(); ++block )
+         (*referenceSweep)( &*block );
+   }
+
+   // inner/frame split, with and without overlapping communication
+
+   for( int overlap = 1; overlap >= 0; --overlap )
+   {
+      const std::string variant = name + ( overlap == 1 ? " (overlapping)" : " (serialized)" );
+
+      const BlockDataID fieldId = lbm::addPdfFieldToStorage( blocks, variant, latticeModel, uint_t(1), layout );
+      initialize< LatticeModel_T >( blocks, fieldId );
+
+      Communication_T communication( blocks );
+      communication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( fieldId ) );
+
+      SweepTimeloop timeloop( blocks->getBlockStorage(), TimeSteps );
+      timeloop.setCommunicationOverlap( overlap == 1 );
+      timeloop.add() << OverlappingSweep( makeSweep( fieldId ), communication.getStartCommunicateFunctor(),
+                                          communication.getWaitFunctor(), "LB stream & collide" );
+
+      WcTimingPool timingPool;
+      timeloop.run( timingPool, false );
+
+      checkBitIdentical< LatticeModel_T >( blocks, referenceId, fieldId, variant );
+
+      WALBERLA_CHECK( timingPool.timerExists( "LB stream & collide (inner)" ) );
+      WALBERLA_CHECK( timingPool.timerExists( "LB stream & collide (frame)" ) );
+      WALBERLA_CHECK( timingPool.timerExists( "LB stream & collide (communication start)" ) );
+      WALBERLA_CHECK( timingPool.timerExists( "LB stream & collide (communication wait)" ) );
+      WALBERLA_CHECK( timingPool.timerExists( "LB stream & collide (hidden communication)" ) );
+      WALBERLA_CHECK_EQUAL( timingPool[ "LB stream & collide (communication wait)" ].getCounter(), TimeSteps );
+      WALBERLA_CHECK_EQUAL( timingPool[ "LB stream & collide (inner)" ].getCounter(), TimeSteps * blocks->getNumberOfBlocks() );
+
+      const double hidden = timeloop::hiddenCommunicationFraction( timingPool, "LB stream & collide" );
+      WALBERLA_CHECK_GREATER_EQUAL( hidden, 0.0 );
+      WALBERLA_CHECK_LESS_EQUAL( hidden, 1.0 );
+      WALBERLA_LOG_INFO_ON_ROOT( variant << ": hidden communication fraction = " << hidden );
+   }
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   const uint_t processes = uint_c( MPIManager::instance()->numProcesses() );
+   if( processes != uint_t(1) && processes != uint_t(2) )
+      WALBERLA_ABORT( "The number of processes must be equal to 1 or 2!" );
+
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(1), uint_t(1),
+                                                      XSize, YSize, ZSize,
+                                                      real_c(1.0),
+                                                      processes, uint_t(1), uint_t(1),
+                                                      true, true, true ); // periodicity
+
+   auto blocks2D = blockforest::createUniformBlockGrid( uint_t(2), uint_t(1), uint_t(1),
+                                                        XSize, YSize, uint_t(1),
+                                                        real_c(1.0),
+                                                        processes, uint_t(1), uint_t(1),
+                                                        true, true, true ); // periodicity
+
+   typedef lbm::D3Q19< lbm::collision_model::SRT, false > D3Q19_SRT_INCOMP;
+   typedef lbm::D3Q19< lbm::collision_model::TRT, true  > D3Q19_TRT_COMP;
+   typedef lbm::D2Q9 < lbm::collision_model::SRT, false > D2Q9_SRT_INCOMP;
+
+   const D3Q19_SRT_INCOMP srtIncomp = D3Q19_SRT_INCOMP( lbm::collision_model::SRT( GlobalOmega ) );
+   const D3Q19_TRT_COMP   trtComp   = D3Q19_TRT_COMP( lbm::collision_model::TRT( GlobalLambdaE, GlobalLambdaD ) );
+   const D2Q9_SRT_INCOMP  d2q9      = D2Q9_SRT_INCOMP( lbm::collision_model::SRT( GlobalOmega ) );
+
+   auto splitPureSRT = []( const BlockDataID & id ) { return make_shared< lbm::SplitPureSweep< D3Q19_SRT_INCOMP > >( id ); };
+   auto splitPureTRT = []( const BlockDataID & id ) { return make_shared< lbm::SplitPureSweep< D3Q19_TRT_COMP > >( id ); };
+
+   test( blocks, srtIncomp, field::fzyx, splitPureSRT, "D3Q19 SRT incomp split pure fzyx" );
+   test( blocks, srtIncomp, field::zyxf, splitPureSRT, "D3Q19 SRT incomp split pure zyxf" );
+   test( blocks, trtComp,   field::fzyx, splitPureTRT, "D3Q19 TRT comp split pure fzyx" );
+   test( blocks, trtComp,   field::zyxf, splitPureTRT, "D3Q19 TRT comp split pure zyxf" );
+
+   auto cellwiseSRT  = []( const BlockDataID & id ) { return lbm::makeCellwiseSweep< D3Q19_SRT_INCOMP >( id ); };
+   auto cellwiseTRT  = []( const BlockDataID & id ) { return lbm::makeCellwiseSweep< D3Q19_TRT_COMP >( id ); };
+   auto cellwiseD2Q9 = []( const BlockDataID & id ) { return lbm::makeCellwiseSweep< D2Q9_SRT_INCOMP >( id ); };
+
+   test( blocks,   srtIncomp, field::fzyx, cellwiseSRT,  "D3Q19 SRT incomp cellwise fzyx" );
+   test( blocks,   trtComp,   field::zyxf, cellwiseTRT,  "D3Q19 TRT comp cellwise zyxf" );
+   test( blocks2D, d2q9,      field::fzyx, cellwiseD2Q9, "D2Q9 SRT incomp cellwise fzyx" );
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,212 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SplitPureSIMDEquivalenceTest.cpp
+//! \ingroup lbm
+//! \brief Checks that the explicitly vectorized D3Q19 split pure kernels produce bit-identical results to the
+//!        scalar X_LOOP kernels, for destination fields with and without peeling
+//
+//======================================================================================================================
+
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/sweeps/SplitPureSIMD.h"
+#include "lbm/sweeps/SplitPureSweep.h"
+
+#include "blockforest/Initialization.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/mpi/Environment.h"
+#include "core/mpi/MPIManager.h"
+
+#include "field/allocation/FieldAllocator.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+
+using namespace walberla;
+using walberla::uint_t;
+
+// x-size is not a multiple of the simd width -> the vectorized kernels also have to treat remaining cells
+const uint_t XSize = uint_t(13);
+const uint_t YSize = uint_t(6);
+const uint_t ZSize = uint_t(5);
+
+const uint_t TimeSteps = uint_t(10);
+
+const real_t GlobalOmega   = real_t(1.4);
+const real_t GlobalLambdaE = real_t(1.8);
+const real_t GlobalLambdaD = real_t(1.7);
+
+
+
+/// Aligned allocator that ignores the inner ghost layer offset, i.e., x = 0 is NOT aligned and every line of the
+/// vectorized kernels starts with a (scalar) peel loop
+class MisalignedAllocator : public field::AllocateAligned< real_t, 32 >
+{
+protected:
+   virtual void setInnerGhostLayerSize( uint_t /*innerGhostLayerSize*/ ) { field::AllocateAligned< real_t, 32 >::setInnerGhostLayerSize( uint_t(0) ); }
+};
+
+
+
+template< typename LatticeModel_T >
+class PdfFieldCreator
+{
+public:
+
+   PdfFieldCreator( const LatticeModel_T & latticeModel, const shared_ptr< field::FieldAllocator<real_t> > & alloc ) :
+      latticeModel_( latticeModel ), alloc_( alloc ) {}
+
+   lbm::PdfField< LatticeModel_T > * operator()( IBlock * const block, StructuredBlockStorage * const storage ) const
+   {
+      return new lbm::PdfField< LatticeModel_T >( storage->getNumberOfXCells( *block ), storage->getNumberOfYCells( *block ),
+                                                  storage->getNumberOfZCells( *block ), latticeModel_, true, Vector3<real_t>( real_t(0) ),
+                                                  real_t(1), uint_t(1), field::fzyx, alloc_ );
+   }
+
+private:
+
+   LatticeModel_T latticeModel_;
+   shared_ptr< field::FieldAllocator<real_t> > alloc_;
+};
+
+
+
+/// deterministic, slightly perturbed equilibrium-like values
+template< typename LatticeModel_T >
+real_t initialValue( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z, const uint_t f, const uint_t step )
+{
+   const int hash = ( 7 * int_c(x) + 13 * int_c(y) + 29 * int_c(z) + 3 * int_c(f) + 11 * int_c(step) + 1000 ) % 17;
+   return real_c( LatticeModel_T::w[f] ) * ( real_t(1) + real_c(0.01) * real_c( hash ) / real_t(17) );
+}
+
+template< typename LatticeModel_T >
+void initialize( lbm::PdfField< LatticeModel_T > * const field, const uint_t step, const bool ghostLayersOnly )
+{
+   const CellInterval inner = field->xyzSize();
+   for( auto cell = field->beginWithGhostLayerXYZ(); cell != field->end(); ++cell )
+   {
+      if( ghostLayersOnly && inner.contains( cell.cell() ) )
+         continue;
+      for( uint_t f = 0; f != LatticeModel_T::Stencil::Size; ++f )
+         cell.getF( f ) = initialValue< LatticeModel_T >( cell.x(), cell.y(), cell.z(), f, step );
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+void test( const shared_ptr< StructuredBlockForest > & blocks, const LatticeModel_T & latticeModel, const std::string & name )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   WALBERLA_LOG_INFO( "Testing " << name );
+
+   const BlockDataID scalarId = blocks->addStructuredBlockData< PdfField_T >(
+            PdfFieldCreator< LatticeModel_T >( latticeModel, make_shared< field::StdFieldAlloc< real_t > >() ), name + " (scalar)" );
+   const BlockDataID alignedId = blocks->addStructuredBlockData< PdfField_T >(
+            PdfFieldCreator< LatticeModel_T >( latticeModel, make_shared< field::AllocateAligned< real_t, 32 > >() ), name + " (aligned)" );
+   const BlockDataID misalignedId = blocks->addStructuredBlockData< PdfField_T >(
+            PdfFieldCreator< LatticeModel_T >( latticeModel, make_shared< MisalignedAllocator >() ), name + " (misaligned)" );
+
+   const std::vector< BlockDataID > ids = { scalarId, alignedId, misalignedId };
+
+   std::vector< lbm::SplitPureSweep< LatticeModel_T > > sweeps;
+   for( auto id = ids.begin(); id != ids.end(); ++id )
+      sweeps.push_back( lbm::SplitPureSweep< LatticeModel_T >( *id ) );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      for( auto id = ids.begin(); id != ids.end(); ++id )
+         initialize( block->template getData< PdfField_T >( *id ), uint_t(0), false );
+
+#ifdef WALBERLA_LBM_SPLIT_PURE_SIMD
+      // make sure the three fields really exercise the intended code paths
+      PdfField_T * scalar = block->template getData< PdfField_T >( scalarId );
+      PdfField_T * aligned = block->template getData< PdfField_T >( alignedId );
+      PdfField_T * misaligned = block->template getData< PdfField_T >( misalignedId );
+      WALBERLA_CHECK( !lbm::internal::split_pure_simd::isApplicable( scalar, scalar ) );
+      WALBERLA_CHECK( lbm::internal::split_pure_simd::isApplicable( aligned, aligned ) );
+      WALBERLA_CHECK( lbm::internal::split_pure_simd::isApplicable( misaligned, misaligned ) );
+      WALBERLA_CHECK_EQUAL( lbm::internal::split_pure_simd::peel( &aligned->get(0,0,0,0), cell_idx_c( XSize ) ), cell_idx_t(0) );
+      WALBERLA_CHECK_GREATER( lbm::internal::split_pure_simd::peel( &misaligned->get(0,0,0,0), cell_idx_c( XSize ) ), cell_idx_t(0) );
+#else
+      WALBERLA_LOG_INFO( "Explicitly vectorized kernels are not available in this build, only the scalar kernels are compared" );
+#endif
+   }
+
+   for( uint_t t = 0; t != TimeSteps; ++t )
+   {
+      for( auto block = blocks->begin(); block != blocks->end(); ++block )
+      {
+         for( uint_t i = 0; i != ids.size(); ++i )
+         {
+            initialize( block->template getData< PdfField_T >( ids[i] ), t, true );
+            sweeps[i]( &*block );
+         }
+
+         const PdfField_T * reference = block->template getData< PdfField_T >( scalarId );
+         for( uint_t i = 1; i != ids.size(); ++i )
+         {
+            const PdfField_T * field = block->template getData< PdfField_T >( ids[i] );
+            for( auto cell = reference->beginXYZ(); cell != reference->end(); ++cell )
+            {
+               for( uint_t f = 0; f != LatticeModel_T::Stencil::Size; ++f )
+               {
+                  const real_t expected = cell.getF( f );
+                  const real_t actual = field->get( cell.x(), cell.y(), cell.z(), f );
+                  // bit-wise comparison
+                  WALBERLA_CHECK_EQUAL( std::memcmp( &expected, &actual, sizeof(real_t) ), 0,
+                                        name << ": time step " << t << ", cell " << cell.cell() << ", f " << f << ": " << expected << " != " << actual );
+               }
+            }
+         }
+      }
+   }
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   if( MPIManager::instance()->numProcesses() != 1 )
+      WALBERLA_ABORT( "The number of processes must be equal to 1!" );
+
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(1), uint_t(1), uint_t(1),
+                                                      XSize, YSize, ZSize,
+                                                      real_c(1.0), true,
+                                                      false, false, false ); // periodicity
+
+   typedef lbm::D3Q19< lbm::collision_model::SRT, false > D3Q19_SRT_INCOMP;
+   typedef lbm::D3Q19< lbm::collision_model::SRT, true  > D3Q19_SRT_COMP;
+   typedef lbm::D3Q19< lbm::collision_model::TRT, false > D3Q19_TRT_INCOMP;
+   typedef lbm::D3Q19< lbm::collision_model::TRT, true  > D3Q19_TRT_COMP;
+
+   test( blocks, D3Q19_SRT_INCOMP( lbm::collision_model::SRT( GlobalOmega ) ), "D3Q19 SRT incomp" );
+   test( blocks, D3Q19_SRT_COMP  ( lbm::collision_model::SRT( GlobalOmega ) ), "D3Q19 SRT comp" );
+   test( blocks, D3Q19_TRT_INCOMP( lbm::collision_model::TRT( GlobalLambdaE, GlobalLambdaD ) ), "D3Q19 TRT incomp" );
+   test( blocks, D3Q19_TRT_COMP  ( lbm::collision_model::TRT( GlobalLambdaE, GlobalLambdaD ) ), "D3Q19 TRT comp" );
+
+   return EXIT_SUCCESS;
+}
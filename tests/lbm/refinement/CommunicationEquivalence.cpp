@@ -32,6 +32,8 @@
 #include "core/logging/Logging.h"
 #include "core/math/Limits.h"
 #include "core/mpi/Environment.h"
+#include "core/mpi/MPIManager.h"
+#include "core/mpi/Reduce.h"
 #include "core/timing/RemainingTimeLogger.h"
 #include "core/timing/TimingPool.h"
 
@@ -378,8 +380,12 @@ int main( int argc, char ** argv )
    mpi::Environment env( argc, argv );
 
    bool shortrun = false;
+   bool aggregated = false;
    for( int i = 1; i < argc; ++i )
+   {
       if( std::strcmp( argv[i], "--shortrun" ) == 0 ) shortrun = true;
+      if( std::strcmp( argv[i], "--aggregated" ) == 0 ) aggregated = true;
+   }
 
    logging::Logging::printHeaderOnStream();
 
@@ -464,7 +470,17 @@ int main( int argc, char ** argv )
    auto tstep1 = lbm::refinement::makeTimeStep< LatticeModel_T, BoundaryHandling_T >( blocks, mySweep1, pdfFieldId1, boundaryHandlingId1 );
    auto tstep2 = lbm::refinement::makeTimeStep< LatticeModel_T, BoundaryHandling_T >( blocks, mySweep2, pdfFieldId2, boundaryHandlingId2 );
    tstep1->optimizeCommunication( true );
-   tstep2->optimizeCommunication( false );
+   if( aggregated )
+   {
+      // (2): identical communication, but equal level and coarse to fine messages are aggregated
+      tstep2->optimizeCommunication( true );
+      tstep2->aggregateCommunication( true );
+      tstep2->enableTiming();
+   }
+   else
+   {
+      tstep2->optimizeCommunication( false );
+   }
 
    timeloop.addFuncBeforeTimeStep( makeSharedFunctor( tstep1 ), "LBM refinement time step (1)" );
    timeloop.addFuncBeforeTimeStep( makeSharedFunctor( tstep2 ), "LBM refinement time step (2)" );
@@ -491,6 +507,15 @@ int main( int argc, char ** argv )
    timeloop.run( timeloopTiming );
    timeloopTiming.logResultOnRoot();
 
+   if( aggregated )
+   {
+      uint_t savedMessages = tstep2->savedMessages();
+      mpi::allReduceInplace( savedMessages, mpi::SUM );
+      WALBERLA_LOG_INFO_ON_ROOT( "Messages saved by aggregated communication: " << savedMessages );
+      if( MPIManager::instance()->numProcesses() > 1 )
+         WALBERLA_CHECK_GREATER( savedMessages, uint_t(0) );
+   }
+
    logging::Logging::printFooterOnStream();
    
    return EXIT_SUCCESS;
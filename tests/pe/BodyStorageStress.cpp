@@ -0,0 +1,294 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BodyStorageStress.cpp
+//! \brief Stress test and microbenchmark of the system ID lookup of BodyStorage with the shadow copy / migration /
+//!        deletion traffic of pe::communication::parseMessage
+//
+//======================================================================================================================
+
+#include "pe/Materials.h"
+#include "pe/rigidbody/Sphere.h"
+#include "pe/Types.h"
+#include "pe/rigidbody/BodyStorage.h"
+#include "pe/rigidbody/SystemIDIndex.h"
+#include "core/DataTypes.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Random.h"
+#include "core/timing/Timer.h"
+
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace walberla;
+using namespace walberla::pe;
+
+/// system ID of the n-th body created on process 'rank' (see UniqueID: rank in the high bits)
+walberla::id_t systemID( const uint_t rank, const uint_t n )
+{
+   return ( static_cast<walberla::id_t>( rank ) << 52 ) | static_cast<walberla::id_t>( n + 1 );
+}
+
+BodyID createBody( const walberla::id_t sid )
+{
+   return new Sphere( sid, 0, Vec3(0,0,0), Vec3(0,0,0), Quat(), 1, Material::find("iron"), false, true, false );
+}
+
+/// random insertions, updates, lookups and removals compared to std::map
+void testIndex( const uint_t operations )
+{
+   typedef SystemIDIndex<size_t> Index;
+
+   Index index;
+   std::map< walberla::id_t, size_t > reference;
+   std::vector< walberla::id_t > ids;
+
+   math::seedRandomGenerator( 23 );
+
+   for( uint_t op = 0; op < operations; ++op )
+   {
+      const uint_t type = math::intRandom<uint_t>( 0, 9 );
+      if( type < 4 || ids.empty() )
+      {
+         // ids of up to 8 processes with consecutive counters
+         walberla::id_t sid;
+         do {
+            sid = systemID( math::intRandom<uint_t>( 0, 7 ), math::intRandom<uint_t>( 0, 4 * ( ids.size() + 1 ) ) );
+         } while( reference.find( sid ) != reference.end() );
+
+         WALBERLA_CHECK_EQUAL( index.find( sid ), Index::npos );
+         index.insert( sid, op );
+         reference[sid] = op;
+         ids.push_back( sid );
+      }
+      else if( type < 7 )
+      {
+         const size_t i = math::intRandom<size_t>( 0, ids.size() - 1 );
+         index.erase( ids[i] );
+         reference.erase( ids[i] );
+         WALBERLA_CHECK_EQUAL( index.find( ids[i] ), Index::npos );
+         ids[i] = ids.back();
+         ids.pop_back();
+      }
+      else
+      {
+         const size_t i = math::intRandom<size_t>( 0, ids.size() - 1 );
+         index.update( ids[i], op );
+         reference[ ids[i] ] = op;
+      }
+
+      WALBERLA_CHECK_EQUAL( index.size(), reference.size() );
+      WALBERLA_CHECK_LESS_EQUAL( 2 * index.size(), index.capacity() );
+
+      if( op % 97 == 0 )
+      {
+         for( auto it = reference.begin(); it != reference.end(); ++it )
+            WALBERLA_CHECK_EQUAL( index.find( it->first ), it->second );
+      }
+   }
+
+   index.clear();
+   WALBERLA_CHECK_EQUAL( index.size(), 0 );
+   for( auto it = reference.begin(); it != reference.end(); ++it )
+      WALBERLA_CHECK_EQUAL( index.find( it->first ), Index::npos );
+}
+
+/// one step of the notification traffic of parseMessage, applied to a local and a shadow storage
+class NotificationTraffic
+{
+public:
+   NotificationTraffic( BodyStorage & localStorage, BodyStorage & shadowStorage ) :
+      localStorage_( localStorage ), shadowStorage_( shadowStorage ), created_( 0 ) {}
+
+   void step( const uint_t notifications )
+   {
+      for( uint_t n = 0; n < notifications; ++n )
+      {
+         const uint_t type = math::intRandom<uint_t>( 0, 9 );
+         if( type < 3 || shadowStorage_.isEmpty() )
+         {
+            // rigidBodyCopyNotification: new shadow copy from a neighbor
+            const walberla::id_t sid = systemID( uint_t(1) + created_ % uint_t(26), created_ );
+            ++created_;
+            WALBERLA_CHECK( shadowStorage_.find( sid ) == shadowStorage_.end() );
+            shadowStorage_.add( createBody( sid ) );
+         }
+         else if( type < 6 )
+         {
+            // rigidBodyUpdateNotification
+            const walberla::id_t sid = randomID( shadowStorage_ );
+            auto bodyIt = shadowStorage_.find( sid );
+            WALBERLA_CHECK( bodyIt != shadowStorage_.end() );
+            WALBERLA_CHECK_EQUAL( bodyIt->getSystemID(), sid );
+         }
+         else if( type < 7 )
+         {
+            // rigidBodyMigrationNotification: shadow copy becomes local body
+            const walberla::id_t sid = randomID( shadowStorage_ );
+            auto bodyIt = shadowStorage_.find( sid );
+            WALBERLA_CHECK( bodyIt != shadowStorage_.end() );
+            BodyID b( *bodyIt );
+            shadowStorage_.release( b );
+            localStorage_.add( b );
+            WALBERLA_CHECK( shadowStorage_.find( sid ) == shadowStorage_.end() );
+            WALBERLA_CHECK( localStorage_.find( sid ) != localStorage_.end() );
+         }
+         else if( type < 9 )
+         {
+            // rigidBodyRemovalNotification / rigidBodyDeletionNotification
+            const walberla::id_t sid = randomID( shadowStorage_ );
+            auto bodyIt = shadowStorage_.find( sid );
+            WALBERLA_CHECK( bodyIt != shadowStorage_.end() );
+            shadowStorage_.remove( *bodyIt );
+            WALBERLA_CHECK( shadowStorage_.find( sid ) == shadowStorage_.end() );
+         }
+         else if( !localStorage_.isEmpty() )
+         {
+            // local body leaves the domain (migration to a neighbor)
+            const walberla::id_t sid = randomID( localStorage_ );
+            localStorage_.remove( sid );
+            WALBERLA_CHECK( localStorage_.find( sid ) == localStorage_.end() );
+         }
+      }
+   }
+
+private:
+   static walberla::id_t randomID( const BodyStorage & storage )
+   {
+      return storage.at( math::intRandom<size_t>( 0, storage.size() - 1 ) )->getSystemID();
+   }
+
+   BodyStorage & localStorage_;
+   BodyStorage & shadowStorage_;
+   uint_t created_;
+};
+
+void testBodyStorage( const uint_t steps )
+{
+   math::seedRandomGenerator( 42 );
+
+   BodyStorage localStorage;
+   BodyStorage shadowStorage;
+   NotificationTraffic traffic( localStorage, shadowStorage );
+
+   for( uint_t step = 0; step < steps; ++step )
+   {
+      traffic.step( uint_t(1000) );
+
+      localStorage.validate();
+      shadowStorage.validate();
+      for( auto it = localStorage.begin(); it != localStorage.end(); ++it )
+         WALBERLA_CHECK_EQUAL( localStorage.find( it->getSystemID() ), it );
+      for( auto it = shadowStorage.begin(); it != shadowStorage.end(); ++it )
+         WALBERLA_CHECK_EQUAL( shadowStorage.find( *it ), it );
+   }
+
+   WALBERLA_LOG_INFO( "stress test: " << localStorage.size() << " local bodies, " << shadowStorage.size() << " shadow copies" );
+}
+
+/// lookup, insertion and removal times of SystemIDIndex and std::map for the shadow copy churn of one process
+void measureLookups( const uint_t numberOfShadowCopies, const uint_t steps )
+{
+   math::seedRandomGenerator( 7 );
+
+   // per step: 1/4 of the shadow copies is replaced, all shadow copies are updated (found) once
+   std::vector< walberla::id_t > alive;
+   uint_t created = 0;
+   for( ; created < numberOfShadowCopies; ++created )
+      alive.push_back( systemID( uint_t(1) + created % uint_t(26), created ) );
+
+   std::vector< std::vector< walberla::id_t > > removed( steps ), added( steps ), updated( steps );
+   {
+      std::vector< walberla::id_t > current( alive );
+      std::mt19937 generator( 7 );
+      for( uint_t step = 0; step < steps; ++step )
+      {
+         for( uint_t i = 0; i < numberOfShadowCopies / uint_t(4); ++i )
+         {
+            const size_t pos = math::intRandom<size_t>( 0, current.size() - 1 );
+            removed[step].push_back( current[pos] );
+            current[pos] = systemID( uint_t(1) + created % uint_t(26), created );
+            ++created;
+            added[step].push_back( current[pos] );
+         }
+         updated[step] = current;
+         std::shuffle( updated[step].begin(), updated[step].end(), generator );
+      }
+   }
+
+   uint_t checksum[2] = { 0, 0 };
+   WcTimer timer[2];
+
+   for( int useMap = 0; useMap <= 1; ++useMap )
+   {
+      SystemIDIndex<size_t> index;
+      std::map< walberla::id_t, size_t > map;
+      for( size_t i = 0; i < alive.size(); ++i )
+      {
+         if( useMap == 1 ) map[ alive[i] ] = i; else index.insert( alive[i], i );
+      }
+
+      timer[useMap].start();
+      for( uint_t step = 0; step < steps; ++step )
+      {
+         for( size_t i = 0; i < removed[step].size(); ++i )
+         {
+            if( useMap == 1 )
+            {
+               const size_t pos = map.find( removed[step][i] )->second;
+               map.erase( removed[step][i] );
+               map[ added[step][i] ] = pos;
+            }
+            else
+            {
+               const size_t pos = index.find( removed[step][i] );
+               index.erase( removed[step][i] );
+               index.insert( added[step][i], pos );
+            }
+         }
+         for( size_t i = 0; i < updated[step].size(); ++i )
+            checksum[useMap] += ( useMap == 1 ) ? map.find( updated[step][i] )->second : index.find( updated[step][i] );
+      }
+      timer[useMap].end();
+   }
+
+   WALBERLA_CHECK_EQUAL( checksum[0], checksum[1] );
+
+   const double operations = double( steps ) * double( numberOfShadowCopies ) * 1.5;
+   WALBERLA_LOG_INFO( numberOfShadowCopies << " shadow copies: SystemIDIndex " << 1e9 * timer[0].total() / operations
+                      << " ns, std::map " << 1e9 * timer[1].total() / operations << " ns per notification" );
+}
+
+int main( int argc, char** argv )
+{
+   walberla::debug::enterTestMode();
+
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+
+   bool shortrun = false;
+   for( int i = 1; i < argc; ++i )
+      if( std::strcmp( argv[i], "--shortrun" ) == 0 ) shortrun = true;
+
+   testIndex( shortrun ? uint_t(20000) : uint_t(200000) );
+   testBodyStorage( shortrun ? uint_t(20) : uint_t(200) );
+
+   measureLookups( uint_t(1000), uint_t(20) );
+   measureLookups( shortrun ? uint_t(10000) : uint_t(100000), uint_t(20) );
+
+   return EXIT_SUCCESS;
+}
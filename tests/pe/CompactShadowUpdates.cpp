@@ -0,0 +1,209 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file CompactShadowUpdates.cpp
+//! \brief Checks that the shadow copies synchronized with compact updates stay within the tolerances of the shadow
+//!        copies synchronized with full updates
+//
+//======================================================================================================================
+
+#include "blockforest/all.h"
+#include "core/all.h"
+
+#include "pe/basic.h"
+#include "pe/synchronization/SyncNextNeighbors.h"
+#include "pe/synchronization/SyncShadowOwners.h"
+
+#include "core/debug/TestSubsystem.h"
+
+#include <boost/tuple/tuple.hpp>
+
+#include <cmath>
+#include <map>
+
+using namespace walberla;
+using namespace walberla::pe;
+
+typedef boost::tuple<Sphere> BodyTuple ;
+
+const real_t positionTolerance    = real_t(1e-3);
+const real_t orientationTolerance = real_t(1e-3);
+const real_t velocityTolerance    = real_t(1e-2);
+
+// sizes of the marshalled update notifications (system ID, position, orientation, velocities)
+const uint_t fullUpdateSize    = uint_c( sizeof( walberla::id_t ) + 3 * sizeof( real_t ) + 4 * sizeof( real_t ) + 6 * sizeof( real_t ) );
+const uint_t compactUpdateSize = uint_c( sizeof( walberla::id_t ) + 3 * sizeof( real_t ) + 4 * sizeof( float  ) + 6 * sizeof( float  ) );
+
+/// lattice position of the body with the given user ID
+Vec3 center( walberla::id_t uid )
+{
+   const uint_t i = uint_c( uid );
+   return Vec3( real_c( i % 6 ) * real_t(3) + real_t(2.5), real_c( ( i / 6 ) % 6 ) * real_t(3) + real_t(2.5), real_c( i / 36 ) * real_t(3) + real_t(2.5) );
+}
+
+/// moves the local bodies: bodies with even user ID circle around their lattice positions (and cross block
+/// boundaries), the other ones rest with a jitter below the tolerances
+void move( BlockForest& forest, BlockDataID storageID, uint_t step )
+{
+   const real_t t = real_c( step ) * real_t(0.1);
+   for( auto it = forest.begin(); it != forest.end(); ++it )
+   {
+      for( auto bodyIt = LocalBodyIterator::begin( *it, storageID ); bodyIt != LocalBodyIterator::end(); ++bodyIt )
+      {
+         const walberla::id_t uid = bodyIt->getID();
+         if( uid % 2 == 0 )
+         {
+            bodyIt->setPosition( center( uid ) + Vec3( real_t(1.5) * std::cos( t ), real_t(1.5) * std::sin( t ), real_t(0) ) );
+            bodyIt->setOrientation( Quat( Vec3( real_t(0), real_t(0), real_t(1) ), t ) );
+            bodyIt->setLinearVel( Vec3( -real_t(0.15) * std::sin( t ), real_t(0.15) * std::cos( t ), real_t(0) ) );
+            bodyIt->setAngularVel( Vec3( real_t(0), real_t(0), real_t(0.1) ) );
+         }
+         else
+         {
+            const real_t jitter = real_t(0.5) * std::sin( real_t(7) * t );
+            bodyIt->setPosition( center( uid ) + Vec3( jitter * positionTolerance, real_t(0), real_t(0) ) );
+            bodyIt->setLinearVel( Vec3( real_t(0), jitter * velocityTolerance, real_t(0) ) );
+         }
+      }
+   }
+}
+
+std::map< walberla::id_t, BodyID > shadowCopies( IBlock& block, BlockDataID storageID )
+{
+   std::map< walberla::id_t, BodyID > shadows;
+   BodyStorage& shadowStorage = (*block.getData< Storage >( storageID ))[StorageType::SHADOW];
+   for( auto bodyIt = shadowStorage.begin(); bodyIt != shadowStorage.end(); ++bodyIt )
+      shadows[ bodyIt->getID() ] = *bodyIt;
+   return shadows;
+}
+
+void checkTolerance( const Vec3& v, const Vec3& ref, real_t tolerance, const std::string& name, walberla::id_t uid )
+{
+   for( uint_t d = 0; d < 3; ++d )
+      WALBERLA_CHECK_LESS_EQUAL( std::fabs( v[d] - ref[d] ), tolerance + real_t(1e-6) * ( real_t(1) + std::fabs( ref[d] ) ),
+                                 name << " of shadow copy of body " << uid << ": " << v << " != " << ref );
+}
+
+void runTest( bool shadowOwners )
+{
+   shared_ptr< StructuredBlockForest > forest = blockforest::createUniformBlockGrid(
+            uint_c( 2), uint_c( 2), uint_c( 2), // number of blocks in x,y,z direction
+            uint_c( 1), uint_c( 1), uint_c( 1), // how many cells per block (x,y,z)
+            real_c(10),                         // dx: length of one cell in physical coordinates
+            0,                                  // max blocks per process
+            false, false,                       // include metis / force metis
+            false, false, false );              // no periodicity
+
+   BlockDataID fullID    = forest->addBlockData( createStorageDataHandling<BodyTuple>(), "Storage (full updates)" );
+   BlockDataID compactID = forest->addBlockData( createStorageDataHandling<BodyTuple>(), "Storage (compact updates)" );
+
+   // the resting bodies are large enough to have shadow copies next to the block boundaries
+   BodyStorage globalStorage;
+   for( walberla::id_t uid = 0; uid < 6 * 6 * 6; ++uid )
+   {
+      const real_t radius = ( uid % 2 == 0 ) ? real_t(0.4) : real_t(1.6);
+      createSphere( globalStorage, forest->getBlockStorage(), fullID,    uid, center( uid ), radius );
+      createSphere( globalStorage, forest->getBlockStorage(), compactID, uid, center( uid ), radius );
+   }
+   move( forest->getBlockForest(), fullID,    0 );
+   move( forest->getBlockForest(), compactID, 0 );
+
+   // initial shadow copies
+   if( shadowOwners )
+   {
+      syncShadowOwners<BodyTuple>( forest->getBlockForest(), fullID );
+      syncShadowOwners<BodyTuple>( forest->getBlockForest(), compactID );
+   } else
+   {
+      syncNextNeighbors<BodyTuple>( forest->getBlockForest(), fullID );
+      syncNextNeighbors<BodyTuple>( forest->getBlockForest(), compactID );
+   }
+
+   CompactShadowUpdates compact( positionTolerance, orientationTolerance, velocityTolerance );
+
+   uint_t checkedShadows = 0;
+   for( uint_t step = 1; step <= 100; ++step )
+   {
+      move( forest->getBlockForest(), fullID,    step );
+      move( forest->getBlockForest(), compactID, step );
+
+      if( shadowOwners )
+      {
+         syncShadowOwners<BodyTuple>( forest->getBlockForest(), fullID );
+         syncShadowOwnersCompact<BodyTuple>( forest->getBlockForest(), compactID, compact );
+      } else
+      {
+         syncNextNeighbors<BodyTuple>( forest->getBlockForest(), fullID );
+         syncNextNeighborsCompact<BodyTuple>( forest->getBlockForest(), compactID, compact );
+      }
+
+      // the shadow copies of the full updates carry the exact state of the owner
+      for( auto it = forest->begin(); it != forest->end(); ++it )
+      {
+         const std::map< walberla::id_t, BodyID > reference = shadowCopies( *it, fullID );
+         const std::map< walberla::id_t, BodyID > shadows   = shadowCopies( *it, compactID );
+         WALBERLA_CHECK_EQUAL( shadows.size(), reference.size() );
+         for( auto shadowIt = shadows.begin(), refIt = reference.begin(); shadowIt != shadows.end(); ++shadowIt, ++refIt )
+         {
+            WALBERLA_CHECK_EQUAL( shadowIt->first, refIt->first );
+            const BodyID b   = shadowIt->second;
+            const BodyID ref = refIt->second;
+            checkTolerance( b->getPosition(),   ref->getPosition(),   positionTolerance, "position", shadowIt->first );
+            checkTolerance( b->getLinearVel(),  ref->getLinearVel(),  velocityTolerance, "linear velocity", shadowIt->first );
+            checkTolerance( b->getAngularVel(), ref->getAngularVel(), velocityTolerance, "angular velocity", shadowIt->first );
+            for( uint_t i = 0; i < 4; ++i )
+               WALBERLA_CHECK_LESS_EQUAL( std::fabs( b->getQuaternion()[i] - ref->getQuaternion()[i] ), orientationTolerance + real_t(1e-6),
+                                          "orientation of shadow copy of body " << shadowIt->first );
+            ++checkedShadows;
+         }
+      }
+   }
+
+   mpi::reduceInplace( checkedShadows, mpi::SUM );
+   uint_t updates        = compact.getNumberOfUpdates();
+   uint_t skippedUpdates = compact.getNumberOfSkippedUpdates();
+   mpi::reduceInplace( updates, mpi::SUM );
+   mpi::reduceInplace( skippedUpdates, mpi::SUM );
+
+   WALBERLA_ROOT_SECTION()
+   {
+      WALBERLA_CHECK_GREATER( checkedShadows, 0 );
+      WALBERLA_CHECK_GREATER( updates, 0 );
+      WALBERLA_CHECK_GREATER( skippedUpdates, 0 );
+
+      const uint_t fullVolume    = ( updates + skippedUpdates ) * fullUpdateSize;
+      const uint_t compactVolume = updates * compactUpdateSize;
+      WALBERLA_LOG_INFO( ( shadowOwners ? "syncShadowOwners: " : "syncNextNeighbors: " ) << checkedShadows << " shadow copies checked, "
+                         << updates << " compact updates sent, " << skippedUpdates << " skipped" );
+      WALBERLA_LOG_INFO( "update notification volume: " << compactVolume << " bytes instead of " << fullVolume << " bytes ("
+                         << real_c( compactVolume ) / real_c( fullVolume ) << ")" );
+   }
+}
+
+int main( int argc, char ** argv )
+{
+   walberla::debug::enterTestMode();
+
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+
+   SetBodyTypeIDs<BodyTuple>::execute();
+
+   runTest( false );
+   // syncShadowOwners only supports one block per process
+   if( mpi::MPIManager::instance()->numProcesses() == 8 )
+      runTest( true );
+
+   return EXIT_SUCCESS;
+}
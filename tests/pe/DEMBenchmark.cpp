@@ -0,0 +1,196 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file DEMBenchmark.cpp
+//! \brief Strong scaling of the thread-parallel DEM solver for spheres settling in a box, checks that the trajectories
+//!        are identical to the serial contact resolution for every number of threads
+//
+//======================================================================================================================
+
+#include "pe/basic.h"
+#include "pe/ccd/HashGridsDataHandling.h"
+
+#include "blockforest/all.h"
+#include "core/all.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Random.h"
+#include "core/OpenMP.h"
+#include "core/timing/Timer.h"
+
+#include <cstring>
+#include <map>
+#include <vector>
+
+using namespace walberla;
+using namespace walberla::pe;
+
+typedef boost::tuple<Plane, Sphere> BodyTuple ;
+
+struct BodyState
+{
+   Vec3 position;
+   Vec3 linearVel;
+   Vec3 angularVel;
+};
+
+/// settles a densely packed, slightly overlapping lattice of spheres in a closed box and returns the final states
+std::map< walberla::id_t, BodyState > settle( uint_t dim, uint_t steps, bool threadParallel, WcTimer & timer, size_t & contacts )
+{
+   const real_t length = real_c( dim );
+
+   shared_ptr<BodyStorage> globalBodyStorage = make_shared<BodyStorage>();
+
+   shared_ptr< StructuredBlockForest > forest = blockforest::createUniformBlockGrid(
+            AABB( real_t(0), real_t(0), real_t(0), length, length, real_t(2) * length ),
+            uint_t(1), uint_t(1), uint_t(1), // number of blocks in x,y,z direction
+            uint_t(1), uint_t(1), uint_t(1), // how many cells per block (x,y,z)
+            true,                            // one block per process
+            false, false, false );           // no periodicity
+
+   auto storageID = forest->addBlockData(createStorageDataHandling<BodyTuple>(), "Storage");
+   auto hccdID    = forest->addBlockData(ccd::createHashGridsDataHandling( globalBodyStorage, storageID ), "HCCD");
+   auto fcdID     = forest->addBlockData(fcd::createGenericFCDDataHandling<BodyTuple, fcd::AnalyticCollideFunctor>(), "FCD");
+
+   cr::DEM cr( globalBodyStorage, forest->getBlockStoragePointer(), storageID, hccdID, fcdID, NULL );
+   cr.setGlobalLinearAcceleration( Vec3( real_t(0), real_t(0), real_t(-10) ) );
+   cr.setThreadParallel( threadParallel );
+
+   MaterialID material = Material::find( "settling" );
+
+   pe::createPlane( *globalBodyStorage, 0, Vec3( 1, 0, 0), Vec3(     0,      0,                  0), material );
+   pe::createPlane( *globalBodyStorage, 0, Vec3(-1, 0, 0), Vec3(length,      0,                  0), material );
+   pe::createPlane( *globalBodyStorage, 0, Vec3( 0, 1, 0), Vec3(     0,      0,                  0), material );
+   pe::createPlane( *globalBodyStorage, 0, Vec3( 0,-1, 0), Vec3(     0, length,                  0), material );
+   pe::createPlane( *globalBodyStorage, 0, Vec3( 0, 0, 1), Vec3(     0,      0,                  0), material );
+   pe::createPlane( *globalBodyStorage, 0, Vec3( 0, 0,-1), Vec3(     0,      0, real_t(2) * length), material );
+
+   math::seedRandomGenerator( 42 );
+   walberla::id_t uid = 0;
+   for( uint_t z = 0; z < dim; ++z )
+      for( uint_t y = 0; y < dim; ++y )
+         for( uint_t x = 0; x < dim; ++x )
+         {
+            const Vec3 position( real_c(x) + real_t(0.5), real_c(y) + real_t(0.5), real_c(z) + real_t(0.5) );
+            SphereID sphere = pe::createSphere( *globalBodyStorage, forest->getBlockStorage(), storageID, ++uid, position,
+                                                math::realRandom<real_t>( real_t(0.49), real_t(0.51) ), material );
+            WALBERLA_CHECK_NOT_NULLPTR( sphere );
+            sphere->setLinearVel( Vec3( math::realRandom<real_t>( real_t(-0.1), real_t(0.1) ),
+                                        math::realRandom<real_t>( real_t(-0.1), real_t(0.1) ),
+                                        math::realRandom<real_t>( real_t(-0.1), real_t(0.1) ) ) );
+         }
+
+   contacts = 0;
+   for( uint_t step = 0; step < steps; ++step )
+   {
+      timer.start();
+      cr.timestep( real_t(0.001) );
+      timer.end();
+      contacts += cr.getNumberOfContactsTreated();
+   }
+
+   std::map< walberla::id_t, BodyState > states;
+   for( auto it = forest->begin(); it != forest->end(); ++it )
+   {
+      for( auto bodyIt = LocalBodyIterator::begin( *it, storageID ); bodyIt != LocalBodyIterator::end(); ++bodyIt )
+      {
+         BodyState & state = states[ bodyIt->getID() ];
+         state.position   = bodyIt->getPosition();
+         state.linearVel  = bodyIt->getLinearVel();
+         state.angularVel = bodyIt->getAngularVel();
+      }
+   }
+
+   return states;
+}
+
+void checkIdentical( const std::map< walberla::id_t, BodyState > & states, const std::map< walberla::id_t, BodyState > & reference )
+{
+   WALBERLA_CHECK_EQUAL( states.size(), reference.size() );
+   for( auto it = states.begin(), refIt = reference.begin(); it != states.end(); ++it, ++refIt )
+   {
+      WALBERLA_CHECK_EQUAL( it->first, refIt->first );
+      for( uint_t d = 0; d < 3; ++d )
+      {
+         WALBERLA_CHECK_IDENTICAL( it->second.position[d]  , refIt->second.position[d]  , "body " << it->first );
+         WALBERLA_CHECK_IDENTICAL( it->second.linearVel[d] , refIt->second.linearVel[d] , "body " << it->first );
+         WALBERLA_CHECK_IDENTICAL( it->second.angularVel[d], refIt->second.angularVel[d], "body " << it->first );
+      }
+   }
+}
+
+int main( int argc, char** argv )
+{
+   walberla::debug::enterTestMode();
+
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+
+   bool shortrun = false;
+   for( int i = 1; i < argc; ++i )
+      if( std::strcmp( argv[i], "--shortrun" ) == 0 ) shortrun = true;
+
+   const uint_t dim   = shortrun ? uint_t(8)  : uint_t(24);
+   const uint_t steps = shortrun ? uint_t(20) : uint_t(100);
+
+   SetBodyTypeIDs<BodyTuple>::execute();
+   createMaterial( "settling", real_t(1), real_t(0.5), real_t(0.3), real_t(0.3), real_t(0.3), real_t(1e5), real_t(1e4), real_t(10), real_t(10) );
+
+   WALBERLA_LOG_INFO( "DEM benchmark with " << dim * dim * dim << " spheres" );
+
+#ifdef _OPENMP
+   const int maxThreads = omp_get_max_threads();
+#else
+   const int maxThreads = 1;
+#endif
+
+   // serial contact resolution in the original contact order
+   WcTimer serialTimer;
+   size_t serialContacts( 0 );
+   const std::map< walberla::id_t, BodyState > reference = settle( dim, steps, false, serialTimer, serialContacts );
+   WALBERLA_CHECK_GREATER( serialContacts, 0 );
+
+   std::vector< int > threadCounts;
+   for( int threads = 1; threads < maxThreads; threads *= 2 )
+      threadCounts.push_back( threads );
+   threadCounts.push_back( maxThreads );
+
+   std::vector< WcTimer > timers( threadCounts.size() );
+
+   for( size_t i = 0; i < threadCounts.size(); ++i )
+   {
+#ifdef _OPENMP
+      omp_set_num_threads( threadCounts[i] );
+#endif
+      size_t contacts( 0 );
+      const std::map< walberla::id_t, BodyState > states = settle( dim, steps, true, timers[i], contacts );
+
+      WALBERLA_CHECK_EQUAL( contacts, serialContacts );
+      checkIdentical( states, reference );
+   }
+
+#ifdef _OPENMP
+   omp_set_num_threads( maxThreads );
+#endif
+
+   WALBERLA_LOG_INFO( serialContacts / steps << " treated contacts per time step" );
+   WALBERLA_LOG_INFO( "serial resolution: " << serialTimer.average() << " s per time step" );
+   for( size_t i = 0; i < threadCounts.size(); ++i )
+   {
+      WALBERLA_LOG_INFO( threadCounts[i] << " thread(s): " << timers[i].average() << " s per time step (speedup: "
+                         << ( timers[0].average() / timers[i].average() ) << ")" );
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -110,9 +110,9 @@ int main( int argc, char** argv )
       if (sp != NULL) sp->setLinearVel(Vec3(math::realRandom<real_t>(-dv, dv), math::realRandom<real_t>(-dv, dv), math::realRandom<real_t>(-dv, dv)));
     }
 
-    pe::createSphere(*globalBodyStorage, forest->getBlockStorage(), storageID, 999999999,
-                     Vec3(15,15,15), 7,
-                     iron, true, false, true);
+    SphereID globalSphere = pe::createSphere(*globalBodyStorage, forest->getBlockStorage(), storageID, 999999999,
+                                             Vec3(15,15,15), 7,
+                                             iron, true, false, true);
 
     syncShadowOwners<BodyTuple>( forest->getBlockForest(), storageID);
     for (int step=0; step < 100; ++step){
@@ -122,6 +122,9 @@ int main( int argc, char** argv )
        for (auto it = forest->begin(); it != forest->end(); ++it){
           IBlock & currentBlock = *it;
 
+          // the second half is run with reuse of the candidate pairs, which must not change the contacts
+          if (step == 50) currentBlock.getData< ccd::HashGrids >( hccdID )->setSkin( real_c(0.5) );
+
           ccd::ICCD* sccd = currentBlock.getData< ccd::ICCD >( sccdID );
           ccd::ICCD* hccd = currentBlock.getData< ccd::ICCD >( hccdID );
           fcd::IFCD* fcd  = currentBlock.getData< fcd::IFCD >( fcdID );
@@ -142,6 +145,59 @@ int main( int argc, char** argv )
        }
     }
 
+    // small displacements (less than half of the skin) do not require a regeneration of the candidate pairs
+    // (setting the skin again discards the candidates, so that the displacements are measured from step 0 on)
+    for (auto it = forest->begin(); it != forest->end(); ++it)
+       it->getData< ccd::HashGrids >( hccdID )->setSkin( real_c(0.5) );
+
+    std::map< IBlock*, size_t > rebuilds;
+    for (int step=0; step < 10; ++step){
+       for (auto it = forest->begin(); it != forest->end(); ++it){
+          IBlock & currentBlock = *it;
+
+          for (auto bodyIt = LocalBodyIterator::begin(currentBlock, storageID); bodyIt != LocalBodyIterator::end(); ++bodyIt)
+          {
+             bodyIt->setPosition(bodyIt->getPosition() + Vec3(real_c(0.01), real_c(-0.01), real_c(0.01)));
+          }
+
+          ccd::ICCD* sccd      = currentBlock.getData< ccd::ICCD >( sccdID );
+          ccd::HashGrids* hccd = currentBlock.getData< ccd::HashGrids >( hccdID );
+          fcd::IFCD* fcd       = currentBlock.getData< fcd::IFCD >( fcdID );
+          Contacts cont1 = fcd->generateContacts( sccd->generatePossibleContacts() );
+          auto tmp1 = cont1.size();
+          Contacts cont2 = fcd->generateContacts( hccd->generatePossibleContacts() );
+          WALBERLA_CHECK_EQUAL(tmp1, cont2.size());
+          if (step == 0)
+             rebuilds[&currentBlock] = hccd->getNumberOfRebuilds();
+          else
+             WALBERLA_CHECK_EQUAL(rebuilds[&currentBlock], hccd->getNumberOfRebuilds());
+       }
+    }
+
+    // exchanging a global body (same number of global bodies) requires a regeneration of the candidate pairs
+    globalBodyStorage->remove( globalSphere );
+    pe::createSphere(*globalBodyStorage, forest->getBlockStorage(), storageID, 999999998,
+                     Vec3(15,15,15), 7,
+                     iron, true, false, true);
+    for (auto it = forest->begin(); it != forest->end(); ++it){
+       IBlock & currentBlock = *it;
+
+       ccd::ICCD* sccd      = currentBlock.getData< ccd::ICCD >( sccdID );
+       ccd::HashGrids* hccd = currentBlock.getData< ccd::HashGrids >( hccdID );
+       fcd::IFCD* fcd       = currentBlock.getData< fcd::IFCD >( fcdID );
+       Contacts cont1 = fcd->generateContacts( sccd->generatePossibleContacts() );
+       auto tmp1 = cont1.size();
+       Contacts cont2 = fcd->generateContacts( hccd->generatePossibleContacts() );
+       WALBERLA_CHECK_EQUAL(tmp1, cont2.size());
+       WALBERLA_CHECK_EQUAL(rebuilds[&currentBlock] + 1, hccd->getNumberOfRebuilds());
+    }
+
+    for (auto it = forest->begin(); it != forest->end(); ++it){
+       const ccd::HashGrids* hccd = it->getData< ccd::HashGrids >( hccdID );
+       WALBERLA_CHECK_LESS(hccd->getNumberOfRebuilds(), hccd->getNumberOfContactGenerations());
+       WALBERLA_LOG_DETAIL_ON_ROOT("rebuild frequency of the candidate pairs: " << hccd->getRebuildFrequency());
+    }
+
     forest.reset();
 
     return EXIT_SUCCESS;
@@ -0,0 +1,190 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file HashGridsBenchmark.cpp
+//! \brief Strong scaling of the thread-parallel HashGrids coarse collision detection for the bidisperse particle bed
+//!        of apps/showcases/BidisperseFluidizedBed, checks that the possible contacts do not depend on the number of
+//!        threads
+//
+//======================================================================================================================
+
+#include "pe/basic.h"
+#include "pe/ccd/HashGridsDataHandling.h"
+
+#include "blockforest/all.h"
+#include "core/all.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Random.h"
+#include "core/OpenMP.h"
+#include "core/timing/Timer.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace walberla;
+using namespace walberla::pe;
+
+typedef boost::tuple<Plane, Sphere> BodyTuple ;
+
+int main( int argc, char** argv )
+{
+   walberla::debug::enterTestMode();
+
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+
+   bool shortrun = false;
+   for( int i = 1; i < argc; ++i )
+      if( std::strcmp( argv[i], "--shortrun" ) == 0 ) shortrun = true;
+
+   // particle bed of the bidisperse fluidized bed showcase (without fluid coupling)
+   const real_t diameter1   = real_t(0.7);
+   const real_t diameter2   = real_t(0.8);
+   const real_t diameterAvg = real_t(0.75);
+   const real_t solidVolumeFraction = real_t(0.2);
+
+   const real_t xlength = real_t(32) * diameterAvg;
+   const real_t ylength = real_t(16) * diameterAvg;
+   const real_t zlength = ( shortrun ? real_t(16) : real_t(64) ) * diameterAvg;
+
+   const uint_t steps = shortrun ? uint_t(3) : uint_t(20);
+
+   shared_ptr<BodyStorage> globalBodyStorage = make_shared<BodyStorage>();
+
+   shared_ptr< StructuredBlockForest > forest = blockforest::createUniformBlockGrid(
+            AABB( real_t(0), real_t(0), real_t(0), xlength, ylength, zlength ),
+            uint_t(1), uint_t(1), uint_t(1), // number of blocks in x,y,z direction
+            uint_t(1), uint_t(1), uint_t(1), // how many cells per block (x,y,z)
+            true,                            // one block per process
+            false, false, false );           // no periodicity
+
+   SetBodyTypeIDs<BodyTuple>::execute();
+
+   auto storageID = forest->addBlockData(createStorageDataHandling<BodyTuple>(), "Storage");
+   auto hccdID    = forest->addBlockData(ccd::createHashGridsDataHandling( globalBodyStorage, storageID ), "HCCD");
+
+   MaterialID material = Material::find("iron");
+
+   pe::createPlane( *globalBodyStorage, 0, Vec3( 1, 0, 0), Vec3(      0,       0,       0), material );
+   pe::createPlane( *globalBodyStorage, 0, Vec3(-1, 0, 0), Vec3(xlength,       0,       0), material );
+   pe::createPlane( *globalBodyStorage, 0, Vec3( 0, 1, 0), Vec3(      0,       0,       0), material );
+   pe::createPlane( *globalBodyStorage, 0, Vec3( 0,-1, 0), Vec3(      0, ylength,       0), material );
+   pe::createPlane( *globalBodyStorage, 0, Vec3( 0, 0, 1), Vec3(      0,       0,       0), material );
+   pe::createPlane( *globalBodyStorage, 0, Vec3( 0, 0,-1), Vec3(      0,       0, zlength), material );
+
+   // random bidisperse sphere distribution (see createSpheresRandomly in BidisperseFluidizedBedDPM.cpp)
+   math::seedRandomGenerator( 42 );
+
+   const real_t effectiveMass1   = diameter1 * diameter1 * diameter1;
+   const real_t effectiveMass2   = diameter2 * diameter2 * diameter2;
+   const real_t effectiveMassAvg = diameterAvg * diameterAvg * diameterAvg;
+   const real_t percentageOfSpecies1 = ( effectiveMassAvg - effectiveMass2 ) / ( effectiveMass1 - effectiveMass2 );
+
+   const real_t radiusMax = real_t(0.5) * diameter2;
+   const real_t totalSphereVolume = xlength * ylength * zlength * solidVolumeFraction;
+
+   std::vector< SphereID > spheres;
+   real_t currentSphereVolume = real_t(0);
+   walberla::id_t uid = 0;
+   while( currentSphereVolume < totalSphereVolume )
+   {
+      const Vec3 position( math::realRandom<real_t>( radiusMax, xlength - radiusMax ),
+                           math::realRandom<real_t>( radiusMax, ylength - radiusMax ),
+                           math::realRandom<real_t>( radiusMax, zlength - radiusMax ) );
+      const real_t diameter = ( percentageOfSpecies1 > math::realRandom<real_t>( real_t(0), real_t(1) ) ) ? diameter1 : diameter2;
+
+      SphereID sphere = pe::createSphere( *globalBodyStorage, forest->getBlockStorage(), storageID, ++uid, position, diameter * real_t(0.5), material );
+      if( sphere != NULL )
+         spheres.push_back( sphere );
+
+      currentSphereVolume += math::M_PI / real_t(6) * diameter * diameter * diameter;
+   }
+
+   WALBERLA_LOG_INFO( "HashGrids benchmark with " << spheres.size() << " spheres" );
+
+#ifdef _OPENMP
+   const int maxThreads = omp_get_max_threads();
+#else
+   const int maxThreads = 1;
+#endif
+
+   std::vector< int > threadCounts;
+   for( int threads = 1; threads < maxThreads; threads *= 2 )
+      threadCounts.push_back( threads );
+   threadCounts.push_back( maxThreads );
+
+   std::vector< WcTimer > timers( threadCounts.size() );
+
+   for( auto it = forest->begin(); it != forest->end(); ++it )
+   {
+      ccd::ICCD* hccd = it->getData< ccd::ICCD >( hccdID );
+
+      for( uint_t step = 0; step < steps; ++step )
+      {
+         // the particles are moved between the detection steps (as they would be by the DEM solver)
+         for( auto sphere = spheres.begin(); sphere != spheres.end(); ++sphere )
+         {
+            const real_t dx = real_t(0.1) * diameterAvg;
+            const Vec3 delta( math::realRandom<real_t>( -dx, dx ), math::realRandom<real_t>( -dx, dx ), math::realRandom<real_t>( -dx, dx ) );
+            const Vec3 position = (*sphere)->getPosition() + delta;
+            if( position[0] > radiusMax && position[0] < xlength - radiusMax &&
+                position[1] > radiusMax && position[1] < ylength - radiusMax &&
+                position[2] > radiusMax && position[2] < zlength - radiusMax )
+               (*sphere)->setPosition( position );
+         }
+
+         PossibleContacts reference;
+         for( size_t i = 0; i < threadCounts.size(); ++i )
+         {
+#ifdef _OPENMP
+            omp_set_num_threads( threadCounts[i] );
+#endif
+            timers[i].start();
+            const PossibleContacts & contacts = hccd->generatePossibleContacts();
+            timers[i].end();
+
+            if( i == 0 )
+            {
+               reference = contacts;
+               continue;
+            }
+
+            // contacts (and their order) must be identical to the serial detection
+            WALBERLA_CHECK_EQUAL( contacts.size(), reference.size() );
+            for( size_t c = 0; c < contacts.size(); ++c )
+            {
+               WALBERLA_CHECK_EQUAL( contacts[c].first , reference[c].first  );
+               WALBERLA_CHECK_EQUAL( contacts[c].second, reference[c].second );
+            }
+         }
+
+         WALBERLA_CHECK_GREATER( reference.size(), 0 );
+      }
+   }
+
+#ifdef _OPENMP
+   omp_set_num_threads( maxThreads );
+#endif
+
+   for( size_t i = 0; i < threadCounts.size(); ++i )
+   {
+      WALBERLA_LOG_INFO( threadCounts[i] << " thread(s): " << timers[i].average() << " s per detection step (speedup: "
+                         << ( timers[0].average() / timers[i].average() ) << ")" );
+   }
+
+   forest.reset();
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,313 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file IncrementalBodyMappingTest.cpp
+//! \ingroup pe_coupling
+//! \brief Compares the incremental body mapping (with BodyMappingCache) and PDF reconstruction with the complete ones
+//
+//======================================================================================================================
+
+#include "blockforest/Initialization.h"
+
+#include "boundary/all.h"
+
+#include "core/DataTypes.h"
+#include "core/Environment.h"
+#include "core/debug/Debug.h"
+#include "core/debug/TestSubsystem.h"
+#include "core/math/all.h"
+#include "core/timing/Timer.h"
+
+#include "field/AddToStorage.h"
+
+#include "lbm/boundary/all.h"
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+
+#include "pe/basic.h"
+#include "pe/utility/DestroyBody.h"
+
+#include "pe_coupling/mapping/all.h"
+#include "pe_coupling/momentum_exchange_method/all.h"
+#include "pe_coupling/utility/all.h"
+
+#include <cstring>
+#include <vector>
+
+namespace incremental_body_mapping_test
+{
+
+///////////
+// USING //
+///////////
+
+using namespace walberla;
+using walberla::uint_t;
+
+typedef lbm::D3Q19< lbm::collision_model::SRT >  LatticeModel_T;
+
+typedef LatticeModel_T::Stencil                         Stencil_T;
+typedef lbm::PdfField< LatticeModel_T >                 PdfField_T;
+
+const uint_t FieldGhostLayers = 1;
+
+typedef walberla::uint8_t                 flag_t;
+typedef FlagField< flag_t >               FlagField_T;
+typedef GhostLayerField< pe::BodyID, 1 >  BodyField_T;
+
+typedef lbm::NoSlip< LatticeModel_T, flag_t > NoSlip_T;
+typedef pe_coupling::SimpleBB< LatticeModel_T, FlagField_T >  MO_T;
+typedef boost::tuples::tuple< NoSlip_T, MO_T > BoundaryConditions_T;
+typedef BoundaryHandling< FlagField_T, Stencil_T, BoundaryConditions_T > BoundaryHandling_T;
+
+typedef boost::tuple<pe::Sphere, pe::Box, pe::Capsule, pe::Ellipsoid> BodyTypeTuple;
+
+typedef pe_coupling::EquilibriumReconstructor< LatticeModel_T, BoundaryHandling_T > Reconstructor_T;
+
+///////////
+// FLAGS //
+///////////
+
+const FlagUID Fluid_Flag ( "fluid" );
+const FlagUID MO_Flag ( "moving obstacle" );
+const FlagUID FormerMO_Flag ( "former moving obstacle" );
+const FlagUID NoSlip_Flag  ( "no slip" );
+
+
+/////////////////////////////////////
+// BOUNDARY HANDLING CUSTOMIZATION //
+/////////////////////////////////////
+
+class MyBoundaryHandling
+{
+public:
+
+   MyBoundaryHandling( const BlockDataID & flagFieldID, const BlockDataID & pdfFieldID, const BlockDataID & bodyFieldID ) :
+      flagFieldID_( flagFieldID ), pdfFieldID_( pdfFieldID ), bodyFieldID_ ( bodyFieldID ) {}
+
+   BoundaryHandling_T * operator()( IBlock* const block, const StructuredBlockStorage* const storage ) const
+   {
+      FlagField_T * flagField = block->getData< FlagField_T >( flagFieldID_ );
+      PdfField_T *  pdfField  = block->getData< PdfField_T > ( pdfFieldID_ );
+      BodyField_T * bodyField = block->getData< BodyField_T >( bodyFieldID_ );
+
+      const auto fluid = flagField->flagExists( Fluid_Flag ) ? flagField->getFlag( Fluid_Flag ) : flagField->registerFlag( Fluid_Flag );
+
+      BoundaryHandling_T * handling = new BoundaryHandling_T( "moving obstacle boundary handling", flagField, fluid,
+                                                              boost::tuples::make_tuple( NoSlip_T( "NoSlip", NoSlip_Flag, pdfField ),
+                                                                                         MO_T (  "MO_BB",  MO_Flag, pdfField, flagField, bodyField, fluid, *storage, *block ) ) );
+      handling->fillWithDomain( FieldGhostLayers );
+      return handling;
+   }
+
+private:
+
+   const BlockDataID flagFieldID_;
+   const BlockDataID pdfFieldID_;
+   const BlockDataID bodyFieldID_;
+
+}; // class MyBoundaryHandling
+
+
+/// PDF, flag and body field with boundary handling
+struct Fields
+{
+   Fields( const shared_ptr< StructuredBlockForest > & blocks, const std::string & name )
+   {
+      LatticeModel_T latticeModel = LatticeModel_T( real_t(1) );
+      pdfFieldID  = lbm::addPdfFieldToStorage< LatticeModel_T >( blocks, "pdf field " + name, latticeModel, Vector3<real_t>(real_t(0)), real_t(1),
+                                                                 FieldGhostLayers, field::zyxf );
+      flagFieldID = field::addFlagFieldToStorage<FlagField_T>( blocks, "flag field " + name, FieldGhostLayers );
+      bodyFieldID = field::addToStorage<BodyField_T>( blocks, "body field " + name, NULL, field::zyxf, FieldGhostLayers );
+      boundaryHandlingID = blocks->addStructuredBlockData< BoundaryHandling_T >( MyBoundaryHandling( flagFieldID, pdfFieldID, bodyFieldID ),
+                                                                                 "boundary handling " + name );
+
+      // non-uniform PDFs, such that the reconstructed values depend on the neighborhood
+      for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+      {
+         PdfField_T * pdfField = blockIt->getData< PdfField_T >( pdfFieldID );
+         const CellInterval cells = pdfField->xyzSizeWithGhostLayer();
+         for( auto cell = cells.begin(); cell != cells.end(); ++cell )
+            for( uint_t f = 0; f < Stencil_T::Size; ++f )
+               pdfField->get( *cell, f ) += real_t(0.001) * real_c( ( 7 * cell->x() + 13 * cell->y() + 29 * cell->z() + cell_idx_c(f) ) % 17 );
+      }
+   }
+
+   BlockDataID pdfFieldID;
+   BlockDataID flagFieldID;
+   BlockDataID bodyFieldID;
+   BlockDataID boundaryHandlingID;
+};
+
+
+void checkIdentical( const shared_ptr< StructuredBlockForest > & blocks, const Fields & complete, const Fields & incremental, uint_t step )
+{
+   for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+   {
+      const FlagField_T * flagField    = blockIt->getData< FlagField_T >( complete.flagFieldID );
+      const FlagField_T * flagFieldInc = blockIt->getData< FlagField_T >( incremental.flagFieldID );
+      const BodyField_T * bodyField    = blockIt->getData< BodyField_T >( complete.bodyFieldID );
+      const BodyField_T * bodyFieldInc = blockIt->getData< BodyField_T >( incremental.bodyFieldID );
+      const PdfField_T *  pdfField     = blockIt->getData< PdfField_T >( complete.pdfFieldID );
+      const PdfField_T *  pdfFieldInc  = blockIt->getData< PdfField_T >( incremental.pdfFieldID );
+
+      const CellInterval cells = flagField->xyzSizeWithGhostLayer();
+      for( auto cell = cells.begin(); cell != cells.end(); ++cell )
+      {
+         WALBERLA_CHECK_EQUAL( flagField->get( *cell ), flagFieldInc->get( *cell ), "step " << step << ", cell " << *cell );
+         WALBERLA_CHECK_EQUAL( bodyField->get( *cell ), bodyFieldInc->get( *cell ), "step " << step << ", cell " << *cell );
+         for( uint_t f = 0; f < Stencil_T::Size; ++f )
+            WALBERLA_CHECK_IDENTICAL( pdfField->get( *cell, f ), pdfFieldInc->get( *cell, f ), "step " << step << ", cell " << *cell );
+      }
+   }
+}
+
+
+int main( int argc, char **argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   bool shortrun = false;
+   for( int i = 1; i < argc; ++i )
+      if( std::strcmp( argv[i], "--shortrun" ) == 0 ) shortrun = true;
+
+   const uint_t timesteps = shortrun ? uint_t(60) : uint_t(600);
+   const real_t domainSize = real_t(48);
+
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(1), uint_t(1), uint_t(1),
+                                                      uint_c(domainSize), uint_c(domainSize), uint_c(domainSize),
+                                                      real_t(1), 0, false, false, false, false, false, false );
+
+   Fields complete( blocks, "(complete)" );
+   Fields incremental( blocks, "(incremental)" );
+
+   pe::SetBodyTypeIDs<BodyTypeTuple>::execute();
+   shared_ptr<pe::BodyStorage> globalBodyStorage = make_shared<pe::BodyStorage>();
+   auto bodyStorageID = blocks->addBlockData( pe::createStorageDataHandling<BodyTypeTuple>(), "Storage" );
+
+   // spheres, boxes, capsules, and an ellipsoid (not cached), with two overlapping spheres
+   math::seedRandomGenerator( 42 );
+   std::vector< pe::Vec3 > velocities;
+   std::vector< pe::Vec3 > angularSteps;
+   for( uint_t i = 0; i < uint_t(12); ++i )
+   {
+      const pe::Vec3 position( math::realRandom<real_t>( real_t(12), domainSize - real_t(12) ),
+                               math::realRandom<real_t>( real_t(12), domainSize - real_t(12) ),
+                               math::realRandom<real_t>( real_t(12), domainSize - real_t(12) ) );
+      if( i < uint_t(6) )
+         pe::createSphere( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, i, position, math::realRandom<real_t>( real_t(3), real_t(8) ) );
+      else if( i < uint_t(8) )
+         pe::createBox( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, i, position, pe::Vec3( real_t(9), real_t(5), real_t(7) ) );
+      else if( i < uint_t(10) )
+         pe::createCapsule( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, i, position, real_t(3), real_t(8) );
+      else if( i < uint_t(11) )
+         pe::createEllipsoid( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, i, position, pe::Vec3( real_t(6), real_t(4), real_t(3) ) );
+      else
+         pe::createSphere( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, i,
+                           blocks->begin()->getData< pe::Storage >( bodyStorageID )->at(0).at(0)->getPosition() + pe::Vec3( real_t(2.5), 0, 0 ), real_t(4) );
+
+      velocities.push_back( pe::Vec3( math::realRandom<real_t>( real_t(-0.05), real_t(0.05) ),
+                                      math::realRandom<real_t>( real_t(-0.05), real_t(0.05) ),
+                                      math::realRandom<real_t>( real_t(-0.05), real_t(0.05) ) ) );
+      angularSteps.push_back( pe::Vec3( math::realRandom<real_t>( real_t(-0.005), real_t(0.005) ),
+                                        math::realRandom<real_t>( real_t(-0.005), real_t(0.005) ),
+                                        math::realRandom<real_t>( real_t(-0.005), real_t(0.005) ) ) );
+   }
+
+   pe_coupling::mapMovingBodies< BoundaryHandling_T >( *blocks, complete.boundaryHandlingID, bodyStorageID, *globalBodyStorage,
+                                                       complete.bodyFieldID, MO_Flag, pe_coupling::selectRegularBodies );
+   pe_coupling::mapMovingBodies< BoundaryHandling_T >( *blocks, incremental.boundaryHandlingID, bodyStorageID, *globalBodyStorage,
+                                                       incremental.bodyFieldID, MO_Flag, pe_coupling::selectRegularBodies );
+
+   pe_coupling::BodyMapping< BoundaryHandling_T > completeMapping( blocks, complete.boundaryHandlingID, bodyStorageID, globalBodyStorage,
+                                                                   complete.bodyFieldID, MO_Flag, FormerMO_Flag );
+   pe_coupling::BodyMapping< BoundaryHandling_T > incrementalMapping( blocks, incremental.boundaryHandlingID, bodyStorageID, globalBodyStorage,
+                                                                      incremental.bodyFieldID, MO_Flag, FormerMO_Flag );
+   auto cache = make_shared< pe_coupling::BodyMappingCache >();
+   incrementalMapping.setBodyMappingCache( cache );
+
+   pe_coupling::PDFReconstruction< LatticeModel_T, BoundaryHandling_T, Reconstructor_T >
+         completeReconstruction( blocks, complete.boundaryHandlingID, bodyStorageID, globalBodyStorage, complete.bodyFieldID,
+                                 Reconstructor_T( blocks, complete.boundaryHandlingID, complete.pdfFieldID, complete.bodyFieldID ),
+                                 FormerMO_Flag, Fluid_Flag );
+   pe_coupling::PDFReconstruction< LatticeModel_T, BoundaryHandling_T, Reconstructor_T >
+         incrementalReconstruction( blocks, incremental.boundaryHandlingID, bodyStorageID, globalBodyStorage, incremental.bodyFieldID,
+                                    Reconstructor_T( blocks, incremental.boundaryHandlingID, incremental.pdfFieldID, incremental.bodyFieldID ),
+                                    FormerMO_Flag, Fluid_Flag );
+   incrementalReconstruction.setBodyMappingCache( cache );
+
+   WcTimer completeTimer;
+   WcTimer incrementalTimer;
+   uint_t cellTests( 0 );
+   uint_t skippedCellTests( 0 );
+
+   for( uint_t step = 0; step < timesteps; ++step )
+   {
+      // move all bodies, reflect them at the domain borders
+      uint_t i = 0;
+      for( auto bodyIt = pe::LocalBodyIterator::begin( *blocks->begin(), bodyStorageID ); bodyIt != pe::LocalBodyIterator::end(); ++bodyIt, ++i )
+      {
+         const pe::Vec3 position = bodyIt->getPosition() + velocities[i];
+         for( uint_t d = 0; d < 3; ++d )
+            if( position[d] < real_t(10) || position[d] > domainSize - real_t(10) ) velocities[i][d] = -velocities[i][d];
+         bodyIt->setPosition( bodyIt->getPosition() + velocities[i] );
+         bodyIt->rotate( angularSteps[i][0], angularSteps[i][1], angularSteps[i][2] );
+      }
+
+      // a body leaves the simulation
+      if( step == timesteps / uint_t(2) )
+      {
+         pe::destroyBodyByUID( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, uint_t(3) );
+         velocities.erase( velocities.begin() + 3 );
+         angularSteps.erase( angularSteps.begin() + 3 );
+      }
+
+      completeTimer.start();
+      for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+         completeMapping( &(*blockIt) );
+      completeTimer.end();
+
+      cache->resetCounters();
+      incrementalTimer.start();
+      for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+         incrementalMapping( &(*blockIt) );
+      incrementalTimer.end();
+      cellTests += cache->getNumberOfCellTests();
+      skippedCellTests += cache->getNumberOfSkippedCellTests();
+
+      for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+      {
+         completeReconstruction( &(*blockIt) );
+         incrementalReconstruction( &(*blockIt) );
+      }
+
+      checkIdentical( blocks, complete, incremental, step );
+   }
+
+   WALBERLA_LOG_INFO( "cell tests per step: " << cellTests / timesteps << ", skipped cell tests per step: " << skippedCellTests / timesteps );
+   WALBERLA_LOG_INFO( "mapping time: complete " << completeTimer.total() << " s, incremental " << incrementalTimer.total() << " s" );
+   WALBERLA_CHECK_GREATER( skippedCellTests, cellTests );
+
+   return EXIT_SUCCESS;
+}
+
+} // namespace incremental_body_mapping_test
+
+int main( int argc, char **argv ){
+   return incremental_body_mapping_test::main(argc, argv);
+}
@@ -0,0 +1,178 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SpherePairSearch.cpp
+//! \ingroup pe_coupling
+//! \brief Compares the cell list sphere pair search with a nested loop over all bodies of a block
+//
+//======================================================================================================================
+
+#include "blockforest/all.h"
+#include "core/all.h"
+#include "domain_decomposition/all.h"
+
+#include "pe/basic.h"
+#include "pe/utility/Distance.h"
+
+#include "pe_coupling/utility/SpherePairSearch.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Random.h"
+#include "core/timing/Timer.h"
+
+#include <cstring>
+#include <vector>
+
+namespace sphere_pair_search_test
+{
+
+using namespace walberla;
+
+typedef boost::tuple<pe::Sphere, pe::Box> BodyTypeTuple;
+
+typedef std::pair< pe::SphereID, pe::SphereID > SpherePair;
+
+/// sphere pairs selected like in the former nested loop of the lubrication correction
+void findPairsBruteForce( IBlock & block, const BlockDataID & bodyStorageID, real_t cutOffDistance, std::vector< SpherePair > & pairs )
+{
+   pairs.clear();
+   for( auto body1It = pe::BodyIterator::begin( block, bodyStorageID ); body1It != pe::BodyIterator::end(); ++body1It )
+   {
+      if( body1It->getTypeID() != pe::Sphere::getStaticTypeID() )
+         continue;
+
+      auto copyBody1It = body1It;
+      for( auto body2It = (++copyBody1It); body2It != pe::BodyIterator::end(); ++body2It )
+      {
+         if( body2It->getTypeID() != pe::Sphere::getStaticTypeID() )
+            continue;
+
+         pe::SphereID sphereI = static_cast<pe::SphereID>( *body1It );
+         pe::SphereID sphereJ = static_cast<pe::SphereID>( *body2It );
+         if( !( pe::getSurfaceDistance( sphereI, sphereJ ) > cutOffDistance ) )
+            pairs.push_back( SpherePair( sphereI, sphereJ ) );
+      }
+   }
+}
+
+/// random suspension of spheres with different radii and some boxes in a single block, some spheres are added as shadow copies
+void createSuspension( pe::BodyStorage & globalBodyStorage, StructuredBlockForest & forest, const BlockDataID & bodyStorageID,
+                       real_t domainSize, uint_t numberOfBodies )
+{
+   math::seedRandomGenerator( 42 );
+
+   pe::MaterialID material = pe::Material::find( "iron" );
+   pe::BodyStorage & shadowStorage = ( *forest.begin()->getData< pe::Storage >( bodyStorageID ) )[1];
+
+   for( uint_t i = 0; i < numberOfBodies; ++i )
+   {
+      const pe::Vec3 position( math::realRandom<real_t>( real_t(0), domainSize ),
+                               math::realRandom<real_t>( real_t(0), domainSize ),
+                               math::realRandom<real_t>( real_t(0), domainSize ) );
+      const real_t radius = math::realRandom<real_t>( real_t(0.5), real_t(1.5) );
+
+      if( i % 10 == 9 )
+      {
+         pe::createBox( globalBodyStorage, forest.getBlockStorage(), bodyStorageID, i, position, pe::Vec3( radius ), material );
+      }
+      else if( i % 10 == 8 )
+      {
+         shadowStorage.add( new pe::Sphere( walberla::id_t( i ) + walberla::id_t( 1000000 ), i, position, pe::Vec3( 0 ), pe::Quat(), radius,
+                                            material, false, false, false ) );
+      }
+      else
+      {
+         pe::createSphere( globalBodyStorage, forest.getBlockStorage(), bodyStorageID, i, position, radius, material );
+      }
+   }
+}
+
+void testPairs( real_t domainSize, uint_t numberOfBodies, real_t cutOffDistance, bool measure )
+{
+   auto forest = blockforest::createUniformBlockGrid( AABB( real_t(0), real_t(0), real_t(0), domainSize, domainSize, domainSize ),
+                                                      uint_t(1), uint_t(1), uint_t(1),
+                                                      uint_t(1), uint_t(1), uint_t(1),
+                                                      true, false, false, false );
+
+   shared_ptr<pe::BodyStorage> globalBodyStorage = make_shared<pe::BodyStorage>();
+   auto bodyStorageID = forest->addBlockData( pe::createStorageDataHandling<BodyTypeTuple>(), "Storage" );
+   createSuspension( *globalBodyStorage, *forest, bodyStorageID, domainSize, numberOfBodies );
+
+   IBlock & block = *forest->begin();
+
+   std::vector< SpherePair > reference;
+   pe_coupling::SpherePairSearch pairSearch( cutOffDistance );
+
+   WcTimer bruteForceTimer;
+   WcTimer cellListTimer;
+
+   bruteForceTimer.start();
+   findPairsBruteForce( block, bodyStorageID, cutOffDistance, reference );
+   bruteForceTimer.end();
+
+   cellListTimer.start();
+   pairSearch.update( block, bodyStorageID );
+   cellListTimer.end();
+
+   // identical pairs in identical order
+   WALBERLA_CHECK_EQUAL( pairSearch.size(), reference.size() );
+   auto refIt = reference.begin();
+   for( auto pairIt = pairSearch.begin(); pairIt != pairSearch.end(); ++pairIt, ++refIt )
+   {
+      WALBERLA_CHECK_EQUAL( pairIt->first , refIt->first  );
+      WALBERLA_CHECK_EQUAL( pairIt->second, refIt->second );
+   }
+
+   // buffers are reused
+   pairSearch.update( block, bodyStorageID );
+   WALBERLA_CHECK_EQUAL( pairSearch.size(), reference.size() );
+
+   if( measure )
+   {
+      WALBERLA_LOG_INFO( numberOfBodies << " bodies, " << reference.size() << " sphere pairs: nested loop " << bruteForceTimer.total()
+                         << " s, cell list " << cellListTimer.total() << " s" );
+   }
+}
+
+int main( int argc, char **argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   bool shortrun = false;
+   for( int i = 1; i < argc; ++i )
+      if( std::strcmp( argv[i], "--shortrun" ) == 0 ) shortrun = true;
+
+   // degenerated configurations
+   testPairs( real_t(10), uint_t(0), real_t(2) / real_t(3), false );
+   testPairs( real_t(10), uint_t(1), real_t(2) / real_t(3), false );
+   testPairs( real_t(10), uint_t(3), real_t(0), false );
+
+   // sparse and dense suspensions
+   testPairs( real_t(200), uint_t(500), real_t(2) / real_t(3), false );
+   testPairs( real_t(20), uint_t(1000), real_t(2) / real_t(3), true );
+   testPairs( real_t(20), uint_t(1000), real_t(4), false );
+   if( !shortrun )
+      testPairs( real_t(40), uint_t(8000), real_t(2) / real_t(3), true );
+
+   return EXIT_SUCCESS;
+}
+
+} //namespace sphere_pair_search_test
+
+int main( int argc, char **argv ){
+   return sphere_pair_search_test::main(argc, argv);
+}